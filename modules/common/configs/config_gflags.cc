@@ -33,6 +33,18 @@ DEFINE_string(end_way_point_filename, "default_end_way_point.txt",
               "End way point of the map, will be sent in RoutingRequest.");
 DEFINE_string(speed_control_filename, "speed_control.pb.txt",
               "The speed control region in a map.");
+DEFINE_bool(use_tiled_map, false,
+            "Load the base map as the tiles around the vehicle.");
+DEFINE_string(map_tile_dirname, "tiles",
+              "The directory of the base map tiles in the map_dir.");
+DEFINE_double(map_tile_load_radius, 500.0,
+              "The tiles of a tiled map within this distance are loaded.");
+DEFINE_double(map_tile_evict_radius, 1000.0,
+              "The tiles of a tiled map beyond this distance are evicted.");
+DEFINE_int32(map_num_prefetch_tiles, 4,
+             "The number of tiles prefetched ahead along the routing.");
+DEFINE_bool(enable_multi_thread_in_map_batch_query, false,
+            "Search the cells of a batch map query in parallel.");
 
 DEFINE_string(vehicle_config_path,
               "/apollo/modules/common/data/vehicle_param.pb.txt",
@@ -29,6 +29,12 @@ DECLARE_string(sim_map_filename);
 DECLARE_string(routing_map_filename);
 DECLARE_string(end_way_point_filename);
 DECLARE_string(speed_control_filename);
+DECLARE_bool(use_tiled_map);
+DECLARE_string(map_tile_dirname);
+DECLARE_double(map_tile_load_radius);
+DECLARE_double(map_tile_evict_radius);
+DECLARE_int32(map_num_prefetch_tiles);
+DECLARE_bool(enable_multi_thread_in_map_batch_query);
 
 DECLARE_double(look_forward_time_sec);
 
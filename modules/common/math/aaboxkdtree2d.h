@@ -16,14 +16,14 @@
 
 /**
  * @file
- * @brief Defines the templated AABoxKDTree2dNode class.
+ * @brief Defines the templated AABoxKDTree2d class.
  */
 
 #pragma once
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
-#include <memory>
 #include <vector>
 
 #include "cyber/common/log.h"
@@ -53,63 +53,58 @@ struct AABoxKDTreeParams {
 };
 
 /**
- * @class AABoxKDTree2dNode
- * @brief The class of KD-tree node of axis-aligned bounding box.
+ * @class AABoxKDTree2d
+ * @brief The class of KD-tree of Aligned Axis Bounding Box(AABox).
+ *
+ * The nodes are stored in one array in pre-order, and the objects of the
+ * nodes in arrays in the same order, so that the objects of a subtree are
+ * contiguous. The bounding boxes of the objects are copied next to them, so
+ * that the objects out of the search range are skipped without reading the
+ * objects themselves.
  */
 template <class ObjectType>
-class AABoxKDTree2dNode {
+class AABoxKDTree2d {
  public:
   using ObjectPtr = const ObjectType *;
+
   /**
-   * @brief Constructor which takes a vector of objects,
-   *        parameters and depth of the node.
-   * @param objects Objects to build the KD-tree node.
+   * @brief Contructor which takes a vector of objects and parameters.
    * @param params Parameters to build the KD-tree.
-   * @param depth Depth of the KD-tree node.
    */
-  AABoxKDTree2dNode(const std::vector<ObjectPtr> &objects,
-                    const AABoxKDTreeParams &params, int depth)
-      : depth_(depth) {
-    CHECK(!objects.empty());
-
-    ComputeBoundary(objects);
-    ComputePartition();
-
-    if (SplitToSubNodes(objects, params)) {
-      std::vector<ObjectPtr> left_subnode_objects;
-      std::vector<ObjectPtr> right_subnode_objects;
-      PartitionObjects(objects, &left_subnode_objects, &right_subnode_objects);
-
-      // Split to sub-nodes.
-      if (!left_subnode_objects.empty()) {
-        left_subnode_.reset(new AABoxKDTree2dNode<ObjectType>(
-            left_subnode_objects, params, depth + 1));
-      }
-      if (!right_subnode_objects.empty()) {
-        right_subnode_.reset(new AABoxKDTree2dNode<ObjectType>(
-            right_subnode_objects, params, depth + 1));
+  AABoxKDTree2d(const std::vector<ObjectType> &objects,
+                const AABoxKDTreeParams &params) {
+    if (!objects.empty()) {
+      std::vector<ObjectPtr> object_ptrs;
+      object_ptrs.reserve(objects.size());
+      for (const auto &object : objects) {
+        object_ptrs.push_back(&object);
       }
-    } else {
-      InitObjects(objects);
+      objects_sorted_by_min_.reserve(objects.size());
+      objects_sorted_by_max_.reserve(objects.size());
+      objects_sorted_by_min_bound_.reserve(objects.size());
+      objects_sorted_by_max_bound_.reserve(objects.size());
+      objects_sorted_by_min_box_.reserve(objects.size());
+      objects_sorted_by_max_box_.reserve(objects.size());
+      BuildNode(object_ptrs, params, 0);
     }
   }
 
   /**
-   * @brief Get the nearest object to a target point by the KD-tree
-   *        rooted at this node.
+   * @brief Get the nearest object to a target point.
    * @param point The target point. Search it's nearest object.
    * @return The nearest object to the target point.
    */
   ObjectPtr GetNearestObject(const Vec2d &point) const {
     ObjectPtr nearest_object = nullptr;
-    double min_distance_sqr = std::numeric_limits<double>::infinity();
-    GetNearestObjectInternal(point, &min_distance_sqr, &nearest_object);
+    if (!nodes_.empty()) {
+      double min_distance_sqr = std::numeric_limits<double>::infinity();
+      GetNearestObjectInternal(0, point, &min_distance_sqr, &nearest_object);
+    }
     return nearest_object;
   }
 
   /**
-   * @brief Get objects within a distance to a point by the KD-tree
-   *        rooted at this node.
+   * @brief Get objects within a distance to a point.
    * @param point The center point of the range to search objects.
    * @param distance The radius of the range to search objects.
    * @return All objects within the specified distance to the specified point.
@@ -117,7 +112,10 @@ class AABoxKDTree2dNode {
   std::vector<ObjectPtr> GetObjects(const Vec2d &point,
                                     const double distance) const {
     std::vector<ObjectPtr> result_objects;
-    GetObjectsInternal(point, distance, Square(distance), &result_objects);
+    if (!nodes_.empty()) {
+      GetObjectsInternal(0, point, distance, Square(distance),
+                         &result_objects);
+    }
     return result_objects;
   }
 
@@ -126,109 +124,198 @@ class AABoxKDTree2dNode {
    * @return The axis-aligned bounding box of the objects.
    */
   AABox2d GetBoundingBox() const {
-    return AABox2d({min_x_, min_y_}, {max_x_, max_y_});
+    if (nodes_.empty()) {
+      return AABox2d();
+    }
+    const Box &box = nodes_.front().box;
+    return AABox2d({box.min_x, box.min_y}, {box.max_x, box.max_y});
   }
 
  private:
-  void InitObjects(const std::vector<ObjectPtr> &objects) {
-    num_objects_ = static_cast<int>(objects.size());
-    objects_sorted_by_min_ = objects;
-    objects_sorted_by_max_ = objects;
-    std::sort(objects_sorted_by_min_.begin(), objects_sorted_by_min_.end(),
+  enum Partition {
+    PARTITION_X = 1,
+    PARTITION_Y = 2,
+  };
+
+  struct Box {
+    double min_x = 0.0;
+    double max_x = 0.0;
+    double min_y = 0.0;
+    double max_y = 0.0;
+  };
+
+  struct Node {
+    // Boundary
+    Box box;
+
+    double partition_position = 0.0;
+    Partition partition = PARTITION_X;
+
+    // The left subnode, if any, is the next node.
+    bool has_left_subnode = false;
+    int right_subnode = -1;
+
+    // The objects of the node are [objects_begin, objects_end) and the
+    // objects of the subtree rooted at the node are
+    // [objects_begin, subtree_objects_end) in the object arrays.
+    int objects_begin = 0;
+    int objects_end = 0;
+    int subtree_objects_end = 0;
+  };
+
+  // Branch-free, the same as the distance with the branches on the sides.
+  static double LowerDistanceSquareToPoint(const Box &box,
+                                           const Vec2d &point) {
+    const double dx =
+        std::max(0.0, std::max(box.min_x - point.x(), point.x() - box.max_x));
+    const double dy =
+        std::max(0.0, std::max(box.min_y - point.y(), point.y() - box.max_y));
+    return dx * dx + dy * dy;
+  }
+
+  static double UpperDistanceSquareToPoint(const Box &box,
+                                           const Vec2d &point) {
+    const double mid_x = (box.min_x + box.max_x) / 2.0;
+    const double mid_y = (box.min_y + box.max_y) / 2.0;
+    const double dx = (point.x() > mid_x ? (point.x() - box.min_x)
+                                         : (point.x() - box.max_x));
+    const double dy = (point.y() > mid_y ? (point.y() - box.min_y)
+                                         : (point.y() - box.max_y));
+    return dx * dx + dy * dy;
+  }
+
+  // Whether the object with the box may be within the distance to the point.
+  // The box is a lower bound of the distance up to the rounding of the
+  // object, hence the margin.
+  static bool MayBeWithin(const Box &box, const Vec2d &point,
+                          const double distance_sqr) {
+    return LowerDistanceSquareToPoint(box, point) <=
+           distance_sqr + kMathEpsilon;
+  }
+
+  int BuildNode(const std::vector<ObjectPtr> &objects,
+                const AABoxKDTreeParams &params, int depth) {
+    CHECK(!objects.empty());
+    const int index = static_cast<int>(nodes_.size());
+    nodes_.emplace_back();
+
+    // nodes_ grows with the subnodes, so the node is filled aside.
+    Node node;
+    ComputeBoundary(objects, &node);
+    ComputePartition(&node);
+
+    if (SplitToSubNodes(objects, params, depth, node)) {
+      std::vector<ObjectPtr> left_subnode_objects;
+      std::vector<ObjectPtr> right_subnode_objects;
+      std::vector<ObjectPtr> other_objects;
+      PartitionObjects(objects, node, &left_subnode_objects,
+                       &right_subnode_objects, &other_objects);
+      InitObjects(other_objects, &node);
+
+      // Split to sub-nodes.
+      if (!left_subnode_objects.empty()) {
+        BuildNode(left_subnode_objects, params, depth + 1);
+        node.has_left_subnode = true;
+      }
+      if (!right_subnode_objects.empty()) {
+        node.right_subnode =
+            BuildNode(right_subnode_objects, params, depth + 1);
+      }
+    } else {
+      InitObjects(objects, &node);
+    }
+    node.subtree_objects_end = static_cast<int>(objects_sorted_by_min_.size());
+    nodes_[index] = node;
+    return index;
+  }
+
+  void InitObjects(const std::vector<ObjectPtr> &objects, Node *const node) {
+    const Partition partition = node->partition;
+    std::vector<ObjectPtr> objects_sorted_by_min = objects;
+    std::vector<ObjectPtr> objects_sorted_by_max = objects;
+    std::sort(objects_sorted_by_min.begin(), objects_sorted_by_min.end(),
               [&](ObjectPtr obj1, ObjectPtr obj2) {
-                return partition_ == PARTITION_X
+                return partition == PARTITION_X
                            ? obj1->aabox().min_x() < obj2->aabox().min_x()
                            : obj1->aabox().min_y() < obj2->aabox().min_y();
               });
-    std::sort(objects_sorted_by_max_.begin(), objects_sorted_by_max_.end(),
+    std::sort(objects_sorted_by_max.begin(), objects_sorted_by_max.end(),
               [&](ObjectPtr obj1, ObjectPtr obj2) {
-                return partition_ == PARTITION_X
+                return partition == PARTITION_X
                            ? obj1->aabox().max_x() > obj2->aabox().max_x()
                            : obj1->aabox().max_y() > obj2->aabox().max_y();
               });
-    objects_sorted_by_min_bound_.reserve(num_objects_);
-    for (ObjectPtr object : objects_sorted_by_min_) {
-      objects_sorted_by_min_bound_.push_back(partition_ == PARTITION_X
+    node->objects_begin = static_cast<int>(objects_sorted_by_min_.size());
+    for (ObjectPtr object : objects_sorted_by_min) {
+      objects_sorted_by_min_.push_back(object);
+      objects_sorted_by_min_bound_.push_back(partition == PARTITION_X
                                                  ? object->aabox().min_x()
                                                  : object->aabox().min_y());
+      objects_sorted_by_min_box_.push_back(ObjectBox(object));
     }
-    objects_sorted_by_max_bound_.reserve(num_objects_);
-    for (ObjectPtr object : objects_sorted_by_max_) {
-      objects_sorted_by_max_bound_.push_back(partition_ == PARTITION_X
+    for (ObjectPtr object : objects_sorted_by_max) {
+      objects_sorted_by_max_.push_back(object);
+      objects_sorted_by_max_bound_.push_back(partition == PARTITION_X
                                                  ? object->aabox().max_x()
                                                  : object->aabox().max_y());
+      objects_sorted_by_max_box_.push_back(ObjectBox(object));
     }
+    node->objects_end = static_cast<int>(objects_sorted_by_min_.size());
+  }
+
+  static Box ObjectBox(ObjectPtr object) {
+    Box box;
+    box.min_x = object->aabox().min_x();
+    box.max_x = object->aabox().max_x();
+    box.min_y = object->aabox().min_y();
+    box.max_y = object->aabox().max_y();
+    return box;
   }
 
   bool SplitToSubNodes(const std::vector<ObjectPtr> &objects,
-                       const AABoxKDTreeParams &params) {
-    if (params.max_depth >= 0 && depth_ >= params.max_depth) {
+                       const AABoxKDTreeParams &params, const int depth,
+                       const Node &node) const {
+    if (params.max_depth >= 0 && depth >= params.max_depth) {
       return false;
     }
     if (static_cast<int>(objects.size()) <= std::max(1, params.max_leaf_size)) {
       return false;
     }
     if (params.max_leaf_dimension >= 0.0 &&
-        std::max(max_x_ - min_x_, max_y_ - min_y_) <=
+        std::max(node.box.max_x - node.box.min_x,
+                 node.box.max_y - node.box.min_y) <=
             params.max_leaf_dimension) {
       return false;
     }
     return true;
   }
 
-  double LowerDistanceSquareToPoint(const Vec2d &point) const {
-    double dx = 0.0;
-    if (point.x() < min_x_) {
-      dx = min_x_ - point.x();
-    } else if (point.x() > max_x_) {
-      dx = point.x() - max_x_;
-    }
-    double dy = 0.0;
-    if (point.y() < min_y_) {
-      dy = min_y_ - point.y();
-    } else if (point.y() > max_y_) {
-      dy = point.y() - max_y_;
-    }
-    return dx * dx + dy * dy;
-  }
-
-  double UpperDistanceSquareToPoint(const Vec2d &point) const {
-    const double dx =
-        (point.x() > mid_x_ ? (point.x() - min_x_) : (point.x() - max_x_));
-    const double dy =
-        (point.y() > mid_y_ ? (point.y() - min_y_) : (point.y() - max_y_));
-    return dx * dx + dy * dy;
-  }
-
-  void GetAllObjects(std::vector<ObjectPtr> *const result_objects) const {
-    result_objects->insert(result_objects->end(),
-                           objects_sorted_by_min_.begin(),
-                           objects_sorted_by_min_.end());
-    if (left_subnode_ != nullptr) {
-      left_subnode_->GetAllObjects(result_objects);
-    }
-    if (right_subnode_ != nullptr) {
-      right_subnode_->GetAllObjects(result_objects);
-    }
-  }
-
-  void GetObjectsInternal(const Vec2d &point, const double distance,
-                          const double distance_sqr,
+  void GetObjectsInternal(const int index, const Vec2d &point,
+                          const double distance, const double distance_sqr,
                           std::vector<ObjectPtr> *const result_objects) const {
-    if (LowerDistanceSquareToPoint(point) > distance_sqr) {
+    const Node &node = nodes_[index];
+    if (LowerDistanceSquareToPoint(node.box, point) > distance_sqr) {
       return;
     }
-    if (UpperDistanceSquareToPoint(point) <= distance_sqr) {
-      GetAllObjects(result_objects);
+    if (UpperDistanceSquareToPoint(node.box, point) <= distance_sqr) {
+      // All the objects of the subtree.
+      result_objects->insert(
+          result_objects->end(),
+          objects_sorted_by_min_.begin() + node.objects_begin,
+          objects_sorted_by_min_.begin() + node.subtree_objects_end);
       return;
     }
-    const double pvalue = (partition_ == PARTITION_X ? point.x() : point.y());
-    if (pvalue < partition_position_) {
+    const double pvalue =
+        (node.partition == PARTITION_X ? point.x() : point.y());
+    if (pvalue < node.partition_position) {
       const double limit = pvalue + distance;
-      for (int i = 0; i < num_objects_; ++i) {
+      for (int i = node.objects_begin; i < node.objects_end; ++i) {
         if (objects_sorted_by_min_bound_[i] > limit) {
           break;
         }
+        if (!MayBeWithin(objects_sorted_by_min_box_[i], point, distance_sqr)) {
+          continue;
+        }
         ObjectPtr object = objects_sorted_by_min_[i];
         if (object->DistanceSquareTo(point) <= distance_sqr) {
           result_objects->push_back(object);
@@ -236,43 +323,49 @@ class AABoxKDTree2dNode {
       }
     } else {
       const double limit = pvalue - distance;
-      for (int i = 0; i < num_objects_; ++i) {
+      for (int i = node.objects_begin; i < node.objects_end; ++i) {
         if (objects_sorted_by_max_bound_[i] < limit) {
           break;
         }
+        if (!MayBeWithin(objects_sorted_by_max_box_[i], point, distance_sqr)) {
+          continue;
+        }
         ObjectPtr object = objects_sorted_by_max_[i];
         if (object->DistanceSquareTo(point) <= distance_sqr) {
           result_objects->push_back(object);
         }
       }
     }
-    if (left_subnode_ != nullptr) {
-      left_subnode_->GetObjectsInternal(point, distance, distance_sqr,
-                                        result_objects);
+    if (node.has_left_subnode) {
+      GetObjectsInternal(index + 1, point, distance, distance_sqr,
+                         result_objects);
     }
-    if (right_subnode_ != nullptr) {
-      right_subnode_->GetObjectsInternal(point, distance, distance_sqr,
-                                         result_objects);
+    if (node.right_subnode >= 0) {
+      GetObjectsInternal(node.right_subnode, point, distance, distance_sqr,
+                         result_objects);
     }
   }
 
-  void GetNearestObjectInternal(const Vec2d &point,
+  void GetNearestObjectInternal(const int index, const Vec2d &point,
                                 double *const min_distance_sqr,
                                 ObjectPtr *const nearest_object) const {
-    if (LowerDistanceSquareToPoint(point) >= *min_distance_sqr - kMathEpsilon) {
+    const Node &node = nodes_[index];
+    if (LowerDistanceSquareToPoint(node.box, point) >=
+        *min_distance_sqr - kMathEpsilon) {
       return;
     }
-    const double pvalue = (partition_ == PARTITION_X ? point.x() : point.y());
-    const bool search_left_first = (pvalue < partition_position_);
+    const double pvalue =
+        (node.partition == PARTITION_X ? point.x() : point.y());
+    const bool search_left_first = (pvalue < node.partition_position);
     if (search_left_first) {
-      if (left_subnode_ != nullptr) {
-        left_subnode_->GetNearestObjectInternal(point, min_distance_sqr,
-                                                nearest_object);
+      if (node.has_left_subnode) {
+        GetNearestObjectInternal(index + 1, point, min_distance_sqr,
+                                 nearest_object);
       }
     } else {
-      if (right_subnode_ != nullptr) {
-        right_subnode_->GetNearestObjectInternal(point, min_distance_sqr,
-                                                 nearest_object);
+      if (node.right_subnode >= 0) {
+        GetNearestObjectInternal(node.right_subnode, point, min_distance_sqr,
+                                 nearest_object);
       }
     }
     if (*min_distance_sqr <= kMathEpsilon) {
@@ -280,11 +373,15 @@ class AABoxKDTree2dNode {
     }
 
     if (search_left_first) {
-      for (int i = 0; i < num_objects_; ++i) {
+      for (int i = node.objects_begin; i < node.objects_end; ++i) {
         const double bound = objects_sorted_by_min_bound_[i];
         if (bound > pvalue && Square(bound - pvalue) > *min_distance_sqr) {
           break;
         }
+        if (!MayBeWithin(objects_sorted_by_min_box_[i], point,
+                         *min_distance_sqr)) {
+          continue;
+        }
         ObjectPtr object = objects_sorted_by_min_[i];
         const double distance_sqr = object->DistanceSquareTo(point);
         if (distance_sqr < *min_distance_sqr) {
@@ -293,11 +390,15 @@ class AABoxKDTree2dNode {
         }
       }
     } else {
-      for (int i = 0; i < num_objects_; ++i) {
+      for (int i = node.objects_begin; i < node.objects_end; ++i) {
         const double bound = objects_sorted_by_max_bound_[i];
         if (bound < pvalue && Square(bound - pvalue) > *min_distance_sqr) {
           break;
         }
+        if (!MayBeWithin(objects_sorted_by_max_box_[i], point,
+                         *min_distance_sqr)) {
+          continue;
+        }
         ObjectPtr object = objects_sorted_by_max_[i];
         const double distance_sqr = object->DistanceSquareTo(point);
         if (distance_sqr < *min_distance_sqr) {
@@ -310,160 +411,84 @@ class AABoxKDTree2dNode {
       return;
     }
     if (search_left_first) {
-      if (right_subnode_ != nullptr) {
-        right_subnode_->GetNearestObjectInternal(point, min_distance_sqr,
-                                                 nearest_object);
+      if (node.right_subnode >= 0) {
+        GetNearestObjectInternal(node.right_subnode, point, min_distance_sqr,
+                                 nearest_object);
       }
     } else {
-      if (left_subnode_ != nullptr) {
-        left_subnode_->GetNearestObjectInternal(point, min_distance_sqr,
-                                                nearest_object);
+      if (node.has_left_subnode) {
+        GetNearestObjectInternal(index + 1, point, min_distance_sqr,
+                                 nearest_object);
       }
     }
   }
 
-  void ComputeBoundary(const std::vector<ObjectPtr> &objects) {
-    min_x_ = std::numeric_limits<double>::infinity();
-    min_y_ = std::numeric_limits<double>::infinity();
-    max_x_ = -std::numeric_limits<double>::infinity();
-    max_y_ = -std::numeric_limits<double>::infinity();
+  static void ComputeBoundary(const std::vector<ObjectPtr> &objects,
+                              Node *const node) {
+    Box &box = node->box;
+    box.min_x = std::numeric_limits<double>::infinity();
+    box.min_y = std::numeric_limits<double>::infinity();
+    box.max_x = -std::numeric_limits<double>::infinity();
+    box.max_y = -std::numeric_limits<double>::infinity();
     for (ObjectPtr object : objects) {
-      min_x_ = std::fmin(min_x_, object->aabox().min_x());
-      max_x_ = std::fmax(max_x_, object->aabox().max_x());
-      min_y_ = std::fmin(min_y_, object->aabox().min_y());
-      max_y_ = std::fmax(max_y_, object->aabox().max_y());
+      box.min_x = std::fmin(box.min_x, object->aabox().min_x());
+      box.max_x = std::fmax(box.max_x, object->aabox().max_x());
+      box.min_y = std::fmin(box.min_y, object->aabox().min_y());
+      box.max_y = std::fmax(box.max_y, object->aabox().max_y());
     }
-    mid_x_ = (min_x_ + max_x_) / 2.0;
-    mid_y_ = (min_y_ + max_y_) / 2.0;
-    CHECK(!std::isinf(max_x_) && !std::isinf(max_y_) && !std::isinf(min_x_) &&
-          !std::isinf(min_y_))
+    CHECK(!std::isinf(box.max_x) && !std::isinf(box.max_y) &&
+          !std::isinf(box.min_x) && !std::isinf(box.min_y))
         << "the provided object box size is infinity";
   }
 
-  void ComputePartition() {
-    if (max_x_ - min_x_ >= max_y_ - min_y_) {
-      partition_ = PARTITION_X;
-      partition_position_ = (min_x_ + max_x_) / 2.0;
+  static void ComputePartition(Node *const node) {
+    const Box &box = node->box;
+    if (box.max_x - box.min_x >= box.max_y - box.min_y) {
+      node->partition = PARTITION_X;
+      node->partition_position = (box.min_x + box.max_x) / 2.0;
     } else {
-      partition_ = PARTITION_Y;
-      partition_position_ = (min_y_ + max_y_) / 2.0;
+      node->partition = PARTITION_Y;
+      node->partition_position = (box.min_y + box.max_y) / 2.0;
     }
   }
 
-  void PartitionObjects(const std::vector<ObjectPtr> &objects,
-                        std::vector<ObjectPtr> *const left_subnode_objects,
-                        std::vector<ObjectPtr> *const right_subnode_objects) {
-    left_subnode_objects->clear();
-    right_subnode_objects->clear();
-    std::vector<ObjectPtr> other_objects;
-    if (partition_ == PARTITION_X) {
+  static void PartitionObjects(
+      const std::vector<ObjectPtr> &objects, const Node &node,
+      std::vector<ObjectPtr> *const left_subnode_objects,
+      std::vector<ObjectPtr> *const right_subnode_objects,
+      std::vector<ObjectPtr> *const other_objects) {
+    if (node.partition == PARTITION_X) {
       for (ObjectPtr object : objects) {
-        if (object->aabox().max_x() <= partition_position_) {
+        if (object->aabox().max_x() <= node.partition_position) {
           left_subnode_objects->push_back(object);
-        } else if (object->aabox().min_x() >= partition_position_) {
+        } else if (object->aabox().min_x() >= node.partition_position) {
           right_subnode_objects->push_back(object);
         } else {
-          other_objects.push_back(object);
+          other_objects->push_back(object);
         }
       }
     } else {
       for (ObjectPtr object : objects) {
-        if (object->aabox().max_y() <= partition_position_) {
+        if (object->aabox().max_y() <= node.partition_position) {
           left_subnode_objects->push_back(object);
-        } else if (object->aabox().min_y() >= partition_position_) {
+        } else if (object->aabox().min_y() >= node.partition_position) {
           right_subnode_objects->push_back(object);
         } else {
-          other_objects.push_back(object);
+          other_objects->push_back(object);
         }
       }
     }
-    InitObjects(other_objects);
   }
 
  private:
-  int num_objects_ = 0;
+  std::vector<Node> nodes_;
+
   std::vector<ObjectPtr> objects_sorted_by_min_;
   std::vector<ObjectPtr> objects_sorted_by_max_;
   std::vector<double> objects_sorted_by_min_bound_;
   std::vector<double> objects_sorted_by_max_bound_;
-  int depth_ = 0;
-
-  // Boundary
-  double min_x_ = 0.0;
-  double max_x_ = 0.0;
-  double min_y_ = 0.0;
-  double max_y_ = 0.0;
-  double mid_x_ = 0.0;
-  double mid_y_ = 0.0;
-
-  enum Partition {
-    PARTITION_X = 1,
-    PARTITION_Y = 2,
-  };
-  Partition partition_ = PARTITION_X;
-  double partition_position_ = 0.0;
-
-  std::unique_ptr<AABoxKDTree2dNode<ObjectType>> left_subnode_ = nullptr;
-  std::unique_ptr<AABoxKDTree2dNode<ObjectType>> right_subnode_ = nullptr;
-};
-
-/**
- * @class AABoxKDTree2d
- * @brief The class of KD-tree of Aligned Axis Bounding Box(AABox).
- */
-template <class ObjectType>
-class AABoxKDTree2d {
- public:
-  using ObjectPtr = const ObjectType *;
-
-  /**
-   * @brief Contructor which takes a vector of objects and parameters.
-   * @param params Parameters to build the KD-tree.
-   */
-  AABoxKDTree2d(const std::vector<ObjectType> &objects,
-                const AABoxKDTreeParams &params) {
-    if (!objects.empty()) {
-      std::vector<ObjectPtr> object_ptrs;
-      for (const auto &object : objects) {
-        object_ptrs.push_back(&object);
-      }
-      root_.reset(new AABoxKDTree2dNode<ObjectType>(object_ptrs, params, 0));
-    }
-  }
-
-  /**
-   * @brief Get the nearest object to a target point.
-   * @param point The target point. Search it's nearest object.
-   * @return The nearest object to the target point.
-   */
-  ObjectPtr GetNearestObject(const Vec2d &point) const {
-    return root_ == nullptr ? nullptr : root_->GetNearestObject(point);
-  }
-
-  /**
-   * @brief Get objects within a distance to a point.
-   * @param point The center point of the range to search objects.
-   * @param distance The radius of the range to search objects.
-   * @return All objects within the specified distance to the specified point.
-   */
-  std::vector<ObjectPtr> GetObjects(const Vec2d &point,
-                                    const double distance) const {
-    if (root_ == nullptr) {
-      return {};
-    }
-    return root_->GetObjects(point, distance);
-  }
-
-  /**
-   * @brief Get the axis-aligned bounding box of the objects.
-   * @return The axis-aligned bounding box of the objects.
-   */
-  AABox2d GetBoundingBox() const {
-    return root_ == nullptr ? AABox2d() : root_->GetBoundingBox();
-  }
-
- private:
-  std::unique_ptr<AABoxKDTree2dNode<ObjectType>> root_ = nullptr;
+  std::vector<Box> objects_sorted_by_min_box_;
+  std::vector<Box> objects_sorted_by_max_box_;
 };
 
 }  // namespace math
@@ -0,0 +1,270 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+// Benchmark of the kd-tree queries of the map and the obstacles. The map
+// workload is the lane segment tree of the HD map: a grid of winding roads of
+// four lanes, split into segments of one meter, with the parameters of
+// HDMapImpl. The obstacle workload is a tree of the polygons of the vehicles
+// around the roads, with one polygon per leaf like the junctions and the
+// crosswalks of the map.
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/common/math/aaboxkdtree2d.h"
+#include "modules/common/math/box2d.h"
+#include "modules/common/math/line_segment2d.h"
+#include "modules/common/math/polygon2d.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+const double kRoadSpacing = 200.0;
+const double kLaneWidth = 3.5;
+const int kNumLanes = 4;
+const double kSegmentLength = 1.0;
+const int kNumQueries = 4096;
+
+// An object referring to its geometry, as ObjectWithAABox in the HD map.
+template <class GeoObject>
+class GeoObjectWithAABox {
+ public:
+  GeoObjectWithAABox(const AABox2d &aabox, const GeoObject *geo_object)
+      : aabox_(aabox), geo_object_(geo_object) {}
+  const AABox2d &aabox() const { return aabox_; }
+  double DistanceTo(const Vec2d &point) const {
+    return geo_object_->DistanceTo(point);
+  }
+  double DistanceSquareTo(const Vec2d &point) const {
+    return geo_object_->DistanceSquareTo(point);
+  }
+
+ private:
+  AABox2d aabox_;
+  const GeoObject *geo_object_;
+};
+
+using SegmentObject = GeoObjectWithAABox<LineSegment2d>;
+using PolygonObject = GeoObjectWithAABox<Polygon2d>;
+
+// The lane segments of num_roads x num_roads roads, half of them along x and
+// the others along y.
+std::vector<LineSegment2d> MakeLaneSegments(const int num_roads) {
+  std::vector<LineSegment2d> segments;
+  const double road_length = kRoadSpacing * num_roads;
+  for (int road = 0; road < 2 * num_roads; ++road) {
+    const bool along_x = road < num_roads;
+    const double offset = kRoadSpacing * (road % num_roads + 0.5);
+    for (int lane = 0; lane < kNumLanes; ++lane) {
+      const double lateral =
+          offset + (lane - (kNumLanes - 1) * 0.5) * kLaneWidth;
+      Vec2d last_point;
+      for (double s = 0.0; s <= road_length; s += kSegmentLength) {
+        const double l = lateral + 5.0 * std::sin(s * 0.01 + road);
+        const Vec2d point = along_x ? Vec2d(s, l) : Vec2d(l, s);
+        if (s > 0.0) {
+          segments.emplace_back(last_point, point);
+        }
+        last_point = point;
+      }
+    }
+  }
+  return segments;
+}
+
+// The polygons of the vehicles on the lanes of the roads.
+std::vector<Polygon2d> MakeObstacles(const int num_roads) {
+  std::mt19937 random_engine(0);
+  std::uniform_real_distribution<double> s_distribution(
+      0.0, kRoadSpacing * num_roads);
+  std::uniform_real_distribution<double> heading_distribution(-0.2, 0.2);
+  std::vector<Polygon2d> obstacles;
+  for (int road = 0; road < 2 * num_roads; ++road) {
+    const bool along_x = road < num_roads;
+    const double offset = kRoadSpacing * (road % num_roads + 0.5);
+    for (int i = 0; i < 50; ++i) {
+      const double s = s_distribution(random_engine);
+      const double l =
+          offset + (i % kNumLanes - (kNumLanes - 1) * 0.5) * kLaneWidth;
+      const double heading = heading_distribution(random_engine) +
+                             (along_x ? 0.0 : M_PI_2);
+      obstacles.emplace_back(
+          Box2d(along_x ? Vec2d(s, l) : Vec2d(l, s), heading, 4.8, 2.0));
+    }
+  }
+  return obstacles;
+}
+
+std::vector<Vec2d> MakeQueries(const int num_roads) {
+  std::mt19937 random_engine(1);
+  std::uniform_real_distribution<double> s_distribution(
+      0.0, kRoadSpacing * num_roads);
+  std::uniform_real_distribution<double> l_distribution(-10.0, 10.0);
+  std::uniform_int_distribution<int> road_distribution(0, 2 * num_roads - 1);
+  std::vector<Vec2d> queries;
+  for (int i = 0; i < kNumQueries; ++i) {
+    const int road = road_distribution(random_engine);
+    const double s = s_distribution(random_engine);
+    const double l =
+        kRoadSpacing * (road % num_roads + 0.5) + l_distribution(random_engine);
+    queries.push_back(road < num_roads ? Vec2d(s, l) : Vec2d(l, s));
+  }
+  return queries;
+}
+
+template <class GeoObject>
+std::vector<GeoObjectWithAABox<GeoObject>> MakeObjects(
+    const std::vector<GeoObject> &geo_objects) {
+  std::vector<GeoObjectWithAABox<GeoObject>> objects;
+  objects.reserve(geo_objects.size());
+  for (const auto &geo_object : geo_objects) {
+    objects.emplace_back(AABox2d(geo_object.start(), geo_object.end()),
+                         &geo_object);
+  }
+  return objects;
+}
+
+template <>
+std::vector<PolygonObject> MakeObjects(
+    const std::vector<Polygon2d> &geo_objects) {
+  std::vector<PolygonObject> objects;
+  objects.reserve(geo_objects.size());
+  for (const auto &geo_object : geo_objects) {
+    objects.emplace_back(geo_object.AABoundingBox(), &geo_object);
+  }
+  return objects;
+}
+
+AABoxKDTreeParams LaneSegmentParams() {
+  AABoxKDTreeParams params;
+  params.max_leaf_dimension = 5.0;
+  params.max_leaf_size = 16;
+  return params;
+}
+
+AABoxKDTreeParams PolygonParams() {
+  AABoxKDTreeParams params;
+  params.max_leaf_dimension = 5.0;
+  params.max_leaf_size = 1;
+  return params;
+}
+
+// state.range(0): number of roads along each axis
+void BM_LaneSegmentsGetNearestObject(benchmark::State &state) {
+  const int num_roads = static_cast<int>(state.range(0));
+  const auto segments = MakeLaneSegments(num_roads);
+  const auto objects = MakeObjects(segments);
+  const AABoxKDTree2d<SegmentObject> kdtree(objects, LaneSegmentParams());
+  const auto queries = MakeQueries(num_roads);
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(
+        kdtree.GetNearestObject(queries[i++ % queries.size()]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// state.range(0): number of roads along each axis
+// state.range(1): search radius in meters
+void BM_LaneSegmentsGetObjects(benchmark::State &state) {
+  const int num_roads = static_cast<int>(state.range(0));
+  const auto segments = MakeLaneSegments(num_roads);
+  const auto objects = MakeObjects(segments);
+  const AABoxKDTree2d<SegmentObject> kdtree(objects, LaneSegmentParams());
+  const auto queries = MakeQueries(num_roads);
+  const double distance = static_cast<double>(state.range(1));
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    const auto result =
+        kdtree.GetObjects(queries[i++ % queries.size()], distance);
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// state.range(0): number of roads along each axis
+void BM_ObstaclePolygonsGetNearestObject(benchmark::State &state) {
+  const int num_roads = static_cast<int>(state.range(0));
+  const auto polygons = MakeObstacles(num_roads);
+  const auto objects = MakeObjects(polygons);
+  const AABoxKDTree2d<PolygonObject> kdtree(objects, PolygonParams());
+  const auto queries = MakeQueries(num_roads);
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(
+        kdtree.GetNearestObject(queries[i++ % queries.size()]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// state.range(0): number of roads along each axis
+// state.range(1): search radius in meters
+void BM_ObstaclePolygonsGetObjects(benchmark::State &state) {
+  const int num_roads = static_cast<int>(state.range(0));
+  const auto polygons = MakeObstacles(num_roads);
+  const auto objects = MakeObjects(polygons);
+  const AABoxKDTree2d<PolygonObject> kdtree(objects, PolygonParams());
+  const auto queries = MakeQueries(num_roads);
+  const double distance = static_cast<double>(state.range(1));
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    const auto result =
+        kdtree.GetObjects(queries[i++ % queries.size()], distance);
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// state.range(0): number of roads along each axis
+void BM_LaneSegmentsConstruction(benchmark::State &state) {
+  const auto segments = MakeLaneSegments(static_cast<int>(state.range(0)));
+  const auto objects = MakeObjects(segments);
+  while (state.KeepRunning()) {
+    std::unique_ptr<AABoxKDTree2d<SegmentObject>> kdtree(
+        new AABoxKDTree2d<SegmentObject>(objects, LaneSegmentParams()));
+    benchmark::DoNotOptimize(kdtree.get());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_LaneSegmentsGetNearestObject)->Arg(2)->Arg(8)->Arg(16);
+BENCHMARK(BM_LaneSegmentsGetObjects)
+    ->Args({2, 10})
+    ->Args({8, 10})
+    ->Args({8, 50})
+    ->Args({16, 10});
+BENCHMARK(BM_ObstaclePolygonsGetNearestObject)->Arg(2)->Arg(8)->Arg(16);
+BENCHMARK(BM_ObstaclePolygonsGetObjects)->Args({2, 50})->Args({8, 50});
+BENCHMARK(BM_LaneSegmentsConstruction)
+    ->Arg(2)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+int main(int argc, char **argv) {
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
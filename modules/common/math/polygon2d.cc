@@ -29,6 +29,38 @@ namespace apollo {
 namespace common {
 namespace math {
 
+namespace {
+
+// The minimal square distance between the points and the edges. The loop
+// over the points is branch-free, and all the points are tested in one pass
+// over the edges.
+double MinDistanceSquareToEdges(const std::vector<LineSegment2d> &edges,
+                                const Vec2d *const points,
+                                const int num_points) {
+  double distance_sqr = std::numeric_limits<double>::infinity();
+  for (const auto &edge : edges) {
+    const double start_x = edge.start().x();
+    const double start_y = edge.start().y();
+    // the unit direction of the degenerated edges is zero, so that their
+    // distance is to the start points
+    const double unit_x = edge.unit_direction().x();
+    const double unit_y = edge.unit_direction().y();
+    const double length = edge.length();
+    for (int i = 0; i < num_points; ++i) {
+      const double x0 = points[i].x() - start_x;
+      const double y0 = points[i].y() - start_y;
+      const double proj =
+          std::min(length, std::max(0.0, x0 * unit_x + y0 * unit_y));
+      const double x1 = x0 - proj * unit_x;
+      const double y1 = y0 - proj * unit_y;
+      distance_sqr = std::min(distance_sqr, x1 * x1 + y1 * y1);
+    }
+  }
+  return distance_sqr;
+}
+
+}  // namespace
+
 Polygon2d::Polygon2d(const Box2d &box) {
   box.GetAllCorners(&points_);
   BuildFromPoints();
@@ -43,11 +75,7 @@ double Polygon2d::DistanceTo(const Vec2d &point) const {
   if (IsPointIn(point)) {
     return 0.0;
   }
-  double distance = std::numeric_limits<double>::infinity();
-  for (int i = 0; i < num_points_; ++i) {
-    distance = std::min(distance, line_segments_[i].DistanceTo(point));
-  }
-  return distance;
+  return std::sqrt(MinDistanceSquareToEdges(line_segments_, &point, 1));
 }
 
 double Polygon2d::DistanceSquareTo(const Vec2d &point) const {
@@ -55,12 +83,7 @@ double Polygon2d::DistanceSquareTo(const Vec2d &point) const {
   if (IsPointIn(point)) {
     return 0.0;
   }
-  double distance_sqr = std::numeric_limits<double>::infinity();
-  for (int i = 0; i < num_points_; ++i) {
-    distance_sqr =
-        std::min(distance_sqr, line_segments_[i].DistanceSquareTo(point));
-  }
-  return distance_sqr;
+  return MinDistanceSquareToEdges(line_segments_, &point, 1);
 }
 
 double Polygon2d::DistanceTo(const LineSegment2d &line_segment) const {
@@ -95,25 +118,54 @@ double Polygon2d::DistanceTo(const Polygon2d &polygon) const {
   CHECK_GE(points_.size(), 3);
   CHECK_GE(polygon.num_points(), 3);
 
-  if (IsPointIn(polygon.points()[0])) {
-    return 0.0;
-  }
-  if (polygon.IsPointIn(points_[0])) {
-    return 0.0;
+  // The polygons with apart bounding boxes neither contain nor cross each
+  // other.
+  if (polygon.max_x() >= min_x() && polygon.min_x() <= max_x() &&
+      polygon.max_y() >= min_y() && polygon.min_y() <= max_y()) {
+    if (IsPointIn(polygon.points()[0])) {
+      return 0.0;
+    }
+    if (polygon.IsPointIn(points_[0])) {
+      return 0.0;
+    }
+    if (HasEdgeIntersect(polygon)) {
+      return 0.0;
+    }
   }
-  double distance = std::numeric_limits<double>::infinity();
-  for (int i = 0; i < num_points_; ++i) {
-    distance = std::min(distance, polygon.DistanceTo(line_segments_[i]));
+  // The distance between two edges apart is from an end of one of them.
+  const double distance_sqr = std::min(
+      MinDistanceSquareToEdges(line_segments_, polygon.points().data(),
+                               polygon.num_points()),
+      MinDistanceSquareToEdges(polygon.line_segments(), points_.data(),
+                               num_points_));
+  return std::sqrt(distance_sqr);
+}
+
+bool Polygon2d::HasEdgeIntersect(const Polygon2d &polygon) const {
+  for (const auto &line_segment : polygon.line_segments()) {
+    // The edges out of the bounding box do not cross this polygon.
+    if ((line_segment.start().x() < min_x_ - kMathEpsilon &&
+         line_segment.end().x() < min_x_ - kMathEpsilon) ||
+        (line_segment.start().x() > max_x_ + kMathEpsilon &&
+         line_segment.end().x() > max_x_ + kMathEpsilon) ||
+        (line_segment.start().y() < min_y_ - kMathEpsilon &&
+         line_segment.end().y() < min_y_ - kMathEpsilon) ||
+        (line_segment.start().y() > max_y_ + kMathEpsilon &&
+         line_segment.end().y() > max_y_ + kMathEpsilon)) {
+      continue;
+    }
+    if (std::any_of(line_segments_.begin(), line_segments_.end(),
+                    [&](const LineSegment2d &poly_seg) {
+                      return line_segment.HasIntersect(poly_seg);
+                    })) {
+      return true;
+    }
   }
-  return distance;
+  return false;
 }
 
 double Polygon2d::DistanceToBoundary(const Vec2d &point) const {
-  double distance = std::numeric_limits<double>::infinity();
-  for (int i = 0; i < num_points_; ++i) {
-    distance = std::min(distance, line_segments_[i].DistanceTo(point));
-  }
-  return distance;
+  return std::sqrt(MinDistanceSquareToEdges(line_segments_, &point, 1));
 }
 
 bool Polygon2d::IsPointOnBoundary(const Vec2d &point) const {
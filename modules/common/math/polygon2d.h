@@ -322,6 +322,9 @@ class Polygon2d {
   int Next(int at) const;
   int Prev(int at) const;
 
+  // Whether an edge of the polygon crosses an edge of this polygon.
+  bool HasEdgeIntersect(const Polygon2d &polygon) const;
+
   static bool ClipConvexHull(const LineSegment2d &line_segment,
                              std::vector<Vec2d> *const points);
 
@@ -0,0 +1,132 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+// Benchmark of the polygon queries of the obstacle checks: the distance and
+// the overlap between the polygon of the vehicle and the polygons of the
+// obstacles scattered around it, most of them apart and a few overlapping,
+// and the distance of the points around an obstacle of many vertices.
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/common/math/box2d.h"
+#include "modules/common/math/polygon2d.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+const int kNumObstacles = 1024;
+
+// A convex obstacle of num_points vertices on an ellipse.
+Polygon2d MakeObstacle(const Vec2d &center, const double heading,
+                       const int num_points) {
+  std::vector<Vec2d> points;
+  for (int i = 0; i < num_points; ++i) {
+    const double angle = 2.0 * M_PI * i / num_points;
+    points.push_back(center + Vec2d(2.4 * std::cos(angle),
+                                    1.0 * std::sin(angle))
+                                  .rotate(heading));
+  }
+  return Polygon2d(points);
+}
+
+// The obstacles within 40 meters around the origin.
+std::vector<Polygon2d> MakeObstacles(const int num_points) {
+  std::mt19937 random_engine(0);
+  std::uniform_real_distribution<double> position_distribution(-40.0, 40.0);
+  std::uniform_real_distribution<double> heading_distribution(-M_PI, M_PI);
+  std::vector<Polygon2d> obstacles;
+  for (int i = 0; i < kNumObstacles; ++i) {
+    obstacles.push_back(MakeObstacle(
+        Vec2d(position_distribution(random_engine),
+              position_distribution(random_engine)),
+        heading_distribution(random_engine), num_points));
+  }
+  return obstacles;
+}
+
+Polygon2d MakeVehicle() { return Polygon2d(Box2d({0.0, 0.0}, 0.3, 4.8, 2.0)); }
+
+// state.range(0): number of vertices of the obstacles
+void BM_PolygonDistanceToPolygon(benchmark::State &state) {
+  const auto obstacles = MakeObstacles(static_cast<int>(state.range(0)));
+  const Polygon2d vehicle = MakeVehicle();
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(
+        vehicle.DistanceTo(obstacles[i++ % obstacles.size()]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// state.range(0): number of vertices of the obstacles
+void BM_PolygonHasOverlap(benchmark::State &state) {
+  // the obstacles closer to the vehicle, so that the bounding boxes overlap
+  // more often
+  std::vector<Polygon2d> obstacles;
+  for (const auto &obstacle : MakeObstacles(static_cast<int>(state.range(0)))) {
+    std::vector<Vec2d> points = obstacle.points();
+    for (auto &point : points) {
+      point *= 0.2;
+    }
+    obstacles.emplace_back(points);
+  }
+  const Polygon2d vehicle = MakeVehicle();
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(
+        vehicle.HasOverlap(obstacles[i++ % obstacles.size()]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// state.range(0): number of vertices of the obstacle
+void BM_PolygonDistanceToPoint(benchmark::State &state) {
+  const Polygon2d obstacle = MakeObstacle(
+      Vec2d(0.0, 0.0), 0.3, static_cast<int>(state.range(0)));
+  std::mt19937 random_engine(0);
+  std::uniform_real_distribution<double> position_distribution(-5.0, 5.0);
+  std::vector<Vec2d> points;
+  for (int i = 0; i < kNumObstacles; ++i) {
+    points.emplace_back(position_distribution(random_engine),
+                        position_distribution(random_engine));
+  }
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(
+        obstacle.DistanceSquareTo(points[i++ % points.size()]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_PolygonDistanceToPolygon)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(BM_PolygonHasOverlap)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(BM_PolygonDistanceToPoint)->Arg(4)->Arg(16)->Arg(64);
+
+}  // namespace
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+int main(int argc, char **argv) {
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
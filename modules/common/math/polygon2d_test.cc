@@ -258,6 +258,20 @@ TEST(Polygon2dTest, DistanceToPolygon) {
   EXPECT_NEAR(poly4.DistanceTo(poly1), 0.0, 1e-5);
   EXPECT_NEAR(poly4.DistanceTo(poly2), 0.0, 1e-5);
   EXPECT_NEAR(poly4.DistanceTo(poly3), 0.0, 1e-5);
+
+  // crossing without a vertex in the other polygon
+  const Polygon2d poly5(Box2d::CreateAABox({-2, -0.5}, {2, 0.5}));
+  const Polygon2d poly6(Box2d::CreateAABox({-0.5, -2}, {0.5, 2}));
+  EXPECT_NEAR(poly5.DistanceTo(poly6), 0.0, 1e-5);
+  EXPECT_TRUE(poly5.HasOverlap(poly6));
+
+  // in the notch of a non-convex polygon, with overlapping bounding boxes
+  const Polygon2d poly7({{0, 0}, {3, 0}, {3, 3}, {2, 3}, {2, 1}, {1, 1}, {1, 3},
+                         {0, 3}});
+  const Polygon2d poly8(Box2d::CreateAABox({1.25, 2}, {1.75, 4}));
+  EXPECT_NEAR(poly7.DistanceTo(poly8), 0.25, 1e-5);
+  EXPECT_NEAR(poly8.DistanceTo(poly7), 0.25, 1e-5);
+  EXPECT_FALSE(poly7.HasOverlap(poly8));
 }
 
 TEST(Polygon2dTest, ContainPolygon) {
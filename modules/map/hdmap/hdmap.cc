@@ -79,6 +79,54 @@ PNCJunctionInfoConstPtr HDMap::GetPNCJunctionById(const Id& id) const {
   return impl_.GetPNCJunctionById(id);
 }
 
+LaneInfoConstPtr HDMap::GetLaneByIndex(const int index) const {
+  return impl_.GetLaneByIndex(index);
+}
+
+JunctionInfoConstPtr HDMap::GetJunctionByIndex(const int index) const {
+  return impl_.GetJunctionByIndex(index);
+}
+
+SignalInfoConstPtr HDMap::GetSignalByIndex(const int index) const {
+  return impl_.GetSignalByIndex(index);
+}
+
+CrosswalkInfoConstPtr HDMap::GetCrosswalkByIndex(const int index) const {
+  return impl_.GetCrosswalkByIndex(index);
+}
+
+StopSignInfoConstPtr HDMap::GetStopSignByIndex(const int index) const {
+  return impl_.GetStopSignByIndex(index);
+}
+
+YieldSignInfoConstPtr HDMap::GetYieldSignByIndex(const int index) const {
+  return impl_.GetYieldSignByIndex(index);
+}
+
+ClearAreaInfoConstPtr HDMap::GetClearAreaByIndex(const int index) const {
+  return impl_.GetClearAreaByIndex(index);
+}
+
+SpeedBumpInfoConstPtr HDMap::GetSpeedBumpByIndex(const int index) const {
+  return impl_.GetSpeedBumpByIndex(index);
+}
+
+OverlapInfoConstPtr HDMap::GetOverlapByIndex(const int index) const {
+  return impl_.GetOverlapByIndex(index);
+}
+
+RoadInfoConstPtr HDMap::GetRoadByIndex(const int index) const {
+  return impl_.GetRoadByIndex(index);
+}
+
+ParkingSpaceInfoConstPtr HDMap::GetParkingSpaceByIndex(const int index) const {
+  return impl_.GetParkingSpaceByIndex(index);
+}
+
+PNCJunctionInfoConstPtr HDMap::GetPNCJunctionByIndex(const int index) const {
+  return impl_.GetPNCJunctionByIndex(index);
+}
+
 int HDMap::GetLanes(const apollo::common::PointENU& point, double distance,
                     std::vector<LaneInfoConstPtr>* lanes) const {
   return impl_.GetLanes(point, distance, lanes);
@@ -166,6 +214,42 @@ int HDMap::GetLanesWithHeading(const apollo::common::PointENU& point,
                                    max_heading_difference, lanes);
 }
 
+int HDMap::GetLanes(const std::vector<apollo::common::PointENU>& points,
+                    const double distance,
+                    std::vector<std::vector<LaneInfoConstPtr>>* lanes) const {
+  return impl_.GetLanes(points, distance, lanes);
+}
+
+int HDMap::GetLanesWithHeading(
+    const std::vector<apollo::common::PointENU>& points, const double distance,
+    const std::vector<double>& central_headings,
+    const double max_heading_difference,
+    std::vector<std::vector<LaneInfoConstPtr>>* lanes) const {
+  return impl_.GetLanesWithHeading(points, distance, central_headings,
+                                   max_heading_difference, lanes);
+}
+
+void HDMap::SelectLanesWithHeading(
+    const apollo::common::PointENU& point, const double distance,
+    const double central_heading, const double max_heading_difference,
+    const std::vector<LaneInfoConstPtr>& candidate_lanes,
+    std::vector<LaneInfoConstPtr>* lanes) {
+  HDMapImpl::SelectLanesWithHeading(point, distance, central_heading,
+                                    max_heading_difference, candidate_lanes,
+                                    lanes);
+}
+
+int HDMap::GetNearestLanesWithHeading(
+    const std::vector<apollo::common::PointENU>& points, const double distance,
+    const std::vector<double>& central_headings,
+    const double max_heading_difference,
+    std::vector<LaneInfoConstPtr>* nearest_lanes,
+    std::vector<double>* nearest_s, std::vector<double>* nearest_l) const {
+  return impl_.GetNearestLanesWithHeading(points, distance, central_headings,
+                                          max_heading_difference,
+                                          nearest_lanes, nearest_s, nearest_l);
+}
+
 int HDMap::GetRoadBoundaries(
     const apollo::common::PointENU& point, double radius,
     std::vector<RoadROIBoundaryPtr>* road_boundaries,
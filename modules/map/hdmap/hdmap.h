@@ -79,6 +79,23 @@ class HDMap {
   ParkingSpaceInfoConstPtr GetParkingSpaceById(const Id& id) const;
   PNCJunctionInfoConstPtr GetPNCJunctionById(const Id& id) const;
 
+  /**
+   * @brief get the elements by their interned handles, see LaneInfo::index()
+   * @return nullptr if the index is out of the range of the elements
+   */
+  LaneInfoConstPtr GetLaneByIndex(const int index) const;
+  JunctionInfoConstPtr GetJunctionByIndex(const int index) const;
+  SignalInfoConstPtr GetSignalByIndex(const int index) const;
+  CrosswalkInfoConstPtr GetCrosswalkByIndex(const int index) const;
+  StopSignInfoConstPtr GetStopSignByIndex(const int index) const;
+  YieldSignInfoConstPtr GetYieldSignByIndex(const int index) const;
+  ClearAreaInfoConstPtr GetClearAreaByIndex(const int index) const;
+  SpeedBumpInfoConstPtr GetSpeedBumpByIndex(const int index) const;
+  OverlapInfoConstPtr GetOverlapByIndex(const int index) const;
+  RoadInfoConstPtr GetRoadByIndex(const int index) const;
+  ParkingSpaceInfoConstPtr GetParkingSpaceByIndex(const int index) const;
+  PNCJunctionInfoConstPtr GetPNCJunctionByIndex(const int index) const;
+
   /**
    * @brief get all lanes in certain range
    * @param point the central point of the range
@@ -221,6 +238,68 @@ class HDMap {
                           const double distance, const double central_heading,
                           const double max_heading_difference,
                           std::vector<LaneInfoConstPtr>* lanes) const;
+  /**
+   * @brief get all lanes within a certain range of each point in a batch, the
+   * points are visited cell by cell and the points of a cell share one search
+   * of the KD-tree
+   * @param points the target positions
+   * @param distance the search radius
+   * @param lanes the lanes of each point, in the order of the points
+   * @return 0:success, otherwise failed
+   */
+  int GetLanes(const std::vector<apollo::common::PointENU>& points,
+               const double distance,
+               std::vector<std::vector<LaneInfoConstPtr>>* lanes) const;
+  /**
+   * @brief get all lanes within a certain range by pose of each point in a
+   * batch, same as GetLanesWithHeading of every point
+   * @param points the target positions
+   * @param distance the search radius
+   * @param central_headings the base heading of each point
+   * @param max_heading_difference the heading range
+   * @param lanes the lanes of each point, in the order of the points
+   * @return 0:success, otherwise failed
+   */
+  int GetLanesWithHeading(
+      const std::vector<apollo::common::PointENU>& points,
+      const double distance, const std::vector<double>& central_headings,
+      const double max_heading_difference,
+      std::vector<std::vector<LaneInfoConstPtr>>* lanes) const;
+  /**
+   * @brief select the lanes within a certain range by pose among candidate
+   * lanes, e.g. the lanes found by GetLanes, with the heading filter of
+   * GetLanesWithHeading
+   * @param point the target position
+   * @param distance the search radius
+   * @param central_heading the base heading
+   * @param max_heading_difference the heading range
+   * @param candidate_lanes the lanes to select from
+   * @param lanes the selected lanes are appended, in the order of
+   * candidate_lanes
+   */
+  static void SelectLanesWithHeading(
+      const apollo::common::PointENU& point, const double distance,
+      const double central_heading, const double max_heading_difference,
+      const std::vector<LaneInfoConstPtr>& candidate_lanes,
+      std::vector<LaneInfoConstPtr>* lanes);
+  /**
+   * @brief get the nearest lane within a certain range by pose of each point
+   * in a batch, same as GetNearestLaneWithHeading of every point
+   * @param points the target positions
+   * @param distance the search radius
+   * @param central_headings the base heading of each point
+   * @param max_heading_difference the heading range
+   * @param nearest_lanes the nearest lane of each point, nullptr if none
+   * @param nearest_s the offset of each point from lane start point
+   * @param nearest_l the lateral offset of each point from lane center line
+   * @return 0:success, otherwise failed
+   */
+  int GetNearestLanesWithHeading(
+      const std::vector<apollo::common::PointENU>& points,
+      const double distance, const std::vector<double>& central_headings,
+      const double max_heading_difference,
+      std::vector<LaneInfoConstPtr>* nearest_lanes,
+      std::vector<double>* nearest_s, std::vector<double>* nearest_l) const;
   /**
    * @brief get all road and junctions boundaries within certain range
    * @param point the target position
@@ -463,6 +463,22 @@ bool LaneInfo::GetProjection(const Vec2d &point, double *accumulate_s,
 
 void LaneInfo::PostProcess(const HDMapImpl &map_instance) {
   UpdateOverlaps(map_instance);
+  UpdateLaneIndices(map_instance);
+}
+
+void LaneInfo::UpdateLaneIndices(const HDMapImpl &map_instance) {
+  auto to_indices = [&map_instance](
+                        const google::protobuf::RepeatedPtrField<Id> &ids,
+                        std::vector<int> *const indices) {
+    indices->clear();
+    indices->reserve(ids.size());
+    for (const auto &id : ids) {
+      const auto lane_ptr = map_instance.GetLaneById(id);
+      indices->push_back(lane_ptr == nullptr ? -1 : lane_ptr->index());
+    }
+  };
+  to_indices(lane_.successor_id(), &successor_indices_);
+  to_indices(lane_.predecessor_id(), &predecessor_indices_);
 }
 
 void LaneInfo::UpdateOverlaps(const HDMapImpl &map_instance) {
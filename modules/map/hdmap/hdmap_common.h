@@ -140,6 +140,9 @@ class LaneInfo {
   explicit LaneInfo(const Lane &lane);
 
   const Id &id() const { return lane_.id(); }
+  // the interned handle of the lane, its index in the lanes of the map,
+  // for HDMapImpl::GetLaneByIndex
+  int index() const { return index_; }
   const Id &road_id() const { return road_id_; }
   const Id &section_id() const { return section_id_; }
   const Lane &lane() const { return lane_; }
@@ -156,6 +159,14 @@ class LaneInfo {
     return segments_;
   }
   const std::vector<double> &accumulate_s() const { return accumulated_s_; }
+  // the handles of lane().successor_id() and predecessor_id() in the same
+  // order, -1 for the ids not in the map
+  const std::vector<int> &successor_indices() const {
+    return successor_indices_;
+  }
+  const std::vector<int> &predecessor_indices() const {
+    return predecessor_indices_;
+  }
   const std::vector<OverlapInfoConstPtr> &overlaps() const { return overlaps_; }
   const std::vector<OverlapInfoConstPtr> &cross_lanes() const {
     return cross_lanes_;
@@ -226,6 +237,7 @@ class LaneInfo {
   void Init();
   void PostProcess(const HDMapImpl &map_instance);
   void UpdateOverlaps(const HDMapImpl &map_instance);
+  void UpdateLaneIndices(const HDMapImpl &map_instance);
   double GetWidthFromSample(const std::vector<LaneInfo::SampledWidth> &samples,
                             const double s) const;
   void CreateKDTree();
@@ -240,6 +252,8 @@ class LaneInfo {
   std::vector<apollo::common::math::LineSegment2d> segments_;
   std::vector<double> accumulated_s_;
   std::vector<std::string> overlap_ids_;
+  std::vector<int> successor_indices_;
+  std::vector<int> predecessor_indices_;
   std::vector<OverlapInfoConstPtr> overlaps_;
   std::vector<OverlapInfoConstPtr> cross_lanes_;
   std::vector<OverlapInfoConstPtr> signals_;
@@ -263,6 +277,7 @@ class LaneInfo {
 
   Id road_id_;
   Id section_id_;
+  int index_ = -1;
 };
 
 class JunctionInfo {
@@ -270,6 +285,7 @@ class JunctionInfo {
   explicit JunctionInfo(const Junction &junction);
 
   const Id &id() const { return junction_.id(); }
+  int index() const { return index_; }
   const Junction &junction() const { return junction_; }
   const apollo::common::math::Polygon2d &polygon() const { return polygon_; }
 
@@ -289,6 +305,7 @@ class JunctionInfo {
 
   std::vector<Id> overlap_stop_sign_ids_;
   std::vector<Id> overlap_ids_;
+  int index_ = -1;
 };
 using JunctionPolygonBox =
     ObjectWithAABox<JunctionInfo, apollo::common::math::Polygon2d>;
@@ -300,17 +317,20 @@ class SignalInfo {
   explicit SignalInfo(const Signal &signal);
 
   const Id &id() const { return signal_.id(); }
+  int index() const { return index_; }
   const Signal &signal() const { return signal_; }
   const std::vector<apollo::common::math::LineSegment2d> &segments() const {
     return segments_;
   }
 
  private:
+  friend class HDMapImpl;
   void Init();
 
  private:
   const Signal &signal_;
   std::vector<apollo::common::math::LineSegment2d> segments_;
+  int index_ = -1;
 };
 using SignalSegmentBox =
     ObjectWithAABox<SignalInfo, apollo::common::math::LineSegment2d>;
@@ -322,15 +342,18 @@ class CrosswalkInfo {
   explicit CrosswalkInfo(const Crosswalk &crosswalk);
 
   const Id &id() const { return crosswalk_.id(); }
+  int index() const { return index_; }
   const Crosswalk &crosswalk() const { return crosswalk_; }
   const apollo::common::math::Polygon2d &polygon() const { return polygon_; }
 
  private:
+  friend class HDMapImpl;
   void Init();
 
  private:
   const Crosswalk &crosswalk_;
   apollo::common::math::Polygon2d polygon_;
+  int index_ = -1;
 };
 using CrosswalkPolygonBox =
     ObjectWithAABox<CrosswalkInfo, apollo::common::math::Polygon2d>;
@@ -342,6 +365,7 @@ class StopSignInfo {
   explicit StopSignInfo(const StopSign &stop_sign);
 
   const Id &id() const { return stop_sign_.id(); }
+  int index() const { return index_; }
   const StopSign &stop_sign() const { return stop_sign_; }
   const std::vector<apollo::common::math::LineSegment2d> &segments() const {
     return segments_;
@@ -364,6 +388,7 @@ class StopSignInfo {
   std::vector<Id> overlap_lane_ids_;
   std::vector<Id> overlap_junction_ids_;
   std::vector<Id> overlap_ids_;
+  int index_ = -1;
 };
 using StopSignSegmentBox =
     ObjectWithAABox<StopSignInfo, apollo::common::math::LineSegment2d>;
@@ -375,17 +400,20 @@ class YieldSignInfo {
   explicit YieldSignInfo(const YieldSign &yield_sign);
 
   const Id &id() const { return yield_sign_.id(); }
+  int index() const { return index_; }
   const YieldSign &yield_sign() const { return yield_sign_; }
   const std::vector<apollo::common::math::LineSegment2d> &segments() const {
     return segments_;
   }
 
  private:
+  friend class HDMapImpl;
   void Init();
 
  private:
   const YieldSign &yield_sign_;
   std::vector<apollo::common::math::LineSegment2d> segments_;
+  int index_ = -1;
 };
 using YieldSignSegmentBox =
     ObjectWithAABox<YieldSignInfo, apollo::common::math::LineSegment2d>;
@@ -397,15 +425,18 @@ class ClearAreaInfo {
   explicit ClearAreaInfo(const ClearArea &clear_area);
 
   const Id &id() const { return clear_area_.id(); }
+  int index() const { return index_; }
   const ClearArea &clear_area() const { return clear_area_; }
   const apollo::common::math::Polygon2d &polygon() const { return polygon_; }
 
  private:
+  friend class HDMapImpl;
   void Init();
 
  private:
   const ClearArea &clear_area_;
   apollo::common::math::Polygon2d polygon_;
+  int index_ = -1;
 };
 using ClearAreaPolygonBox =
     ObjectWithAABox<ClearAreaInfo, apollo::common::math::Polygon2d>;
@@ -417,17 +448,20 @@ class SpeedBumpInfo {
   explicit SpeedBumpInfo(const SpeedBump &speed_bump);
 
   const Id &id() const { return speed_bump_.id(); }
+  int index() const { return index_; }
   const SpeedBump &speed_bump() const { return speed_bump_; }
   const std::vector<apollo::common::math::LineSegment2d> &segments() const {
     return segments_;
   }
 
  private:
+  friend class HDMapImpl;
   void Init();
 
  private:
   const SpeedBump &speed_bump_;
   std::vector<apollo::common::math::LineSegment2d> segments_;
+  int index_ = -1;
 };
 using SpeedBumpSegmentBox =
     ObjectWithAABox<SpeedBumpInfo, apollo::common::math::LineSegment2d>;
@@ -439,17 +473,22 @@ class OverlapInfo {
   explicit OverlapInfo(const Overlap &overlap);
 
   const Id &id() const { return overlap_.id(); }
+  int index() const { return index_; }
   const Overlap &overlap() const { return overlap_; }
   const ObjectOverlapInfo *GetObjectOverlapInfo(const Id &id) const;
 
  private:
+  friend class HDMapImpl;
+
   const Overlap &overlap_;
+  int index_ = -1;
 };
 
 class RoadInfo {
  public:
   explicit RoadInfo(const Road &road);
   const Id &id() const { return road_.id(); }
+  int index() const { return index_; }
   const Road &road() const { return road_; }
   const std::vector<RoadSection> &sections() const { return sections_; }
 
@@ -461,24 +500,30 @@ class RoadInfo {
   apollo::hdmap::Road_Type type() const { return road_.type(); }
 
  private:
+  friend class HDMapImpl;
+
   Road road_;
   std::vector<RoadSection> sections_;
   std::vector<RoadBoundary> road_boundaries_;
+  int index_ = -1;
 };
 
 class ParkingSpaceInfo {
  public:
   explicit ParkingSpaceInfo(const ParkingSpace &parkingspace);
   const Id &id() const { return parking_space_.id(); }
+  int index() const { return index_; }
   const ParkingSpace &parking_space() const { return parking_space_; }
   const apollo::common::math::Polygon2d &polygon() const { return polygon_; }
 
  private:
+  friend class HDMapImpl;
   void Init();
 
  private:
   const ParkingSpace &parking_space_;
   apollo::common::math::Polygon2d polygon_;
+  int index_ = -1;
 };
 using ParkingSpacePolygonBox =
     ObjectWithAABox<ParkingSpaceInfo, apollo::common::math::Polygon2d>;
@@ -490,10 +535,12 @@ class PNCJunctionInfo {
   explicit PNCJunctionInfo(const PNCJunction &pnc_junction);
 
   const Id &id() const { return junction_.id(); }
+  int index() const { return index_; }
   const PNCJunction &pnc_junction() const { return junction_; }
   const apollo::common::math::Polygon2d &polygon() const { return polygon_; }
 
  private:
+  friend class HDMapImpl;
   void Init();
 
  private:
@@ -501,6 +548,7 @@ class PNCJunctionInfo {
   apollo::common::math::Polygon2d polygon_;
 
   std::vector<Id> overlap_ids_;
+  int index_ = -1;
 };
 using PNCJunctionPolygonBox =
     ObjectWithAABox<PNCJunctionInfo, apollo::common::math::Polygon2d>;
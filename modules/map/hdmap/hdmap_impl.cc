@@ -16,11 +16,16 @@ limitations under the License.
 #include "modules/map/hdmap/hdmap_impl.h"
 
 #include <algorithm>
+#include <cmath>
+#include <future>
 #include <limits>
+#include <map>
 #include <set>
 #include <unordered_set>
 
 #include "cyber/common/file.h"
+#include "cyber/task/task.h"
+#include "modules/common/configs/config_gflags.h"
 #include "modules/common/util/string_util.h"
 #include "modules/map/hdmap/adapter/opendrive_adapter.h"
 
@@ -38,10 +43,20 @@ Id CreateHDMapId(const std::string& string_id) {
   return id;
 }
 
+template <class InfoPtr>
+InfoPtr GetElementByIndex(const std::vector<InfoPtr>& elements,
+                          const int index) {
+  return index >= 0 && index < static_cast<int>(elements.size())
+             ? elements[index]
+             : nullptr;
+}
+
 // default lanes search radius in GetForwardNearestSignalsOnLane
 constexpr double kLanesSearchRange = 10.0;
 // backward search distance in GetForwardNearestSignalsOnLane
 constexpr int kBackwardDistance = 4;
+// minimal cell length of the batch lane queries
+constexpr double kMinBatchQueryCellLength = 1.0;
 
 }  // namespace
 
@@ -66,46 +81,41 @@ int HDMapImpl::LoadMapFromProto(const Map& map_proto) {
     map_ = map_proto;
   }
   for (const auto& lane : map_.lane()) {
-    lane_table_[lane.id().id()].reset(new LaneInfo(lane));
+    AddElement(lane, &lane_table_, &lanes_);
   }
   for (const auto& junction : map_.junction()) {
-    junction_table_[junction.id().id()].reset(new JunctionInfo(junction));
+    AddElement(junction, &junction_table_, &junctions_);
   }
   for (const auto& signal : map_.signal()) {
-    signal_table_[signal.id().id()].reset(new SignalInfo(signal));
+    AddElement(signal, &signal_table_, &signals_);
   }
   for (const auto& crosswalk : map_.crosswalk()) {
-    crosswalk_table_[crosswalk.id().id()].reset(new CrosswalkInfo(crosswalk));
+    AddElement(crosswalk, &crosswalk_table_, &crosswalks_);
   }
   for (const auto& stop_sign : map_.stop_sign()) {
-    stop_sign_table_[stop_sign.id().id()].reset(new StopSignInfo(stop_sign));
+    AddElement(stop_sign, &stop_sign_table_, &stop_signs_);
   }
   for (const auto& yield_sign : map_.yield()) {
-    yield_sign_table_[yield_sign.id().id()].reset(
-        new YieldSignInfo(yield_sign));
+    AddElement(yield_sign, &yield_sign_table_, &yield_signs_);
   }
   for (const auto& clear_area : map_.clear_area()) {
-    clear_area_table_[clear_area.id().id()].reset(
-        new ClearAreaInfo(clear_area));
+    AddElement(clear_area, &clear_area_table_, &clear_areas_);
   }
   for (const auto& speed_bump : map_.speed_bump()) {
-    speed_bump_table_[speed_bump.id().id()].reset(
-        new SpeedBumpInfo(speed_bump));
+    AddElement(speed_bump, &speed_bump_table_, &speed_bumps_);
   }
   for (const auto& parking_space : map_.parking_space()) {
-    parking_space_table_[parking_space.id().id()].reset(
-        new ParkingSpaceInfo(parking_space));
+    AddElement(parking_space, &parking_space_table_, &parking_spaces_);
   }
   for (const auto& pnc_junction : map_.pnc_junction()) {
-    pnc_junction_table_[pnc_junction.id().id()].reset(
-        new PNCJunctionInfo(pnc_junction));
+    AddElement(pnc_junction, &pnc_junction_table_, &pnc_junctions_);
   }
   for (const auto& overlap : map_.overlap()) {
-    overlap_table_[overlap.id().id()].reset(new OverlapInfo(overlap));
+    AddElement(overlap, &overlap_table_, &overlaps_);
   }
 
   for (const auto& road : map_.road()) {
-    road_table_[road.id().id()].reset(new RoadInfo(road));
+    AddElement(road, &road_table_, &roads_);
   }
   for (const auto& road_ptr_pair : road_table_) {
     const auto& road_id = road_ptr_pair.second->id();
@@ -144,6 +154,24 @@ int HDMapImpl::LoadMapFromProto(const Map& map_proto) {
   return 0;
 }
 
+template <class Info, class Proto>
+void HDMapImpl::AddElement(
+    const Proto& proto,
+    std::unordered_map<std::string, std::shared_ptr<Info>>* const table,
+    std::vector<std::shared_ptr<const Info>>* const elements) {
+  auto& element = (*table)[proto.id().id()];
+  // an element of a duplicated id replaces the former one with its handle
+  const int index =
+      element == nullptr ? static_cast<int>(elements->size()) : element->index_;
+  element.reset(new Info(proto));
+  element->index_ = index;
+  if (index == static_cast<int>(elements->size())) {
+    elements->push_back(element);
+  } else {
+    (*elements)[index] = element;
+  }
+}
+
 LaneInfoConstPtr HDMapImpl::GetLaneById(const Id& id) const {
   LaneTable::const_iterator it = lane_table_.find(id.id());
   return it != lane_table_.end() ? it->second : nullptr;
@@ -204,6 +232,56 @@ PNCJunctionInfoConstPtr HDMapImpl::GetPNCJunctionById(const Id& id) const {
   return it != pnc_junction_table_.end() ? it->second : nullptr;
 }
 
+LaneInfoConstPtr HDMapImpl::GetLaneByIndex(const int index) const {
+  return GetElementByIndex(lanes_, index);
+}
+
+JunctionInfoConstPtr HDMapImpl::GetJunctionByIndex(const int index) const {
+  return GetElementByIndex(junctions_, index);
+}
+
+SignalInfoConstPtr HDMapImpl::GetSignalByIndex(const int index) const {
+  return GetElementByIndex(signals_, index);
+}
+
+CrosswalkInfoConstPtr HDMapImpl::GetCrosswalkByIndex(const int index) const {
+  return GetElementByIndex(crosswalks_, index);
+}
+
+StopSignInfoConstPtr HDMapImpl::GetStopSignByIndex(const int index) const {
+  return GetElementByIndex(stop_signs_, index);
+}
+
+YieldSignInfoConstPtr HDMapImpl::GetYieldSignByIndex(const int index) const {
+  return GetElementByIndex(yield_signs_, index);
+}
+
+ClearAreaInfoConstPtr HDMapImpl::GetClearAreaByIndex(const int index) const {
+  return GetElementByIndex(clear_areas_, index);
+}
+
+SpeedBumpInfoConstPtr HDMapImpl::GetSpeedBumpByIndex(const int index) const {
+  return GetElementByIndex(speed_bumps_, index);
+}
+
+OverlapInfoConstPtr HDMapImpl::GetOverlapByIndex(const int index) const {
+  return GetElementByIndex(overlaps_, index);
+}
+
+RoadInfoConstPtr HDMapImpl::GetRoadByIndex(const int index) const {
+  return GetElementByIndex(roads_, index);
+}
+
+ParkingSpaceInfoConstPtr HDMapImpl::GetParkingSpaceByIndex(
+    const int index) const {
+  return GetElementByIndex(parking_spaces_, index);
+}
+
+PNCJunctionInfoConstPtr HDMapImpl::GetPNCJunctionByIndex(
+    const int index) const {
+  return GetElementByIndex(pnc_junctions_, index);
+}
+
 int HDMapImpl::GetLanes(const PointENU& point, double distance,
                         std::vector<LaneInfoConstPtr>* lanes) const {
   return GetLanes({point.x(), point.y()}, distance, lanes);
@@ -537,7 +615,14 @@ int HDMapImpl::GetNearestLaneWithHeading(
                           max_heading_difference, &lanes) != 0) {
     return -1;
   }
+  return SelectNearestLane(point, distance, lanes, nearest_lane, nearest_s,
+                           nearest_l);
+}
 
+int HDMapImpl::SelectNearestLane(const Vec2d& point, const double distance,
+                                 const std::vector<LaneInfoConstPtr>& lanes,
+                                 LaneInfoConstPtr* nearest_lane,
+                                 double* nearest_s, double* nearest_l) {
   double s = 0;
   size_t s_index = 0;
   Vec2d map_point;
@@ -589,7 +674,27 @@ int HDMapImpl::GetLanesWithHeading(const Vec2d& point, const double distance,
   }
 
   lanes->clear();
-  for (auto& lane : all_lanes) {
+  SelectLanesWithHeading(point, distance, central_heading,
+                         max_heading_difference, all_lanes, lanes);
+  return 0;
+}
+
+void HDMapImpl::SelectLanesWithHeading(
+    const PointENU& point, const double distance, const double central_heading,
+    const double max_heading_difference,
+    const std::vector<LaneInfoConstPtr>& candidate_lanes,
+    std::vector<LaneInfoConstPtr>* lanes) {
+  CHECK_NOTNULL(lanes);
+  SelectLanesWithHeading({point.x(), point.y()}, distance, central_heading,
+                         max_heading_difference, candidate_lanes, lanes);
+}
+
+void HDMapImpl::SelectLanesWithHeading(
+    const Vec2d& point, const double distance, const double central_heading,
+    const double max_heading_difference,
+    const std::vector<LaneInfoConstPtr>& candidate_lanes,
+    std::vector<LaneInfoConstPtr>* lanes) {
+  for (auto& lane : candidate_lanes) {
     Vec2d proj_pt(0.0, 0.0);
     double s_offset = 0.0;
     int s_offset_index = 0;
@@ -603,7 +708,140 @@ int HDMapImpl::GetLanesWithHeading(const Vec2d& point, const double distance,
       }
     }
   }
+}
+
+int HDMapImpl::GetLanes(
+    const std::vector<PointENU>& points, const double distance,
+    std::vector<std::vector<LaneInfoConstPtr>>* lanes) const {
+  if (lanes == nullptr || lane_segment_kdtree_ == nullptr) {
+    return -1;
+  }
+  lanes->assign(points.size(), std::vector<LaneInfoConstPtr>());
+  std::vector<Vec2d> xy_points;
+  xy_points.reserve(points.size());
+  for (const auto& point : points) {
+    xy_points.emplace_back(point.x(), point.y());
+  }
+
+  // group the points by square cells as large as the search radius
+  const double cell_length = std::max(distance, kMinBatchQueryCellLength);
+  std::map<std::pair<int64_t, int64_t>, std::vector<int>> cells;
+  for (size_t i = 0; i < xy_points.size(); ++i) {
+    const auto cell = std::make_pair(
+        static_cast<int64_t>(std::floor(xy_points[i].x() / cell_length)),
+        static_cast<int64_t>(std::floor(xy_points[i].y() / cell_length)));
+    cells[cell].push_back(static_cast<int>(i));
+  }
+  std::vector<const std::vector<int>*> cell_points;
+  cell_points.reserve(cells.size());
+  for (const auto& cell : cells) {
+    cell_points.push_back(&cell.second);
+  }
+
+  // each cell only sets the lanes of its own points
+  if (FLAGS_enable_multi_thread_in_map_batch_query && cell_points.size() > 1) {
+    std::vector<std::future<void>> futures;
+    for (size_t i = 1; i < cell_points.size(); ++i) {
+      const std::vector<int>* point_indices = cell_points[i];
+      futures.push_back(cyber::Async([this, &xy_points, point_indices,
+                                      distance, lanes]() {
+        GetLanesInCell(xy_points, *point_indices, distance, lanes);
+      }));
+    }
+    GetLanesInCell(xy_points, *cell_points.front(), distance, lanes);
+    for (auto& future : futures) {
+      future.get();
+    }
+  } else {
+    for (const auto* point_indices : cell_points) {
+      GetLanesInCell(xy_points, *point_indices, distance, lanes);
+    }
+  }
+  return 0;
+}
 
+void HDMapImpl::GetLanesInCell(
+    const std::vector<Vec2d>& points, const std::vector<int>& point_indices,
+    const double distance,
+    std::vector<std::vector<LaneInfoConstPtr>>* lanes) const {
+  std::vector<Vec2d> cell_points;
+  cell_points.reserve(point_indices.size());
+  for (const int index : point_indices) {
+    cell_points.push_back(points[index]);
+  }
+  // the segments within distance of any point of the cell are within the
+  // distance plus the half diagonal of the bounding box of the cell points
+  const apollo::common::math::AABox2d box(cell_points);
+  const auto segments = lane_segment_kdtree_->GetObjects(
+      box.center(),
+      std::hypot(box.half_length(), box.half_width()) + distance);
+
+  const double distance_sqr = distance * distance;
+  std::vector<int> lane_indices;
+  for (const int index : point_indices) {
+    lane_indices.clear();
+    for (const auto* segment : segments) {
+      if (segment->DistanceSquareTo(points[index]) <= distance_sqr) {
+        lane_indices.push_back(segment->object()->index());
+      }
+    }
+    std::sort(lane_indices.begin(), lane_indices.end());
+    lane_indices.erase(std::unique(lane_indices.begin(), lane_indices.end()),
+                       lane_indices.end());
+    auto& point_lanes = (*lanes)[index];
+    point_lanes.reserve(lane_indices.size());
+    for (const int lane_index : lane_indices) {
+      point_lanes.push_back(lanes_[lane_index]);
+    }
+  }
+}
+
+int HDMapImpl::GetLanesWithHeading(
+    const std::vector<PointENU>& points, const double distance,
+    const std::vector<double>& central_headings,
+    const double max_heading_difference,
+    std::vector<std::vector<LaneInfoConstPtr>>* lanes) const {
+  CHECK_NOTNULL(lanes);
+  CHECK_EQ(points.size(), central_headings.size());
+  std::vector<std::vector<LaneInfoConstPtr>> all_lanes;
+  const int status = GetLanes(points, distance, &all_lanes);
+  if (status < 0) {
+    return status;
+  }
+
+  lanes->assign(points.size(), std::vector<LaneInfoConstPtr>());
+  for (size_t i = 0; i < points.size(); ++i) {
+    SelectLanesWithHeading({points[i].x(), points[i].y()}, distance,
+                           central_headings[i], max_heading_difference,
+                           all_lanes[i], &(*lanes)[i]);
+  }
+  return 0;
+}
+
+int HDMapImpl::GetNearestLanesWithHeading(
+    const std::vector<PointENU>& points, const double distance,
+    const std::vector<double>& central_headings,
+    const double max_heading_difference,
+    std::vector<LaneInfoConstPtr>* nearest_lanes,
+    std::vector<double>* nearest_s, std::vector<double>* nearest_l) const {
+  CHECK_NOTNULL(nearest_lanes);
+  CHECK_NOTNULL(nearest_s);
+  CHECK_NOTNULL(nearest_l);
+  std::vector<std::vector<LaneInfoConstPtr>> lanes;
+  const int status = GetLanesWithHeading(points, distance, central_headings,
+                                         max_heading_difference, &lanes);
+  if (status < 0) {
+    return status;
+  }
+
+  nearest_lanes->assign(points.size(), nullptr);
+  nearest_s->assign(points.size(), 0.0);
+  nearest_l->assign(points.size(), 0.0);
+  for (size_t i = 0; i < points.size(); ++i) {
+    SelectNearestLane({points[i].x(), points[i].y()}, distance, lanes[i],
+                      &(*nearest_lanes)[i], &(*nearest_s)[i],
+                      &(*nearest_l)[i]);
+  }
   return 0;
 }
 
@@ -1310,7 +1548,24 @@ void HDMapImpl::Clear() {
   crosswalk_table_.clear();
   stop_sign_table_.clear();
   yield_sign_table_.clear();
+  clear_area_table_.clear();
+  speed_bump_table_.clear();
   overlap_table_.clear();
+  road_table_.clear();
+  parking_space_table_.clear();
+  pnc_junction_table_.clear();
+  lanes_.clear();
+  junctions_.clear();
+  signals_.clear();
+  crosswalks_.clear();
+  stop_signs_.clear();
+  yield_signs_.clear();
+  clear_areas_.clear();
+  speed_bumps_.clear();
+  overlaps_.clear();
+  roads_.clear();
+  parking_spaces_.clear();
+  pnc_junctions_.clear();
   lane_segment_boxes_.clear();
   lane_segment_kdtree_.reset(nullptr);
   junction_polygon_boxes_.clear();
@@ -106,6 +106,23 @@ class HDMapImpl {
   ParkingSpaceInfoConstPtr GetParkingSpaceById(const Id& id) const;
   PNCJunctionInfoConstPtr GetPNCJunctionById(const Id& id) const;
 
+  /**
+   * @brief get the elements by their interned handles, see LaneInfo::index()
+   * @return nullptr if the index is out of the range of the elements
+   */
+  LaneInfoConstPtr GetLaneByIndex(const int index) const;
+  JunctionInfoConstPtr GetJunctionByIndex(const int index) const;
+  SignalInfoConstPtr GetSignalByIndex(const int index) const;
+  CrosswalkInfoConstPtr GetCrosswalkByIndex(const int index) const;
+  StopSignInfoConstPtr GetStopSignByIndex(const int index) const;
+  YieldSignInfoConstPtr GetYieldSignByIndex(const int index) const;
+  ClearAreaInfoConstPtr GetClearAreaByIndex(const int index) const;
+  SpeedBumpInfoConstPtr GetSpeedBumpByIndex(const int index) const;
+  OverlapInfoConstPtr GetOverlapByIndex(const int index) const;
+  RoadInfoConstPtr GetRoadByIndex(const int index) const;
+  ParkingSpaceInfoConstPtr GetParkingSpaceByIndex(const int index) const;
+  PNCJunctionInfoConstPtr GetPNCJunctionByIndex(const int index) const;
+
   /**
    * @brief get all lanes in certain range
    * @param point the central point of the range
@@ -251,6 +268,68 @@ class HDMapImpl {
                           const double distance, const double central_heading,
                           const double max_heading_difference,
                           std::vector<LaneInfoConstPtr>* lanes) const;
+  /**
+   * @brief get all lanes within a certain range of each point in a batch, the
+   * points are visited cell by cell and the points of a cell share one search
+   * of the KD-tree
+   * @param points the target positions
+   * @param distance the search radius
+   * @param lanes the lanes of each point, in the order of the points
+   * @return 0:success, otherwise failed
+   */
+  int GetLanes(const std::vector<apollo::common::PointENU>& points,
+               const double distance,
+               std::vector<std::vector<LaneInfoConstPtr>>* lanes) const;
+  /**
+   * @brief get all lanes within a certain range by pose of each point in a
+   * batch, same as GetLanesWithHeading of every point
+   * @param points the target positions
+   * @param distance the search radius
+   * @param central_headings the base heading of each point
+   * @param max_heading_difference the heading range
+   * @param lanes the lanes of each point, in the order of the points
+   * @return 0:success, otherwise failed
+   */
+  int GetLanesWithHeading(
+      const std::vector<apollo::common::PointENU>& points,
+      const double distance, const std::vector<double>& central_headings,
+      const double max_heading_difference,
+      std::vector<std::vector<LaneInfoConstPtr>>* lanes) const;
+  /**
+   * @brief select the lanes within a certain range by pose among candidate
+   * lanes, e.g. the lanes found by GetLanes, with the heading filter of
+   * GetLanesWithHeading
+   * @param point the target position
+   * @param distance the search radius
+   * @param central_heading the base heading
+   * @param max_heading_difference the heading range
+   * @param candidate_lanes the lanes to select from
+   * @param lanes the selected lanes are appended, in the order of
+   * candidate_lanes
+   */
+  static void SelectLanesWithHeading(
+      const apollo::common::PointENU& point, const double distance,
+      const double central_heading, const double max_heading_difference,
+      const std::vector<LaneInfoConstPtr>& candidate_lanes,
+      std::vector<LaneInfoConstPtr>* lanes);
+  /**
+   * @brief get the nearest lane within a certain range by pose of each point
+   * in a batch, same as GetNearestLaneWithHeading of every point
+   * @param points the target positions
+   * @param distance the search radius
+   * @param central_headings the base heading of each point
+   * @param max_heading_difference the heading range
+   * @param nearest_lanes the nearest lane of each point, nullptr if none
+   * @param nearest_s the offset of each point from lane start point
+   * @param nearest_l the lateral offset of each point from lane center line
+   * @return 0:success, otherwise failed
+   */
+  int GetNearestLanesWithHeading(
+      const std::vector<apollo::common::PointENU>& points,
+      const double distance, const std::vector<double>& central_headings,
+      const double max_heading_difference,
+      std::vector<LaneInfoConstPtr>* nearest_lanes,
+      std::vector<double>* nearest_s, std::vector<double>* nearest_l) const;
   /**
    * @brief get all road and junctions boundaries within certain range
    * @param point the target position
@@ -366,6 +445,24 @@ class HDMapImpl {
   int GetRoads(const apollo::common::math::Vec2d& point, double distance,
                std::vector<RoadInfoConstPtr>* roads) const;
 
+  // search the lanes of the points at point_indices in one KD-tree search
+  void GetLanesInCell(const std::vector<apollo::common::math::Vec2d>& points,
+                      const std::vector<int>& point_indices,
+                      const double distance,
+                      std::vector<std::vector<LaneInfoConstPtr>>* lanes) const;
+  // keep the candidate lanes within distance and heading range of the point
+  static void SelectLanesWithHeading(
+      const apollo::common::math::Vec2d& point, const double distance,
+      const double central_heading, const double max_heading_difference,
+      const std::vector<LaneInfoConstPtr>& candidate_lanes,
+      std::vector<LaneInfoConstPtr>* lanes);
+  // find the nearest one of the lanes within distance of the point
+  static int SelectNearestLane(const apollo::common::math::Vec2d& point,
+                               const double distance,
+                               const std::vector<LaneInfoConstPtr>& lanes,
+                               LaneInfoConstPtr* nearest_lane,
+                               double* nearest_s, double* nearest_l);
+
   template <class Table, class BoxTable, class KDTree>
   static void BuildSegmentKDTree(
       const Table& table, const apollo::common::math::AABoxKDTreeParams& params,
@@ -387,6 +484,12 @@ class HDMapImpl {
   void BuildParkingSpacePolygonKDTree();
   void BuildPNCJunctionPolygonKDTree();
 
+  template <class Info, class Proto>
+  static void AddElement(
+      const Proto& proto,
+      std::unordered_map<std::string, std::shared_ptr<Info>>* const table,
+      std::vector<std::shared_ptr<const Info>>* const elements);
+
   template <class KDTree>
   static int SearchObjects(const apollo::common::math::Vec2d& center,
                            const double radius, const KDTree& kdtree,
@@ -409,6 +512,20 @@ class HDMapImpl {
   ParkingSpaceTable parking_space_table_;
   PNCJunctionTable pnc_junction_table_;
 
+  // the elements in the order of their interned handles
+  std::vector<LaneInfoConstPtr> lanes_;
+  std::vector<JunctionInfoConstPtr> junctions_;
+  std::vector<SignalInfoConstPtr> signals_;
+  std::vector<CrosswalkInfoConstPtr> crosswalks_;
+  std::vector<StopSignInfoConstPtr> stop_signs_;
+  std::vector<YieldSignInfoConstPtr> yield_signs_;
+  std::vector<ClearAreaInfoConstPtr> clear_areas_;
+  std::vector<SpeedBumpInfoConstPtr> speed_bumps_;
+  std::vector<OverlapInfoConstPtr> overlaps_;
+  std::vector<RoadInfoConstPtr> roads_;
+  std::vector<ParkingSpaceInfoConstPtr> parking_spaces_;
+  std::vector<PNCJunctionInfoConstPtr> pnc_junctions_;
+
   std::vector<LaneSegmentBox> lane_segment_boxes_;
   std::unique_ptr<LaneSegmentKDTree> lane_segment_kdtree_;
 
@@ -14,6 +14,9 @@ limitations under the License.
 =========================================================================*/
 
 #include "modules/map/hdmap/hdmap_impl.h"
+
+#include <set>
+
 #include "cyber/common/file.h"
 #include "gtest/gtest.h"
 
@@ -48,6 +51,37 @@ TEST_F(HDMapImplTestSuite, GetLaneById) {
   EXPECT_STREQ(lane_id.id().c_str(), lane_ptr->id().id().c_str());
 }
 
+TEST_F(HDMapImplTestSuite, GetLaneByIndex) {
+  Id lane_id;
+  lane_id.set_id("1272_1_-1");
+  LaneInfoConstPtr lane_ptr = hdmap_impl_.GetLaneById(lane_id);
+  ASSERT_NE(nullptr, lane_ptr);
+  EXPECT_GE(lane_ptr->index(), 0);
+  EXPECT_EQ(lane_ptr, hdmap_impl_.GetLaneByIndex(lane_ptr->index()));
+  EXPECT_EQ(nullptr, hdmap_impl_.GetLaneByIndex(-1));
+  EXPECT_EQ(nullptr, hdmap_impl_.GetLaneByIndex(1 << 30));
+
+  ASSERT_EQ(lane_ptr->lane().successor_id_size(),
+            lane_ptr->successor_indices().size());
+  for (int i = 0; i < lane_ptr->lane().successor_id_size(); ++i) {
+    EXPECT_EQ(hdmap_impl_.GetLaneById(lane_ptr->lane().successor_id(i)),
+              hdmap_impl_.GetLaneByIndex(lane_ptr->successor_indices()[i]));
+  }
+  ASSERT_EQ(lane_ptr->lane().predecessor_id_size(),
+            lane_ptr->predecessor_indices().size());
+  for (int i = 0; i < lane_ptr->lane().predecessor_id_size(); ++i) {
+    EXPECT_EQ(hdmap_impl_.GetLaneById(lane_ptr->lane().predecessor_id(i)),
+              hdmap_impl_.GetLaneByIndex(lane_ptr->predecessor_indices()[i]));
+  }
+
+  Id junction_id;
+  junction_id.set_id("1183");
+  JunctionInfoConstPtr junction_ptr = hdmap_impl_.GetJunctionById(junction_id);
+  ASSERT_NE(nullptr, junction_ptr);
+  EXPECT_EQ(junction_ptr,
+            hdmap_impl_.GetJunctionByIndex(junction_ptr->index()));
+}
+
 TEST_F(HDMapImplTestSuite, GetJunctionById) {
   Id junction_id;
   junction_id.set_id("1");
@@ -192,6 +226,79 @@ TEST_F(HDMapImplTestSuite, GetLanesWithHeading) {
   EXPECT_EQ("773_1_-2", lanes[0]->id().id());
 }
 
+TEST_F(HDMapImplTestSuite, GetLanesInBatch) {
+  std::vector<apollo::common::PointENU> points;
+  std::vector<double> headings;
+  for (double dx = -60.0; dx <= 60.0; dx += 7.0) {
+    for (double dy = -60.0; dy <= 60.0; dy += 11.0) {
+      apollo::common::PointENU point;
+      point.set_x(586424.09 + dx);
+      point.set_y(4140727.02 + dy);
+      point.set_z(0.0);
+      points.push_back(point);
+      headings.push_back(-2.35 + 0.01 * dx);
+    }
+  }
+
+  for (const double distance : {1e-6, 5.0, 20.0}) {
+    std::vector<std::vector<LaneInfoConstPtr>> batch_lanes;
+    EXPECT_EQ(0, hdmap_impl_.GetLanes(points, distance, &batch_lanes));
+    ASSERT_EQ(points.size(), batch_lanes.size());
+    std::vector<std::vector<LaneInfoConstPtr>> batch_heading_lanes;
+    EXPECT_EQ(0, hdmap_impl_.GetLanesWithHeading(points, distance, headings,
+                                                 1.0, &batch_heading_lanes));
+    ASSERT_EQ(points.size(), batch_heading_lanes.size());
+    std::vector<LaneInfoConstPtr> nearest_lanes;
+    std::vector<double> nearest_s;
+    std::vector<double> nearest_l;
+    EXPECT_EQ(0, hdmap_impl_.GetNearestLanesWithHeading(
+                     points, distance, headings, 1.0, &nearest_lanes,
+                     &nearest_s, &nearest_l));
+    ASSERT_EQ(points.size(), nearest_lanes.size());
+
+    const auto lane_ids = [](const std::vector<LaneInfoConstPtr>& lanes) {
+      std::set<std::string> ids;
+      for (const auto& lane : lanes) {
+        ids.insert(lane->id().id());
+      }
+      return ids;
+    };
+    for (size_t i = 0; i < points.size(); ++i) {
+      std::vector<LaneInfoConstPtr> lanes;
+      EXPECT_EQ(0, hdmap_impl_.GetLanes(points[i], distance, &lanes));
+      EXPECT_EQ(lane_ids(lanes), lane_ids(batch_lanes[i]));
+
+      lanes.clear();
+      hdmap_impl_.GetLanesWithHeading(points[i], distance, headings[i], 1.0,
+                                      &lanes);
+      EXPECT_EQ(lane_ids(lanes), lane_ids(batch_heading_lanes[i]));
+      std::vector<LaneInfoConstPtr> selected_lanes;
+      HDMapImpl::SelectLanesWithHeading(points[i], distance, headings[i], 1.0,
+                                        batch_lanes[i], &selected_lanes);
+      EXPECT_EQ(lane_ids(lanes), lane_ids(selected_lanes));
+
+      LaneInfoConstPtr nearest_lane;
+      double s = 0.0;
+      double l = 0.0;
+      if (hdmap_impl_.GetNearestLaneWithHeading(points[i], distance,
+                                                headings[i], 1.0,
+                                                &nearest_lane, &s, &l) == 0) {
+        ASSERT_NE(nullptr, nearest_lanes[i]);
+        // lanes as near as each other may be found in another order
+        const common::math::Vec2d xy(points[i].x(), points[i].y());
+        EXPECT_DOUBLE_EQ(nearest_lane->DistanceTo(xy),
+                         nearest_lanes[i]->DistanceTo(xy));
+        if (nearest_lane == nearest_lanes[i]) {
+          EXPECT_DOUBLE_EQ(s, nearest_s[i]);
+          EXPECT_DOUBLE_EQ(l, nearest_l[i]);
+        }
+      } else {
+        EXPECT_EQ(nullptr, nearest_lanes[i]);
+      }
+    }
+  }
+}
+
 TEST_F(HDMapImplTestSuite, GetJunctions) {
   std::vector<JunctionInfoConstPtr> junctions;
   apollo::common::PointENU point;
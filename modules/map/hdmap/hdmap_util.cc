@@ -14,6 +14,8 @@ limitations under the License.
 =========================================================================*/
 #include "modules/map/hdmap/hdmap_util.h"
 
+#include <utility>
+
 #include "cyber/common/file.h"
 #include "modules/common/util/string_tokenizer.h"
 #include "modules/map/relative_map/proto/navigation.pb.h"
@@ -68,6 +70,11 @@ std::string RoutingMapFile() {
   return FindFirstExist(FLAGS_map_dir, FLAGS_routing_map_filename);
 }
 
+std::string BaseMapTileDir() {
+  return apollo::common::util::StrCat(FLAGS_map_dir, "/",
+                                      FLAGS_map_tile_dirname);
+}
+
 std::unique_ptr<HDMap> CreateMap(const std::string& map_file_path) {
   std::unique_ptr<HDMap> hdmap(new HDMap());
   if (hdmap->LoadMapFromFile(map_file_path) != 0) {
@@ -91,6 +98,8 @@ std::unique_ptr<HDMap> CreateMap(const MapMsg& map_msg) {
 std::unique_ptr<HDMap> HDMapUtil::base_map_ = nullptr;
 uint64_t HDMapUtil::base_map_seq_ = 0;
 std::mutex HDMapUtil::base_map_mutex_;
+std::unique_ptr<TiledHDMap> HDMapUtil::tiled_map_ = nullptr;
+std::shared_ptr<const HDMap> HDMapUtil::tiled_base_map_ = nullptr;
 
 std::unique_ptr<HDMap> HDMapUtil::sim_map_ = nullptr;
 std::mutex HDMapUtil::sim_map_mutex_;
@@ -131,6 +140,10 @@ const HDMap* HDMapUtil::BaseMapPtr() {
       base_map_seq_ = latest.header().sequence_num();
     }
   } else*/
+  if (FLAGS_use_tiled_map) {
+    std::lock_guard<std::mutex> lock(base_map_mutex_);
+    return InitTiledMap() ? tiled_base_map_.get() : nullptr;
+  }
   if (base_map_ == nullptr) {
     std::lock_guard<std::mutex> lock(base_map_mutex_);
     if (base_map_ == nullptr) {  // Double check.
@@ -142,6 +155,37 @@ const HDMap* HDMapUtil::BaseMapPtr() {
 
 const HDMap& HDMapUtil::BaseMap() { return *CHECK_NOTNULL(BaseMapPtr()); }
 
+std::shared_ptr<const HDMap> HDMapUtil::TiledBaseMap(
+    const apollo::common::PointENU& position) {
+  if (!FLAGS_use_tiled_map) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(base_map_mutex_);
+  if (!InitTiledMap()) {
+    return nullptr;
+  }
+  if (tiled_map_->Update(position) && tiled_map_->NumLoadedTiles() == 0) {
+    tiled_map_->WaitForMap();
+  }
+  tiled_base_map_ = tiled_map_->map();
+  return tiled_base_map_;
+}
+
+bool HDMapUtil::InitTiledMap() {
+  if (tiled_map_ != nullptr) {
+    return true;
+  }
+  std::unique_ptr<TiledHDMap> tiled_map(new TiledHDMap());
+  if (tiled_map->Init(BaseMapTileDir()) != 0) {
+    AERROR << "Failed to load HDMap tiles " << BaseMapTileDir();
+    return false;
+  }
+  AINFO << "Load HDMap tile index success: " << BaseMapTileDir();
+  tiled_base_map_ = tiled_map->map();
+  tiled_map_ = std::move(tiled_map);
+  return true;
+}
+
 const HDMap* HDMapUtil::SimMapPtr() {
   if (FLAGS_use_navigation_mode) {
     return BaseMapPtr();
@@ -157,15 +201,23 @@ const HDMap* HDMapUtil::SimMapPtr() {
 const HDMap& HDMapUtil::SimMap() { return *CHECK_NOTNULL(SimMapPtr()); }
 
 bool HDMapUtil::ReloadMaps() {
+  bool base_map_loaded = false;
   {
     std::lock_guard<std::mutex> lock(base_map_mutex_);
-    base_map_ = CreateMap(BaseMapFile());
+    if (FLAGS_use_tiled_map) {
+      tiled_map_.reset();
+      tiled_base_map_.reset();
+      base_map_loaded = InitTiledMap();
+    } else {
+      base_map_ = CreateMap(BaseMapFile());
+      base_map_loaded = base_map_ != nullptr;
+    }
   }
   {
     std::lock_guard<std::mutex> lock(sim_map_mutex_);
     sim_map_ = CreateMap(SimMapFile());
   }
-  return base_map_ != nullptr && sim_map_ != nullptr;
+  return base_map_loaded && sim_map_ != nullptr;
 }
 
 }  // namespace hdmap
@@ -21,6 +21,7 @@ limitations under the License.
 #include "modules/common/configs/config_gflags.h"
 #include "modules/common/util/string_util.h"
 #include "modules/map/hdmap/hdmap.h"
+#include "modules/map/hdmap/tiled_map.h"
 #include "modules/map/proto/map_id.pb.h"
 #include "modules/map/relative_map/proto/navigation.pb.h"
 
@@ -74,6 +75,12 @@ inline apollo::hdmap::Id MakeMapId(const std::string& id) {
   return map_id;
 }
 
+/**
+ * @brief get the directory of the base map tiles from flags.
+ * @return base map tile directory
+ */
+std::string BaseMapTileDir();
+
 std::unique_ptr<HDMap> CreateMap(const std::string& map_file_path);
 
 class HDMapUtil {
@@ -85,6 +92,17 @@ class HDMapUtil {
   // Guarantee to return a valid base_map, or else raise fatal error.
   static const HDMap& BaseMap();
 
+  // With FLAGS_use_tiled_map, the base map is the map of the tiles around the
+  // position of the last call, see TiledHDMap. The tiles of the position are
+  // loaded in the background, and the map of the tiles loaded so far is
+  // returned, except on the first call which waits for its map. The map must
+  // be held while its elements are used. The base map from BaseMapPtr is the
+  // one returned last, and is only valid until the next call, so it only
+  // suits the callers which get it again for each query.
+  // Return nullptr if FLAGS_use_tiled_map is false or failed to load.
+  static std::shared_ptr<const HDMap> TiledBaseMap(
+      const apollo::common::PointENU& position);
+
   // Get default sim_map from the file specified by global flags.
   // Return nullptr if failed to load.
   static const HDMap* SimMapPtr();
@@ -98,9 +116,14 @@ class HDMapUtil {
  private:
   HDMapUtil() = delete;
 
+  // Read the tile index if not done yet, with base_map_mutex_ held.
+  static bool InitTiledMap();
+
   static std::unique_ptr<HDMap> base_map_;
   static uint64_t base_map_seq_;
   static std::mutex base_map_mutex_;
+  static std::unique_ptr<TiledHDMap> tiled_map_;
+  static std::shared_ptr<const HDMap> tiled_base_map_;
 
   static std::unique_ptr<HDMap> sim_map_;
   static std::mutex sim_map_mutex_;
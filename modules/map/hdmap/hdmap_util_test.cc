@@ -15,6 +15,12 @@ limitations under the License.
 
 #include "modules/map/hdmap/hdmap_util.h"
 
+#include <unistd.h>
+
+#include <cstdlib>
+#include <string>
+
+#include "cyber/common/file.h"
 #include "gtest/gtest.h"
 #include "modules/common/time/time.h"
 
@@ -53,6 +59,42 @@ void HDMapUtilTestSuite::InitMapProto(Map* map_proto) {
   lane->set_type(Lane::CITY_DRIVING);
 }
 
+TEST_F(HDMapUtilTestSuite, TiledBaseMap) {
+  const char* test_tmpdir = std::getenv("TEST_TMPDIR");
+  std::string map_dir =
+      std::string(test_tmpdir == nullptr ? "/tmp" : test_tmpdir) +
+      "/hdmap_util_test_XXXXXX";
+  ASSERT_NE(nullptr, mkdtemp(&map_dir[0]));
+  FLAGS_map_dir = map_dir;
+  FLAGS_map_tile_load_radius = 50.0;
+  FLAGS_map_tile_evict_radius = 100.0;
+  Map map_proto;
+  InitMapProto(&map_proto);
+  ASSERT_TRUE(SaveMapTiles(map_proto, 100.0, BaseMapTileDir()));
+
+  apollo::common::PointENU position;
+  position.set_x(0.0);
+  position.set_y(10.0);
+  FLAGS_use_tiled_map = false;
+  EXPECT_EQ(nullptr, HDMapUtil::TiledBaseMap(position));
+
+  FLAGS_use_tiled_map = true;
+  // empty until a position is given
+  ASSERT_NE(nullptr, HDMapUtil::BaseMapPtr());
+  EXPECT_EQ(nullptr, HDMapUtil::BaseMap().GetLaneById(MakeMapId("lane_1")));
+
+  // the first call waits for its map
+  const auto hdmap = HDMapUtil::TiledBaseMap(position);
+  ASSERT_NE(nullptr, hdmap);
+  EXPECT_NE(nullptr, hdmap->GetLaneById(MakeMapId("lane_1")));
+  EXPECT_EQ(hdmap.get(), HDMapUtil::BaseMapPtr());
+
+  FLAGS_use_tiled_map = false;
+  cyber::common::RemoveAllFiles(BaseMapTileDir());
+  rmdir(BaseMapTileDir().c_str());
+  rmdir(map_dir.c_str());
+}
+
 // TEST_F(HDMapUtilTestSuite, ReuseMap) {
 //  MapMsg map_msg;
 //  InitMapProto(map_msg.mutable_hdmap());
@@ -0,0 +1,525 @@
+/* Copyright 2019 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+#include "modules/map/hdmap/tiled_map.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <set>
+#include <utility>
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "modules/common/configs/config_gflags.h"
+
+namespace apollo {
+namespace hdmap {
+namespace {
+
+using apollo::common::PointENU;
+using google::protobuf::RepeatedPtrField;
+
+using TileCoord = std::pair<int, int>;
+using TileSet = std::set<TileCoord>;
+using TileMaps = std::map<TileCoord, Map>;
+
+int64_t TileKey(const int x, const int y) {
+  return (static_cast<int64_t>(x) << 32) | static_cast<uint32_t>(y);
+}
+
+// The axis aligned bounding box of the geometry of an element.
+class Bounds {
+ public:
+  void Add(const PointENU& point) {
+    min_x_ = std::min(min_x_, point.x());
+    min_y_ = std::min(min_y_, point.y());
+    max_x_ = std::max(max_x_, point.x());
+    max_y_ = std::max(max_y_, point.y());
+  }
+
+  void Add(const Curve& curve) {
+    for (const auto& segment : curve.segment()) {
+      for (const auto& point : segment.line_segment().point()) {
+        Add(point);
+      }
+    }
+  }
+
+  void Add(const Polygon& polygon) {
+    for (const auto& point : polygon.point()) {
+      Add(point);
+    }
+  }
+
+  void Add(const BoundaryPolygon& polygon) {
+    for (const auto& edge : polygon.edge()) {
+      Add(edge.curve());
+    }
+  }
+
+  // the tiles the bounding box touches
+  TileSet Tiles(const double tile_length) const {
+    TileSet tiles;
+    if (min_x_ > max_x_) {
+      return tiles;
+    }
+    const int min_x = static_cast<int>(std::floor(min_x_ / tile_length));
+    const int min_y = static_cast<int>(std::floor(min_y_ / tile_length));
+    const int max_x = static_cast<int>(std::floor(max_x_ / tile_length));
+    const int max_y = static_cast<int>(std::floor(max_y_ / tile_length));
+    for (int x = min_x; x <= max_x; ++x) {
+      for (int y = min_y; y <= max_y; ++y) {
+        tiles.emplace(x, y);
+      }
+    }
+    return tiles;
+  }
+
+ private:
+  double min_x_ = std::numeric_limits<double>::infinity();
+  double min_y_ = std::numeric_limits<double>::infinity();
+  double max_x_ = -std::numeric_limits<double>::infinity();
+  double max_y_ = -std::numeric_limits<double>::infinity();
+};
+
+template <class T>
+void AddToTiles(const T& element, const TileSet& tile_set,
+                T* (Map::*add_element)(),
+                std::unordered_map<std::string, TileSet>* element_tiles,
+                TileMaps* tiles) {
+  if (tile_set.empty()) {
+    AWARN << "Element " << element.id().id()
+          << " has no geometry and is left out of the tiles";
+    return;
+  }
+  (*element_tiles)[element.id().id()] = tile_set;
+  for (const auto& coord : tile_set) {
+    *((*tiles)[coord].*add_element)() = element;
+  }
+}
+
+template <class T>
+void AddToTiles(const T& element, const Bounds& bounds,
+                const double tile_length, T* (Map::*add_element)(),
+                std::unordered_map<std::string, TileSet>* element_tiles,
+                TileMaps* tiles) {
+  AddToTiles(element, bounds.Tiles(tile_length), add_element, element_tiles,
+             tiles);
+}
+
+// Merge the elements of the tiles, an element in several tiles is added once.
+template <class T>
+void MergeElements(const std::map<int64_t, std::unique_ptr<Map>>& tiles,
+                   const RepeatedPtrField<T>& (Map::*elements)() const,
+                   RepeatedPtrField<T>* merged_elements,
+                   std::unordered_set<std::string>* all_ids) {
+  std::unordered_set<std::string> ids;
+  for (const auto& tile : tiles) {
+    for (const auto& element : ((*tile.second).*elements)()) {
+      if (ids.insert(element.id().id()).second) {
+        *merged_elements->Add() = element;
+        if (all_ids != nullptr) {
+          all_ids->insert(element.id().id());
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+bool SaveMapTiles(const Map& map, const double tile_length,
+                  const std::string& tile_dir) {
+  if (tile_length <= 0.0) {
+    AERROR << "Invalid tile length " << tile_length;
+    return false;
+  }
+  if (!cyber::common::EnsureDirectory(tile_dir)) {
+    AERROR << "Failed to create directory " << tile_dir;
+    return false;
+  }
+
+  TileMaps tiles;
+  std::unordered_map<std::string, TileSet> element_tiles;
+  for (const auto& lane : map.lane()) {
+    Bounds bounds;
+    bounds.Add(lane.central_curve());
+    bounds.Add(lane.left_boundary().curve());
+    bounds.Add(lane.right_boundary().curve());
+    AddToTiles(lane, bounds, tile_length, &Map::add_lane, &element_tiles,
+               &tiles);
+  }
+  for (const auto& junction : map.junction()) {
+    Bounds bounds;
+    bounds.Add(junction.polygon());
+    AddToTiles(junction, bounds, tile_length, &Map::add_junction,
+               &element_tiles, &tiles);
+  }
+  for (const auto& signal : map.signal()) {
+    Bounds bounds;
+    bounds.Add(signal.boundary());
+    for (const auto& stop_line : signal.stop_line()) {
+      bounds.Add(stop_line);
+    }
+    AddToTiles(signal, bounds, tile_length, &Map::add_signal, &element_tiles,
+               &tiles);
+  }
+  for (const auto& crosswalk : map.crosswalk()) {
+    Bounds bounds;
+    bounds.Add(crosswalk.polygon());
+    AddToTiles(crosswalk, bounds, tile_length, &Map::add_crosswalk,
+               &element_tiles, &tiles);
+  }
+  for (const auto& stop_sign : map.stop_sign()) {
+    Bounds bounds;
+    for (const auto& stop_line : stop_sign.stop_line()) {
+      bounds.Add(stop_line);
+    }
+    AddToTiles(stop_sign, bounds, tile_length, &Map::add_stop_sign,
+               &element_tiles, &tiles);
+  }
+  for (const auto& yield_sign : map.yield()) {
+    Bounds bounds;
+    for (const auto& stop_line : yield_sign.stop_line()) {
+      bounds.Add(stop_line);
+    }
+    AddToTiles(yield_sign, bounds, tile_length, &Map::add_yield,
+               &element_tiles, &tiles);
+  }
+  for (const auto& clear_area : map.clear_area()) {
+    Bounds bounds;
+    bounds.Add(clear_area.polygon());
+    AddToTiles(clear_area, bounds, tile_length, &Map::add_clear_area,
+               &element_tiles, &tiles);
+  }
+  for (const auto& speed_bump : map.speed_bump()) {
+    Bounds bounds;
+    for (const auto& position : speed_bump.position()) {
+      bounds.Add(position);
+    }
+    AddToTiles(speed_bump, bounds, tile_length, &Map::add_speed_bump,
+               &element_tiles, &tiles);
+  }
+  for (const auto& parking_space : map.parking_space()) {
+    Bounds bounds;
+    bounds.Add(parking_space.polygon());
+    AddToTiles(parking_space, bounds, tile_length, &Map::add_parking_space,
+               &element_tiles, &tiles);
+  }
+  for (const auto& pnc_junction : map.pnc_junction()) {
+    Bounds bounds;
+    bounds.Add(pnc_junction.polygon());
+    AddToTiles(pnc_junction, bounds, tile_length, &Map::add_pnc_junction,
+               &element_tiles, &tiles);
+  }
+  // a road goes with its lanes, which are found by the road of the lanes
+  for (const auto& road : map.road()) {
+    Bounds bounds;
+    for (const auto& section : road.section()) {
+      bounds.Add(section.boundary().outer_polygon());
+      for (const auto& hole : section.boundary().hole()) {
+        bounds.Add(hole);
+      }
+    }
+    TileSet tile_set = bounds.Tiles(tile_length);
+    for (const auto& section : road.section()) {
+      for (const auto& lane_id : section.lane_id()) {
+        const auto& lane_tiles = element_tiles[lane_id.id()];
+        tile_set.insert(lane_tiles.begin(), lane_tiles.end());
+      }
+    }
+    AddToTiles(road, tile_set, &Map::add_road, &element_tiles, &tiles);
+  }
+  for (const auto& overlap : map.overlap()) {
+    TileSet tile_set;
+    for (const auto& object : overlap.object()) {
+      const auto& object_tiles = element_tiles[object.id().id()];
+      tile_set.insert(object_tiles.begin(), object_tiles.end());
+    }
+    AddToTiles(overlap, tile_set, &Map::add_overlap, &element_tiles, &tiles);
+  }
+
+  MapTileIndex tile_index;
+  *tile_index.mutable_header() = map.header();
+  tile_index.set_tile_length(tile_length);
+  for (const auto& tile : tiles) {
+    auto* map_tile = tile_index.add_tile();
+    map_tile->set_x(tile.first.first);
+    map_tile->set_y(tile.first.second);
+    map_tile->set_filename("tile_" + std::to_string(tile.first.first) + "_" +
+                           std::to_string(tile.first.second) + ".bin");
+    for (const auto& lane : tile.second.lane()) {
+      map_tile->add_lane_id(lane.id().id());
+    }
+    const std::string tile_file = tile_dir + "/" + map_tile->filename();
+    if (!cyber::common::SetProtoToBinaryFile(tile.second, tile_file)) {
+      AERROR << "Failed to write file " << tile_file;
+      return false;
+    }
+  }
+  const std::string index_file = tile_dir + "/" + kMapTileIndexFilename;
+  if (!cyber::common::SetProtoToASCIIFile(tile_index, index_file)) {
+    AERROR << "Failed to write file " << index_file;
+    return false;
+  }
+  AINFO << "Split the map into " << tile_index.tile_size() << " tiles";
+  return true;
+}
+
+TiledHDMap::~TiledHDMap() { WaitForMap(); }
+
+int TiledHDMap::Init(const std::string& tile_dir) {
+  if (FLAGS_map_tile_evict_radius < FLAGS_map_tile_load_radius) {
+    AERROR << "The map tile evict radius " << FLAGS_map_tile_evict_radius
+           << " is less than the load radius " << FLAGS_map_tile_load_radius;
+    return -1;
+  }
+  WaitForMap();
+  tile_dir_ = tile_dir;
+  tile_index_.Clear();
+  tile_positions_.clear();
+  lane_tiles_.clear();
+  routing_tiles_.clear();
+
+  const std::string index_file = tile_dir + "/" + kMapTileIndexFilename;
+  if (!cyber::common::GetProtoFromFile(index_file, &tile_index_)) {
+    AERROR << "Failed to load map tile index " << index_file;
+    return -1;
+  }
+  if (tile_index_.tile_length() <= 0.0) {
+    AERROR << "Invalid tile length " << tile_index_.tile_length() << " in "
+           << index_file;
+    return -1;
+  }
+  for (int i = 0; i < tile_index_.tile_size(); ++i) {
+    const auto& tile = tile_index_.tile(i);
+    const int64_t key = TileKey(tile.x(), tile.y());
+    tile_positions_[key] = i;
+    for (const auto& lane_id : tile.lane_id()) {
+      lane_tiles_[lane_id].push_back(key);
+    }
+  }
+  return BuildMap(std::set<int64_t>()) ? 0 : -1;
+}
+
+void TiledHDMap::SetRouting(const routing::RoutingResponse& routing) {
+  routing_tiles_.clear();
+  std::unordered_set<int64_t> routing_tile_keys;
+  for (const auto& road : routing.road()) {
+    for (const auto& passage : road.passage()) {
+      for (const auto& segment : passage.segment()) {
+        const auto iter = lane_tiles_.find(segment.id());
+        if (iter == lane_tiles_.end()) {
+          continue;
+        }
+        for (const int64_t key : iter->second) {
+          if (routing_tile_keys.insert(key).second) {
+            routing_tiles_.push_back(key);
+          }
+        }
+      }
+    }
+  }
+}
+
+bool TiledHDMap::Update(const PointENU& position) {
+  // the tiles are updated by a later call while the former map is being built
+  if (map_building_.valid()) {
+    if (map_building_.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready) {
+      return false;
+    }
+    map_building_.get();
+  }
+
+  std::unordered_set<int64_t> near_tile_keys;
+  FindTilesWithin(position, FLAGS_map_tile_load_radius, &near_tile_keys);
+  std::unordered_set<int64_t> prefetch_tile_keys;
+  FindPrefetchTiles(near_tile_keys, &prefetch_tile_keys);
+
+  std::set<int64_t> map_tile_keys;
+  {
+    std::lock_guard<std::mutex> lock(map_mutex_);
+    map_tile_keys = map_tile_keys_;
+  }
+  std::set<int64_t> tile_keys(near_tile_keys.begin(), near_tile_keys.end());
+  tile_keys.insert(prefetch_tile_keys.begin(), prefetch_tile_keys.end());
+  for (const int64_t key : map_tile_keys) {
+    const auto& tile = tile_index_.tile(tile_positions_.at(key));
+    if (prefetch_tile_keys.count(key) > 0 ||
+        DistanceToTile(position, tile) <= FLAGS_map_tile_evict_radius) {
+      tile_keys.insert(key);
+    }
+  }
+  if (tile_keys == map_tile_keys) {
+    return false;
+  }
+  map_building_ = std::async(std::launch::async, [this, tile_keys]() {
+    return BuildMap(tile_keys);
+  });
+  return true;
+}
+
+void TiledHDMap::WaitForMap() {
+  if (map_building_.valid()) {
+    map_building_.get();
+  }
+}
+
+std::shared_ptr<const HDMap> TiledHDMap::map() const {
+  std::lock_guard<std::mutex> lock(map_mutex_);
+  return map_;
+}
+
+size_t TiledHDMap::NumLoadedTiles() const {
+  std::lock_guard<std::mutex> lock(map_mutex_);
+  return map_tile_keys_.size();
+}
+
+double TiledHDMap::DistanceToTile(const PointENU& position,
+                                  const MapTile& tile) const {
+  const double length = tile_index_.tile_length();
+  const double dx = std::max({tile.x() * length - position.x(),
+                              position.x() - (tile.x() + 1) * length, 0.0});
+  const double dy = std::max({tile.y() * length - position.y(),
+                              position.y() - (tile.y() + 1) * length, 0.0});
+  return std::hypot(dx, dy);
+}
+
+void TiledHDMap::FindTilesWithin(const PointENU& position, const double radius,
+                                 std::unordered_set<int64_t>* tile_keys) const {
+  const double length = tile_index_.tile_length();
+  const double x0 = position.x();
+  const double y0 = position.y();
+  const int min_x = static_cast<int>(std::floor((x0 - radius) / length));
+  const int min_y = static_cast<int>(std::floor((y0 - radius) / length));
+  const int max_x = static_cast<int>(std::floor((x0 + radius) / length));
+  const int max_y = static_cast<int>(std::floor((y0 + radius) / length));
+  for (int x = min_x; x <= max_x; ++x) {
+    for (int y = min_y; y <= max_y; ++y) {
+      const auto iter = tile_positions_.find(TileKey(x, y));
+      if (iter != tile_positions_.end() &&
+          DistanceToTile(position, tile_index_.tile(iter->second)) <= radius) {
+        tile_keys->insert(iter->first);
+      }
+    }
+  }
+}
+
+void TiledHDMap::FindPrefetchTiles(
+    const std::unordered_set<int64_t>& near_tile_keys,
+    std::unordered_set<int64_t>* tile_keys) const {
+  // the vehicle is taken at the last near tile along the routing
+  const int num_routing_tiles = static_cast<int>(routing_tiles_.size());
+  int start = 0;
+  for (int i = num_routing_tiles - 1; i >= 0; --i) {
+    if (near_tile_keys.count(routing_tiles_[i]) > 0) {
+      start = i + 1;
+      break;
+    }
+  }
+  const int end =
+      std::min(num_routing_tiles, start + FLAGS_map_num_prefetch_tiles);
+  for (int i = start; i < end; ++i) {
+    tile_keys->insert(routing_tiles_[i]);
+  }
+}
+
+bool TiledHDMap::BuildMap(const std::set<int64_t>& tile_keys) {
+  std::map<int64_t, std::unique_ptr<Map>> loaded_tiles;
+  std::set<int64_t> loaded_tile_keys;
+  for (const int64_t key : tile_keys) {
+    const auto& tile = tile_index_.tile(tile_positions_.at(key));
+    std::unique_ptr<Map> tile_map(new Map());
+    const std::string tile_file = tile_dir_ + "/" + tile.filename();
+    if (!cyber::common::GetProtoFromBinaryFile(tile_file, tile_map.get())) {
+      AERROR << "Failed to load map tile " << tile.filename();
+      continue;
+    }
+    loaded_tiles.emplace(key, std::move(tile_map));
+    loaded_tile_keys.insert(key);
+  }
+
+  Map map;
+  *map.mutable_header() = tile_index_.header();
+  std::unordered_set<std::string> ids;
+  MergeElements(loaded_tiles, &Map::lane, map.mutable_lane(), &ids);
+  MergeElements(loaded_tiles, &Map::junction, map.mutable_junction(), &ids);
+  MergeElements(loaded_tiles, &Map::signal, map.mutable_signal(), &ids);
+  MergeElements(loaded_tiles, &Map::crosswalk, map.mutable_crosswalk(),
+                &ids);
+  MergeElements(loaded_tiles, &Map::stop_sign, map.mutable_stop_sign(),
+                &ids);
+  MergeElements(loaded_tiles, &Map::yield, map.mutable_yield(), &ids);
+  MergeElements(loaded_tiles, &Map::clear_area, map.mutable_clear_area(),
+                &ids);
+  MergeElements(loaded_tiles, &Map::speed_bump, map.mutable_speed_bump(),
+                &ids);
+  MergeElements(loaded_tiles, &Map::parking_space,
+                map.mutable_parking_space(), &ids);
+  MergeElements(loaded_tiles, &Map::pnc_junction, map.mutable_pnc_junction(),
+                &ids);
+
+  // keep the lanes of the roads which are loaded
+  std::unordered_set<std::string> lane_ids;
+  for (const auto& lane : map.lane()) {
+    lane_ids.insert(lane.id().id());
+  }
+  MergeElements(loaded_tiles, &Map::road, map.mutable_road(), nullptr);
+  for (auto& road : *map.mutable_road()) {
+    for (auto& section : *road.mutable_section()) {
+      RepeatedPtrField<Id> section_lane_ids;
+      for (const auto& lane_id : section.lane_id()) {
+        if (lane_ids.count(lane_id.id()) > 0) {
+          *section_lane_ids.Add() = lane_id;
+        }
+      }
+      section.mutable_lane_id()->Swap(&section_lane_ids);
+    }
+  }
+
+  // keep the overlaps whose objects are all loaded
+  RepeatedPtrField<Overlap> overlaps;
+  MergeElements(loaded_tiles, &Map::overlap, &overlaps, nullptr);
+  for (const auto& overlap : overlaps) {
+    const bool loaded = std::all_of(
+        overlap.object().begin(), overlap.object().end(),
+        [&ids](const ObjectOverlapInfo& object) {
+          return ids.count(object.id().id()) > 0;
+        });
+    if (loaded) {
+      *map.add_overlap() = overlap;
+    }
+  }
+
+  // the tiles are no longer needed once merged
+  loaded_tiles.clear();
+
+  std::shared_ptr<HDMap> hdmap = std::make_shared<HDMap>();
+  if (hdmap->LoadMapFromProto(map) != 0) {
+    AERROR << "Failed to load the map of " << loaded_tile_keys.size()
+           << " tiles, keep the former one";
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(map_mutex_);
+  map_ = hdmap;
+  map_tile_keys_ = std::move(loaded_tile_keys);
+  return true;
+}
+
+}  // namespace hdmap
+}  // namespace apollo
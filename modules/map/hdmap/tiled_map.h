@@ -0,0 +1,147 @@
+/* Copyright 2019 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+#pragma once
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "modules/common/proto/geometry.pb.h"
+#include "modules/map/hdmap/hdmap.h"
+#include "modules/map/proto/map.pb.h"
+#include "modules/map/proto/map_tile.pb.h"
+#include "modules/routing/proto/routing.pb.h"
+
+/**
+ * @namespace apollo::hdmap
+ * @brief apollo::hdmap
+ */
+namespace apollo {
+namespace hdmap {
+
+constexpr char kMapTileIndexFilename[] = "map_tile_index.pb.txt";
+
+/**
+ * @brief Split a map into square tiles of tile_length meters, and write every
+ * tile as a binary map proto into tile_dir together with the tile index. An
+ * element goes into all the tiles its bounding box touches, a road also into
+ * the tiles of its lanes, and an overlap into the tiles of its objects.
+ * @return true on success.
+ */
+bool SaveMapTiles(const Map& map, const double tile_length,
+                  const std::string& tile_dir);
+
+/**
+ * @class TiledHDMap
+ *
+ * @brief A map of the region around the vehicle, loaded from the tiles written
+ * by SaveMapTiles. Update loads the tiles within FLAGS_map_tile_load_radius
+ * and the next FLAGS_map_num_prefetch_tiles tiles along the routing, and
+ * evicts the tiles beyond FLAGS_map_tile_evict_radius, so that the memory and
+ * the load time follow the local area instead of the whole map.
+ *
+ * The tiles are merged into an immutable HDMap, which is built again in a
+ * background thread when the tiles to load change, and swapped in once built.
+ * The tiles are read again for each build and only the built map is kept.
+ * An element lies whole in every tile it touches, so the queries on the map,
+ * e.g. GetLanes, GetNearestLane and GetRoadBoundaries, return the same as on
+ * the whole map as long as the queried region is within the load radius
+ * around the vehicle. The element pointers returned by the map are only
+ * valid while the map is held.
+ *
+ * Init, SetRouting and Update are called from one thread, map() from any.
+ */
+class TiledHDMap {
+ public:
+  ~TiledHDMap();
+
+  /**
+   * @brief Read the tile index in tile_dir, and build an empty map.
+   * FLAGS_map_tile_evict_radius must not be less than
+   * FLAGS_map_tile_load_radius, or the tiles just loaded would be evicted.
+   * @return 0:success, otherwise failed
+   */
+  int Init(const std::string& tile_dir);
+
+  /**
+   * @brief Set the routing along which the tiles are prefetched.
+   */
+  void SetRouting(const routing::RoutingResponse& routing);
+
+  /**
+   * @brief Start building the map of the tiles for the vehicle at the
+   * position, if they differ from the tiles of the current map. Nothing is
+   * done while a former map is still being built.
+   * @return true if a new map is being built.
+   */
+  bool Update(const apollo::common::PointENU& position);
+
+  /**
+   * @brief Wait for the map being built, if any, to be swapped in.
+   */
+  void WaitForMap();
+
+  /**
+   * @brief The map of the loaded tiles, is never nullptr after Init.
+   */
+  std::shared_ptr<const HDMap> map() const;
+
+  /**
+   * @brief The number of tiles in the current map.
+   */
+  size_t NumLoadedTiles() const;
+
+ private:
+  // the distance between the position and the region of the tile
+  double DistanceToTile(const apollo::common::PointENU& position,
+                        const MapTile& tile) const;
+
+  void FindTilesWithin(const apollo::common::PointENU& position,
+                       const double radius,
+                       std::unordered_set<int64_t>* tile_keys) const;
+
+  void FindPrefetchTiles(const std::unordered_set<int64_t>& near_tile_keys,
+                         std::unordered_set<int64_t>* tile_keys) const;
+
+  // loads the tiles, merges them into a map and swaps it in, the tiles which
+  // fail to load are left out of the map
+  bool BuildMap(const std::set<int64_t>& tile_keys);
+
+ private:
+  std::string tile_dir_;
+  MapTileIndex tile_index_;
+  // the position in tile_index_ of the tiles
+  std::unordered_map<int64_t, int> tile_positions_;
+  std::unordered_map<std::string, std::vector<int64_t>> lane_tiles_;
+  // the tiles of the routing lanes in the order of the routing
+  std::vector<int64_t> routing_tiles_;
+
+  mutable std::mutex map_mutex_;
+  std::shared_ptr<const HDMap> map_;
+  // the tiles of map_
+  std::set<int64_t> map_tile_keys_;
+
+  std::future<bool> map_building_;
+};
+
+}  // namespace hdmap
+}  // namespace apollo
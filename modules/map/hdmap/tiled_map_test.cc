@@ -0,0 +1,212 @@
+/* Copyright 2019 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+#include "modules/map/hdmap/tiled_map.h"
+
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "cyber/common/file.h"
+#include "gtest/gtest.h"
+#include "modules/common/configs/config_gflags.h"
+
+namespace {
+
+constexpr char kMapFilename[] = "modules/map/hdmap/test-data/base_map.bin";
+constexpr double kTileLength = 100.0;
+
+}  // namespace
+
+namespace apollo {
+namespace hdmap {
+
+using apollo::common::PointENU;
+
+class TiledHDMapTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    FLAGS_map_tile_load_radius = 200.0;
+    FLAGS_map_tile_evict_radius = 400.0;
+    FLAGS_map_num_prefetch_tiles = 2;
+    const char* test_tmpdir = std::getenv("TEST_TMPDIR");
+    std::string tile_dir =
+        std::string(test_tmpdir == nullptr ? "/tmp" : test_tmpdir) +
+        "/tiled_map_test_XXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(&tile_dir[0]));
+    tile_dir_ = tile_dir;
+    Map map;
+    ASSERT_TRUE(cyber::common::GetProtoFromFile(kMapFilename, &map));
+    ASSERT_TRUE(SaveMapTiles(map, kTileLength, tile_dir_));
+    ASSERT_EQ(0, whole_map_.LoadMapFromProto(map));
+    ASSERT_EQ(0, tiled_map_.Init(tile_dir_));
+  }
+
+  void TearDown() override {
+    tiled_map_.WaitForMap();
+    if (!tile_dir_.empty()) {
+      cyber::common::RemoveAllFiles(tile_dir_);
+      rmdir(tile_dir_.c_str());
+    }
+  }
+
+  static std::set<std::string> LaneIds(
+      const std::vector<LaneInfoConstPtr>& lanes) {
+    std::set<std::string> lane_ids;
+    for (const auto& lane : lanes) {
+      lane_ids.insert(lane->id().id());
+    }
+    return lane_ids;
+  }
+
+  static std::set<std::string> RoadBoundaries(
+      const std::vector<RoadROIBoundaryPtr>& road_boundaries) {
+    std::set<std::string> serialized_road_boundaries;
+    for (const auto& road_boundary : road_boundaries) {
+      serialized_road_boundaries.insert(road_boundary->SerializeAsString());
+    }
+    return serialized_road_boundaries;
+  }
+
+  static std::set<std::string> JunctionIds(
+      const std::vector<JunctionBoundaryPtr>& junctions) {
+    std::set<std::string> junction_ids;
+    for (const auto& junction : junctions) {
+      junction_ids.insert(junction->junction_info->id().id());
+    }
+    return junction_ids;
+  }
+
+  std::string tile_dir_;
+  HDMap whole_map_;
+  TiledHDMap tiled_map_;
+};
+
+TEST_F(TiledHDMapTest, LoadAroundVehicle) {
+  EXPECT_EQ(0, tiled_map_.NumLoadedTiles());
+  EXPECT_NE(nullptr, tiled_map_.map());
+
+  Id lane_id;
+  lane_id.set_id("1272_1_-1");
+  const auto lane = whole_map_.GetLaneById(lane_id);
+  ASSERT_NE(nullptr, lane);
+  PointENU position;
+  position.set_x(lane->points().front().x());
+  position.set_y(lane->points().front().y());
+  EXPECT_TRUE(tiled_map_.Update(position));
+  tiled_map_.WaitForMap();
+  EXPECT_FALSE(tiled_map_.Update(position));
+  EXPECT_GT(tiled_map_.NumLoadedTiles(), 0);
+
+  const auto hdmap = tiled_map_.map();
+  EXPECT_NE(nullptr, hdmap->GetLaneById(lane_id));
+  std::vector<LaneInfoConstPtr> lanes;
+  std::vector<LaneInfoConstPtr> tiled_lanes;
+  for (const double distance : {10.0, 50.0, 150.0}) {
+    ASSERT_EQ(0, whole_map_.GetLanes(position, distance, &lanes));
+    ASSERT_EQ(0, hdmap->GetLanes(position, distance, &tiled_lanes));
+    EXPECT_EQ(LaneIds(lanes), LaneIds(tiled_lanes));
+  }
+
+  PointENU point = position;
+  point.set_x(point.x() + 30.0);
+  LaneInfoConstPtr nearest_lane;
+  LaneInfoConstPtr tiled_nearest_lane;
+  double s = 0.0;
+  double l = 0.0;
+  ASSERT_EQ(0, whole_map_.GetNearestLane(point, &nearest_lane, &s, &l));
+  ASSERT_EQ(0, hdmap->GetNearestLane(point, &tiled_nearest_lane, &s, &l));
+  EXPECT_EQ(nearest_lane->id().id(), tiled_nearest_lane->id().id());
+
+  // far from the map, all the tiles are evicted while the former map is valid
+  position.set_x(position.x() + 1.0e5);
+  EXPECT_TRUE(tiled_map_.Update(position));
+  tiled_map_.WaitForMap();
+  EXPECT_EQ(0, tiled_map_.NumLoadedTiles());
+  EXPECT_EQ(nullptr, tiled_map_.map()->GetLaneById(lane_id));
+  EXPECT_NE(nullptr, hdmap->GetLaneById(lane_id));
+}
+
+TEST_F(TiledHDMapTest, PrefetchAlongRouting) {
+  routing::RoutingResponse routing;
+  auto* segment = routing.add_road()->add_passage()->add_segment();
+  segment->set_id("1272_1_-1");
+
+  // away from the map, only the tiles along the routing are loaded
+  PointENU position;
+  position.set_x(-1.0e5);
+  position.set_y(-1.0e5);
+  tiled_map_.SetRouting(routing);
+  EXPECT_TRUE(tiled_map_.Update(position));
+  tiled_map_.WaitForMap();
+  EXPECT_GT(tiled_map_.NumLoadedTiles(), 0);
+  EXPECT_LE(tiled_map_.NumLoadedTiles(), FLAGS_map_num_prefetch_tiles);
+  Id lane_id;
+  lane_id.set_id("1272_1_-1");
+  EXPECT_NE(nullptr, tiled_map_.map()->GetLaneById(lane_id));
+}
+
+TEST_F(TiledHDMapTest, RoadBoundariesAcrossTiles) {
+  // the point of the lane closest to a border between two tiles
+  Id lane_id;
+  lane_id.set_id("1272_1_-1");
+  const auto lane = whole_map_.GetLaneById(lane_id);
+  ASSERT_NE(nullptr, lane);
+  PointENU position;
+  double min_distance_to_border = kTileLength;
+  for (const auto& point : lane->points()) {
+    const double distance_to_border =
+        std::min(std::abs(std::remainder(point.x(), kTileLength)),
+                 std::abs(std::remainder(point.y(), kTileLength)));
+    if (distance_to_border < min_distance_to_border) {
+      min_distance_to_border = distance_to_border;
+      position.set_x(point.x());
+      position.set_y(point.y());
+    }
+  }
+  ASSERT_LT(min_distance_to_border, 5.0);
+
+  EXPECT_TRUE(tiled_map_.Update(position));
+  tiled_map_.WaitForMap();
+  const auto hdmap = tiled_map_.map();
+  std::vector<RoadROIBoundaryPtr> road_boundaries;
+  std::vector<JunctionBoundaryPtr> junctions;
+  std::vector<RoadROIBoundaryPtr> tiled_road_boundaries;
+  std::vector<JunctionBoundaryPtr> tiled_junctions;
+  for (const double radius : {5.0, 30.0, 100.0}) {
+    ASSERT_EQ(0, whole_map_.GetRoadBoundaries(position, radius,
+                                              &road_boundaries, &junctions));
+    ASSERT_EQ(0, hdmap->GetRoadBoundaries(position, radius,
+                                          &tiled_road_boundaries,
+                                          &tiled_junctions));
+    EXPECT_FALSE(road_boundaries.empty() && junctions.empty());
+    EXPECT_EQ(RoadBoundaries(road_boundaries),
+              RoadBoundaries(tiled_road_boundaries));
+    EXPECT_EQ(JunctionIds(junctions), JunctionIds(tiled_junctions));
+  }
+}
+
+TEST_F(TiledHDMapTest, EvictRadiusLessThanLoadRadius) {
+  FLAGS_map_tile_evict_radius = FLAGS_map_tile_load_radius - 1.0;
+  TiledHDMap tiled_map;
+  EXPECT_NE(0, tiled_map.Init(tile_dir_));
+}
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -17,6 +17,7 @@
 #include "modules/map/pnc_map/path.h"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <unordered_map>
 
@@ -42,6 +43,18 @@ using std::placeholders::_1;
 namespace {
 
 const double kSampleDistance = 0.25;
+// The length of the cells of the grid to search the segments for projections.
+const double kProjectionCellLength = 4.0;
+// Beyond this coordinate the cell indices could overflow.
+const double kMaxProjectionCoordinate = 1.0e9;
+
+int GetCellIndex(const double coordinate) {
+  return static_cast<int>(std::floor(coordinate / kProjectionCellLength));
+}
+
+int64_t GetCellKey(const int cell_x, const int cell_y) {
+  return (static_cast<int64_t>(cell_x) << 32) | static_cast<uint32_t>(cell_y);
+}
 
 bool FindLaneSegment(const MapPathPoint& p1, const MapPathPoint& p2,
                      LaneSegment* const lane_segment) {
@@ -354,6 +367,7 @@ void Path::Init() {
   InitPointIndex();
   InitWidth();
   InitOverlaps();
+  InitProjectionCells();
 }
 
 void Path::InitPoints() {
@@ -488,6 +502,35 @@ void Path::InitPointIndex() {
   CHECK_EQ(last_point_index_.size(), num_sample_points_);
 }
 
+void Path::InitProjectionCells() {
+  auto cells = std::make_shared<ProjectionCells>();
+  cells->min_x = std::numeric_limits<int>::max();
+  cells->max_x = std::numeric_limits<int>::min();
+  cells->min_y = std::numeric_limits<int>::max();
+  cells->max_y = std::numeric_limits<int>::min();
+  for (int i = 0; i < num_segments_; ++i) {
+    const auto& segment = segments_[i];
+    const int start_x =
+        GetCellIndex(std::min(segment.start().x(), segment.end().x()));
+    const int end_x =
+        GetCellIndex(std::max(segment.start().x(), segment.end().x()));
+    const int start_y =
+        GetCellIndex(std::min(segment.start().y(), segment.end().y()));
+    const int end_y =
+        GetCellIndex(std::max(segment.start().y(), segment.end().y()));
+    for (int x = start_x; x <= end_x; ++x) {
+      for (int y = start_y; y <= end_y; ++y) {
+        cells->segments[GetCellKey(x, y)].push_back(i);
+      }
+    }
+    cells->min_x = std::min(cells->min_x, start_x);
+    cells->max_x = std::max(cells->max_x, end_x);
+    cells->min_y = std::min(cells->min_y, start_y);
+    cells->max_y = std::max(cells->max_y, end_y);
+  }
+  projection_cells_ = std::move(cells);
+}
+
 void Path::GetAllOverlaps(GetOverlapFromLaneFunc GetOverlaps_from_lane,
                           std::vector<PathOverlap>* const overlaps) const {
   if (overlaps == nullptr) {
@@ -756,28 +799,8 @@ bool Path::GetProjectionWithHueristicParams(const Vec2d& point,
     }
   }
   *min_distance = std::sqrt(*min_distance);
-  const auto& nearest_seg = segments_[min_index];
-  const auto prod = nearest_seg.ProductOntoUnit(point);
-  const auto proj = nearest_seg.ProjectOntoUnit(point);
-  if (min_index == 0) {
-    *accumulate_s = std::min(proj, nearest_seg.length());
-    if (proj < 0) {
-      *lateral = prod;
-    } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
-    }
-  } else if (min_index == num_segments_ - 1) {
-    *accumulate_s = accumulated_s_[min_index] + std::max(0.0, proj);
-    if (proj > 0) {
-      *lateral = prod;
-    } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
-    }
-  } else {
-    *accumulate_s = accumulated_s_[min_index] +
-                    std::max(0.0, std::min(proj, nearest_seg.length()));
-    *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
-  }
+  GetProjectionOnSegment(point, min_index, *min_distance, accumulate_s,
+                         lateral);
   return true;
 }
 
@@ -795,39 +818,188 @@ bool Path::GetProjection(const Vec2d& point, double* accumulate_s,
                                         min_distance);
   }
   CHECK_GE(num_points_, 2);
-  *min_distance = std::numeric_limits<double>::infinity();
+  const int min_index = GetNearestSegmentIndex(point, -1, min_distance);
+  *min_distance = std::sqrt(*min_distance);
+  GetProjectionOnSegment(point, min_index, *min_distance, accumulate_s,
+                         lateral);
+  return true;
+}
+
+bool Path::GetProjectionWithWarmStartS(const Vec2d& point,
+                                       const double warm_start_s,
+                                       double* accumulate_s,
+                                       double* lateral) const {
+  double distance = 0.0;
+  return GetProjectionWithWarmStartS(point, warm_start_s, accumulate_s,
+                                     lateral, &distance);
+}
+
+bool Path::GetProjectionWithWarmStartS(const Vec2d& point,
+                                       const double warm_start_s,
+                                       double* accumulate_s, double* lateral,
+                                       double* min_distance) const {
+  if (segments_.empty()) {
+    return false;
+  }
+  if (accumulate_s == nullptr || lateral == nullptr ||
+      min_distance == nullptr) {
+    return false;
+  }
+  if (use_path_approximation_) {
+    return approximation_.GetProjection(*this, point, accumulate_s, lateral,
+                                        min_distance);
+  }
+  CHECK_GE(num_points_, 2);
+  const int hint_index =
+      std::isfinite(warm_start_s)
+          ? std::min(GetIndexFromS(warm_start_s).id, num_segments_ - 1)
+          : -1;
+  const int min_index = GetNearestSegmentIndex(point, hint_index, min_distance);
+  *min_distance = std::sqrt(*min_distance);
+  GetProjectionOnSegment(point, min_index, *min_distance, accumulate_s,
+                         lateral);
+  return true;
+}
+
+int Path::GetNearestSegmentIndex(const Vec2d& point, const int hint_index,
+                                 double* min_distance_sqr) const {
   int min_index = 0;
-  for (int i = 0; i < num_segments_; ++i) {
-    const double distance = segments_[i].DistanceSquareTo(point);
-    if (distance < *min_distance) {
-      min_index = i;
-      *min_distance = distance;
+  *min_distance_sqr = std::numeric_limits<double>::infinity();
+  // keep the first of the nearest segments as a scan over all of them does
+  auto search_segment = [&](const int index) {
+    const double distance_sqr = segments_[index].DistanceSquareTo(point);
+    if (distance_sqr < *min_distance_sqr ||
+        (distance_sqr == *min_distance_sqr && index < min_index)) {
+      min_index = index;
+      *min_distance_sqr = distance_sqr;
+    }
+  };
+  if (!(std::fabs(point.x()) < kMaxProjectionCoordinate &&
+        std::fabs(point.y()) < kMaxProjectionCoordinate)) {
+    for (int i = 0; i < num_segments_; ++i) {
+      search_segment(i);
+    }
+    return min_index;
+  }
+
+  if (hint_index >= 0) {
+    // descend along the path from the hint to a local minimum, which bounds
+    // the cells to search
+    min_index = hint_index;
+    *min_distance_sqr = segments_[hint_index].DistanceSquareTo(point);
+    for (const int step : {-1, 1}) {
+      for (int i = min_index + step; i >= 0 && i < num_segments_; i += step) {
+        const double distance_sqr = segments_[i].DistanceSquareTo(point);
+        if (distance_sqr >= *min_distance_sqr) {
+          break;
+        }
+        min_index = i;
+        *min_distance_sqr = distance_sqr;
+      }
     }
   }
-  *min_distance = std::sqrt(*min_distance);
-  const auto& nearest_seg = segments_[min_index];
+
+  const ProjectionCells& cells = *projection_cells_;
+  const int cell_x = GetCellIndex(point.x());
+  const int cell_y = GetCellIndex(point.y());
+  // the distance from the point to the sides of its cell
+  const double margin =
+      std::min({point.x() - cell_x * kProjectionCellLength,
+                (cell_x + 1) * kProjectionCellLength - point.x(),
+                point.y() - cell_y * kProjectionCellLength,
+                (cell_y + 1) * kProjectionCellLength - point.y()});
+  int num_searched_cells = 0;
+  auto search_cell = [&](const int x, const int y) {
+    // skip the cells farther than the nearest segment so far
+    const double gap_x =
+        x < cell_x ? point.x() - (x + 1) * kProjectionCellLength
+                   : (x > cell_x ? x * kProjectionCellLength - point.x() : 0.0);
+    const double gap_y =
+        y < cell_y ? point.y() - (y + 1) * kProjectionCellLength
+                   : (y > cell_y ? y * kProjectionCellLength - point.y() : 0.0);
+    if (gap_x * gap_x + gap_y * gap_y > *min_distance_sqr + kMathEpsilon) {
+      return;
+    }
+    ++num_searched_cells;
+    const auto iter = cells.segments.find(GetCellKey(x, y));
+    if (iter == cells.segments.end()) {
+      return;
+    }
+    for (const int index : iter->second) {
+      search_segment(index);
+    }
+  };
+  // search the rings of cells around the point outwards, starting from the
+  // first ring that reaches the cells of the path
+  const int start_ring =
+      std::max({0, cells.min_x - cell_x, cell_x - cells.max_x,
+                cells.min_y - cell_y, cell_y - cells.max_y});
+  for (int ring = start_ring;; ++ring) {
+    const int x0 = cell_x - ring;
+    const int x1 = cell_x + ring;
+    const int y0 = cell_y - ring;
+    const int y1 = cell_y + ring;
+    for (int x = std::max(x0, cells.min_x); x <= std::min(x1, cells.max_x);
+         ++x) {
+      if (x == x0 || x == x1) {
+        for (int y = std::max(y0, cells.min_y);
+             y <= std::min(y1, cells.max_y); ++y) {
+          search_cell(x, y);
+        }
+        continue;
+      }
+      if (y0 >= cells.min_y) {
+        search_cell(x, y0);
+      }
+      if (y1 <= cells.max_y) {
+        search_cell(x, y1);
+      }
+    }
+    if (x0 <= cells.min_x && x1 >= cells.max_x && y0 <= cells.min_y &&
+        y1 >= cells.max_y) {
+      break;
+    }
+    // the segments out of the searched cells are farther than the bound
+    const double bound = ring * kProjectionCellLength + margin - kMathEpsilon;
+    if (bound > 0.0 && *min_distance_sqr < bound * bound) {
+      break;
+    }
+    if (num_searched_cells > num_segments_) {
+      // far from the path, scanning all the segments is faster
+      for (int i = 0; i < num_segments_; ++i) {
+        search_segment(i);
+      }
+      break;
+    }
+  }
+  return min_index;
+}
+
+void Path::GetProjectionOnSegment(const Vec2d& point, const int index,
+                                  const double min_distance,
+                                  double* accumulate_s, double* lateral) const {
+  const auto& nearest_seg = segments_[index];
   const auto prod = nearest_seg.ProductOntoUnit(point);
   const auto proj = nearest_seg.ProjectOntoUnit(point);
-  if (min_index == 0) {
+  if (index == 0) {
     *accumulate_s = std::min(proj, nearest_seg.length());
     if (proj < 0) {
       *lateral = prod;
     } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
+      *lateral = (prod > 0.0 ? 1 : -1) * min_distance;
     }
-  } else if (min_index == num_segments_ - 1) {
-    *accumulate_s = accumulated_s_[min_index] + std::max(0.0, proj);
+  } else if (index == num_segments_ - 1) {
+    *accumulate_s = accumulated_s_[index] + std::max(0.0, proj);
     if (proj > 0) {
       *lateral = prod;
     } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
+      *lateral = (prod > 0.0 ? 1 : -1) * min_distance;
     }
   } else {
-    *accumulate_s = accumulated_s_[min_index] +
+    *accumulate_s = accumulated_s_[index] +
                     std::max(0.0, std::min(proj, nearest_seg.length()));
-    *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
+    *lateral = (prod > 0.0 ? 1 : -1) * min_distance;
   }
-  return true;
 }
 
 bool Path::GetHeadingAlongPath(const Vec2d& point, double* heading) const {
@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -260,6 +263,16 @@ class Path {
                      double* lateral) const;
   bool GetProjection(const common::math::Vec2d& point, double* accumulate_s,
                      double* lateral, double* distance) const;
+  // Same as GetProjection, but the nearest segment found around warm_start_s,
+  // e.g. the projection of the previous point of a trajectory, bounds the
+  // cells to search.
+  bool GetProjectionWithWarmStartS(const common::math::Vec2d& point,
+                                   const double warm_start_s,
+                                   double* accumulate_s, double* lateral) const;
+  bool GetProjectionWithWarmStartS(const common::math::Vec2d& point,
+                                   const double warm_start_s,
+                                   double* accumulate_s, double* lateral,
+                                   double* distance) const;
 
   bool GetHeadingAlongPath(const common::math::Vec2d& point,
                            double* heading) const;
@@ -338,6 +351,17 @@ class Path {
   void InitWidth();
   void InitPointIndex();
   void InitOverlaps();
+  void InitProjectionCells();
+
+  // Find the first of the segments nearest to the point, which is the same as
+  // scanning all the segments. The search starts from hint_index if it is not
+  // negative.
+  int GetNearestSegmentIndex(const common::math::Vec2d& point,
+                             const int hint_index,
+                             double* min_distance_sqr) const;
+  void GetProjectionOnSegment(const common::math::Vec2d& point,
+                              const int index, const double min_distance,
+                              double* accumulate_s, double* lateral) const;
 
   double GetSample(const std::vector<double>& samples, const double s) const;
 
@@ -360,6 +384,18 @@ class Path {
   bool use_path_approximation_ = false;
   PathApproximation approximation_;
 
+  // The segments in the cells of a uniform grid that their bounding boxes
+  // overlap, so that a projection only searches the cells around the point.
+  struct ProjectionCells {
+    std::unordered_map<int64_t, std::vector<int>> segments;
+    int min_x = 0;
+    int max_x = 0;
+    int min_y = 0;
+    int max_y = 0;
+  };
+  // Immutable once built, so that the copies of the path share it.
+  std::shared_ptr<const ProjectionCells> projection_cells_;
+
   // Sampled every fixed length.
   int num_sample_points_ = 0;
   std::vector<double> lane_left_width_;
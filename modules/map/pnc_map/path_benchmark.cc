@@ -0,0 +1,184 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+// Benchmark of the projections onto a long winding path sampled every half
+// meter like a reference line. The queries are the points of the vehicles
+// driving along the four lanes around the path, either in random order or in
+// the order of a trajectory, which is where the warm start applies.
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/map/pnc_map/path.h"
+
+namespace apollo {
+namespace hdmap {
+namespace {
+
+using apollo::common::math::Vec2d;
+
+const double kPointSpacing = 0.5;
+const double kLaneWidth = 3.5;
+const int kNumLanes = 4;
+const int kNumQueries = 4096;
+
+Path MakeWindingPath(const int num_points) {
+  std::vector<MapPathPoint> points;
+  double x = 0.0;
+  double y = 0.0;
+  double heading = 0.0;
+  for (int i = 0; i < num_points; ++i) {
+    points.emplace_back(Vec2d(x, y), heading);
+    heading += 0.004 * std::sin(i * 0.002);
+    x += kPointSpacing * std::cos(heading);
+    y += kPointSpacing * std::sin(heading);
+  }
+  return Path(std::move(points));
+}
+
+// The points on the lanes around the path, in the order along the path.
+std::vector<Vec2d> MakeTrajectory(const Path& path, const int lane) {
+  const double lateral = (lane - (kNumLanes - 1) * 0.5) * kLaneWidth;
+  std::vector<Vec2d> points;
+  for (int i = 0; i < kNumQueries; ++i) {
+    const double s = path.length() * i / kNumQueries;
+    const auto point = path.GetSmoothPoint(s);
+    points.emplace_back(point.x() - std::sin(point.heading()) * lateral,
+                        point.y() + std::cos(point.heading()) * lateral);
+  }
+  return points;
+}
+
+std::vector<Vec2d> MakeQueries(const Path& path) {
+  std::vector<Vec2d> queries;
+  for (int lane = 0; lane < kNumLanes; ++lane) {
+    const auto trajectory = MakeTrajectory(path, lane);
+    queries.insert(queries.end(), trajectory.begin(), trajectory.end());
+  }
+  std::shuffle(queries.begin(), queries.end(), std::mt19937(0));
+  queries.resize(kNumQueries);
+  return queries;
+}
+
+// state.range(0): number of path points
+void BM_PathProjectionScan(benchmark::State& state) {
+  const Path path = MakeWindingPath(static_cast<int>(state.range(0)));
+  const auto queries = MakeQueries(path);
+  double s = 0.0;
+  double l = 0.0;
+  double distance = 0.0;
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    // a scan over all the segments, as GetProjection without the grid
+    path.GetProjectionWithHueristicParams(queries[i++ % queries.size()], 0.0,
+                                          path.length(), &s, &l, &distance);
+    benchmark::DoNotOptimize(s);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_PathGetProjection(benchmark::State& state) {
+  const Path path = MakeWindingPath(static_cast<int>(state.range(0)));
+  const auto queries = MakeQueries(path);
+  double s = 0.0;
+  double l = 0.0;
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    path.GetProjection(queries[i++ % queries.size()], &s, &l);
+    benchmark::DoNotOptimize(s);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_PathGetProjectionAlongTrajectory(benchmark::State& state) {
+  const Path path = MakeWindingPath(static_cast<int>(state.range(0)));
+  const auto trajectory = MakeTrajectory(path, 0);
+  double s = 0.0;
+  double l = 0.0;
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    path.GetProjection(trajectory[i++ % trajectory.size()], &s, &l);
+    benchmark::DoNotOptimize(s);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_PathGetProjectionWithWarmStartS(benchmark::State& state) {
+  const Path path = MakeWindingPath(static_cast<int>(state.range(0)));
+  const auto trajectory = MakeTrajectory(path, 0);
+  double s = 0.0;
+  double l = 0.0;
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    path.GetProjectionWithWarmStartS(trajectory[i++ % trajectory.size()], s,
+                                     &s, &l);
+    benchmark::DoNotOptimize(s);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_PathConstruction(benchmark::State& state) {
+  std::vector<MapPathPoint> points =
+      MakeWindingPath(static_cast<int>(state.range(0))).path_points();
+  while (state.KeepRunning()) {
+    Path path(points);
+    benchmark::DoNotOptimize(path);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// The copies of the reference lines through the stages of the planning.
+void BM_PathCopy(benchmark::State& state) {
+  const Path path = MakeWindingPath(static_cast<int>(state.range(0)));
+  while (state.KeepRunning()) {
+    Path copy(path);
+    benchmark::DoNotOptimize(copy);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_PathProjectionScan)->Arg(1000)->Arg(4000)->Arg(16000);
+BENCHMARK(BM_PathGetProjection)->Arg(1000)->Arg(4000)->Arg(16000);
+BENCHMARK(BM_PathGetProjectionAlongTrajectory)
+    ->Arg(1000)
+    ->Arg(4000)
+    ->Arg(16000);
+BENCHMARK(BM_PathGetProjectionWithWarmStartS)
+    ->Arg(1000)
+    ->Arg(4000)
+    ->Arg(16000);
+BENCHMARK(BM_PathConstruction)
+    ->Arg(1000)
+    ->Arg(4000)
+    ->Arg(16000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PathCopy)
+    ->Arg(1000)
+    ->Arg(4000)
+    ->Arg(16000)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+}  // namespace hdmap
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
@@ -578,6 +578,81 @@ TEST(TestSuite, hdmap_jerky_path) {
   }
 }
 
+TEST(TestSuite, hdmap_path_projection_cells) {
+  const int kNumPaths = 20;
+  const int kCasesPerPath = 1000;
+  for (int path_id = 0; path_id < kNumPaths; ++path_id) {
+    const int num_segments = RandomInt(100, 1000);
+    const double segment_length = RandomDouble(0.2, 10.0);
+    const double max_turn = RandomDouble(0.0, 0.5);
+
+    // a winding path which may cross itself
+    std::vector<MapPathPoint> points;
+    double x = 0.0;
+    double y = 0.0;
+    double heading = RandomDouble(-M_PI, M_PI);
+    for (int i = 0; i <= num_segments; ++i) {
+      points.push_back(MakeMapPathPoint(x, y));
+      heading += RandomDouble(-max_turn, max_turn);
+      x += segment_length * cos(heading);
+      y += segment_length * sin(heading);
+    }
+    const Path path(points);
+
+    double prev_accumulate_s = 0.0;
+    for (int case_id = 0; case_id < kCasesPerPath; ++case_id) {
+      const auto& point = points[RandomInt(0, num_segments)];
+      const double radius = (case_id % 10 == 0 ? 500.0 : 20.0);
+      const Vec2d query(point.x() + RandomDouble(-radius, radius),
+                        point.y() + RandomDouble(-radius, radius));
+
+      // scanning all the segments
+      double expected_accumulate_s;
+      double expected_lateral;
+      double expected_distance;
+      EXPECT_TRUE(path.GetProjectionWithHueristicParams(
+          query, 0.0, path.length(), &expected_accumulate_s, &expected_lateral,
+          &expected_distance));
+
+      double accumulate_s;
+      double lateral;
+      double distance;
+      EXPECT_TRUE(
+          path.GetProjection(query, &accumulate_s, &lateral, &distance));
+      EXPECT_DOUBLE_EQ(expected_accumulate_s, accumulate_s);
+      EXPECT_DOUBLE_EQ(expected_lateral, lateral);
+      EXPECT_DOUBLE_EQ(expected_distance, distance);
+
+      EXPECT_TRUE(path.GetProjectionWithWarmStartS(
+          query, prev_accumulate_s, &accumulate_s, &lateral, &distance));
+      EXPECT_DOUBLE_EQ(expected_accumulate_s, accumulate_s);
+      EXPECT_DOUBLE_EQ(expected_lateral, lateral);
+      EXPECT_DOUBLE_EQ(expected_distance, distance);
+      prev_accumulate_s = accumulate_s;
+    }
+  }
+}
+
+TEST(TestSuite, hdmap_path_projection_cells_copy) {
+  std::vector<MapPathPoint> points;
+  for (int i = 0; i <= 100; ++i) {
+    points.push_back(MakeMapPathPoint(i * 1.0, 0.0));
+  }
+  Path path(points);
+  const Path copy = path;
+  // the copy keeps its cells when the original is replaced
+  path = Path({MakeMapPathPoint(0.0, 50.0), MakeMapPathPoint(1.0, 50.0)});
+
+  double accumulate_s;
+  double lateral;
+  double distance;
+  EXPECT_TRUE(copy.GetProjection({30.5, 2.0}, &accumulate_s, &lateral,
+                                 &distance));
+  EXPECT_NEAR(30.5, accumulate_s, 1e-6);
+  EXPECT_NEAR(2.0, lateral, 1e-6);
+  EXPECT_NEAR(2.0, distance, 1e-6);
+}
+
 TEST(TestSuite, hdmap_s_path) {
   std::vector<MapPathPoint> points;
   const double kRadius = 50.0;
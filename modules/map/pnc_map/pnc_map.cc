@@ -133,20 +133,21 @@ std::vector<routing::LaneWaypoint> PncMap::FutureRouteWaypoints() const {
 void PncMap::UpdateRoutingRange(int adc_index) {
   // Track routing range.
   if (range_start_ > adc_index || range_end_ < adc_index) {
-    range_lane_ids_.clear();
+    range_lane_indices_.clear();
     range_start_ = std::max(0, adc_index - 1);
     range_end_ = range_start_;
   }
   while (range_start_ + 1 < adc_index) {
-    range_lane_ids_.erase(route_indices_[range_start_].segment.lane->id().id());
+    range_lane_indices_.erase(
+        route_indices_[range_start_].segment.lane->index());
     ++range_start_;
   }
   while (range_end_ < static_cast<int>(route_indices_.size())) {
-    const auto &lane_id = route_indices_[range_end_].segment.lane->id().id();
-    if (range_lane_ids_.count(lane_id) != 0) {
+    const int lane_index = route_indices_[range_end_].segment.lane->index();
+    if (range_lane_indices_.count(lane_index) != 0) {
       break;
     }
-    range_lane_ids_.insert(lane_id);
+    range_lane_indices_.insert(lane_index);
     ++range_end_;
   }
 }
@@ -190,7 +191,7 @@ bool PncMap::UpdateVehicleState(const VehicleState &vehicle_state) {
     return false;
   }
 
-  int last_index = GetWaypointIndex(routing_waypoint_index_.back().waypoint);
+  int last_index = GetDestinationIndex();
   if (next_routing_waypoint_index_ == routing_waypoint_index_.size() - 1 ||
       (!stop_for_destination_ &&
        last_index == routing_waypoint_index_.back().index)) {
@@ -213,9 +214,12 @@ bool PncMap::IsNewRouting(const routing::RoutingResponse &prev,
 }
 
 bool PncMap::UpdateRoutingResponse(const routing::RoutingResponse &routing) {
-  range_lane_ids_.clear();
+  range_lane_indices_.clear();
   route_indices_.clear();
-  all_lane_ids_.clear();
+  all_lane_indices_.clear();
+  route_passages_.clear();
+  destination_forward_indices_.clear();
+  destination_backward_indices_.clear();
   for (int road_index = 0; road_index < routing.road_size(); ++road_index) {
     const auto &road_segment = routing.road(road_index);
     for (int passage_index = 0; passage_index < road_segment.passage_size();
@@ -223,7 +227,6 @@ bool PncMap::UpdateRoutingResponse(const routing::RoutingResponse &routing) {
       const auto &passage = road_segment.passage(passage_index);
       for (int lane_index = 0; lane_index < passage.segment_size();
            ++lane_index) {
-        all_lane_ids_.insert(passage.segment(lane_index).id());
         route_indices_.emplace_back();
         route_indices_.back().segment =
             ToLaneSegment(passage.segment(lane_index));
@@ -231,6 +234,7 @@ bool PncMap::UpdateRoutingResponse(const routing::RoutingResponse &routing) {
           AERROR << "Failed to get lane segment from passage.";
           return false;
         }
+        all_lane_indices_.insert(route_indices_.back().segment.lane->index());
         route_indices_.back().index = {road_index, passage_index, lane_index};
       }
     }
@@ -260,12 +264,81 @@ bool PncMap::UpdateRoutingResponse(const routing::RoutingResponse &routing) {
       ++i;
     }
   }
+  UpdateRoutePassages(routing);
+  UpdateDestinationIndices();
   routing_ = routing;
   adc_waypoint_ = LaneWaypoint();
   stop_for_destination_ = false;
   return true;
 }
 
+void PncMap::UpdateRoutePassages(const routing::RoutingResponse &routing) {
+  route_passages_.resize(routing.road_size());
+  for (int road_index = 0; road_index < routing.road_size(); ++road_index) {
+    const auto &road = routing.road(road_index);
+    auto &road_passages = route_passages_[road_index];
+    road_passages.resize(road.passage_size());
+    for (int i = 0; i < road.passage_size(); ++i) {
+      road_passages[i].is_valid =
+          PassageToSegments(road.passage(i), &road_passages[i].segments);
+    }
+    for (int i = 0; i < road.passage_size(); ++i) {
+      const auto &source_passage = road.passage(i);
+      if (!road_passages[i].is_valid ||
+          source_passage.change_lane_type() == routing::FORWARD) {
+        continue;
+      }
+      std::unordered_set<std::string> neighbor_lanes;
+      for (const auto &segment : road_passages[i].segments) {
+        const auto &neighbor_ids =
+            source_passage.change_lane_type() == routing::LEFT
+                ? segment.lane->lane().left_neighbor_forward_lane_id()
+                : segment.lane->lane().right_neighbor_forward_lane_id();
+        for (const auto &neighbor_id : neighbor_ids) {
+          neighbor_lanes.insert(neighbor_id.id());
+        }
+      }
+      for (int j = 0; j < road.passage_size(); ++j) {
+        if (j == i) {
+          continue;
+        }
+        for (const auto &segment : road.passage(j).segment()) {
+          if (neighbor_lanes.count(segment.id())) {
+            road_passages[i].neighbor_passages.push_back(j);
+            break;
+          }
+        }
+      }
+    }
+  }
+}
+
+void PncMap::UpdateDestinationIndices() {
+  const int num_route_indices = static_cast<int>(route_indices_.size());
+  destination_forward_indices_.assign(num_route_indices + 1,
+                                      num_route_indices);
+  destination_backward_indices_.assign(num_route_indices, -1);
+  if (routing_waypoint_index_.empty()) {
+    return;
+  }
+  const auto &destination = routing_waypoint_index_.back().waypoint;
+  for (int i = num_route_indices - 1; i >= 0; --i) {
+    destination_forward_indices_[i] =
+        RouteSegments::WithinLaneSegment(route_indices_[i].segment,
+                                         destination)
+            ? i
+            : destination_forward_indices_[i + 1];
+  }
+  for (int i = 0; i < num_route_indices; ++i) {
+    if (RouteSegments::WithinLaneSegment(route_indices_[i].segment,
+                                         destination)) {
+      destination_backward_indices_[i] = i;
+    } else if (i > 0) {
+      destination_backward_indices_[i] = destination_backward_indices_[i - 1];
+    }
+  }
+}
+
 const routing::RoutingResponse &PncMap::routing_response() const {
   return routing_;
 }
@@ -323,14 +396,39 @@ int PncMap::NextWaypointIndex(int index) const {
 
 int PncMap::GetWaypointIndex(const LaneWaypoint &waypoint) const {
   int forward_index = SearchForwardWaypointIndex(adc_route_index_, waypoint);
+  if (forward_index < static_cast<int>(route_indices_.size()) &&
+      (forward_index == adc_route_index_ ||
+       forward_index == adc_route_index_ + 1)) {
+    return forward_index;
+  }
+  return ChooseWaypointIndex(
+      forward_index, SearchBackwardWaypointIndex(adc_route_index_, waypoint));
+}
+
+int PncMap::GetDestinationIndex() const {
+  const int num_route_indices = static_cast<int>(route_indices_.size());
+  if (static_cast<int>(destination_backward_indices_.size()) !=
+          num_route_indices ||
+      adc_route_index_ >= num_route_indices) {
+    return GetWaypointIndex(routing_waypoint_index_.back().waypoint);
+  }
+  const int forward_index =
+      destination_forward_indices_[std::max(adc_route_index_, 0)];
+  const int backward_index =
+      adc_route_index_ < 0 ? -1
+                           : destination_backward_indices_[adc_route_index_];
+  return ChooseWaypointIndex(forward_index, backward_index);
+}
+
+int PncMap::ChooseWaypointIndex(const int forward_index,
+                                const int backward_index) const {
   if (forward_index >= static_cast<int>(route_indices_.size())) {
-    return SearchBackwardWaypointIndex(adc_route_index_, waypoint);
+    return backward_index;
   }
   if (forward_index == adc_route_index_ ||
       forward_index == adc_route_index_ + 1) {
     return forward_index;
   }
-  auto backward_index = SearchBackwardWaypointIndex(adc_route_index_, waypoint);
   if (backward_index < 0) {
     return forward_index;
   }
@@ -339,7 +437,7 @@ int PncMap::GetWaypointIndex(const LaneWaypoint &waypoint) const {
                                                   : forward_index;
 }
 
-bool PncMap::PassageToSegments(routing::Passage passage,
+bool PncMap::PassageToSegments(const routing::Passage &passage,
                                RouteSegments *segments) const {
   CHECK_NOTNULL(segments);
   segments->clear();
@@ -355,8 +453,11 @@ bool PncMap::PassageToSegments(routing::Passage passage,
   return !segments->empty();
 }
 
-std::vector<int> PncMap::GetNeighborPassages(const routing::RoadSegment &road,
+std::vector<int> PncMap::GetNeighborPassages(int road_index,
                                              int start_passage) const {
+  CHECK_GE(road_index, 0);
+  CHECK_LT(road_index, routing_.road_size());
+  const auto &road = routing_.road(road_index);
   CHECK_GE(start_passage, 0);
   CHECK_LE(start_passage, road.passage_size());
   std::vector<int> result;
@@ -368,49 +469,23 @@ std::vector<int> PncMap::GetNeighborPassages(const routing::RoadSegment &road,
   if (source_passage.can_exit()) {  // No need to change lane
     return result;
   }
-  RouteSegments source_segments;
-  if (!PassageToSegments(source_passage, &source_segments)) {
+  const auto &route_passage = route_passages_[road_index][start_passage];
+  if (!route_passage.is_valid) {
     AERROR << "Failed to convert passage to segments";
     return result;
   }
   if (next_routing_waypoint_index_ < routing_waypoint_index_.size() &&
-      source_segments.IsWaypointOnSegment(
+      route_passage.segments.IsWaypointOnSegment(
           routing_waypoint_index_[next_routing_waypoint_index_].waypoint)) {
     ADEBUG << "Need to pass next waypoint[" << next_routing_waypoint_index_
            << "] before change lane";
     return result;
   }
-  std::unordered_set<std::string> neighbor_lanes;
-  if (source_passage.change_lane_type() == routing::LEFT) {
-    for (const auto &segment : source_segments) {
-      for (const auto &left_id :
-           segment.lane->lane().left_neighbor_forward_lane_id()) {
-        neighbor_lanes.insert(left_id.id());
-      }
-    }
-  } else if (source_passage.change_lane_type() == routing::RIGHT) {
-    for (const auto &segment : source_segments) {
-      for (const auto &right_id :
-           segment.lane->lane().right_neighbor_forward_lane_id()) {
-        neighbor_lanes.insert(right_id.id());
-      }
-    }
-  }
-
-  for (int i = 0; i < road.passage_size(); ++i) {
-    if (i == start_passage) {
-      continue;
-    }
-    const auto &target_passage = road.passage(i);
-    for (const auto &segment : target_passage.segment()) {
-      if (neighbor_lanes.count(segment.id())) {
-        result.emplace_back(i);
-        break;
-      }
-    }
-  }
+  result.insert(result.end(), route_passage.neighbor_passages.begin(),
+                route_passage.neighbor_passages.end());
   return result;
 }
+
 bool PncMap::GetRouteSegments(const VehicleState &vehicle_state,
                               std::list<RouteSegments> *const route_segments) {
   double look_forward_distance =
@@ -440,14 +515,15 @@ bool PncMap::GetRouteSegments(const VehicleState &vehicle_state,
   const int passage_index = route_index[1];
   const auto &road = routing_.road(road_index);
   // Raw filter to find all neighboring passages
-  auto drive_passages = GetNeighborPassages(road, passage_index);
+  auto drive_passages = GetNeighborPassages(road_index, passage_index);
   for (const int index : drive_passages) {
     const auto &passage = road.passage(index);
-    RouteSegments segments;
-    if (!PassageToSegments(passage, &segments)) {
+    const auto &route_passage = route_passages_[road_index][index];
+    if (!route_passage.is_valid) {
       ADEBUG << "Failed to convert passage to lane segments.";
       continue;
     }
+    const auto &segments = route_passage.segments;
     PointENU nearest_point =
         MakePointENU(adc_state_.x(), adc_state_.y(), adc_state_.z());
     if (index == passage_index) {
@@ -517,19 +593,19 @@ bool PncMap::GetNearestPointFromRouting(const VehicleState &state,
   std::vector<LaneInfoConstPtr> valid_lanes;
   std::copy_if(lanes.begin(), lanes.end(), std::back_inserter(valid_lanes),
                [&](LaneInfoConstPtr ptr) {
-                 return range_lane_ids_.count(ptr->lane().id().id()) > 0;
+                 return range_lane_indices_.count(ptr->index()) > 0;
                });
   if (valid_lanes.empty()) {
     std::copy_if(lanes.begin(), lanes.end(), std::back_inserter(valid_lanes),
                  [&](LaneInfoConstPtr ptr) {
-                   return all_lane_ids_.count(ptr->lane().id().id()) > 0;
+                   return all_lane_indices_.count(ptr->index()) > 0;
                  });
   }
 
   // Get nearest_wayponints for current position
   double min_distance = std::numeric_limits<double>::infinity();
   for (const auto &lane : valid_lanes) {
-    if (range_lane_ids_.count(lane->id().id()) == 0) {
+    if (range_lane_indices_.count(lane->index()) == 0) {
       continue;
     }
     {
@@ -567,31 +643,33 @@ bool PncMap::GetNearestPointFromRouting(const VehicleState &state,
 }
 
 LaneInfoConstPtr PncMap::GetRouteSuccessor(LaneInfoConstPtr lane) const {
-  if (lane->lane().successor_id_size() == 0) {
+  const auto &successor_indices = lane->successor_indices();
+  if (successor_indices.empty()) {
     return nullptr;
   }
-  hdmap::Id preferred_id = lane->lane().successor_id(0);
-  for (const auto &lane_id : lane->lane().successor_id()) {
-    if (range_lane_ids_.count(lane_id.id()) != 0) {
-      preferred_id = lane_id;
+  int preferred_index = successor_indices.front();
+  for (const int lane_index : successor_indices) {
+    if (range_lane_indices_.count(lane_index) != 0) {
+      preferred_index = lane_index;
       break;
     }
   }
-  return hdmap_->GetLaneById(preferred_id);
+  return hdmap_->GetLaneByIndex(preferred_index);
 }
 
 LaneInfoConstPtr PncMap::GetRoutePredecessor(LaneInfoConstPtr lane) const {
-  if (lane->lane().predecessor_id_size() == 0) {
+  const auto &predecessor_indices = lane->predecessor_indices();
+  if (predecessor_indices.empty()) {
     return nullptr;
   }
-  hdmap::Id preferred_id = lane->lane().predecessor_id(0);
-  for (const auto &lane_id : lane->lane().predecessor_id()) {
-    if (range_lane_ids_.count(lane_id.id()) != 0) {
-      preferred_id = lane_id;
+  int preferred_index = predecessor_indices.front();
+  for (const int lane_index : predecessor_indices) {
+    if (range_lane_indices_.count(lane_index) != 0) {
+      preferred_index = lane_index;
       break;
     }
   }
-  return hdmap_->GetLaneById(preferred_id);
+  return hdmap_->GetLaneByIndex(preferred_index);
 }
 
 bool PncMap::ExtendSegments(const RouteSegments &segments,
@@ -92,10 +92,23 @@ class PncMap {
    */
   int GetWaypointIndex(const LaneWaypoint &waypoint) const;
 
+  /**
+   * @brief Find the waypoint index of the routing destination, the same as
+   * GetWaypointIndex but from the indices precomputed with the routing.
+   */
+  int GetDestinationIndex() const;
+
+  /**
+   * @brief Choose the waypoint index from the indices of the waypoint found by
+   * searching forward and backward from adc_route_index_.
+   */
+  int ChooseWaypointIndex(const int forward_index,
+                          const int backward_index) const;
+
   bool GetNearestPointFromRouting(const common::VehicleState &point,
                                   LaneWaypoint *waypoint) const;
 
-  bool PassageToSegments(routing::Passage passage,
+  bool PassageToSegments(const routing::Passage &passage,
                          RouteSegments *segments) const;
 
   bool ProjectToSegments(const common::PointENU &point_enu,
@@ -113,13 +126,20 @@ class PncMap {
 
   /**
    * Return the neighbor passages from passage with index start_passage on road.
-   * @param road the road information from routing
+   * @param road_index the road index in routing
    * @param start_passage the passsage index in road
    * @return all the indices of the neighboring passages, including
    * start_passage.
    */
-  std::vector<int> GetNeighborPassages(const routing::RoadSegment &road,
-                                       int start_passage) const;
+  std::vector<int> GetNeighborPassages(int road_index, int start_passage) const;
+
+  /**
+   * @brief Convert the passages of the routing to lane segments, and find the
+   * passages every passage may change lane into.
+   */
+  void UpdateRoutePassages(const routing::RoutingResponse &routing);
+
+  void UpdateDestinationIndices();
 
   /**
    * @brief convert a routing waypoint to lane waypoint
@@ -166,9 +186,28 @@ class PncMap {
   std::vector<RouteIndex> route_indices_;
   int range_start_ = 0;
   int range_end_ = 0;
-  // routing ids in range
-  std::unordered_set<std::string> range_lane_ids_;
-  std::unordered_set<std::string> all_lane_ids_;
+  // the interned lane handles of the routing lanes in range, and of all the
+  // routing lanes
+  std::unordered_set<int> range_lane_indices_;
+  std::unordered_set<int> all_lane_indices_;
+
+  /**
+   * A routing passage converted to lane segments once with the routing
+   */
+  struct RoutePassage {
+    RouteSegments segments;
+    bool is_valid = false;
+    // the other passages of the road with lanes next to the passage on the
+    // side of its lane change, in the order of the road
+    std::vector<int> neighbor_passages;
+  };
+  // the passages indexed by road index and passage index
+  std::vector<std::vector<RoutePassage>> route_passages_;
+  // for every route index, the first route index from it and the last route
+  // index up to it on which the destination is, route_indices_.size() and -1
+  // if not found
+  std::vector<int> destination_forward_indices_;
+  std::vector<int> destination_backward_indices_;
 
   /**
    * The routing request waypoints
@@ -218,6 +257,7 @@ class PncMap {
   FRIEND_TEST(PncMapTest, UpdateRouting);
   FRIEND_TEST(PncMapTest, GetNearestPointFromRouting);
   FRIEND_TEST(PncMapTest, UpdateWaypointIndex);
+  FRIEND_TEST(PncMapTest, GetDestinationIndex);
   FRIEND_TEST(PncMapTest, UpdateNextRoutingWaypointIndex);
   FRIEND_TEST(PncMapTest, GetNeighborPassages);
   FRIEND_TEST(PncMapTest, NextWaypointIndex);
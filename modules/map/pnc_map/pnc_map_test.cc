@@ -99,6 +99,20 @@ TEST_F(PncMapTest, UpdateWaypointIndex) {
   EXPECT_EQ(14, result);
 }
 
+TEST_F(PncMapTest, GetDestinationIndex) {
+  const int saved_adc_route_index = pnc_map_->adc_route_index_;
+  const auto& destination =
+      pnc_map_->routing_waypoint_index_.back().waypoint;
+  const int num_route_indices =
+      static_cast<int>(pnc_map_->route_indices_.size());
+  for (int i = -1; i < num_route_indices; ++i) {
+    pnc_map_->adc_route_index_ = i;
+    EXPECT_EQ(pnc_map_->GetWaypointIndex(destination),
+              pnc_map_->GetDestinationIndex());
+  }
+  pnc_map_->adc_route_index_ = saved_adc_route_index;
+}
+
 TEST_F(PncMapTest, GetRouteSegments_NoChangeLane) {
   auto lane = hdmap_.GetLaneById(hdmap::MakeMapId("9_1_-2"));
   ASSERT_TRUE(lane);
@@ -206,26 +220,25 @@ TEST_F(PncMapTest, SearchForwardIndex_SearchBackwardIndex) {
 }
 
 TEST_F(PncMapTest, GetNeighborPassages) {
-  const auto& road0 = routing_.road(0);
   {
-    auto result = pnc_map_->GetNeighborPassages(road0, 0);
+    auto result = pnc_map_->GetNeighborPassages(0, 0);
     EXPECT_EQ(2, result.size());
     EXPECT_EQ(0, result[0]);
     EXPECT_EQ(1, result[1]);
   }
   {
-    auto result = pnc_map_->GetNeighborPassages(road0, 1);
+    auto result = pnc_map_->GetNeighborPassages(0, 1);
     EXPECT_EQ(3, result.size());
     EXPECT_EQ(1, result[0]);
     EXPECT_EQ(0, result[1]);
     EXPECT_EQ(2, result[2]);
   }
   {
-    auto result = pnc_map_->GetNeighborPassages(road0, 2);
+    auto result = pnc_map_->GetNeighborPassages(0, 2);
     EXPECT_EQ(1, result.size());
   }
   {
-    auto result = pnc_map_->GetNeighborPassages(road0, 3);
+    auto result = pnc_map_->GetNeighborPassages(0, 3);
     EXPECT_EQ(1, result.size());
     EXPECT_EQ(3, result[0]);
   }
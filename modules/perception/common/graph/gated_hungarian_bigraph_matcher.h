@@ -26,6 +26,7 @@
 
 #include "modules/perception/common/graph/connected_component_analysis.h"
 #include "modules/perception/common/graph/hungarian_optimizer.h"
+#include "modules/perception/common/graph/sparse_assignment_optimizer.h"
 
 namespace apollo {
 namespace perception {
@@ -35,6 +36,11 @@ template <typename T>
 class GatedHungarianMatcher {
  public:
   enum class OptimizeFlag { OPTMAX, OPTMIN };
+  /* HUNGARIAN runs munkres on the dense local costs of each component,
+   * SPARSE runs shortest augmenting paths on the gated pairs only, which
+   * bounds the latency of large components in crowded scenes. Both find
+   * an optimal assignment, they may differ only among equal cost ones. */
+  enum class SolverType { HUNGARIAN, SPARSE };
 
   explicit GatedHungarianMatcher(int max_matching_size = 1000) {
     global_costs_.Reserve(max_matching_size, max_matching_size);
@@ -52,6 +58,9 @@ class GatedHungarianMatcher {
   const SecureMat<T>& global_costs() const { return global_costs_; }
   SecureMat<T>* mutable_global_costs() { return &global_costs_; }
 
+  void set_solver_type(SolverType solver_type) { solver_type_ = solver_type; }
+  SolverType solver_type() const { return solver_type_; }
+
   void Match(T cost_thresh, OptimizeFlag opt_flag,
              std::vector<std::pair<size_t, size_t>>* assignments,
              std::vector<size_t>* unassigned_rows,
@@ -97,9 +106,24 @@ class GatedHungarianMatcher {
   void OptimizeAdapter(
       std::vector<std::pair<size_t, size_t>>* local_assignments);
 
+  /* @brief: optimize the component on its gated pairs. the gain of a pair
+   * is how much better than bound_value its cost is, which is what the
+   * dense optimizer trades against the bound valued pairs.
+   * @params[IN] row_component: the set of index of rows of sub-graph
+   * @params[IN] col_component: the set of index of cols of sub-graph
+   * @params[OUT] local_assignments: assignments of local index */
+  void OptimizeSparse(
+      const std::vector<size_t>& row_component,
+      const std::vector<size_t>& col_component,
+      std::vector<std::pair<size_t, size_t>>* local_assignments);
+
   /* hungarian optimizer */
   HungarianOptimizer<T> optimizer_;
 
+  /* sparse optimizer */
+  SparseAssignmentOptimizer<T> sparse_optimizer_;
+  SolverType solver_type_ = SolverType::HUNGARIAN;
+
   /* global costs matrix */
   SecureMat<T> global_costs_;
 
@@ -241,12 +265,15 @@ void GatedHungarianMatcher<T>::OptimizeConnectedComponent(
     return;
   }
 
-  /* update local cost matrix */
-  UpdateGatingLocalCostsMat(row_component, col_component);
-
   /* get local assignments */
   std::vector<std::pair<size_t, size_t>> local_assignments;
-  OptimizeAdapter(&local_assignments);
+  if (solver_type_ == SolverType::SPARSE) {
+    OptimizeSparse(row_component, col_component, &local_assignments);
+  } else {
+    /* update local cost matrix */
+    UpdateGatingLocalCostsMat(row_component, col_component);
+    OptimizeAdapter(&local_assignments);
+  }
 
   /* parse local assginments into global ones */
   for (size_t i = 0; i < local_assignments.size(); ++i) {
@@ -319,6 +346,28 @@ void GatedHungarianMatcher<T>::OptimizeAdapter(
   }
 }
 
+template <typename T>
+void GatedHungarianMatcher<T>::OptimizeSparse(
+    const std::vector<size_t>& row_component,
+    const std::vector<size_t>& col_component,
+    std::vector<std::pair<size_t, size_t>>* local_assignments) {
+  CHECK_NOTNULL(local_assignments);
+  sparse_optimizer_.Reset(row_component.size(), col_component.size());
+  for (size_t i = 0; i < row_component.size(); ++i) {
+    for (size_t j = 0; j < col_component.size(); ++j) {
+      const T& current_cost =
+          global_costs_(row_component[i], col_component[j]);
+      if (!is_valid_cost_(current_cost)) {
+        continue;
+      }
+      T gain = opt_flag_ == OptimizeFlag::OPTMIN ? bound_value_ - current_cost
+                                                 : current_cost - bound_value_;
+      sparse_optimizer_.AddEdge(i, j, gain);
+    }
+  }
+  sparse_optimizer_.Maximize(local_assignments);
+}
+
 }  // namespace common
 }  // namespace perception
 }  // namespace apollo
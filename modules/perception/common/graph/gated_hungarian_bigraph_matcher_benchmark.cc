@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+// Benchmark of GatedHungarianMatcher on synthetic crowded scenes: tracks
+// stand on a grid two meters apart, e.g. a jam over several lanes, and the
+// objects are the tracks moved by noise with some misses and new objects.
+// With a gate of four meters every scene is a single large component.
+
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/perception/common/graph/gated_hungarian_bigraph_matcher.h"
+
+namespace apollo {
+namespace perception {
+namespace common {
+namespace {
+
+const float kCostThresh = 4.0f;
+const float kBoundValue = 100.0f;
+const int kNrScenes = 8;
+
+typedef std::vector<std::vector<float>> Scene;
+
+Scene MakeCrowdedScene(int nr_tracks, unsigned int seed) {
+  const float kSpacing = 2.0f;
+  const int kNrLanes = 8;
+  std::mt19937 rng(seed);
+  std::normal_distribution<float> noise(0.0f, 0.5f);
+  std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+  std::vector<std::pair<float, float>> tracks;
+  std::vector<std::pair<float, float>> objects;
+  for (int i = 0; i < nr_tracks; ++i) {
+    float x = static_cast<float>(i / kNrLanes) * kSpacing;
+    float y = static_cast<float>(i % kNrLanes) * kSpacing;
+    tracks.emplace_back(x, y);
+    // 5% of the tracks are missed, 5% of the objects are new
+    if (uniform(rng) > 0.05f) {
+      objects.emplace_back(x + noise(rng), y + noise(rng));
+    }
+    if (uniform(rng) < 0.05f) {
+      objects.emplace_back(x + kSpacing * uniform(rng),
+                           y + kSpacing * uniform(rng));
+    }
+  }
+  Scene costs(tracks.size(), std::vector<float>(objects.size()));
+  for (size_t i = 0; i < tracks.size(); ++i) {
+    for (size_t j = 0; j < objects.size(); ++j) {
+      float dx = tracks[i].first - objects[j].first;
+      float dy = tracks[i].second - objects[j].second;
+      costs[i][j] = std::sqrt(dx * dx + dy * dy);
+    }
+  }
+  return costs;
+}
+
+// state.range(0): number of tracks, state.range(1): 1 for the sparse solver
+void BM_GatedHungarianMatch(benchmark::State &state) {
+  const int nr_tracks = static_cast<int>(state.range(0));
+  std::vector<Scene> scenes;
+  for (int i = 0; i < kNrScenes; ++i) {
+    scenes.push_back(MakeCrowdedScene(nr_tracks, i));
+  }
+  GatedHungarianMatcher<float> matcher(1000);
+  if (state.range(1) != 0) {
+    matcher.set_solver_type(GatedHungarianMatcher<float>::SolverType::SPARSE);
+  }
+  SecureMat<float> *global_costs = matcher.mutable_global_costs();
+  std::vector<std::pair<size_t, size_t>> assignments;
+  std::vector<size_t> unassigned_rows;
+  std::vector<size_t> unassigned_cols;
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    // filling the costs is part of every association
+    const Scene &scene = scenes[i++ % scenes.size()];
+    global_costs->Resize(scene.size(), scene[0].size());
+    for (size_t row = 0; row < scene.size(); ++row) {
+      for (size_t col = 0; col < scene[row].size(); ++col) {
+        (*global_costs)(row, col) = scene[row][col];
+      }
+    }
+    matcher.Match(kCostThresh, kBoundValue,
+                  GatedHungarianMatcher<float>::OptimizeFlag::OPTMIN,
+                  &assignments, &unassigned_rows, &unassigned_cols);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_GatedHungarianMatch)
+    ->Args({50, 0})
+    ->Args({50, 1})
+    ->Args({100, 0})
+    ->Args({100, 1})
+    ->Args({200, 0})
+    ->Args({200, 1})
+    ->Args({400, 0})
+    ->Args({400, 1})
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace common
+}  // namespace perception
+}  // namespace apollo
+
+int main(int argc, char **argv) {
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
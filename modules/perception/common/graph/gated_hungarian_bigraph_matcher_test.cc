@@ -16,6 +16,8 @@
 
 #include "modules/perception/common/graph/gated_hungarian_bigraph_matcher.h"
 
+#include <random>
+
 #include "Eigen/Core"
 #include "gtest/gtest.h"
 
@@ -551,6 +553,54 @@ TEST_F(GatedHungarianMatcherTest, test_Match_Maximize) {
   EXPECT_EQ(0, unassigned_rows.size());
 }
 
+/* the sparse solver reaches the optimum of the dense one, random costs have
+ * no ties so the assignments are the same */
+TEST_F(GatedHungarianMatcherTest, test_Match_Sparse) {
+  GatedHungarianMatcher<float> sparse_optimizer(1000);
+  sparse_optimizer.set_solver_type(
+      GatedHungarianMatcher<float>::SolverType::SPARSE);
+  EXPECT_TRUE(sparse_optimizer.solver_type() ==
+              GatedHungarianMatcher<float>::SolverType::SPARSE);
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> cost_dist(0.f, 10.f);
+  std::vector<std::pair<size_t, size_t>> assignments;
+  std::vector<std::pair<size_t, size_t>> sparse_assignments;
+  std::vector<size_t> unassigned_rows;
+  std::vector<size_t> sparse_unassigned_rows;
+  std::vector<size_t> unassigned_cols;
+  std::vector<size_t> sparse_unassigned_cols;
+  const size_t sizes[][2] = {{1, 1}, {5, 3}, {3, 5}, {20, 20}, {37, 29}};
+  for (const auto& size : sizes) {
+    for (auto opt_flag : {GatedHungarianMatcher<float>::OptimizeFlag::OPTMIN,
+                          GatedHungarianMatcher<float>::OptimizeFlag::OPTMAX}) {
+      bool minimize =
+          opt_flag == GatedHungarianMatcher<float>::OptimizeFlag::OPTMIN;
+      float cost_thresh = minimize ? 3.f : 7.f;
+      float bound_value = minimize ? 10.f : 0.f;
+      SecureMat<float>* global_costs = optimizer_->mutable_global_costs();
+      SecureMat<float>* sparse_costs = sparse_optimizer.mutable_global_costs();
+      global_costs->Resize(size[0], size[1]);
+      sparse_costs->Resize(size[0], size[1]);
+      for (size_t i = 0; i < size[0]; ++i) {
+        for (size_t j = 0; j < size[1]; ++j) {
+          (*global_costs)(i, j) = cost_dist(rng);
+          (*sparse_costs)(i, j) = (*global_costs)(i, j);
+        }
+      }
+      optimizer_->Match(cost_thresh, bound_value, opt_flag, &assignments,
+                        &unassigned_rows, &unassigned_cols);
+      sparse_optimizer.Match(cost_thresh, bound_value, opt_flag,
+                             &sparse_assignments, &sparse_unassigned_rows,
+                             &sparse_unassigned_cols);
+      std::sort(assignments.begin(), assignments.end());
+      std::sort(sparse_assignments.begin(), sparse_assignments.end());
+      EXPECT_EQ(assignments, sparse_assignments);
+      EXPECT_EQ(unassigned_rows, sparse_unassigned_rows);
+      EXPECT_EQ(unassigned_cols, sparse_unassigned_cols);
+    }
+  }
+}
+
 }  // namespace common
 }  // namespace perception
 }  // namespace apollo
@@ -0,0 +1,261 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace apollo {
+namespace perception {
+namespace common {
+
+/* Maximum weight bipartite matching on a sparse graph, solved by the
+ * shortest augmenting paths of Jonker-Volgenant. Only the given edges can be
+ * matched and a row or col may stay unmatched with a gain of zero, so every
+ * row owns a private dummy col of zero cost. The search of a row stops at
+ * its dummy col, and the work per row is bounded by the edges reachable
+ * with a better gain instead of by the size of the whole matrix. */
+template <typename T>
+class SparseAssignmentOptimizer {
+ public:
+  SparseAssignmentOptimizer() = default;
+  ~SparseAssignmentOptimizer() = default;
+
+  /* Clear the edges and set the size of the graph. */
+  void Reset(size_t rows_num, size_t cols_num);
+
+  /* Add an edge of positive gain, edges of non-positive gain never help
+   * and are ignored. */
+  void AddEdge(size_t row, size_t col, T gain);
+
+  /* Find the matching of maximum total gain. Return the matched pairs
+   * (row, col) in the order of rows. */
+  void Maximize(std::vector<std::pair<size_t, size_t>>* assignments);
+
+ private:
+  struct Edge {
+    size_t row = 0;
+    size_t col = 0;
+    T cost = 0;
+  };
+
+  /* sort the edges by row into compressed rows */
+  void BuildRows();
+
+  /* Augment the matching from the free row cur_row along the shortest path
+   * of reduced costs, update the potentials to keep them feasible. */
+  void Augment(size_t cur_row);
+
+  /* Relax the cols adjacent to row, min_cost is the path cost to row */
+  void Relax(size_t row, T min_cost);
+
+  static constexpr T kInfinity = std::numeric_limits<T>::max();
+  static const int kNotAssigned = -1;
+
+  size_t rows_num_ = 0;
+  size_t cols_num_ = 0;
+  std::vector<Edge> edges_;
+
+  /* compressed rows, the edges of row i are
+   * [row_starts_[i], row_starts_[i + 1]) of row_cols_ and row_costs_ */
+  std::vector<size_t> row_starts_;
+  std::vector<size_t> row_cols_;
+  std::vector<T> row_costs_;
+
+  /* dual potentials and matching, cols_num_ + i is the dummy col of row i */
+  std::vector<T> row_potentials_;
+  std::vector<T> col_potentials_;
+  std::vector<int> col_of_row_;
+  std::vector<int> row_of_col_;
+
+  /* shortest path search, reset only for the touched cols after each row */
+  std::vector<T> path_costs_;
+  std::vector<size_t> path_rows_;
+  std::vector<bool> scanned_;
+  std::vector<size_t> touched_cols_;
+  std::vector<size_t> scanned_cols_;
+  std::vector<size_t> visited_rows_;
+  /* candidate cols ordered by path cost, free cols first on ties */
+  std::vector<std::pair<T, size_t>> heap_;
+};  // class SparseAssignmentOptimizer
+
+template <typename T>
+constexpr T SparseAssignmentOptimizer<T>::kInfinity;
+template <typename T>
+const int SparseAssignmentOptimizer<T>::kNotAssigned;
+
+template <typename T>
+void SparseAssignmentOptimizer<T>::Reset(size_t rows_num, size_t cols_num) {
+  rows_num_ = rows_num;
+  cols_num_ = cols_num;
+  edges_.clear();
+}
+
+template <typename T>
+void SparseAssignmentOptimizer<T>::AddEdge(size_t row, size_t col, T gain) {
+  if (row >= rows_num_ || col >= cols_num_ || !(gain > 0)) {
+    return;
+  }
+  Edge edge;
+  edge.row = row;
+  edge.col = col;
+  edge.cost = -gain;
+  edges_.push_back(edge);
+}
+
+template <typename T>
+void SparseAssignmentOptimizer<T>::BuildRows() {
+  row_starts_.assign(rows_num_ + 1, 0);
+  for (const auto& edge : edges_) {
+    ++row_starts_[edge.row + 1];
+  }
+  for (size_t i = 0; i < rows_num_; ++i) {
+    row_starts_[i + 1] += row_starts_[i];
+  }
+  row_cols_.resize(edges_.size());
+  row_costs_.resize(edges_.size());
+  std::vector<size_t> next(row_starts_.begin(), row_starts_.end() - 1);
+  for (const auto& edge : edges_) {
+    size_t pos = next[edge.row]++;
+    row_cols_[pos] = edge.col;
+    row_costs_[pos] = edge.cost;
+  }
+}
+
+template <typename T>
+void SparseAssignmentOptimizer<T>::Maximize(
+    std::vector<std::pair<size_t, size_t>>* assignments) {
+  assignments->clear();
+  BuildRows();
+  const size_t all_cols_num = cols_num_ + rows_num_;
+  row_potentials_.assign(rows_num_, 0);
+  col_potentials_.assign(all_cols_num, 0);
+  col_of_row_.assign(rows_num_, kNotAssigned);
+  row_of_col_.assign(all_cols_num, kNotAssigned);
+  path_costs_.assign(all_cols_num, kInfinity);
+  path_rows_.assign(all_cols_num, 0);
+  scanned_.assign(all_cols_num, false);
+  for (size_t row = 0; row < rows_num_; ++row) {
+    // rows without edges keep their dummy col
+    if (row_starts_[row] == row_starts_[row + 1]) {
+      continue;
+    }
+    Augment(row);
+  }
+  for (size_t row = 0; row < rows_num_; ++row) {
+    int col = col_of_row_[row];
+    if (col != kNotAssigned && static_cast<size_t>(col) < cols_num_) {
+      assignments->push_back(std::make_pair(row, static_cast<size_t>(col)));
+    }
+  }
+}
+
+template <typename T>
+void SparseAssignmentOptimizer<T>::Relax(size_t row, T min_cost) {
+  auto relax_col = [&](size_t col, T cost) {
+    if (scanned_[col]) {
+      return;
+    }
+    T reduced = min_cost + cost - row_potentials_[row] - col_potentials_[col];
+    if (reduced < path_costs_[col]) {
+      if (path_costs_[col] == kInfinity) {
+        touched_cols_.push_back(col);
+      }
+      path_costs_[col] = reduced;
+      path_rows_[col] = row;
+      // the lowest pair on the heap is the next col, a free col is preferred
+      // on ties since it ends the search
+      heap_.emplace_back(reduced, row_of_col_[col] == kNotAssigned
+                                      ? col
+                                      : col + row_of_col_.size());
+      std::push_heap(heap_.begin(), heap_.end(),
+                     std::greater<std::pair<T, size_t>>());
+    }
+  };
+  for (size_t k = row_starts_[row]; k < row_starts_[row + 1]; ++k) {
+    relax_col(row_cols_[k], row_costs_[k]);
+  }
+  relax_col(cols_num_ + row, 0);
+}
+
+template <typename T>
+void SparseAssignmentOptimizer<T>::Augment(size_t cur_row) {
+  const size_t all_cols_num = row_of_col_.size();
+  T min_cost = 0;
+  size_t row = cur_row;
+  size_t sink = all_cols_num;
+  heap_.clear();
+  while (sink == all_cols_num) {
+    visited_rows_.push_back(row);
+    Relax(row, min_cost);
+    // the dummy col of cur_row is always reachable, so the heap never runs
+    // out before a free col is found
+    size_t col = 0;
+    do {
+      std::pop_heap(heap_.begin(), heap_.end(),
+                    std::greater<std::pair<T, size_t>>());
+      col = heap_.back().second % all_cols_num;
+      min_cost = heap_.back().first;
+      heap_.pop_back();
+    } while (scanned_[col] || min_cost != path_costs_[col]);
+    scanned_[col] = true;
+    scanned_cols_.push_back(col);
+    if (row_of_col_[col] == kNotAssigned) {
+      sink = col;
+    } else {
+      row = static_cast<size_t>(row_of_col_[col]);
+    }
+  }
+
+  // update the potentials of the rows and cols on the shortest path tree
+  row_potentials_[cur_row] += min_cost;
+  for (size_t i : visited_rows_) {
+    if (i != cur_row) {
+      row_potentials_[i] += min_cost - path_costs_[col_of_row_[i]];
+    }
+  }
+  for (size_t j : scanned_cols_) {
+    col_potentials_[j] -= min_cost - path_costs_[j];
+  }
+
+  // augment along the path from the sink back to cur_row
+  size_t col = sink;
+  while (true) {
+    size_t i = path_rows_[col];
+    row_of_col_[col] = static_cast<int>(i);
+    int prev_col = col_of_row_[i];
+    col_of_row_[i] = static_cast<int>(col);
+    if (i == cur_row) {
+      break;
+    }
+    col = static_cast<size_t>(prev_col);
+  }
+
+  for (size_t j : touched_cols_) {
+    path_costs_[j] = kInfinity;
+    scanned_[j] = false;
+  }
+  touched_cols_.clear();
+  scanned_cols_.clear();
+  visited_rows_.clear();
+}
+
+}  // namespace common
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,131 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/common/graph/sparse_assignment_optimizer.h"
+
+#include <random>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace common {
+
+/* best total gain over all matchings by enumerating the col of each row */
+float BruteForceGain(const std::vector<std::vector<float>>& gains,
+                     size_t row, std::vector<bool>* used_cols) {
+  if (row == gains.size()) {
+    return 0.f;
+  }
+  float best = BruteForceGain(gains, row + 1, used_cols);
+  for (size_t col = 0; col < used_cols->size(); ++col) {
+    if ((*used_cols)[col] || gains[row][col] <= 0.f) {
+      continue;
+    }
+    (*used_cols)[col] = true;
+    best = std::max(best, gains[row][col] +
+                              BruteForceGain(gains, row + 1, used_cols));
+    (*used_cols)[col] = false;
+  }
+  return best;
+}
+
+TEST(SparseAssignmentOptimizerTest, test_Maximize) {
+  SparseAssignmentOptimizer<float> optimizer;
+  std::vector<std::pair<size_t, size_t>> assignments;
+
+  /* empty graph */
+  optimizer.Reset(3, 2);
+  optimizer.Maximize(&assignments);
+  EXPECT_EQ(0, assignments.size());
+
+  /* 0 -> 1 is better alone, but 0 -> 0 and 1 -> 1 gain more together
+   * gains:
+   * 2, 3
+   * -, 2
+   * and the non-positive and out of range edges are ignored */
+  optimizer.Reset(2, 2);
+  optimizer.AddEdge(0, 1, 3.f);
+  optimizer.AddEdge(1, 1, 2.f);
+  optimizer.AddEdge(0, 0, 2.f);
+  optimizer.AddEdge(1, 0, -1.f);
+  optimizer.AddEdge(2, 0, 5.f);
+  optimizer.Maximize(&assignments);
+  ASSERT_EQ(2, assignments.size());
+  EXPECT_EQ(0, assignments[0].first);
+  EXPECT_EQ(0, assignments[0].second);
+  EXPECT_EQ(1, assignments[1].first);
+  EXPECT_EQ(1, assignments[1].second);
+
+  /* leaving a row unmatched is better than a long chain of small gains
+   * gains:
+   * 10, 9
+   *  -, 0.5 */
+  optimizer.Reset(2, 2);
+  optimizer.AddEdge(0, 0, 10.f);
+  optimizer.AddEdge(0, 1, 9.f);
+  optimizer.AddEdge(1, 1, 0.5f);
+  optimizer.Maximize(&assignments);
+  ASSERT_EQ(2, assignments.size());
+  EXPECT_EQ(0, assignments[0].second);
+  EXPECT_EQ(1, assignments[1].second);
+
+  optimizer.Reset(2, 2);
+  optimizer.AddEdge(0, 0, 1.f);
+  optimizer.AddEdge(1, 0, 10.f);
+  optimizer.AddEdge(1, 1, 0.5f);
+  optimizer.Maximize(&assignments);
+  ASSERT_EQ(1, assignments.size());
+  EXPECT_EQ(1, assignments[0].first);
+  EXPECT_EQ(0, assignments[0].second);
+}
+
+TEST(SparseAssignmentOptimizerTest, test_Maximize_random) {
+  SparseAssignmentOptimizer<float> optimizer;
+  std::vector<std::pair<size_t, size_t>> assignments;
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<float> gain_dist(-5.f, 5.f);
+  for (int trial = 0; trial < 200; ++trial) {
+    size_t rows_num = 1 + rng() % 6;
+    size_t cols_num = 1 + rng() % 6;
+    std::vector<std::vector<float>> gains(rows_num,
+                                          std::vector<float>(cols_num, 0.f));
+    optimizer.Reset(rows_num, cols_num);
+    for (size_t i = 0; i < rows_num; ++i) {
+      for (size_t j = 0; j < cols_num; ++j) {
+        gains[i][j] = gain_dist(rng);
+        optimizer.AddEdge(i, j, gains[i][j]);
+      }
+    }
+    optimizer.Maximize(&assignments);
+    std::vector<bool> used_rows(rows_num, false);
+    std::vector<bool> used_cols(cols_num, false);
+    float gain = 0.f;
+    for (const auto& assignment : assignments) {
+      EXPECT_FALSE(used_rows[assignment.first]);
+      EXPECT_FALSE(used_cols[assignment.second]);
+      used_rows[assignment.first] = true;
+      used_cols[assignment.second] = true;
+      EXPECT_GT(gains[assignment.first][assignment.second], 0.f);
+      gain += gains[assignment.first][assignment.second];
+    }
+    used_cols.assign(cols_num, false);
+    EXPECT_NEAR(BruteForceGain(gains, 0, &used_cols), gain, 1e-4);
+  }
+}
+
+}  // namespace common
+}  // namespace perception
+}  // namespace apollo
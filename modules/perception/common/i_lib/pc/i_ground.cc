@@ -15,8 +15,11 @@
  *****************************************************************************/
 #include "modules/perception/common/i_lib/pc/i_ground.h"
 
+#include <smmintrin.h>
+
 #include <algorithm>
 #include <cfloat>
+#include <functional>
 
 namespace apollo {
 namespace perception {
@@ -44,6 +47,9 @@ void PlaneFitGroundDetectorParam::SetDefault() {
   nr_ransac_iter_threshold = 32;
   candidate_filter_threshold = 1.0f;  // 1 meter
   nr_smooth_iter = 1;
+  enable_parallel_fit = false;
+  nr_fit_threads = 4;
+  enable_warm_start = false;
 }
 
 bool PlaneFitGroundDetectorParam::Validate() const {
@@ -53,7 +59,8 @@ bool PlaneFitGroundDetectorParam::Validate() const {
       nr_inliers_min_threshold == 0 || nr_ransac_iter_threshold == 0 ||
       roi_region_rad_x <= 0.f || roi_region_rad_y <= 0.f ||
       roi_region_rad_z <= 0.f ||
-      planefit_dist_threshold_near > planefit_dist_threshold_far) {
+      planefit_dist_threshold_near > planefit_dist_threshold_far ||
+      (enable_parallel_fit && nr_fit_threads == 0)) {
     std::cerr << "Invalid ground detector parameters... " << std::endl;
     return false;
   }
@@ -91,6 +98,67 @@ int PlaneFitPointCandIndices::Prune(unsigned int min_nr_samples,
   return static_cast<int>(indices.size());
 }
 
+// Count the samples (x, y, z stored continuously) within dist_thre to the unit
+// norm plane, four samples at a time. The distances of the inliers are
+// accumulated to fit_cost if it is not nullptr.
+static int ICountPlaneInliers(const float *plane, const float *threeds,
+                              int nr_samples, float dist_thre,
+                              float *fit_cost) {
+  int i = 0;
+  int nr_inliers = 0;
+  float ptp_dist = 0.0f;
+  float cost = 0.0f;
+  int nr_loops = (nr_samples >> 2);
+  int nr_fast_processed = (nr_loops << 2);
+  const float *cptr = threeds;
+
+  __m128 v_a = _mm_set_ps1(plane[0]);
+  __m128 v_b = _mm_set_ps1(plane[1]);
+  __m128 v_c = _mm_set_ps1(plane[2]);
+  __m128 v_d = _mm_set_ps1(plane[3]);
+  __m128 v_thre = _mm_set_ps1(dist_thre);
+  __m128 v_sign_mask = _mm_set_ps1(-0.0f);
+  __m128 v_cost = _mm_setzero_ps();
+  __m128i iv_nr_inliers = _mm_setzero_si128();
+  __m128 v_xs, v_ys, v_zs, v_dist, v_is_inlier;
+
+  for (i = 0; i < nr_loops; ++i, cptr += 12) {
+    v_xs = _mm_setr_ps(cptr[0], cptr[3], cptr[6], cptr[9]);
+    v_ys = _mm_setr_ps(cptr[1], cptr[4], cptr[7], cptr[10]);
+    v_zs = _mm_setr_ps(cptr[2], cptr[5], cptr[8], cptr[11]);
+    // same evaluation order as IPlaneToPointDistanceWUnitNorm
+    v_dist = _mm_add_ps(_mm_mul_ps(v_a, v_xs), _mm_mul_ps(v_b, v_ys));
+    v_dist = _mm_add_ps(v_dist, _mm_mul_ps(v_c, v_zs));
+    v_dist = _mm_add_ps(v_dist, v_d);
+    v_dist = _mm_andnot_ps(v_sign_mask, v_dist);
+    v_is_inlier = _mm_cmplt_ps(v_dist, v_thre);
+    // the comparison mask is -1 for inliers
+    iv_nr_inliers =
+        _mm_sub_epi32(iv_nr_inliers, _mm_castps_si128(v_is_inlier));
+    v_cost = _mm_add_ps(v_cost, _mm_and_ps(v_is_inlier, v_dist));
+  }
+
+  nr_inliers = _mm_extract_epi32(iv_nr_inliers, 0) +
+               _mm_extract_epi32(iv_nr_inliers, 1) +
+               _mm_extract_epi32(iv_nr_inliers, 2) +
+               _mm_extract_epi32(iv_nr_inliers, 3);
+  v_cost = _mm_hadd_ps(v_cost, v_cost);
+  v_cost = _mm_hadd_ps(v_cost, v_cost);
+  cost = _mm_cvtss_f32(v_cost);
+
+  for (i = nr_fast_processed; i < nr_samples; ++i, cptr += 3) {
+    ptp_dist = IPlaneToPointDistanceWUnitNorm(plane, cptr);
+    if (ptp_dist < dist_thre) {
+      nr_inliers++;
+      cost += ptp_dist;
+    }
+  }
+  if (fit_cost != nullptr) {
+    *fit_cost = cost;
+  }
+  return nr_inliers;
+}
+
 PlaneFitGroundDetector::PlaneFitGroundDetector(
     const PlaneFitGroundDetectorParam &param)
     : BaseGroundDetector(param) {
@@ -258,10 +326,44 @@ bool PlaneFitGroundDetector::Init() {
   }
   // compute thresholds
   ComputeAdaptiveThreshold();
+  // previous frame planes:
+  prev_ground_planes_ =
+      IAlloc2<GroundPlaneLiDAR>(param_.nr_grids_coarse, param_.nr_grids_coarse);
+  if (!prev_ground_planes_) {
+    return false;
+  }
+  has_prev_ground_planes_ = false;
+  // parallel fit workers, each with its own ransac memory:
+  fit_workers_.clear();
+  for (auto &threeds : worker_threeds_) {
+    IFreeAligned<float>(&threeds);
+  }
+  worker_threeds_.clear();
+  worker_nr_grids_.clear();
+  if (param_.enable_parallel_fit) {
+    worker_threeds_.assign(param_.nr_fit_threads, nullptr);
+    worker_nr_grids_.assign(param_.nr_fit_threads, 0);
+    for (unsigned int i = 0; i < param_.nr_fit_threads; ++i) {
+      worker_threeds_[i] =
+          IAllocAligned<float>(param_.nr_samples_max_threshold * dim_point_, 4);
+      if (!worker_threeds_[i]) {
+        return false;
+      }
+      fit_workers_.emplace_back(new lib::ThreadWorker);
+      fit_workers_.back()->Bind(
+          std::bind(&PlaneFitGroundDetector::FitWorker, this, i));
+      fit_workers_.back()->Start();
+    }
+  }
   return true;
 }
 
 void PlaneFitGroundDetector::CleanUp() {
+  // stop the workers before releasing the memory they use
+  fit_workers_.clear();
+  for (auto &threeds : worker_threeds_) {
+    IFreeAligned<float>(&threeds);
+  }
   if (vg_fine_) {
     delete vg_fine_;
   }
@@ -279,6 +381,7 @@ void PlaneFitGroundDetector::CleanUp() {
   IFreeAligned<int>(&sampled_indices_);
   IFree2<float>(&pf_thresholds_);
   IFree<std::pair<int, int> >(&order_table_);
+  IFree2<GroundPlaneLiDAR>(&prev_ground_planes_);
 }
 
 int PlaneFitGroundDetector::CompareZ(const float *point_cloud,
@@ -616,7 +719,9 @@ int PlaneFitGroundDetector::FitGrid(const float *point_cloud,
                                     GroundPlaneLiDAR *groundplane,
                                     unsigned int nr_points,
                                     unsigned int nr_point_element,
-                                    float dist_thre) {
+                                    float dist_thre,
+                                    const GroundPlaneLiDAR *warm_start,
+                                    float *threeds) {
   // initialize the best plane
   groundplane->ForceInvalid();
   // not enough samples, failed and return
@@ -629,8 +734,8 @@ int PlaneFitGroundDetector::FitGrid(const float *point_cloud,
   float fit_cost_best = dist_thre;
   int nr_inliers = 0;
   int nr_inliers_best = -1;
+  int nr_iter = param_.nr_ransac_iter_threshold;
   int i = 0;
-  int j = 0;
   int rseed = I_DEFAULT_SEED;
   int indices_trial[] = {0, 0, 0};
   int nr_samples = candi->Prune(param_.nr_samples_min_threshold,
@@ -641,19 +746,36 @@ int PlaneFitGroundDetector::FitGrid(const float *point_cloud,
   float samples[9];
   // copy 3D points
   float *psrc = nullptr;
-  float *pdst = pf_threeds_;
+  float *pdst = threeds;
   for (i = 0; i < nr_samples; ++i) {
     assert((*candi)[i] < static_cast<int>(nr_points));
     ICopy3(point_cloud + (nr_point_element * (*candi)[i]), pdst);
     pdst += dim_point_;
   }
+  // vote for the warm start plane first, the ransac is skipped if it already
+  // has enough inliers
+  if (warm_start != nullptr && warm_start->IsValid()) {
+    plane = *warm_start;
+    nr_inliers =
+        ICountPlaneInliers(plane.params, threeds, nr_samples, dist_thre,
+                           &fit_cost);
+    if (nr_inliers > 0) {
+      plane.SetNrSupport(nr_inliers);
+      nr_inliers_best = nr_inliers;
+      fit_cost_best = fit_cost / static_cast<float>(nr_inliers);
+      *groundplane = plane;
+      if (nr_inliers_best > nr_inliers_termi) {
+        nr_iter = 0;
+      }
+    }
+  }
   // generate plane hypothesis and vote
-  for (i = 0; i < param_.nr_ransac_iter_threshold; ++i) {
+  for (i = 0; i < nr_iter; ++i) {
     IRandomSample(indices_trial, 3, nr_samples, &rseed);
     IScale3(indices_trial, dim_point_);
-    ICopy3(pf_threeds_ + indices_trial[0], samples);
-    ICopy3(pf_threeds_ + indices_trial[1], samples + 3);
-    ICopy3(pf_threeds_ + indices_trial[2], samples + 6);
+    ICopy3(threeds + indices_trial[0], samples);
+    ICopy3(threeds + indices_trial[1], samples + 3);
+    ICopy3(threeds + indices_trial[2], samples + 6);
     IPlaneFitDestroyed(samples, plane.params);
     // check if the plane hypothesis has valid geometry
     if (plane.GetDegreeNormalToZ() > param_.planefit_orien_threshold) {
@@ -661,17 +783,8 @@ int PlaneFitGroundDetector::FitGrid(const float *point_cloud,
     }
     // iterate samples and check if the point to plane distance is below
     // threshold
-    psrc = pf_threeds_;
-    nr_inliers = 0;
-    fit_cost = 0;
-    for (j = 0; j < nr_samples; ++j) {
-      ptp_dist = IPlaneToPointDistanceWUnitNorm(plane.params, psrc);
-      if (ptp_dist < dist_thre) {
-        nr_inliers++;
-        fit_cost += ptp_dist;
-      }
-      psrc += dim_point_;
-    }
+    nr_inliers = ICountPlaneInliers(plane.params, threeds, nr_samples,
+                                    dist_thre, &fit_cost);
     // Assign number of supports
     plane.SetNrSupport(nr_inliers);
 
@@ -708,8 +821,8 @@ int PlaneFitGroundDetector::FitGrid(const float *point_cloud,
   // iterate samples and check if the point to plane distance is within
   // threshold
   nr_inliers = 0;
-  psrc = pf_threeds_;
-  pdst = pf_threeds_;
+  psrc = threeds;
+  pdst = threeds;
   for (i = 0; i < nr_samples; ++i) {
     ptp_dist = IPlaneToPointDistanceWUnitNorm(groundplane->params, psrc);
     if (ptp_dist < dist_thre) {
@@ -720,8 +833,8 @@ int PlaneFitGroundDetector::FitGrid(const float *point_cloud,
     psrc += dim_point_;
   }
   groundplane->SetNrSupport(nr_inliers);
-  // note that pf_threeds_ will be destroyed after calling this routine
-  IPlaneFitTotalLeastSquare(pf_threeds_, groundplane->params, nr_inliers);
+  // note that threeds will be destroyed after calling this routine
+  IPlaneFitTotalLeastSquare(threeds, groundplane->params, nr_inliers);
   // filtering: the best plane orientation is not valid*/
   // std::cout << groundplane->GetDegreeNormalToZ() << std::endl;
   if (groundplane->GetDegreeNormalToZ() > param_.planefit_orien_threshold) {
@@ -738,7 +851,7 @@ int PlaneFitGroundDetector::FitLine(unsigned int r) {
   for (c = 0; c < param_.nr_grids_coarse; c++) {
     if (FitGrid(vg_coarse_->const_data(), &local_candis_[r][c], &gp,
                 vg_coarse_->NrPoints(), vg_coarse_->NrPointElement(),
-                pf_thresholds_[r][c]) >=
+                pf_thresholds_[r][c], nullptr, pf_threeds_) >=
         static_cast<int>(param_.nr_inliers_min_threshold)) {
       // transform to polar coordinates and store:
       IPlaneEucliToSpher(gp, &ground_planes_sphe_[r][c]);
@@ -760,6 +873,83 @@ int PlaneFitGroundDetector::Fit() {
   return nr_grids;
 }
 
+// Fit the grids independently on the workers and wait for all of them
+int PlaneFitGroundDetector::FitParallel() {
+  int nr_grids = 0;
+  size_t i = 0;
+  for (i = 0; i < fit_workers_.size(); ++i) {
+    fit_workers_[i]->WakeUp();
+  }
+  for (i = 0; i < fit_workers_.size(); ++i) {
+    fit_workers_[i]->Join();
+    nr_grids += worker_nr_grids_[i];
+  }
+  return nr_grids;
+}
+
+bool PlaneFitGroundDetector::FitWorker(unsigned int worker_id) {
+  int nr_grids = 0;
+  unsigned int i = 0;
+  int r = 0;
+  int c = 0;
+  unsigned int nr_workers = static_cast<unsigned int>(fit_workers_.size());
+  const GroundPlaneLiDAR *warm_start = nullptr;
+  GroundPlaneLiDAR gp;
+  // grids are interleaved in the near to far order to balance the load, each
+  // grid only writes its own plane so no locking is needed
+  for (i = worker_id; i < vg_coarse_->NrVoxel(); i += nr_workers) {
+    r = order_table_[i].first;
+    c = order_table_[i].second;
+    warm_start = (param_.enable_warm_start && has_prev_ground_planes_)
+                     ? &prev_ground_planes_[r][c]
+                     : nullptr;
+    if (FitGrid(vg_coarse_->const_data(), &local_candis_[r][c], &gp,
+                vg_coarse_->NrPoints(), vg_coarse_->NrPointElement(),
+                pf_thresholds_[r][c], warm_start,
+                worker_threeds_[worker_id]) >=
+        static_cast<int>(param_.nr_inliers_min_threshold)) {
+      IPlaneEucliToSpher(gp, &ground_planes_sphe_[r][c]);
+      ground_planes_[r][c] = gp;
+      nr_grids++;
+    } else {
+      ground_planes_sphe_[r][c].ForceInvalid();
+      ground_planes_[r][c].ForceInvalid();
+    }
+  }
+  worker_nr_grids_[worker_id] = nr_grids;
+  return true;
+}
+
+void PlaneFitGroundDetector::StoreWarmStartPlanes() {
+  unsigned int r = 0;
+  unsigned int c = 0;
+  for (r = 0; r < param_.nr_grids_coarse; ++r) {
+    for (c = 0; c < param_.nr_grids_coarse; ++c) {
+      prev_ground_planes_[r][c] = ground_planes_[r][c];
+    }
+  }
+  has_prev_ground_planes_ = true;
+}
+
+void PlaneFitGroundDetector::TranslateWarmStartPlanes(
+    const float *translation) {
+  unsigned int r = 0;
+  unsigned int c = 0;
+  if (!has_prev_ground_planes_) {
+    return;
+  }
+  // a point p in the current frame is p + t in the previous frame:
+  // n * (p + t) + d = n * p + (n * t + d)
+  for (r = 0; r < param_.nr_grids_coarse; ++r) {
+    for (c = 0; c < param_.nr_grids_coarse; ++c) {
+      GroundPlaneLiDAR &plane = prev_ground_planes_[r][c];
+      if (plane.IsValid()) {
+        plane.params[3] += IDot3(plane.params, translation);
+      }
+    }
+  }
+}
+
 //  Filter candidates by neighbors
 int PlaneFitGroundDetector::FilterCandidates(
     int r, int c, const float *point_cloud, PlaneFitPointCandIndices *candi,
@@ -868,15 +1058,8 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
     }
     // iterate samples and check if the point to plane distance is below
     // threshold
-    psrc = pf_threeds_;
-    nr_inliers = 0;
-    for (int j = 0; j < nr_samples; ++j) {
-      ptp_dist = IPlaneToPointDistanceWUnitNorm(hypothesis[i].params, psrc);
-      if (ptp_dist < dist_thre) {
-        nr_inliers++;
-      }
-      psrc += dim_point_;
-    }
+    nr_inliers = ICountPlaneInliers(hypothesis[i].params, pf_threeds_,
+                                    nr_samples, dist_thre, nullptr);
     // Assign number of supports
     hypothesis[i].SetNrSupport(nr_inliers);
 
@@ -891,16 +1074,9 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
     if (ground_planes_[r_n][c_n].IsValid()) {
       hypothesis[i + param_.nr_ransac_iter_threshold] =
           ground_planes_[r_n][c_n];
-      psrc = pf_threeds_;
-      nr_inliers = 0;
-      for (int j = 0; j < nr_samples; ++j) {
-        ptp_dist = IPlaneToPointDistanceWUnitNorm(
-            hypothesis[i + param_.nr_ransac_iter_threshold].params, psrc);
-        if (ptp_dist < dist_thre) {
-          nr_inliers++;
-        }
-        psrc += dim_point_;
-      }
+      nr_inliers = ICountPlaneInliers(
+          hypothesis[i + param_.nr_ransac_iter_threshold].params, pf_threeds_,
+          nr_samples, dist_thre, nullptr);
       if (nr_inliers < static_cast<int>(param_.nr_inliers_min_threshold)) {
         hypothesis[i + param_.nr_ransac_iter_threshold].ForceInvalid();
         continue;
@@ -930,6 +1106,10 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
     }
   }
 
+  // no valid hypothesis at all
+  if (best < 0) {
+    return (0);
+  }
   *groundplane = hypothesis[best];
 
   // check if meet the inlier number requirement
@@ -1004,19 +1184,23 @@ float PlaneFitGroundDetector::CalculateAngleDist(
   return angle_dist / static_cast<float>(count);
 }
 
-int PlaneFitGroundDetector::FitInOrder() {
-  int nr_grids = 0;
+void PlaneFitGroundDetector::ResetGroundZ() {
   unsigned int i = 0;
   unsigned int j = 0;
-  int r = 0;
-  int c = 0;
-  GroundPlaneLiDAR gp;
   for (i = 0; i < param_.nr_grids_coarse; ++i) {
     for (j = 0; j < param_.nr_grids_coarse; ++j) {
       ground_z_[i][j].first = 0.f;
       ground_z_[i][j].second = false;
     }
   }
+}
+
+int PlaneFitGroundDetector::FitInOrder() {
+  int nr_grids = 0;
+  unsigned int i = 0;
+  int r = 0;
+  int c = 0;
+  GroundPlaneLiDAR gp;
   for (i = 0; i < vg_coarse_->NrVoxel(); ++i) {
     r = order_table_[i].first;
     c = order_table_[i].second;
@@ -1243,18 +1427,18 @@ bool PlaneFitGroundDetector::Detect(const float *point_cloud,
   if (!vg_coarse_->SetS(point_cloud, nr_points, nr_point_elements)) {
     return false;
   }
-  // int nr_candis = 0;
-  // int nr_valid_grid = 0;
   unsigned int r = 0;
   unsigned int c = 0;
   // Filter to generate plane fitting candidates
-  // int nr_candis = Filter();
-  // std::cout << "# of plane candidates: " << nr_candis << std::endl;
-  //  Fit local plane using ransac
-  // nr_valid_grid = Fit();
-  // int nr_valid_grid = FitInOrder();
-  // std::cout << "# of valid plane geometry (fitting): " << nr_valid_grid <<
-  // std::endl;
+  Filter();
+  //  Fit local plane using ransac, either guided by the already fitted near
+  //  neighbors or independently per grid on the workers
+  ResetGroundZ();
+  if (param_.enable_parallel_fit) {
+    FitParallel();
+  } else {
+    FitInOrder();
+  }
   // Smooth plane using neighborhood information:
   for (int iter = 0; iter < param_.nr_smooth_iter; ++iter) {
     Smooth();
@@ -1268,8 +1452,10 @@ bool PlaneFitGroundDetector::Detect(const float *point_cloud,
     }
   }
 
-  // std::cout << "# of valid plane geometry (Smooth): " << nr_valid_grid <<
-  // std::endl;
+  // only the independent fit of the workers starts from the former planes
+  if (param_.enable_parallel_fit && param_.enable_warm_start) {
+    StoreWarmStartPlanes();
+  }
   // compute point to ground distance
   ComputeSignedGroundHeight(point_cloud, height_above_ground, nr_points,
                             nr_point_elements);
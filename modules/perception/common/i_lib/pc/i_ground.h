@@ -15,6 +15,7 @@
  *****************************************************************************/
 #pragma once
 
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -22,6 +23,7 @@
 #include "modules/perception/common/i_lib/core/i_rand.h"
 #include "modules/perception/common/i_lib/geometry/i_plane.h"
 #include "modules/perception/common/i_lib/pc/i_struct_s.h"
+#include "modules/perception/lib/thread/thread_worker.h"
 
 namespace apollo {
 namespace perception {
@@ -189,6 +191,12 @@ struct PlaneFitGroundDetectorParam {
   float candidate_filter_threshold;
   int nr_ransac_iter_threshold;
   int nr_smooth_iter;
+  // fit coarse grids independently on worker threads instead of in order
+  bool enable_parallel_fit;
+  unsigned int nr_fit_threads;
+  // seed ransac with the planes detected in the previous frame, only with
+  // enable_parallel_fit
+  bool enable_warm_start;
 };
 
 struct PlaneFitPointCandIndices {
@@ -253,6 +261,9 @@ class PlaneFitGroundDetector : public BaseGroundDetector {
   const unsigned int GetGridDimY() const;
   float GetUnknownHeight();
   PlaneFitPointCandIndices **GetCandis() const;
+  // Move the previous frame planes into the current frame coordinates,
+  // translation is the current origin minus the previous origin
+  void TranslateWarmStartPlanes(const float *translation);
 
  protected:
   void CleanUp();
@@ -261,8 +272,13 @@ class PlaneFitGroundDetector : public BaseGroundDetector {
   int FitLine(unsigned int r);
   int FitGrid(const float *point_cloud, PlaneFitPointCandIndices *candi,
               GroundPlaneLiDAR *groundplane, unsigned int nr_points,
-              unsigned int nr_point_element, float dist_thre);
+              unsigned int nr_point_element, float dist_thre,
+              const GroundPlaneLiDAR *warm_start, float *threeds);
+  void ResetGroundZ();
   int FitInOrder();
+  int FitParallel();
+  bool FitWorker(unsigned int worker_id);
+  void StoreWarmStartPlanes();
   int FilterCandidates(int r, int c, const float *point_cloud,
                        PlaneFitPointCandIndices *candi,
                        std::vector<std::pair<int, int> > *neighbors,
@@ -320,6 +336,13 @@ class PlaneFitGroundDetector : public BaseGroundDetector {
   float *pf_threeds_;
   int *sampled_indices_;
   std::pair<int, int> *order_table_;
+  // previous frame planes used as ransac warm start
+  GroundPlaneLiDAR **prev_ground_planes_;
+  bool has_prev_ground_planes_;
+  // per worker ransac buffers and results for the parallel fit
+  std::vector<std::unique_ptr<lib::ThreadWorker> > fit_workers_;
+  std::vector<float *> worker_threeds_;
+  std::vector<int> worker_nr_grids_;
 };
 
 }  // namespace common
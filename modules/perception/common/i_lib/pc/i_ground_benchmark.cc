@@ -0,0 +1,203 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Benchmark of PlaneFitGroundDetector on recorded frames, e.g.
+//   i_ground_benchmark --pcd_path=/apollo/data/pcd/velodyne128
+// Synthetic 64 and 128 beam frames are used when no pcd path is given.
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "gflags/gflags.h"
+#include "pcl/io/pcd_io.h"
+#include "pcl/point_types.h"
+
+#include "modules/perception/common/i_lib/pc/i_ground.h"
+#include "modules/perception/common/io/io_util.h"
+
+DEFINE_string(pcd_path, "", "folder of recorded pcd frames");
+DEFINE_int32(max_nr_frames, 50, "maximum number of frames to load");
+
+namespace apollo {
+namespace perception {
+namespace common {
+namespace {
+
+struct Frame {
+  std::vector<float> points;  // x, y, z
+  unsigned int nr_points = 0;
+};
+
+// Simulate one sweep of a rotating lidar mounted 1.9m above a slightly
+// tilted ground with boxes around it.
+Frame MakeSyntheticFrame(int nr_beams) {
+  const float kSensorHeight = 1.9f;
+  const float kMaxRange = 100.0f;
+  const int kNrColumns = 1800;  // 0.2 degree resolution
+  const float kMinElevation = -25.0f;
+  const float kMaxElevation = 15.0f;
+  std::mt19937 rng(nr_beams);
+  std::uniform_real_distribution<float> noise(-0.02f, 0.02f);
+  std::uniform_real_distribution<float> box_range(5.0f, 60.0f);
+  std::uniform_real_distribution<float> box_azimuth(
+      0.0f, 2.0f * Constant<float>::PI());
+  // boxes as azimuth sector, range and height
+  std::vector<std::vector<float> > boxes;
+  for (int i = 0; i < 60; ++i) {
+    float range = box_range(rng);
+    float azimuth = box_azimuth(rng);
+    boxes.push_back({azimuth, azimuth + 2.0f / range, range, 1.6f});
+  }
+
+  Frame frame;
+  frame.points.reserve(nr_beams * kNrColumns * 3);
+  for (int b = 0; b < nr_beams; ++b) {
+    float elevation = IDegreeToRadians(
+        kMinElevation +
+        (kMaxElevation - kMinElevation) * static_cast<float>(b) /
+            static_cast<float>(nr_beams - 1));
+    float slope = ITan(elevation);
+    for (int c = 0; c < kNrColumns; ++c) {
+      float azimuth = 2.0f * Constant<float>::PI() * static_cast<float>(c) /
+                      static_cast<float>(kNrColumns);
+      float range = slope < 0.f ? -kSensorHeight / slope : kMaxRange + 1.0f;
+      float z = -kSensorHeight;
+      for (const auto &box : boxes) {
+        if (azimuth < box[0] || azimuth > box[1] || box[2] > range) {
+          continue;
+        }
+        float hit_z = box[2] * slope;
+        if (hit_z > -kSensorHeight && hit_z < box[3] - kSensorHeight) {
+          range = box[2];
+          z = hit_z;
+        }
+      }
+      if (range > kMaxRange) {
+        continue;
+      }
+      float x = range * ICos(azimuth);
+      float y = range * ISin(azimuth);
+      if (z == -kSensorHeight) {
+        // gentle 1% slope along x
+        z += 0.01f * x;
+      }
+      frame.points.push_back(x);
+      frame.points.push_back(y);
+      frame.points.push_back(z + noise(rng));
+    }
+  }
+  frame.nr_points = static_cast<unsigned int>(frame.points.size() / 3);
+  return frame;
+}
+
+bool LoadPcdFrames(const std::string &path, std::vector<Frame> *frames) {
+  std::vector<std::string> files;
+  if (!GetFileList(path, ".pcd", &files)) {
+    return false;
+  }
+  std::sort(files.begin(), files.end());
+  for (const auto &file : files) {
+    if (static_cast<int>(frames->size()) >= FLAGS_max_nr_frames) {
+      break;
+    }
+    pcl::PointCloud<pcl::PointXYZI> cloud;
+    if (pcl::io::loadPCDFile(file, cloud) < 0) {
+      continue;
+    }
+    Frame frame;
+    frame.points.reserve(cloud.size() * 3);
+    for (const auto &pt : cloud.points) {
+      if (std::isnan(pt.x) || std::isnan(pt.y) || std::isnan(pt.z)) {
+        continue;
+      }
+      frame.points.push_back(pt.x);
+      frame.points.push_back(pt.y);
+      frame.points.push_back(pt.z);
+    }
+    frame.nr_points = static_cast<unsigned int>(frame.points.size() / 3);
+    frames->push_back(std::move(frame));
+  }
+  return !frames->empty();
+}
+
+const std::vector<Frame> &GetFrames(int nr_beams) {
+  static std::vector<Frame> recorded;
+  static std::vector<Frame> beams64 = {MakeSyntheticFrame(64)};
+  static std::vector<Frame> beams128 = {MakeSyntheticFrame(128)};
+  if (!FLAGS_pcd_path.empty()) {
+    if (recorded.empty()) {
+      LoadPcdFrames(FLAGS_pcd_path, &recorded);
+    }
+    return recorded;
+  }
+  return nr_beams == 64 ? beams64 : beams128;
+}
+
+// Arguments: number of beams, number of fit threads (0 for the serial fit),
+// warm start on/off
+void BM_PlaneFitGroundDetect(benchmark::State &state) {
+  const std::vector<Frame> &frames = GetFrames(state.range(0));
+  if (frames.empty()) {
+    state.SkipWithError("no frames loaded");
+    return;
+  }
+  PlaneFitGroundDetectorParam param;
+  param.roi_region_rad_x = 120.0f;
+  param.roi_region_rad_y = 120.0f;
+  param.roi_region_rad_z = 120.0f;
+  param.nr_smooth_iter = 5;
+  param.enable_parallel_fit = state.range(1) > 0;
+  param.nr_fit_threads = std::max(static_cast<int>(state.range(1)), 1);
+  param.enable_warm_start = state.range(2) != 0;
+  PlaneFitGroundDetector detector(param);
+  detector.Init();
+  std::vector<float> height_above_ground(param.nr_points_max);
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    const Frame &frame = frames[i++ % frames.size()];
+    detector.Detect(frame.points.data(), height_above_ground.data(),
+                    std::min(frame.nr_points, param.nr_points_max), 3);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_PlaneFitGroundDetect)
+    ->Args({64, 0, 0})
+    ->Args({64, 4, 0})
+    ->Args({64, 4, 1})
+    ->Args({128, 0, 0})
+    ->Args({128, 2, 0})
+    ->Args({128, 4, 0})
+    ->Args({128, 4, 1})
+    ->Args({128, 8, 1})
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace common
+}  // namespace perception
+}  // namespace apollo
+
+int main(int argc, char **argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
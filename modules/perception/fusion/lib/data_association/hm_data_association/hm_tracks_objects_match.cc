@@ -15,6 +15,7 @@
  *****************************************************************************/
 #include "modules/perception/fusion/lib/data_association/hm_data_association/hm_tracks_objects_match.h"
 
+#include <cmath>
 #include <map>
 #include <utility>
 
@@ -31,6 +32,9 @@ double HMTrackersObjectsAssociation::s_match_distance_bound_ = 100.0;
  * is 2 times of ave error around 200m. */
 double HMTrackersObjectsAssociation::s_association_center_dist_threshold_ =
     30.0;
+size_t HMTrackersObjectsAssociation::s_distance_mat_num_threads_ = 4;
+size_t HMTrackersObjectsAssociation::s_distance_mat_min_parallel_pairs_ = 64;
+bool HMTrackersObjectsAssociation::s_use_sparse_solver_ = false;
 
 template <typename T>
 void extract_vector(const std::vector<T>& vec,
@@ -43,6 +47,32 @@ void extract_vector(const std::vector<T>& vec,
   }
 }
 
+bool HMTrackersObjectsAssociation::Init() {
+  track_object_distance_.set_distance_thresh(
+      static_cast<float>(s_match_distance_thresh_));
+  optimizer_.set_solver_type(
+      s_use_sparse_solver_
+          ? common::GatedHungarianMatcher<float>::SolverType::SPARSE
+          : common::GatedHungarianMatcher<float>::SolverType::HUNGARIAN);
+
+  distance_workers_.clear();
+  worker_distances_.clear();
+  const size_t num_threads = s_distance_mat_num_threads_;
+  for (size_t i = 1; i < num_threads; ++i) {
+    worker_distances_.emplace_back(new TrackObjectDistance);
+    TrackObjectDistance* distance = worker_distances_.back().get();
+    distance->set_distance_thresh(
+        static_cast<float>(s_match_distance_thresh_));
+    distance_workers_.emplace_back(new lib::ThreadWorker);
+    distance_workers_.back()->Bind([this, i, num_threads, distance]() {
+      ComputeAssociationDistanceRows(i, num_threads, distance);
+      return true;
+    });
+    distance_workers_.back()->Start();
+  }
+  return true;
+}
+
 bool HMTrackersObjectsAssociation::Associate(
     const AssociationOptions& options, SensorFramePtr sensor_measurements,
     ScenePtr scene, AssociationResult* association_result) {
@@ -64,6 +94,10 @@ bool HMTrackersObjectsAssociation::Associate(
   double measurement_timestamp = sensor_objects[0]->GetTimestamp();
   track_object_distance_.ResetProjectionCache(measurement_sensor_id,
                                               measurement_timestamp);
+  for (auto& distance : worker_distances_) {
+    distance->ResetProjectionCache(measurement_sensor_id,
+                                   measurement_timestamp);
+  }
   bool do_nothing = (sensor_objects[0]->GetSensorId() == "radar_front");
   IdAssign(fusion_tracks, sensor_objects, &association_result->assignments,
            &association_result->unassigned_tracks,
@@ -299,38 +333,76 @@ void HMTrackersObjectsAssociation::ComputeAssociationDistanceMat(
     const std::vector<size_t>& unassigned_tracks,
     const std::vector<size_t>& unassigned_measurements,
     std::vector<std::vector<double>>* association_mat) {
-  // if (sensor_objects.empty()) return;
+  association_mat->resize(unassigned_tracks.size());
+  for (auto& row : *association_mat) {
+    row.resize(unassigned_measurements.size());
+  }
+  mat_fusion_tracks_ = &fusion_tracks;
+  mat_sensor_objects_ = &sensor_objects;
+  mat_unassigned_tracks_ = &unassigned_tracks;
+  mat_unassigned_measurements_ = &unassigned_measurements;
+  mat_association_ = association_mat;
+
+  // the rows are dealt out round robin, the caller keeps row 0, ... and
+  // track_object_distance_ so that its projection cache stays warm for
+  // ComputeDistance
+  size_t num_pairs = unassigned_tracks.size() * unassigned_measurements.size();
+  if (distance_workers_.empty() ||
+      num_pairs < s_distance_mat_min_parallel_pairs_) {
+    ComputeAssociationDistanceRows(0, 1, &track_object_distance_);
+  } else {
+    for (auto& worker : distance_workers_) {
+      worker->WakeUp();
+    }
+    ComputeAssociationDistanceRows(0, distance_workers_.size() + 1,
+                                   &track_object_distance_);
+    for (auto& worker : distance_workers_) {
+      worker->Join();
+    }
+  }
+}
+
+void HMTrackersObjectsAssociation::ComputeAssociationDistanceRows(
+    size_t first_row, size_t row_step, TrackObjectDistance* distance) {
+  const std::vector<TrackPtr>& fusion_tracks = *mat_fusion_tracks_;
+  const std::vector<SensorObjectPtr>& sensor_objects = *mat_sensor_objects_;
+  const std::vector<size_t>& unassigned_tracks = *mat_unassigned_tracks_;
+  const std::vector<size_t>& unassigned_measurements =
+      *mat_unassigned_measurements_;
   TrackObjectDistanceOptions opt;
   // TODO(linjian) ref_point
   Eigen::Vector3d tmp = Eigen::Vector3d::Zero();
   opt.ref_point = &tmp;
-  association_mat->resize(unassigned_tracks.size());
-  for (size_t i = 0; i < unassigned_tracks.size(); ++i) {
+  const double center_dist_threshold_sqr =
+      s_association_center_dist_threshold_ *
+      s_association_center_dist_threshold_;
+  for (size_t i = first_row; i < unassigned_tracks.size(); i += row_step) {
     int fusion_idx = static_cast<int>(unassigned_tracks[i]);
-    (*association_mat)[i].resize(unassigned_measurements.size());
+    std::vector<double>& row = (*mat_association_)[i];
     const TrackPtr& fusion_track = fusion_tracks[fusion_idx];
+    const Eigen::Vector3d& track_center =
+        fusion_track->GetFusedObject()->GetBaseObject()->center;
     for (size_t j = 0; j < unassigned_measurements.size(); ++j) {
       int sensor_idx = static_cast<int>(unassigned_measurements[j]);
       const SensorObjectPtr& sensor_object = sensor_objects[sensor_idx];
-      double distance = s_match_distance_thresh_;
-      double center_dist =
-          (sensor_object->GetBaseObject()->center -
-           fusion_track->GetFusedObject()->GetBaseObject()->center)
-              .norm();
-      if (center_dist < s_association_center_dist_threshold_) {
-        distance =
-            track_object_distance_.Compute(fusion_track, sensor_object, opt);
+      double distance_value = s_match_distance_thresh_;
+      // gate on the center distance before any projection or polygon
+      double center_dist_sqr =
+          (sensor_object->GetBaseObject()->center - track_center)
+              .squaredNorm();
+      if (center_dist_sqr < center_dist_threshold_sqr) {
+        distance_value = distance->Compute(fusion_track, sensor_object, opt);
       } else {
-        ADEBUG << "center_distance " << center_dist
+        ADEBUG << "center_distance " << std::sqrt(center_dist_sqr)
                << " exceeds slack threshold "
                << s_association_center_dist_threshold_
                << ", track_id: " << fusion_track->GetTrackId()
                << ", obs_id: " << sensor_object->GetBaseObject()->track_id;
       }
-      (*association_mat)[i][j] = distance;
+      row[j] = distance_value;
       ADEBUG << "track_id: " << fusion_track->GetTrackId()
              << ", obs_id: " << sensor_object->GetBaseObject()->track_id
-             << ", distance: " << distance;
+             << ", distance: " << distance_value;
     }
   }
 }
@@ -15,12 +15,14 @@
  *****************************************************************************/
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "modules/perception/common/graph/gated_hungarian_bigraph_matcher.h"
 #include "modules/perception/fusion/lib/data_association/hm_data_association/track_object_distance.h"
 #include "modules/perception/fusion/lib/interface/base_data_association.h"
+#include "modules/perception/lib/thread/thread_worker.h"
 
 namespace apollo {
 namespace perception {
@@ -34,11 +36,7 @@ class HMTrackersObjectsAssociation : public BaseDataAssociation {
   HMTrackersObjectsAssociation& operator=(const HMTrackersObjectsAssociation&) =
       delete;
 
-  bool Init() override {
-    track_object_distance_.set_distance_thresh(
-        static_cast<float>(s_match_distance_thresh_));
-    return true;
-  }
+  bool Init() override;
 
   bool Associate(const AssociationOptions& options,
                  SensorFramePtr sensor_measurements, ScenePtr scene,
@@ -46,6 +44,12 @@ class HMTrackersObjectsAssociation : public BaseDataAssociation {
 
   std::string Name() const override { return "HMTrackersObjectsAssociation"; }
 
+  // @brief: solve the assignment on the gated pairs only, takes effect on
+  // the next Init
+  static void SetUseSparseSolver(bool use_sparse_solver) {
+    s_use_sparse_solver_ = use_sparse_solver;
+  }
+
  private:
   void ComputeAssociationDistanceMat(
       const std::vector<TrackPtr>& fusion_tracks,
@@ -55,6 +59,11 @@ class HMTrackersObjectsAssociation : public BaseDataAssociation {
       const std::vector<size_t>& unassigned_measurements,
       std::vector<std::vector<double>>* association_mat);
 
+  // @brief: compute the rows first_row, first_row + row_step, ... of the
+  // association matrix set up by ComputeAssociationDistanceMat
+  void ComputeAssociationDistanceRows(size_t first_row, size_t row_step,
+                                      TrackObjectDistance* distance);
+
   void IdAssign(const std::vector<TrackPtr>& fusion_tracks,
                 const std::vector<SensorObjectPtr>& sensor_objects,
                 std::vector<TrackMeasurmentPair>* assignments,
@@ -94,9 +103,26 @@ class HMTrackersObjectsAssociation : public BaseDataAssociation {
  private:
   common::GatedHungarianMatcher<float> optimizer_;
   TrackObjectDistance track_object_distance_;
+  // the distance matrix rows are shared by the caller, which computes with
+  // track_object_distance_, and the workers, each of them owning a distance
+  // so that its projection cache is reused across the pairs of its rows
+  std::vector<std::unique_ptr<TrackObjectDistance>> worker_distances_;
+  std::vector<std::unique_ptr<lib::ThreadWorker>> distance_workers_;
+  // the inputs of the distance matrix in computation
+  const std::vector<TrackPtr>* mat_fusion_tracks_ = nullptr;
+  const std::vector<SensorObjectPtr>* mat_sensor_objects_ = nullptr;
+  const std::vector<size_t>* mat_unassigned_tracks_ = nullptr;
+  const std::vector<size_t>* mat_unassigned_measurements_ = nullptr;
+  std::vector<std::vector<double>>* mat_association_ = nullptr;
+
   static double s_match_distance_thresh_;
   static double s_match_distance_bound_;
   static double s_association_center_dist_threshold_;
+  // threads computing the distance matrix, including the caller
+  static size_t s_distance_mat_num_threads_;
+  // smaller matrices are computed by the caller alone
+  static size_t s_distance_mat_min_parallel_pairs_;
+  static bool s_use_sparse_solver_;
 };
 
 }  // namespace fusion
@@ -75,6 +75,7 @@ bool ProbabilisticFusion::Init(const FusionInitOptions& init_options) {
   Track::SetMaxRadarInvisiblePeriod(params.max_radar_invisible_period());
   Track::SetMaxCameraInvisiblePeriod(params.max_camera_invisible_period());
   Sensor::SetMaxCachedFrameNumber(params.max_cached_frame_num());
+  HMTrackersObjectsAssociation::SetUseSparseSolver(params.use_sparse_solver());
 
   scenes_.reset(new Scene());
   if (params_.data_association_method == "HMAssociation") {
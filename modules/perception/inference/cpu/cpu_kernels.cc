@@ -0,0 +1,330 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/inference/cpu/cpu_kernels.h"
+
+#include <smmintrin.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+CpuParallelRunner::CpuParallelRunner(int num_threads) {
+  for (int i = 1; i < num_threads; ++i) {
+    workers_.emplace_back(new lib::ThreadWorker);
+    workers_.back()->Bind(std::bind(&CpuParallelRunner::Work, this, i - 1));
+    workers_.back()->Start();
+  }
+}
+
+CpuParallelRunner::~CpuParallelRunner() {
+  for (auto &worker : workers_) {
+    worker->Release();
+  }
+}
+
+bool CpuParallelRunner::Work(int worker_id) {
+  int begin = (worker_id + 1) * chunk_;
+  int end = std::min(size_, begin + chunk_);
+  if (begin < end) {
+    (*func_)(begin, end);
+  }
+  return true;
+}
+
+void CpuParallelRunner::Run(int size,
+                            const std::function<void(int, int)> &func) {
+  if (size <= 0) {
+    return;
+  }
+  if (workers_.empty() || size == 1) {
+    func(0, size);
+    return;
+  }
+  int chunk = (size + num_threads() - 1) / num_threads();
+  // keep the splits of long rows aligned to the simd width
+  if (chunk >= 64) {
+    chunk = (chunk + 7) / 8 * 8;
+  }
+  func_ = &func;
+  size_ = size;
+  chunk_ = chunk;
+  int nr_busy_workers = std::min(static_cast<int>(workers_.size()),
+                                 (size + chunk - 1) / chunk - 1);
+  for (int i = 0; i < nr_busy_workers; ++i) {
+    workers_[i]->WakeUp();
+  }
+  func(0, std::min(size, chunk));
+  for (int i = 0; i < nr_busy_workers; ++i) {
+    workers_[i]->Join();
+  }
+  func_ = nullptr;
+}
+
+namespace {
+
+// cache blocking of the gemm, a block of b is 256 x 256 floats
+const int kGemmBlockK = 256;
+const int kGemmBlockN = 256;
+
+// c[4 x n] += a[4 x k] * b[k x n]
+void GemmKernel4(int n, int k, const float *a, int lda, const float *b,
+                 int ldb, float *c, int ldc) {
+  const float *a0 = a;
+  const float *a1 = a + lda;
+  const float *a2 = a + 2 * lda;
+  const float *a3 = a + 3 * lda;
+  float *c0 = c;
+  float *c1 = c + ldc;
+  float *c2 = c + 2 * ldc;
+  float *c3 = c + 3 * ldc;
+  int j = 0;
+  for (; j + 8 <= n; j += 8) {
+    __m128 c00 = _mm_loadu_ps(c0 + j);
+    __m128 c01 = _mm_loadu_ps(c0 + j + 4);
+    __m128 c10 = _mm_loadu_ps(c1 + j);
+    __m128 c11 = _mm_loadu_ps(c1 + j + 4);
+    __m128 c20 = _mm_loadu_ps(c2 + j);
+    __m128 c21 = _mm_loadu_ps(c2 + j + 4);
+    __m128 c30 = _mm_loadu_ps(c3 + j);
+    __m128 c31 = _mm_loadu_ps(c3 + j + 4);
+    const float *bp = b + j;
+    for (int p = 0; p < k; ++p, bp += ldb) {
+      __m128 b0 = _mm_loadu_ps(bp);
+      __m128 b1 = _mm_loadu_ps(bp + 4);
+      __m128 av = _mm_set1_ps(a0[p]);
+      c00 = _mm_add_ps(c00, _mm_mul_ps(av, b0));
+      c01 = _mm_add_ps(c01, _mm_mul_ps(av, b1));
+      av = _mm_set1_ps(a1[p]);
+      c10 = _mm_add_ps(c10, _mm_mul_ps(av, b0));
+      c11 = _mm_add_ps(c11, _mm_mul_ps(av, b1));
+      av = _mm_set1_ps(a2[p]);
+      c20 = _mm_add_ps(c20, _mm_mul_ps(av, b0));
+      c21 = _mm_add_ps(c21, _mm_mul_ps(av, b1));
+      av = _mm_set1_ps(a3[p]);
+      c30 = _mm_add_ps(c30, _mm_mul_ps(av, b0));
+      c31 = _mm_add_ps(c31, _mm_mul_ps(av, b1));
+    }
+    _mm_storeu_ps(c0 + j, c00);
+    _mm_storeu_ps(c0 + j + 4, c01);
+    _mm_storeu_ps(c1 + j, c10);
+    _mm_storeu_ps(c1 + j + 4, c11);
+    _mm_storeu_ps(c2 + j, c20);
+    _mm_storeu_ps(c2 + j + 4, c21);
+    _mm_storeu_ps(c3 + j, c30);
+    _mm_storeu_ps(c3 + j + 4, c31);
+  }
+  for (; j + 4 <= n; j += 4) {
+    __m128 c00 = _mm_loadu_ps(c0 + j);
+    __m128 c10 = _mm_loadu_ps(c1 + j);
+    __m128 c20 = _mm_loadu_ps(c2 + j);
+    __m128 c30 = _mm_loadu_ps(c3 + j);
+    const float *bp = b + j;
+    for (int p = 0; p < k; ++p, bp += ldb) {
+      __m128 b0 = _mm_loadu_ps(bp);
+      c00 = _mm_add_ps(c00, _mm_mul_ps(_mm_set1_ps(a0[p]), b0));
+      c10 = _mm_add_ps(c10, _mm_mul_ps(_mm_set1_ps(a1[p]), b0));
+      c20 = _mm_add_ps(c20, _mm_mul_ps(_mm_set1_ps(a2[p]), b0));
+      c30 = _mm_add_ps(c30, _mm_mul_ps(_mm_set1_ps(a3[p]), b0));
+    }
+    _mm_storeu_ps(c0 + j, c00);
+    _mm_storeu_ps(c1 + j, c10);
+    _mm_storeu_ps(c2 + j, c20);
+    _mm_storeu_ps(c3 + j, c30);
+  }
+  for (; j < n; ++j) {
+    float s0 = c0[j];
+    float s1 = c1[j];
+    float s2 = c2[j];
+    float s3 = c3[j];
+    const float *bp = b + j;
+    for (int p = 0; p < k; ++p, bp += ldb) {
+      s0 += a0[p] * bp[0];
+      s1 += a1[p] * bp[0];
+      s2 += a2[p] * bp[0];
+      s3 += a3[p] * bp[0];
+    }
+    c0[j] = s0;
+    c1[j] = s1;
+    c2[j] = s2;
+    c3[j] = s3;
+  }
+}
+
+// c[1 x n] += a[1 x k] * b[k x n]
+void GemmKernel1(int n, int k, const float *a, const float *b, int ldb,
+                 float *c) {
+  int j = 0;
+  for (; j + 8 <= n; j += 8) {
+    __m128 c0 = _mm_loadu_ps(c + j);
+    __m128 c1 = _mm_loadu_ps(c + j + 4);
+    const float *bp = b + j;
+    for (int p = 0; p < k; ++p, bp += ldb) {
+      __m128 av = _mm_set1_ps(a[p]);
+      c0 = _mm_add_ps(c0, _mm_mul_ps(av, _mm_loadu_ps(bp)));
+      c1 = _mm_add_ps(c1, _mm_mul_ps(av, _mm_loadu_ps(bp + 4)));
+    }
+    _mm_storeu_ps(c + j, c0);
+    _mm_storeu_ps(c + j + 4, c1);
+  }
+  for (; j < n; ++j) {
+    float s = c[j];
+    const float *bp = b + j;
+    for (int p = 0; p < k; ++p, bp += ldb) {
+      s += a[p] * bp[0];
+    }
+    c[j] = s;
+  }
+}
+
+}  // namespace
+
+void CpuGemm(int m, int n, int k, const float *a, int lda, const float *b,
+             int ldb, float *c, int ldc, bool accumulate) {
+  if (!accumulate) {
+    for (int i = 0; i < m; ++i) {
+      memset(c + i * ldc, 0, n * sizeof(float));
+    }
+  }
+  for (int kk = 0; kk < k; kk += kGemmBlockK) {
+    int kb = std::min(kGemmBlockK, k - kk);
+    for (int jj = 0; jj < n; jj += kGemmBlockN) {
+      int nb = std::min(kGemmBlockN, n - jj);
+      const float *b_block = b + kk * ldb + jj;
+      int i = 0;
+      for (; i + 4 <= m; i += 4) {
+        GemmKernel4(nb, kb, a + i * lda + kk, lda, b_block, ldb,
+                    c + i * ldc + jj, ldc);
+      }
+      for (; i < m; ++i) {
+        GemmKernel1(nb, kb, a + i * lda + kk, b_block, ldb, c + i * ldc + jj);
+      }
+    }
+  }
+}
+
+void CpuIm2Col(const float *data, const CpuConvGeometry &geometry,
+               int channel_begin, int channel_end, float *col) {
+  const int height = geometry.height;
+  const int width = geometry.width;
+  const int out_height = geometry.out_height;
+  const int out_width = geometry.out_width;
+  const int kernel_size = geometry.kernel_h * geometry.kernel_w;
+  const int out_size = out_height * out_width;
+  for (int c = channel_begin; c < channel_end; ++c) {
+    const float *plane = data + c * height * width;
+    float *col_c = col + c * kernel_size * out_size;
+    for (int kh = 0; kh < geometry.kernel_h; ++kh) {
+      for (int kw = 0; kw < geometry.kernel_w; ++kw) {
+        float *row = col_c + (kh * geometry.kernel_w + kw) * out_size;
+        const int w_offset = kw * geometry.dilation_w - geometry.pad_w;
+        // output columns whose input column lies inside the image
+        int ow_begin = 0;
+        while (ow_begin < out_width &&
+               ow_begin * geometry.stride_w + w_offset < 0) {
+          ++ow_begin;
+        }
+        int ow_end = out_width;
+        while (ow_end > ow_begin &&
+               (ow_end - 1) * geometry.stride_w + w_offset >= width) {
+          --ow_end;
+        }
+        for (int oh = 0; oh < out_height; ++oh, row += out_width) {
+          int ih = oh * geometry.stride_h + kh * geometry.dilation_h -
+                   geometry.pad_h;
+          if (ih < 0 || ih >= height) {
+            memset(row, 0, out_width * sizeof(float));
+            continue;
+          }
+          const float *src = plane + ih * width;
+          std::fill(row, row + ow_begin, 0.f);
+          if (geometry.stride_w == 1) {
+            memcpy(row + ow_begin, src + ow_begin + w_offset,
+                   (ow_end - ow_begin) * sizeof(float));
+          } else {
+            for (int ow = ow_begin; ow < ow_end; ++ow) {
+              row[ow] = src[ow * geometry.stride_w + w_offset];
+            }
+          }
+          std::fill(row + ow_end, row + out_width, 0.f);
+        }
+      }
+    }
+  }
+}
+
+void CpuCol2Im(const float *col, const CpuConvGeometry &geometry,
+               int channel_begin, int channel_end, float *data) {
+  const int height = geometry.height;
+  const int width = geometry.width;
+  const int out_height = geometry.out_height;
+  const int out_width = geometry.out_width;
+  const int kernel_size = geometry.kernel_h * geometry.kernel_w;
+  const int out_size = out_height * out_width;
+  for (int c = channel_begin; c < channel_end; ++c) {
+    float *plane = data + c * height * width;
+    memset(plane, 0, height * width * sizeof(float));
+    const float *col_c = col + c * kernel_size * out_size;
+    for (int kh = 0; kh < geometry.kernel_h; ++kh) {
+      for (int kw = 0; kw < geometry.kernel_w; ++kw) {
+        const float *row = col_c + (kh * geometry.kernel_w + kw) * out_size;
+        const int w_offset = kw * geometry.dilation_w - geometry.pad_w;
+        int ow_begin = 0;
+        while (ow_begin < out_width &&
+               ow_begin * geometry.stride_w + w_offset < 0) {
+          ++ow_begin;
+        }
+        int ow_end = out_width;
+        while (ow_end > ow_begin &&
+               (ow_end - 1) * geometry.stride_w + w_offset >= width) {
+          --ow_end;
+        }
+        for (int oh = 0; oh < out_height; ++oh, row += out_width) {
+          int ih = oh * geometry.stride_h + kh * geometry.dilation_h -
+                   geometry.pad_h;
+          if (ih < 0 || ih >= height) {
+            continue;
+          }
+          float *dst = plane + ih * width;
+          for (int ow = ow_begin; ow < ow_end; ++ow) {
+            dst[ow * geometry.stride_w + w_offset] += row[ow];
+          }
+        }
+      }
+    }
+  }
+}
+
+void CpuReLU(const float *src, int count, float negative_slope, float *dst) {
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 slope = _mm_set1_ps(negative_slope);
+  int i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128 x = _mm_loadu_ps(src + i);
+    __m128 y = _mm_add_ps(_mm_max_ps(x, zero),
+                          _mm_mul_ps(slope, _mm_min_ps(x, zero)));
+    _mm_storeu_ps(dst + i, y);
+  }
+  for (; i < count; ++i) {
+    dst[i] = src[i] > 0.f ? src[i] : negative_slope * src[i];
+  }
+}
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
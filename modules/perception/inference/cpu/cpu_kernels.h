@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "modules/perception/lib/thread/thread_worker.h"
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+// Runs a range based function on the calling thread and a fixed set of
+// lib::ThreadWorker, the range is split into contiguous chunks.
+class CpuParallelRunner {
+ public:
+  explicit CpuParallelRunner(int num_threads);
+  ~CpuParallelRunner();
+
+  CpuParallelRunner(const CpuParallelRunner &) = delete;
+  CpuParallelRunner &operator=(const CpuParallelRunner &) = delete;
+
+  int num_threads() const { return static_cast<int>(workers_.size()) + 1; }
+
+  // call func(begin, end) on disjoint ranges covering [0, size), returns
+  // when all ranges are done
+  void Run(int size, const std::function<void(int, int)> &func);
+
+ private:
+  bool Work(int worker_id);
+
+  std::vector<std::unique_ptr<lib::ThreadWorker>> workers_;
+  const std::function<void(int, int)> *func_ = nullptr;
+  int size_ = 0;
+  int chunk_ = 0;
+};
+
+// Geometry of a 2D convolution on a single image, in caffe layout.
+struct CpuConvGeometry {
+  int channels = 0;
+  int height = 0;
+  int width = 0;
+  int kernel_h = 1;
+  int kernel_w = 1;
+  int pad_h = 0;
+  int pad_w = 0;
+  int stride_h = 1;
+  int stride_w = 1;
+  int dilation_h = 1;
+  int dilation_w = 1;
+  int out_height = 0;
+  int out_width = 0;
+};
+
+// c = a * b (+ c when accumulate), row major matrices, a is m x k, b is
+// k x n, c is m x n, lda/ldb/ldc are the row strides
+void CpuGemm(int m, int n, int k, const float *a, int lda, const float *b,
+             int ldb, float *c, int ldc, bool accumulate);
+
+// Unfold channels [channel_begin, channel_end) of data into the rows of col,
+// col has channels * kernel_h * kernel_w rows of out_height * out_width.
+void CpuIm2Col(const float *data, const CpuConvGeometry &geometry,
+               int channel_begin, int channel_end, float *col);
+
+// Inverse of CpuIm2Col, overlapping entries are summed, channels
+// [channel_begin, channel_end) of data are overwritten.
+void CpuCol2Im(const float *col, const CpuConvGeometry &geometry,
+               int channel_begin, int channel_end, float *data);
+
+// dst[i] = src[i] > 0 ? src[i] : negative_slope * src[i], src may be dst
+void CpuReLU(const float *src, int count, float negative_slope, float *dst);
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
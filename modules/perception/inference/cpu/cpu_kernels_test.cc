@@ -0,0 +1,167 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/inference/cpu/cpu_kernels.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+namespace {
+
+std::vector<float> RandomVector(int size, int seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  std::vector<float> res(size);
+  for (auto &value : res) {
+    value = dist(rng);
+  }
+  return res;
+}
+
+}  // namespace
+
+TEST(CpuKernelsTest, parallel_runner_test) {
+  for (int num_threads : {1, 2, 4}) {
+    CpuParallelRunner runner(num_threads);
+    EXPECT_EQ(runner.num_threads(), num_threads);
+    for (int size : {0, 1, 3, 100, 1001}) {
+      std::vector<int> visited(size, 0);
+      runner.Run(size, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+          ++visited[i];
+        }
+      });
+      for (int i = 0; i < size; ++i) {
+        EXPECT_EQ(visited[i], 1);
+      }
+    }
+  }
+}
+
+TEST(CpuKernelsTest, gemm_test) {
+  // covers the 4 row and 8/4/1 column kernels and the k blocking
+  const int sizes[][3] = {{1, 1, 1}, {4, 8, 3}, {7, 13, 5}, {9, 300, 517}};
+  for (const auto &size : sizes) {
+    const int m = size[0];
+    const int n = size[1];
+    const int k = size[2];
+    std::vector<float> a = RandomVector(m * k, 1);
+    std::vector<float> b = RandomVector(k * n, 2);
+    std::vector<float> c = RandomVector(m * n, 3);
+    std::vector<float> expected = c;
+    for (int i = 0; i < m; ++i) {
+      for (int j = 0; j < n; ++j) {
+        for (int p = 0; p < k; ++p) {
+          expected[i * n + j] += a[i * k + p] * b[p * n + j];
+        }
+      }
+    }
+    std::vector<float> accumulated = c;
+    std::vector<float> product(m * n, 1.f);
+    CpuGemm(m, n, k, a.data(), k, b.data(), n, accumulated.data(), n, true);
+    CpuGemm(m, n, k, a.data(), k, b.data(), n, product.data(), n, false);
+    for (int i = 0; i < m * n; ++i) {
+      EXPECT_NEAR(accumulated[i], expected[i], 1e-3);
+      EXPECT_NEAR(product[i], expected[i] - c[i], 1e-3);
+    }
+  }
+}
+
+TEST(CpuKernelsTest, im2col_test) {
+  CpuConvGeometry geometry;
+  geometry.channels = 3;
+  geometry.height = 7;
+  geometry.width = 10;
+  geometry.kernel_h = 3;
+  geometry.kernel_w = 2;
+  geometry.pad_h = 2;
+  geometry.pad_w = 1;
+  geometry.stride_h = 2;
+  geometry.stride_w = 3;
+  geometry.dilation_h = 2;
+  geometry.dilation_w = 1;
+  geometry.out_height = (7 + 4 - 5) / 2 + 1;
+  geometry.out_width = (10 + 2 - 2) / 3 + 1;
+  const int out_size = geometry.out_height * geometry.out_width;
+  std::vector<float> data = RandomVector(3 * 7 * 10, 4);
+  std::vector<float> col(3 * 3 * 2 * out_size, -1.f);
+  CpuIm2Col(data.data(), geometry, 0, 1, col.data());
+  CpuIm2Col(data.data(), geometry, 1, 3, col.data());
+  for (int c = 0; c < 3; ++c) {
+    for (int kh = 0; kh < 3; ++kh) {
+      for (int kw = 0; kw < 2; ++kw) {
+        for (int oh = 0; oh < geometry.out_height; ++oh) {
+          for (int ow = 0; ow < geometry.out_width; ++ow) {
+            int h = oh * 2 - 2 + kh * 2;
+            int w = ow * 3 - 1 + kw;
+            float expected = (h < 0 || h >= 7 || w < 0 || w >= 10)
+                                 ? 0.f
+                                 : data[(c * 7 + h) * 10 + w];
+            int row = (c * 3 + kh) * 2 + kw;
+            EXPECT_EQ(col[row * out_size + oh * geometry.out_width + ow],
+                      expected);
+          }
+        }
+      }
+    }
+  }
+
+  // col2im sums every column entry back into its pixel
+  std::vector<float> image(data.size(), -1.f);
+  std::vector<float> ones(col.size(), 1.f);
+  CpuCol2Im(ones.data(), geometry, 0, 3, image.data());
+  std::vector<float> counts(data.size(), 0.f);
+  for (int c = 0; c < 3; ++c) {
+    for (int kh = 0; kh < 3; ++kh) {
+      for (int kw = 0; kw < 2; ++kw) {
+        for (int oh = 0; oh < geometry.out_height; ++oh) {
+          for (int ow = 0; ow < geometry.out_width; ++ow) {
+            int h = oh * 2 - 2 + kh * 2;
+            int w = ow * 3 - 1 + kw;
+            if (h >= 0 && h < 7 && w >= 0 && w < 10) {
+              counts[(c * 7 + h) * 10 + w] += 1.f;
+            }
+          }
+        }
+      }
+    }
+  }
+  for (size_t i = 0; i < image.size(); ++i) {
+    EXPECT_EQ(image[i], counts[i]);
+  }
+}
+
+TEST(CpuKernelsTest, relu_test) {
+  std::vector<float> data = RandomVector(11, 5);
+  std::vector<float> res(11);
+  CpuReLU(data.data(), 11, 0.1f, res.data());
+  for (int i = 0; i < 11; ++i) {
+    EXPECT_FLOAT_EQ(res[i], data[i] > 0 ? data[i] : 0.1f * data[i]);
+  }
+  CpuReLU(data.data(), 11, 0.f, data.data());
+  for (int i = 0; i < 11; ++i) {
+    EXPECT_GE(data[i], 0.f);
+  }
+}
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,1125 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/inference/cpu/cpu_layers.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace perception {
+namespace inference {
+namespace {
+
+// minimal number of elements handed to one thread by element wise layers
+const int kElementGrain = 4096;
+
+void ParallelElements(CpuParallelRunner *runner, int count,
+                      const std::function<void(int, int)> &func) {
+  int nr_blocks = (count + kElementGrain - 1) / kElementGrain;
+  runner->Run(nr_blocks, [&](int begin, int end) {
+    func(begin * kElementGrain, std::min(count, end * kElementGrain));
+  });
+}
+
+bool CanonicalAxis(const base::Blob<float> &blob, int axis, int *res) {
+  if (axis < -blob.num_axes() || axis >= blob.num_axes()) {
+    return false;
+  }
+  *res = axis < 0 ? axis + blob.num_axes() : axis;
+  return true;
+}
+
+int CeilDiv(int a, int b) {
+  return static_cast<int>(
+      std::ceil(static_cast<float>(a) / static_cast<float>(b)));
+}
+
+bool ParseConvGeometry(const ConvolutionParameter &conv,
+                       CpuConvGeometry *geometry) {
+  if (conv.has_kernel_h() || conv.has_kernel_w()) {
+    geometry->kernel_h = conv.kernel_h();
+    geometry->kernel_w = conv.kernel_w();
+  } else {
+    if (conv.kernel_size_size() < 1) {
+      return false;
+    }
+    geometry->kernel_h = conv.kernel_size(0);
+    geometry->kernel_w = conv.kernel_size_size() > 1 ? conv.kernel_size(1)
+                                                     : conv.kernel_size(0);
+  }
+  if (conv.has_pad_h() || conv.has_pad_w()) {
+    geometry->pad_h = conv.pad_h();
+    geometry->pad_w = conv.pad_w();
+  } else {
+    geometry->pad_h = conv.pad_size() == 0 ? 0 : conv.pad(0);
+    geometry->pad_w = conv.pad_size() > 1 ? conv.pad(1) : geometry->pad_h;
+  }
+  if (conv.has_stride_h() || conv.has_stride_w()) {
+    geometry->stride_h = conv.stride_h();
+    geometry->stride_w = conv.stride_w();
+  } else {
+    geometry->stride_h = conv.stride_size() == 0 ? 1 : conv.stride(0);
+    geometry->stride_w =
+        conv.stride_size() > 1 ? conv.stride(1) : geometry->stride_h;
+  }
+  geometry->dilation_h = conv.dilation_size() == 0 ? 1 : conv.dilation(0);
+  geometry->dilation_w =
+      conv.dilation_size() > 1 ? conv.dilation(1) : geometry->dilation_h;
+  return geometry->kernel_h > 0 && geometry->kernel_w > 0 &&
+         geometry->stride_h > 0 && geometry->stride_w > 0 &&
+         geometry->dilation_h > 0 && geometry->dilation_w > 0;
+}
+
+class ConvolutionLayer : public CpuLayer {
+ public:
+  bool Reshape(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const ConvolutionParameter &conv = param_.convolution_param();
+    if (!ParseConvGeometry(conv, &geometry_) || bottom[0]->num_axes() != 4) {
+      return false;
+    }
+    num_output_ = conv.num_output();
+    group_ = conv.group();
+    channels_ = bottom[0]->shape(1);
+    if (group_ <= 0 || channels_ % group_ != 0 || num_output_ % group_ != 0) {
+      return false;
+    }
+    geometry_.channels = channels_ / group_;
+    geometry_.height = bottom[0]->shape(2);
+    geometry_.width = bottom[0]->shape(3);
+    geometry_.out_height =
+        (geometry_.height + 2 * geometry_.pad_h -
+         (geometry_.dilation_h * (geometry_.kernel_h - 1) + 1)) /
+            geometry_.stride_h +
+        1;
+    geometry_.out_width =
+        (geometry_.width + 2 * geometry_.pad_w -
+         (geometry_.dilation_w * (geometry_.kernel_w - 1) + 1)) /
+            geometry_.stride_w +
+        1;
+    if (geometry_.out_height <= 0 || geometry_.out_width <= 0) {
+      return false;
+    }
+    kernel_dim_ = geometry_.channels * geometry_.kernel_h * geometry_.kernel_w;
+    if (weights_.empty() ||
+        static_cast<int>(weights_[0].size()) != num_output_ * kernel_dim_) {
+      AERROR << param_.name() << ": weights do not match the input channels";
+      return false;
+    }
+    if (weights_.size() > 1 &&
+        static_cast<int>(weights_[1].size()) != num_output_) {
+      return false;
+    }
+    is_1x1_ = geometry_.kernel_h == 1 && geometry_.kernel_w == 1 &&
+              geometry_.stride_h == 1 && geometry_.stride_w == 1 &&
+              geometry_.pad_h == 0 && geometry_.pad_w == 0;
+    if (!is_1x1_) {
+      col_.resize(static_cast<size_t>(kernel_dim_) * geometry_.out_height *
+                  geometry_.out_width);
+    }
+    top[0]->Reshape({bottom[0]->shape(0), num_output_, geometry_.out_height,
+                     geometry_.out_width});
+    return true;
+  }
+
+  void ForwardCPU(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const float *bottom_data = bottom[0]->cpu_data();
+    float *top_data = top[0]->mutable_cpu_data();
+    const int in_size = geometry_.height * geometry_.width;
+    const int out_size = geometry_.out_height * geometry_.out_width;
+    const int out_group = num_output_ / group_;
+    const float *bias = weights_.size() > 1 ? weights_[1].data() : nullptr;
+    for (int n = 0; n < bottom[0]->shape(0); ++n) {
+      for (int g = 0; g < group_; ++g) {
+        const float *in =
+            bottom_data + (n * channels_ + g * geometry_.channels) * in_size;
+        const float *col = in;
+        if (!is_1x1_) {
+          runner_->Run(geometry_.channels, [&](int begin, int end) {
+            CpuIm2Col(in, geometry_, begin, end, col_.data());
+          });
+          col = col_.data();
+        }
+        const float *weight = weights_[0].data() + g * out_group * kernel_dim_;
+        float *out = top_data + (n * num_output_ + g * out_group) * out_size;
+        runner_->Run(out_size, [&](int begin, int end) {
+          for (int o = 0; o < out_group; ++o) {
+            float value = bias == nullptr ? 0.f : bias[g * out_group + o];
+            std::fill(out + o * out_size + begin, out + o * out_size + end,
+                      value);
+          }
+          CpuGemm(out_group, end - begin, kernel_dim_, weight, kernel_dim_,
+                  col + begin, out_size, out + begin, out_size, true);
+        });
+      }
+    }
+  }
+
+ private:
+  CpuConvGeometry geometry_;
+  int num_output_ = 0;
+  int group_ = 1;
+  int channels_ = 0;
+  int kernel_dim_ = 0;
+  bool is_1x1_ = false;
+  std::vector<float> col_;
+};
+
+class DeconvolutionLayer : public CpuLayer {
+ public:
+  bool Reshape(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const ConvolutionParameter &conv = param_.convolution_param();
+    if (!ParseConvGeometry(conv, &geometry_) || bottom[0]->num_axes() != 4) {
+      return false;
+    }
+    num_output_ = conv.num_output();
+    group_ = conv.group();
+    int channels = bottom[0]->shape(1);
+    if (group_ <= 0 || channels % group_ != 0 || num_output_ % group_ != 0) {
+      return false;
+    }
+    in_height_ = bottom[0]->shape(2);
+    in_width_ = bottom[0]->shape(3);
+    // the output of the deconvolution is the image of the im2col geometry
+    geometry_.channels = num_output_ / group_;
+    geometry_.height = geometry_.stride_h * (in_height_ - 1) +
+                       geometry_.dilation_h * (geometry_.kernel_h - 1) + 1 -
+                       2 * geometry_.pad_h;
+    geometry_.width = geometry_.stride_w * (in_width_ - 1) +
+                      geometry_.dilation_w * (geometry_.kernel_w - 1) + 1 -
+                      2 * geometry_.pad_w;
+    geometry_.out_height = in_height_;
+    geometry_.out_width = in_width_;
+    if (geometry_.height <= 0 || geometry_.width <= 0) {
+      return false;
+    }
+    col_dim_ = geometry_.channels * geometry_.kernel_h * geometry_.kernel_w;
+    if (weights_.empty() ||
+        static_cast<int>(weights_[0].size()) != channels * col_dim_) {
+      AERROR << param_.name() << ": weights do not match the input channels";
+      return false;
+    }
+    if (weights_.size() > 1 &&
+        static_cast<int>(weights_[1].size()) != num_output_) {
+      return false;
+    }
+    if (channels != channels_) {
+      // weights are stored as channels x col_dim per group, the gemm needs
+      // the transposed col_dim x channels
+      channels_ = channels;
+      const int in_group = channels_ / group_;
+      transposed_weights_.resize(weights_[0].size());
+      for (int g = 0; g < group_; ++g) {
+        const float *src = weights_[0].data() + g * in_group * col_dim_;
+        float *dst = transposed_weights_.data() + g * in_group * col_dim_;
+        for (int c = 0; c < in_group; ++c) {
+          for (int r = 0; r < col_dim_; ++r) {
+            dst[r * in_group + c] = src[c * col_dim_ + r];
+          }
+        }
+      }
+    }
+    col_.resize(static_cast<size_t>(col_dim_) * in_height_ * in_width_);
+    top[0]->Reshape({bottom[0]->shape(0), num_output_, geometry_.height,
+                     geometry_.width});
+    return true;
+  }
+
+  void ForwardCPU(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const float *bottom_data = bottom[0]->cpu_data();
+    float *top_data = top[0]->mutable_cpu_data();
+    const int in_size = in_height_ * in_width_;
+    const int out_size = geometry_.height * geometry_.width;
+    const int in_group = channels_ / group_;
+    const float *bias = weights_.size() > 1 ? weights_[1].data() : nullptr;
+    for (int n = 0; n < bottom[0]->shape(0); ++n) {
+      for (int g = 0; g < group_; ++g) {
+        const float *in =
+            bottom_data + (n * channels_ + g * in_group) * in_size;
+        const float *weight =
+            transposed_weights_.data() + g * in_group * col_dim_;
+        float *col = col_.data();
+        runner_->Run(in_size, [&](int begin, int end) {
+          CpuGemm(col_dim_, end - begin, in_group, weight, in_group,
+                  in + begin, in_size, col + begin, in_size, false);
+        });
+        float *out =
+            top_data + (n * num_output_ + g * geometry_.channels) * out_size;
+        runner_->Run(geometry_.channels, [&](int begin, int end) {
+          CpuCol2Im(col, geometry_, begin, end, out);
+          if (bias == nullptr) {
+            return;
+          }
+          for (int c = begin; c < end; ++c) {
+            float value = bias[g * geometry_.channels + c];
+            float *plane = out + c * out_size;
+            for (int i = 0; i < out_size; ++i) {
+              plane[i] += value;
+            }
+          }
+        });
+      }
+    }
+  }
+
+ private:
+  CpuConvGeometry geometry_;
+  int num_output_ = 0;
+  int group_ = 1;
+  int channels_ = 0;
+  int in_height_ = 0;
+  int in_width_ = 0;
+  int col_dim_ = 0;
+  std::vector<float> transposed_weights_;
+  std::vector<float> col_;
+};
+
+class PoolingLayer : public CpuLayer {
+ public:
+  bool Reshape(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const PoolingParameter &pool = param_.pooling_param();
+    if (bottom[0]->num_axes() != 4) {
+      return false;
+    }
+    height_ = bottom[0]->shape(2);
+    width_ = bottom[0]->shape(3);
+    if (pool.global_pooling()) {
+      kernel_h_ = height_;
+      kernel_w_ = width_;
+      pad_h_ = pad_w_ = 0;
+      stride_h_ = stride_w_ = 1;
+    } else {
+      kernel_h_ = pool.has_kernel_size() ? pool.kernel_size() : pool.kernel_h();
+      kernel_w_ = pool.has_kernel_size() ? pool.kernel_size() : pool.kernel_w();
+      pad_h_ = pool.has_pad_h() ? pool.pad_h() : pool.pad();
+      pad_w_ = pool.has_pad_w() ? pool.pad_w() : pool.pad();
+      stride_h_ = pool.has_stride_h() ? pool.stride_h() : pool.stride();
+      stride_w_ = pool.has_stride_w() ? pool.stride_w() : pool.stride();
+    }
+    if (kernel_h_ <= 0 || kernel_w_ <= 0 || stride_h_ <= 0 || stride_w_ <= 0) {
+      return false;
+    }
+    if (pool.pool() != PoolingParameter_PoolMethod_MAX &&
+        pool.pool() != PoolingParameter_PoolMethod_AVE) {
+      AERROR << param_.name() << ": only MAX and AVE pooling are supported";
+      return false;
+    }
+    if (pool.cmp_out_shape_floor_as_conv()) {
+      pooled_height_ = (height_ + 2 * pad_h_ - kernel_h_) / stride_h_ + 1;
+      pooled_width_ = (width_ + 2 * pad_w_ - kernel_w_) / stride_w_ + 1;
+    } else {
+      pooled_height_ = CeilDiv(height_ + 2 * pad_h_ - kernel_h_, stride_h_) + 1;
+      pooled_width_ = CeilDiv(width_ + 2 * pad_w_ - kernel_w_, stride_w_) + 1;
+      // the last pooling window has to start inside the image
+      if (pad_h_ > 0 && (pooled_height_ - 1) * stride_h_ >= height_ + pad_h_) {
+        --pooled_height_;
+      }
+      if (pad_w_ > 0 && (pooled_width_ - 1) * stride_w_ >= width_ + pad_w_) {
+        --pooled_width_;
+      }
+    }
+    if (pooled_height_ <= 0 || pooled_width_ <= 0) {
+      return false;
+    }
+    top[0]->Reshape({bottom[0]->shape(0), bottom[0]->shape(1), pooled_height_,
+                     pooled_width_});
+    return true;
+  }
+
+  void ForwardCPU(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const float *bottom_data = bottom[0]->cpu_data();
+    float *top_data = top[0]->mutable_cpu_data();
+    const bool is_max =
+        param_.pooling_param().pool() == PoolingParameter_PoolMethod_MAX;
+    const int nr_planes = bottom[0]->shape(0) * bottom[0]->shape(1);
+    runner_->Run(nr_planes, [&](int begin, int end) {
+      for (int p = begin; p < end; ++p) {
+        const float *in = bottom_data + p * height_ * width_;
+        float *out = top_data + p * pooled_height_ * pooled_width_;
+        for (int ph = 0; ph < pooled_height_; ++ph) {
+          int hstart = ph * stride_h_ - pad_h_;
+          int hend = std::min(hstart + kernel_h_, height_ + pad_h_);
+          for (int pw = 0; pw < pooled_width_; ++pw) {
+            int wstart = pw * stride_w_ - pad_w_;
+            int wend = std::min(wstart + kernel_w_, width_ + pad_w_);
+            int pool_size = (hend - hstart) * (wend - wstart);
+            int h0 = std::max(hstart, 0);
+            int h1 = std::min(hend, height_);
+            int w0 = std::max(wstart, 0);
+            int w1 = std::min(wend, width_);
+            float value = is_max ? -FLT_MAX : 0.f;
+            for (int h = h0; h < h1; ++h) {
+              for (int w = w0; w < w1; ++w) {
+                float v = in[h * width_ + w];
+                value = is_max ? std::max(value, v) : value + v;
+              }
+            }
+            out[ph * pooled_width_ + pw] =
+                is_max ? value : value / static_cast<float>(pool_size);
+          }
+        }
+      }
+    });
+  }
+
+ private:
+  int height_ = 0;
+  int width_ = 0;
+  int kernel_h_ = 0;
+  int kernel_w_ = 0;
+  int pad_h_ = 0;
+  int pad_w_ = 0;
+  int stride_h_ = 1;
+  int stride_w_ = 1;
+  int pooled_height_ = 0;
+  int pooled_width_ = 0;
+};
+
+class ActivationLayer : public CpuLayer {
+ public:
+  bool Reshape(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    top[0]->ReshapeLike(*bottom[0]);
+    return true;
+  }
+
+  bool AllowInPlace() const override { return true; }
+
+  void ForwardCPU(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const float *src = bottom[0]->cpu_data();
+    float *dst = top[0]->mutable_cpu_data();
+    const std::string &type = param_.type();
+    const float negative_slope = param_.relu_param().negative_slope();
+    ParallelElements(runner_, bottom[0]->count(), [&](int begin, int end) {
+      if (type == "ReLU") {
+        CpuReLU(src + begin, end - begin, negative_slope, dst + begin);
+      } else if (type == "Sigmoid") {
+        for (int i = begin; i < end; ++i) {
+          dst[i] = 1.f / (1.f + std::exp(-src[i]));
+        }
+      } else {
+        for (int i = begin; i < end; ++i) {
+          dst[i] = std::tanh(src[i]);
+        }
+      }
+    });
+  }
+};
+
+class ConcatLayer : public CpuLayer {
+ public:
+  bool Reshape(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const ConcatParameter &concat = param_.concat_param();
+    int axis = concat.has_concat_dim() && !concat.has_axis()
+                   ? static_cast<int>(concat.concat_dim())
+                   : concat.axis();
+    if (!CanonicalAxis(*bottom[0], axis, &axis_)) {
+      return false;
+    }
+    std::vector<int> shape = bottom[0]->shape();
+    for (size_t i = 1; i < bottom.size(); ++i) {
+      if (bottom[i]->num_axes() != bottom[0]->num_axes()) {
+        return false;
+      }
+      for (int j = 0; j < bottom[0]->num_axes(); ++j) {
+        if (j != axis_ && bottom[i]->shape(j) != shape[j]) {
+          return false;
+        }
+      }
+      shape[axis_] += bottom[i]->shape(axis_);
+    }
+    top[0]->Reshape(shape);
+    return true;
+  }
+
+  void ForwardCPU(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    float *top_data = top[0]->mutable_cpu_data();
+    const int outer = top[0]->count(0, axis_);
+    const int top_inner = top[0]->count(axis_);
+    std::vector<int> offsets(bottom.size(), 0);
+    for (size_t i = 1; i < bottom.size(); ++i) {
+      offsets[i] = offsets[i - 1] + bottom[i - 1]->count(axis_);
+    }
+    runner_->Run(static_cast<int>(bottom.size()), [&](int begin, int end) {
+      for (int i = begin; i < end; ++i) {
+        const float *src = bottom[i]->cpu_data();
+        const int inner = bottom[i]->count(axis_);
+        for (int o = 0; o < outer; ++o) {
+          memcpy(top_data + o * top_inner + offsets[i], src + o * inner,
+                 inner * sizeof(float));
+        }
+      }
+    });
+  }
+
+ private:
+  int axis_ = 1;
+};
+
+class SliceLayer : public CpuLayer {
+ public:
+  bool Reshape(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const SliceParameter &slice = param_.slice_param();
+    int axis = slice.has_slice_dim() && !slice.has_axis()
+                   ? static_cast<int>(slice.slice_dim())
+                   : slice.axis();
+    if (!CanonicalAxis(*bottom[0], axis, &axis_)) {
+      return false;
+    }
+    const int dim = bottom[0]->shape(axis_);
+    const int nr_tops = static_cast<int>(top.size());
+    std::vector<int> points;
+    if (slice.slice_point_size() > 0) {
+      if (slice.slice_point_size() != nr_tops - 1) {
+        return false;
+      }
+      points.assign(slice.slice_point().begin(), slice.slice_point().end());
+    } else {
+      if (dim % nr_tops != 0) {
+        return false;
+      }
+      for (int i = 1; i < nr_tops; ++i) {
+        points.push_back(i * dim / nr_tops);
+      }
+    }
+    points.insert(points.begin(), 0);
+    points.push_back(dim);
+    std::vector<int> shape = bottom[0]->shape();
+    for (int i = 0; i < nr_tops; ++i) {
+      shape[axis_] = points[i + 1] - points[i];
+      if (shape[axis_] <= 0) {
+        return false;
+      }
+      top[i]->Reshape(shape);
+    }
+    starts_.assign(points.begin(), points.end() - 1);
+    return true;
+  }
+
+  void ForwardCPU(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const float *bottom_data = bottom[0]->cpu_data();
+    const int outer = bottom[0]->count(0, axis_);
+    const int bottom_inner = bottom[0]->count(axis_);
+    const int unit = bottom[0]->count(axis_ + 1);
+    runner_->Run(static_cast<int>(top.size()), [&](int begin, int end) {
+      for (int i = begin; i < end; ++i) {
+        float *dst = top[i]->mutable_cpu_data();
+        const int inner = top[i]->count(axis_);
+        for (int o = 0; o < outer; ++o) {
+          memcpy(dst + o * inner,
+                 bottom_data + o * bottom_inner + starts_[i] * unit,
+                 inner * sizeof(float));
+        }
+      }
+    });
+  }
+
+ private:
+  int axis_ = 1;
+  std::vector<int> starts_;
+};
+
+class EltwiseLayer : public CpuLayer {
+ public:
+  bool Reshape(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const EltwiseParameter &eltwise = param_.eltwise_param();
+    if (bottom.size() < 2 ||
+        (eltwise.coeff_size() != 0 &&
+         eltwise.coeff_size() != static_cast<int>(bottom.size()))) {
+      return false;
+    }
+    for (size_t i = 1; i < bottom.size(); ++i) {
+      if (bottom[i]->shape() != bottom[0]->shape()) {
+        return false;
+      }
+    }
+    coeffs_.assign(bottom.size(), 1.f);
+    for (int i = 0; i < eltwise.coeff_size(); ++i) {
+      coeffs_[i] = eltwise.coeff(i);
+    }
+    top[0]->ReshapeLike(*bottom[0]);
+    return true;
+  }
+
+  bool AllowInPlace() const override { return true; }
+
+  void ForwardCPU(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    std::vector<const float *> srcs;
+    for (const auto &blob : bottom) {
+      srcs.push_back(blob->cpu_data());
+    }
+    float *dst = top[0]->mutable_cpu_data();
+    const EltwiseParameter::EltwiseOp op = param_.eltwise_param().operation();
+    const int nr_srcs = static_cast<int>(srcs.size());
+    // every output is computed from all inputs before it is written, so the
+    // top may alias any of the bottoms
+    ParallelElements(runner_, bottom[0]->count(), [&](int begin, int end) {
+      for (int i = begin; i < end; ++i) {
+        float value = op == EltwiseParameter_EltwiseOp_SUM
+                          ? coeffs_[0] * srcs[0][i]
+                          : srcs[0][i];
+        for (int k = 1; k < nr_srcs; ++k) {
+          if (op == EltwiseParameter_EltwiseOp_SUM) {
+            value += coeffs_[k] * srcs[k][i];
+          } else if (op == EltwiseParameter_EltwiseOp_PROD) {
+            value *= srcs[k][i];
+          } else {
+            value = std::max(value, srcs[k][i]);
+          }
+        }
+        dst[i] = value;
+      }
+    });
+  }
+
+ private:
+  std::vector<float> coeffs_;
+};
+
+// Shared by BatchNorm and Scale: y = x * scale[d] + shift[d] where d runs
+// over the scale dimensions between outer and inner.
+class ChannelAffineLayer : public CpuLayer {
+ public:
+  bool AllowInPlace() const override { return true; }
+
+  void ForwardCPU(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const float *src = bottom[0]->cpu_data();
+    float *dst = top[0]->mutable_cpu_data();
+    const int dim = static_cast<int>(scale_.size());
+    runner_->Run(outer_ * dim, [&](int begin, int end) {
+      for (int p = begin; p < end; ++p) {
+        const float a = scale_[p % dim];
+        const float b = shift_[p % dim];
+        const float *x = src + static_cast<size_t>(p) * inner_;
+        float *y = dst + static_cast<size_t>(p) * inner_;
+        for (int i = 0; i < inner_; ++i) {
+          y[i] = x[i] * a + b;
+        }
+      }
+    });
+  }
+
+ protected:
+  int outer_ = 0;
+  int inner_ = 0;
+  std::vector<float> scale_;
+  std::vector<float> shift_;
+};
+
+class BatchNormLayer : public ChannelAffineLayer {
+ public:
+  bool Setup(const LayerParameter &param,
+             const CpuLayerWeights &weights) override {
+    if (weights.size() < 3 || weights[2].empty() ||
+        weights[0].size() != weights[1].size()) {
+      AERROR << param.name() << ": batch norm needs mean, variance and scale";
+      return false;
+    }
+    param_ = param;
+    // fold the moving statistics into one multiply add, same as RTNet
+    const float scale_factor = weights[2][0] == 0 ? 0 : 1 / weights[2][0];
+    const float eps = param.batch_norm_param().eps();
+    scale_.resize(weights[0].size());
+    shift_.resize(weights[0].size());
+    for (size_t c = 0; c < scale_.size(); ++c) {
+      scale_[c] = 1.0f / std::sqrt(weights[1][c] * scale_factor + eps);
+      shift_[c] = -weights[0][c] * scale_factor * scale_[c];
+    }
+    return true;
+  }
+
+  bool Reshape(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const int channels = bottom[0]->num_axes() > 1 ? bottom[0]->shape(1) : 1;
+    if (channels != static_cast<int>(scale_.size())) {
+      return false;
+    }
+    outer_ = bottom[0]->shape(0);
+    inner_ = bottom[0]->count(std::min(2, bottom[0]->num_axes()));
+    top[0]->ReshapeLike(*bottom[0]);
+    return true;
+  }
+};
+
+class ScaleLayer : public ChannelAffineLayer {
+ public:
+  bool Setup(const LayerParameter &param,
+             const CpuLayerWeights &weights) override {
+    param_ = param;
+    if (weights.empty() ||
+        (param.scale_param().bias_term() &&
+         (weights.size() < 2 || weights[1].size() != weights[0].size()))) {
+      AERROR << param.name() << ": only scale with learned weights is "
+             << "supported";
+      return false;
+    }
+    scale_ = weights[0];
+    if (param.scale_param().bias_term()) {
+      shift_ = weights[1];
+    } else {
+      shift_.assign(scale_.size(), 0.f);
+    }
+    return true;
+  }
+
+  bool Reshape(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    if (bottom.size() != 1) {
+      AERROR << param_.name() << ": scale by a second bottom is not supported";
+      return false;
+    }
+    const ScaleParameter &scale = param_.scale_param();
+    int axis = 0;
+    if (!CanonicalAxis(*bottom[0], scale.axis(), &axis)) {
+      return false;
+    }
+    int end_axis = scale.num_axes() < 0 ? bottom[0]->num_axes()
+                                        : axis + scale.num_axes();
+    if (end_axis > bottom[0]->num_axes() ||
+        bottom[0]->count(axis, end_axis) != static_cast<int>(scale_.size())) {
+      return false;
+    }
+    outer_ = bottom[0]->count(0, axis);
+    inner_ = bottom[0]->count(end_axis);
+    top[0]->ReshapeLike(*bottom[0]);
+    return true;
+  }
+};
+
+class PowerLayer : public CpuLayer {
+ public:
+  bool Reshape(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    top[0]->ReshapeLike(*bottom[0]);
+    return true;
+  }
+
+  bool AllowInPlace() const override { return true; }
+
+  void ForwardCPU(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const float *src = bottom[0]->cpu_data();
+    float *dst = top[0]->mutable_cpu_data();
+    const PowerParameter &power = param_.power_param();
+    const float p = power.power();
+    const float scale = power.scale();
+    const float shift = power.shift();
+    ParallelElements(runner_, bottom[0]->count(), [&](int begin, int end) {
+      for (int i = begin; i < end; ++i) {
+        float value = shift + scale * src[i];
+        dst[i] = p == 1.f ? value : std::pow(value, p);
+      }
+    });
+  }
+};
+
+class InnerProductLayer : public CpuLayer {
+ public:
+  bool Reshape(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const InnerProductParameter &inner_product = param_.inner_product_param();
+    int axis = 0;
+    if (!CanonicalAxis(*bottom[0], inner_product.axis(), &axis)) {
+      return false;
+    }
+    num_output_ = inner_product.num_output();
+    rows_ = bottom[0]->count(0, axis);
+    int dim = bottom[0]->count(axis);
+    if (weights_.empty() ||
+        static_cast<int>(weights_[0].size()) != num_output_ * dim) {
+      AERROR << param_.name() << ": weights do not match the input size";
+      return false;
+    }
+    if (weights_.size() > 1 &&
+        static_cast<int>(weights_[1].size()) != num_output_) {
+      return false;
+    }
+    if (dim != dim_) {
+      dim_ = dim;
+      if (inner_product.transpose()) {
+        transposed_weights_ = weights_[0];
+      } else {
+        transposed_weights_.resize(weights_[0].size());
+        for (int o = 0; o < num_output_; ++o) {
+          for (int k = 0; k < dim_; ++k) {
+            transposed_weights_[k * num_output_ + o] =
+                weights_[0][o * dim_ + k];
+          }
+        }
+      }
+    }
+    std::vector<int> shape(bottom[0]->shape().begin(),
+                           bottom[0]->shape().begin() + axis);
+    shape.push_back(num_output_);
+    top[0]->Reshape(shape);
+    return true;
+  }
+
+  void ForwardCPU(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const float *src = bottom[0]->cpu_data();
+    float *dst = top[0]->mutable_cpu_data();
+    const float *bias = weights_.size() > 1 ? weights_[1].data() : nullptr;
+    runner_->Run(num_output_, [&](int begin, int end) {
+      for (int r = 0; r < rows_; ++r) {
+        for (int o = begin; o < end; ++o) {
+          dst[r * num_output_ + o] = bias == nullptr ? 0.f : bias[o];
+        }
+      }
+      CpuGemm(rows_, end - begin, dim_, src, dim_,
+              transposed_weights_.data() + begin, num_output_, dst + begin,
+              num_output_, true);
+    });
+  }
+
+ private:
+  int num_output_ = 0;
+  int rows_ = 0;
+  int dim_ = 0;
+  std::vector<float> transposed_weights_;
+};
+
+class SoftmaxLayer : public CpuLayer {
+ public:
+  bool Reshape(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    if (!CanonicalAxis(*bottom[0], param_.softmax_param().axis(), &axis_)) {
+      return false;
+    }
+    top[0]->ReshapeLike(*bottom[0]);
+    return true;
+  }
+
+  bool AllowInPlace() const override { return true; }
+
+  void ForwardCPU(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const float *src = bottom[0]->cpu_data();
+    float *dst = top[0]->mutable_cpu_data();
+    const int outer = bottom[0]->count(0, axis_);
+    const int dim = bottom[0]->shape(axis_);
+    const int inner = bottom[0]->count(axis_ + 1);
+    for (int o = 0; o < outer; ++o) {
+      const float *x = src + o * dim * inner;
+      float *y = dst + o * dim * inner;
+      // reduce over dim for a range of contiguous inner positions at once
+      runner_->Run(inner, [&](int begin, int end) {
+        std::vector<float> max_value(x + begin, x + end);
+        for (int d = 1; d < dim; ++d) {
+          for (int i = begin; i < end; ++i) {
+            max_value[i - begin] = std::max(max_value[i - begin],
+                                            x[d * inner + i]);
+          }
+        }
+        std::vector<float> sum(end - begin, 0.f);
+        for (int d = 0; d < dim; ++d) {
+          for (int i = begin; i < end; ++i) {
+            float value = std::exp(x[d * inner + i] - max_value[i - begin]);
+            y[d * inner + i] = value;
+            sum[i - begin] += value;
+          }
+        }
+        for (int d = 0; d < dim; ++d) {
+          for (int i = begin; i < end; ++i) {
+            y[d * inner + i] /= sum[i - begin];
+          }
+        }
+      });
+    }
+  }
+
+ private:
+  int axis_ = 1;
+};
+
+class ReshapeLayer : public CpuLayer {
+ public:
+  bool Reshape(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const ReshapeParameter &reshape = param_.reshape_param();
+    const int nr_axes = bottom[0]->num_axes();
+    int start = reshape.axis() < 0 ? reshape.axis() + nr_axes + 1
+                                   : reshape.axis();
+    int end = reshape.num_axes() < 0 ? nr_axes : start + reshape.num_axes();
+    if (start < 0 || start > nr_axes || end > nr_axes) {
+      return false;
+    }
+    const std::vector<int> &bottom_shape = bottom[0]->shape();
+    std::vector<int> shape(bottom_shape.begin(), bottom_shape.begin() + start);
+    int inferred_axis = -1;
+    for (int i = 0; i < reshape.shape().dim_size(); ++i) {
+      int dim = static_cast<int>(reshape.shape().dim(i));
+      if (dim == 0) {
+        if (start + i >= nr_axes) {
+          return false;
+        }
+        dim = bottom_shape[start + i];
+      } else if (dim == -1) {
+        if (inferred_axis >= 0) {
+          return false;
+        }
+        inferred_axis = static_cast<int>(shape.size());
+        dim = 1;
+      }
+      shape.push_back(dim);
+    }
+    shape.insert(shape.end(), bottom_shape.begin() + end, bottom_shape.end());
+    int count = 1;
+    for (int dim : shape) {
+      count *= dim;
+    }
+    if (inferred_axis >= 0) {
+      if (count <= 0 || bottom[0]->count() % count != 0) {
+        return false;
+      }
+      shape[inferred_axis] = bottom[0]->count() / count;
+      count = bottom[0]->count();
+    }
+    if (count != bottom[0]->count()) {
+      return false;
+    }
+    top[0]->Reshape(shape);
+    return true;
+  }
+
+  void ForwardCPU(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    memcpy(top[0]->mutable_cpu_data(), bottom[0]->cpu_data(),
+           bottom[0]->count() * sizeof(float));
+  }
+};
+
+class PermuteLayer : public CpuLayer {
+ public:
+  bool Reshape(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const PermuteParameter &permute = param_.permute_param();
+    const int nr_axes = bottom[0]->num_axes();
+    std::vector<bool> used(nr_axes, false);
+    order_.clear();
+    for (int i = 0; i < permute.order_size(); ++i) {
+      int axis = static_cast<int>(permute.order(i));
+      if (axis >= nr_axes || used[axis]) {
+        return false;
+      }
+      used[axis] = true;
+      order_.push_back(axis);
+    }
+    // the unspecified axes keep their relative order, as in caffe
+    for (int i = 0; i < nr_axes; ++i) {
+      if (!used[i]) {
+        order_.push_back(i);
+      }
+    }
+    std::vector<int> shape(nr_axes);
+    for (int i = 0; i < nr_axes; ++i) {
+      shape[i] = bottom[0]->shape(order_[i]);
+    }
+    top[0]->Reshape(shape);
+    // stride in the bottom for a step along each top axis
+    strides_.resize(nr_axes);
+    for (int i = 0; i < nr_axes; ++i) {
+      strides_[i] = bottom[0]->count(order_[i] + 1);
+    }
+    return true;
+  }
+
+  void ForwardCPU(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const float *src = bottom[0]->cpu_data();
+    float *dst = top[0]->mutable_cpu_data();
+    const std::vector<int> &shape = top[0]->shape();
+    const int nr_axes = static_cast<int>(shape.size());
+    ParallelElements(runner_, top[0]->count(), [&](int begin, int end) {
+      for (int i = begin; i < end; ++i) {
+        int index = i;
+        int offset = 0;
+        for (int axis = nr_axes - 1; axis >= 0; --axis) {
+          offset += (index % shape[axis]) * strides_[axis];
+          index /= shape[axis];
+        }
+        dst[i] = src[offset];
+      }
+    });
+  }
+
+ private:
+  std::vector<int> order_;
+  std::vector<int> strides_;
+};
+
+class PaddingLayer : public CpuLayer {
+ public:
+  bool Reshape(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    if (bottom[0]->num_axes() != 4) {
+      return false;
+    }
+    const PaddingParameter &padding = param_.padding_param();
+    top[0]->Reshape(
+        {bottom[0]->shape(0), bottom[0]->shape(1),
+         bottom[0]->shape(2) + static_cast<int>(padding.pad_t() +
+                                                padding.pad_b()),
+         bottom[0]->shape(3) + static_cast<int>(padding.pad_l() +
+                                                padding.pad_r())});
+    return true;
+  }
+
+  void ForwardCPU(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const PaddingParameter &padding = param_.padding_param();
+    const float *src = bottom[0]->cpu_data();
+    float *dst = top[0]->mutable_cpu_data();
+    const int height = bottom[0]->shape(2);
+    const int width = bottom[0]->shape(3);
+    const int out_height = top[0]->shape(2);
+    const int out_width = top[0]->shape(3);
+    const int nr_planes = bottom[0]->shape(0) * bottom[0]->shape(1);
+    runner_->Run(nr_planes, [&](int begin, int end) {
+      for (int p = begin; p < end; ++p) {
+        float *out = dst + p * out_height * out_width;
+        std::fill(out, out + out_height * out_width, padding.val());
+        for (int h = 0; h < height; ++h) {
+          memcpy(out + (h + padding.pad_t()) * out_width + padding.pad_l(),
+                 src + (p * height + h) * width, width * sizeof(float));
+        }
+      }
+    });
+  }
+};
+
+class ArgMaxLayer : public CpuLayer {
+ public:
+  bool Reshape(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const ArgMaxParameter &argmax = param_.argmax_param();
+    if (argmax.top_k() != 1) {
+      AERROR << param_.name() << ": only top_k = 1 is supported";
+      return false;
+    }
+    std::vector<int> shape;
+    if (argmax.has_axis()) {
+      if (!CanonicalAxis(*bottom[0], argmax.axis(), &axis_)) {
+        return false;
+      }
+      shape = bottom[0]->shape();
+      shape[axis_] = 1;
+    } else {
+      // all axes but num are flattened, caffe writes index and value pairs
+      axis_ = 1;
+      shape = {bottom[0]->shape(0), argmax.out_max_val() ? 2 : 1, 1};
+    }
+    top[0]->Reshape(shape);
+    return true;
+  }
+
+  void ForwardCPU(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    const ArgMaxParameter &argmax = param_.argmax_param();
+    const float *src = bottom[0]->cpu_data();
+    float *dst = top[0]->mutable_cpu_data();
+    const bool flatten = !argmax.has_axis();
+    const int outer = bottom[0]->count(0, axis_);
+    const int dim = flatten ? bottom[0]->count(1) : bottom[0]->shape(axis_);
+    const int inner = flatten ? 1 : bottom[0]->count(axis_ + 1);
+    runner_->Run(outer * inner, [&](int begin, int end) {
+      for (int p = begin; p < end; ++p) {
+        const float *x = src + (p / inner) * dim * inner + p % inner;
+        int best = 0;
+        for (int d = 1; d < dim; ++d) {
+          if (x[d * inner] > x[best * inner]) {
+            best = d;
+          }
+        }
+        if (flatten) {
+          dst[p * (argmax.out_max_val() ? 2 : 1)] = static_cast<float>(best);
+          if (argmax.out_max_val()) {
+            dst[p * 2 + 1] = x[best];
+          }
+        } else {
+          dst[p] = argmax.out_max_val() ? x[best * inner]
+                                        : static_cast<float>(best);
+        }
+      }
+    });
+  }
+
+ private:
+  int axis_ = 1;
+};
+
+class IdentityLayer : public CpuLayer {
+ public:
+  bool Reshape(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    top[0]->ReshapeLike(*bottom[0]);
+    return true;
+  }
+
+  bool AllowInPlace() const override { return true; }
+
+  void ForwardCPU(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    if (top[0] != bottom[0]) {
+      memcpy(top[0]->mutable_cpu_data(), bottom[0]->cpu_data(),
+             bottom[0]->count() * sizeof(float));
+    }
+  }
+};
+
+// consumes its bottoms without producing anything
+class SilenceLayer : public CpuLayer {
+ public:
+  bool Reshape(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    return true;
+  }
+
+  void ForwardCPU(const CpuBlobVec &bottom, const CpuBlobVec &top) override {}
+};
+
+}  // namespace
+
+CpuLayer *CreateCpuLayer(const std::string &type) {
+  if (type == "Convolution") {
+    return new ConvolutionLayer;
+  } else if (type == "Deconvolution") {
+    return new DeconvolutionLayer;
+  } else if (type == "Pooling") {
+    return new PoolingLayer;
+  } else if (type == "ReLU" || type == "Sigmoid" || type == "TanH") {
+    return new ActivationLayer;
+  } else if (type == "Concat") {
+    return new ConcatLayer;
+  } else if (type == "Slice") {
+    return new SliceLayer;
+  } else if (type == "Eltwise") {
+    return new EltwiseLayer;
+  } else if (type == "BatchNorm") {
+    return new BatchNormLayer;
+  } else if (type == "Scale") {
+    return new ScaleLayer;
+  } else if (type == "Power") {
+    return new PowerLayer;
+  } else if (type == "InnerProduct") {
+    return new InnerProductLayer;
+  } else if (type == "Softmax") {
+    return new SoftmaxLayer;
+  } else if (type == "Reshape") {
+    return new ReshapeLayer;
+  } else if (type == "Permute") {
+    return new PermuteLayer;
+  } else if (type == "Padding") {
+    return new PaddingLayer;
+  } else if (type == "ArgMax") {
+    return new ArgMaxLayer;
+  } else if (type == "Dropout") {
+    return new IdentityLayer;
+  } else if (type == "Silence") {
+    return new SilenceLayer;
+  }
+  return nullptr;
+}
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,74 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/perception/inference/cpu/cpu_kernels.h"
+#include "modules/perception/inference/layer.h"
+#include "modules/perception/proto/rt.pb.h"
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+typedef std::vector<std::shared_ptr<base::Blob<float>>> CpuBlobVec;
+typedef std::vector<std::vector<float>> CpuLayerWeights;
+
+// Host implementation of a caffe layer, the life cycle follows caffe:
+// Setup once with the layer parameter and the trained weights, Reshape
+// whenever the bottom shapes change, then ForwardCPU.
+class CpuLayer : public Layer<float> {
+ public:
+  CpuLayer() = default;
+  virtual ~CpuLayer() = default;
+
+  virtual bool Setup(const LayerParameter &param,
+                     const CpuLayerWeights &weights) {
+    param_ = param;
+    weights_ = weights;
+    return true;
+  }
+
+  // set the top shapes from the bottom shapes, return false if the bottoms
+  // do not fit the layer parameter or the weights
+  virtual bool Reshape(const CpuBlobVec &bottom, const CpuBlobVec &top) = 0;
+
+  // whether the top may be the same blob as the first bottom
+  virtual bool AllowInPlace() const { return false; }
+
+  // there is no device implementation, the layers always run on the host
+  void ForwardGPU(const CpuBlobVec &bottom, const CpuBlobVec &top) override {
+    ForwardCPU(bottom, top);
+  }
+
+  void set_runner(CpuParallelRunner *runner) { runner_ = runner; }
+  const std::string &name() const { return param_.name(); }
+
+ protected:
+  LayerParameter param_;
+  CpuLayerWeights weights_;
+  CpuParallelRunner *runner_ = nullptr;
+};
+
+// Create the layer of the given caffe type, nullptr if it is not supported.
+CpuLayer *CreateCpuLayer(const std::string &type);
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
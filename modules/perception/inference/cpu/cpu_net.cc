@@ -0,0 +1,248 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/inference/cpu/cpu_net.h"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+#include "cyber/common/log.h"
+#include "modules/perception/inference/utils/proto_util.h"
+
+namespace apollo {
+namespace perception {
+namespace inference {
+namespace {
+
+// training only layers such as data and loss layers are skipped
+bool IsTestLayer(const LayerParameter &layer_param) {
+  for (const auto &rule : layer_param.include()) {
+    if (rule.has_phase() && rule.phase() != TEST) {
+      return false;
+    }
+  }
+  for (const auto &rule : layer_param.exclude()) {
+    if (rule.has_phase() && rule.phase() == TEST) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+CpuNet::CpuNet(const std::string &net_file, const std::string &model_file,
+               const std::vector<std::string> &outputs,
+               const std::vector<std::string> &inputs)
+    : net_file_(net_file),
+      model_file_(model_file),
+      output_names_(outputs),
+      input_names_(inputs) {}
+
+bool CpuNet::LoadWeights() {
+  NetParameter net;
+  if (!ReadProtoFromBinaryFile(model_file_, &net)) {
+    AERROR << "open file " << model_file_ << " failed";
+    return false;
+  }
+  for (const auto &layer_param : net.layer()) {
+    CpuLayerWeights weights;
+    for (const auto &blob : layer_param.blobs()) {
+      if (blob.data_size() > 0) {
+        weights.emplace_back(blob.data().begin(), blob.data().end());
+      } else {
+        weights.emplace_back(blob.double_data().begin(),
+                             blob.double_data().end());
+      }
+    }
+    weight_map_[layer_param.name()] = std::move(weights);
+  }
+  return true;
+}
+
+bool CpuNet::AddInput(const std::string &name, const BlobShape &shape,
+                      const std::map<std::string, std::vector<int>> &shapes,
+                      BlobMap *tensor_map) {
+  std::vector<int> dims(shape.dim().begin(), shape.dim().end());
+  auto iter = shapes.find(name);
+  if (iter != shapes.end()) {
+    dims = iter->second;
+  }
+  if (dims.empty()) {
+    AERROR << "no shape for input " << name;
+    return false;
+  }
+  (*tensor_map)[name].reset(new base::Blob<float>(dims));
+  return true;
+}
+
+bool CpuNet::Init(const std::map<std::string, std::vector<int>> &shapes) {
+  net_param_.reset(new NetParameter);
+  if (!loadNetParams(net_file_, net_param_.get()) ||
+      net_param_->layer_size() == 0) {
+    AERROR << "failed to load net " << net_file_;
+    return false;
+  }
+  if (!LoadWeights()) {
+    return false;
+  }
+  int num_threads = num_threads_;
+  if (num_threads <= 0) {
+    num_threads = std::max(1, static_cast<int>(
+                                  std::thread::hardware_concurrency()));
+  }
+  runner_.reset(new CpuParallelRunner(num_threads));
+
+  BlobMap tensor_map;
+  for (int i = 0; i < net_param_->input_size(); ++i) {
+    BlobShape shape;
+    if (i < net_param_->input_shape_size()) {
+      shape = net_param_->input_shape(i);
+    } else if (net_param_->input_dim_size() >= 4 * (i + 1)) {
+      for (int j = 0; j < 4; ++j) {
+        shape.add_dim(net_param_->input_dim(4 * i + j));
+      }
+    }
+    if (!AddInput(net_param_->input(i), shape, shapes, &tensor_map)) {
+      return false;
+    }
+  }
+
+  for (const auto &layer_param : net_param_->layer()) {
+    if (!IsTestLayer(layer_param)) {
+      continue;
+    }
+    if (layer_param.type() == "Input") {
+      if (layer_param.top_size() != 1 ||
+          layer_param.input_param().shape_size() != 1 ||
+          !AddInput(layer_param.top(0), layer_param.input_param().shape(0),
+                    shapes, &tensor_map)) {
+        AERROR << "bad input layer " << layer_param.name();
+        return false;
+      }
+      continue;
+    }
+    std::unique_ptr<CpuLayer> layer(CreateCpuLayer(layer_param.type()));
+    if (layer == nullptr) {
+      AERROR << "unsupported layer type " << layer_param.type() << " of "
+             << layer_param.name();
+      return false;
+    }
+    layer->set_runner(runner_.get());
+    if (!layer->Setup(layer_param, weight_map_[layer_param.name()])) {
+      AERROR << "failed to setup layer " << layer_param.name();
+      return false;
+    }
+    CpuBlobVec bottom;
+    for (const auto &name : layer_param.bottom()) {
+      auto iter = tensor_map.find(name);
+      if (iter == tensor_map.end()) {
+        AERROR << "unknown bottom " << name << " of " << layer_param.name();
+        return false;
+      }
+      bottom.push_back(iter->second);
+    }
+    if (bottom.empty()) {
+      AERROR << "layer " << layer_param.name() << " has no bottom";
+      return false;
+    }
+    CpuBlobVec top;
+    for (int i = 0; i < layer_param.top_size(); ++i) {
+      const std::string &name = layer_param.top(i);
+      if (i < layer_param.bottom_size() && name == layer_param.bottom(i)) {
+        if (i > 0 || !layer->AllowInPlace()) {
+          AERROR << "layer " << layer_param.name() << " cannot run in place";
+          return false;
+        }
+        top.push_back(bottom[i]);
+        continue;
+      }
+      // a top reusing the name of an earlier blob replaces it for the
+      // following layers
+      std::shared_ptr<base::Blob<float>> blob(new base::Blob<float>);
+      tensor_map[name] = blob;
+      top.push_back(blob);
+    }
+    layers_.push_back(std::move(layer));
+    bottoms_.push_back(std::move(bottom));
+    tops_.push_back(std::move(top));
+  }
+  // the layers keep their own copy of the weights
+  weight_map_.clear();
+
+  for (const auto &name : input_names_) {
+    auto iter = tensor_map.find(name);
+    if (iter == tensor_map.end()) {
+      AERROR << "unknown input " << name;
+      return false;
+    }
+    blobs_[name] = iter->second;
+  }
+  for (auto iter = output_names_.begin(); iter != output_names_.end();) {
+    auto blob_iter = tensor_map.find(*iter);
+    if (blob_iter != tensor_map.end()) {
+      blobs_[*iter] = blob_iter->second;
+      ++iter;
+    } else {
+      AINFO << "Erase output: " << *iter;
+      iter = output_names_.erase(iter);
+    }
+  }
+  return Reshape();
+}
+
+bool CpuNet::Reshape() {
+  input_shapes_.clear();
+  for (const auto &name : input_names_) {
+    input_shapes_.push_back(blobs_[name]->shape());
+  }
+  for (size_t i = 0; i < layers_.size(); ++i) {
+    if (!layers_[i]->Reshape(bottoms_[i], tops_[i])) {
+      AERROR << "layer " << layers_[i]->name()
+             << " does not fit the shape of its bottoms";
+      return false;
+    }
+  }
+  return true;
+}
+
+void CpuNet::Infer() {
+  // reshape the net like caffe when the inputs are reshaped outside
+  for (size_t i = 0; i < input_names_.size(); ++i) {
+    if (blobs_[input_names_[i]]->shape() != input_shapes_[i]) {
+      if (!Reshape()) {
+        return;
+      }
+      break;
+    }
+  }
+  for (size_t i = 0; i < layers_.size(); ++i) {
+    layers_[i]->ForwardCPU(bottoms_[i], tops_[i]);
+  }
+}
+
+std::shared_ptr<apollo::perception::base::Blob<float>> CpuNet::get_blob(
+    const std::string &name) {
+  auto iter = blobs_.find(name);
+  if (iter == blobs_.end()) {
+    return nullptr;
+  }
+  return iter->second;
+}
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,79 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/perception/inference/cpu/cpu_layers.h"
+#include "modules/perception/inference/inference.h"
+#include "modules/perception/proto/rt.pb.h"
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+// Runs a caffe prototxt and caffemodel on the host without caffe or cuda,
+// for machines without a gpu. The layer set is the one supported by RTNet.
+class CpuNet : public Inference {
+ public:
+  CpuNet(const std::string &net_file, const std::string &model_file,
+         const std::vector<std::string> &outputs,
+         const std::vector<std::string> &inputs);
+
+  virtual ~CpuNet() = default;
+
+  bool Init(const std::map<std::string, std::vector<int>> &shapes) override;
+
+  void Infer() override;
+
+  std::shared_ptr<apollo::perception::base::Blob<float>> get_blob(
+      const std::string &name) override;
+
+  // number of threads running the layers, should be called before Init,
+  // defaults to the number of cores
+  void set_num_threads(int num_threads) { num_threads_ = num_threads; }
+
+ protected:
+  bool LoadWeights();
+  bool AddInput(const std::string &name, const BlobShape &shape,
+                const std::map<std::string, std::vector<int>> &shapes,
+                BlobMap *tensor_map);
+  bool Reshape();
+
+ private:
+  std::string net_file_;
+  std::string model_file_;
+  std::shared_ptr<NetParameter> net_param_;
+  std::map<std::string, CpuLayerWeights> weight_map_;
+  std::vector<std::string> output_names_;
+  std::vector<std::string> input_names_;
+
+  std::vector<std::unique_ptr<CpuLayer>> layers_;
+  std::vector<CpuBlobVec> bottoms_;
+  std::vector<CpuBlobVec> tops_;
+  // input shapes the layers are reshaped for
+  std::vector<std::vector<int>> input_shapes_;
+  std::unique_ptr<CpuParallelRunner> runner_;
+  int num_threads_ = 0;
+  BlobMap blobs_;
+};
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,265 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/inference/cpu/cpu_net.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "google/protobuf/text_format.h"
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+namespace {
+
+std::string TestFile(const std::string &name) {
+  const char *dir = std::getenv("TEST_TMPDIR");
+  return std::string(dir == nullptr ? "/tmp" : dir) + "/" + name;
+}
+
+void FillRandom(int seed, int size, BlobProto *blob) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  for (int i = 0; i < size; ++i) {
+    blob->add_data(dist(rng));
+  }
+}
+
+// writes the prototxt and the caffemodel of net, the weights are the blobs
+// of the layers
+void WriteNet(const NetParameter &net, const std::string &name) {
+  NetParameter deploy = net;
+  for (auto &layer : *deploy.mutable_layer()) {
+    layer.clear_blobs();
+  }
+  std::string text;
+  google::protobuf::TextFormat::PrintToString(deploy, &text);
+  std::ofstream(TestFile(name + ".prototxt")) << text;
+  std::ofstream model(TestFile(name + ".caffemodel"), std::ios::binary);
+  net.SerializeToOstream(&model);
+}
+
+LayerParameter *AddLayer(const std::string &name, const std::string &type,
+                         const std::string &bottom, const std::string &top,
+                         NetParameter *net) {
+  LayerParameter *layer = net->add_layer();
+  layer->set_name(name);
+  layer->set_type(type);
+  if (!bottom.empty()) {
+    layer->add_bottom(bottom);
+  }
+  layer->add_top(top);
+  return layer;
+}
+
+void AddInputLayer(const std::vector<int> &shape, NetParameter *net) {
+  LayerParameter *layer = AddLayer("data", "Input", "", "data", net);
+  BlobShape *blob_shape = layer->mutable_input_param()->add_shape();
+  for (int dim : shape) {
+    blob_shape->add_dim(dim);
+  }
+}
+
+}  // namespace
+
+TEST(CpuNetTest, conv_deconv_test) {
+  const int kChannels = 3;
+  const int kHeight = 12;
+  const int kWidth = 10;
+  NetParameter net;
+  AddInputLayer({1, kChannels, kHeight, kWidth}, &net);
+  LayerParameter *conv =
+      AddLayer("conv1", "Convolution", "data", "conv1", &net);
+  conv->mutable_convolution_param()->set_num_output(4);
+  conv->mutable_convolution_param()->add_kernel_size(3);
+  conv->mutable_convolution_param()->add_pad(1);
+  conv->mutable_convolution_param()->add_stride(2);
+  FillRandom(1, 4 * kChannels * 9, conv->add_blobs());
+  FillRandom(2, 4, conv->add_blobs());
+  AddLayer("relu1", "ReLU", "conv1", "conv1", &net);
+  LayerParameter *deconv =
+      AddLayer("deconv1", "Deconvolution", "conv1", "deconv1", &net);
+  deconv->mutable_convolution_param()->set_num_output(2);
+  deconv->mutable_convolution_param()->add_kernel_size(4);
+  deconv->mutable_convolution_param()->add_pad(1);
+  deconv->mutable_convolution_param()->add_stride(2);
+  FillRandom(3, 4 * 2 * 16, deconv->add_blobs());
+  FillRandom(4, 2, deconv->add_blobs());
+  WriteNet(net, "conv_deconv");
+
+  // reference by direct convolution and scattering deconvolution
+  std::vector<float> input;
+  BlobProto input_blob;
+  FillRandom(5, kChannels * kHeight * kWidth, &input_blob);
+  input.assign(input_blob.data().begin(), input_blob.data().end());
+  const int conv_h = (kHeight + 2 - 3) / 2 + 1;
+  const int conv_w = (kWidth + 2 - 3) / 2 + 1;
+  std::vector<float> conv_out(4 * conv_h * conv_w);
+  for (int o = 0; o < 4; ++o) {
+    for (int oh = 0; oh < conv_h; ++oh) {
+      for (int ow = 0; ow < conv_w; ++ow) {
+        float sum = conv->blobs(1).data(o);
+        for (int c = 0; c < kChannels; ++c) {
+          for (int kh = 0; kh < 3; ++kh) {
+            for (int kw = 0; kw < 3; ++kw) {
+              int h = oh * 2 - 1 + kh;
+              int w = ow * 2 - 1 + kw;
+              if (h >= 0 && h < kHeight && w >= 0 && w < kWidth) {
+                int weight_index = ((o * kChannels + c) * 3 + kh) * 3 + kw;
+                sum += conv->blobs(0).data(weight_index) *
+                       input[(c * kHeight + h) * kWidth + w];
+              }
+            }
+          }
+        }
+        conv_out[(o * conv_h + oh) * conv_w + ow] = std::max(sum, 0.f);
+      }
+    }
+  }
+  const int deconv_h = (conv_h - 1) * 2 + 4 - 2;
+  const int deconv_w = (conv_w - 1) * 2 + 4 - 2;
+  std::vector<float> expected(2 * deconv_h * deconv_w);
+  for (int o = 0; o < 2; ++o) {
+    for (int i = 0; i < deconv_h * deconv_w; ++i) {
+      expected[o * deconv_h * deconv_w + i] = deconv->blobs(1).data(o);
+    }
+  }
+  for (int c = 0; c < 4; ++c) {
+    for (int ih = 0; ih < conv_h; ++ih) {
+      for (int iw = 0; iw < conv_w; ++iw) {
+        for (int o = 0; o < 2; ++o) {
+          for (int kh = 0; kh < 4; ++kh) {
+            for (int kw = 0; kw < 4; ++kw) {
+              int h = ih * 2 - 1 + kh;
+              int w = iw * 2 - 1 + kw;
+              if (h >= 0 && h < deconv_h && w >= 0 && w < deconv_w) {
+                expected[(o * deconv_h + h) * deconv_w + w] +=
+                    deconv->blobs(0).data(((c * 2 + o) * 4 + kh) * 4 + kw) *
+                    conv_out[(c * conv_h + ih) * conv_w + iw];
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  for (int num_threads : {1, 4}) {
+    CpuNet cpu_net(TestFile("conv_deconv.prototxt"),
+                   TestFile("conv_deconv.caffemodel"), {"deconv1"}, {"data"});
+    cpu_net.set_gpu_id(-1);
+    cpu_net.set_num_threads(num_threads);
+    std::map<std::string, std::vector<int>> shapes;
+    EXPECT_TRUE(cpu_net.Init(shapes));
+    auto data = cpu_net.get_blob("data");
+    ASSERT_NE(data, nullptr);
+    std::copy(input.begin(), input.end(), data->mutable_cpu_data());
+    cpu_net.Infer();
+    auto output = cpu_net.get_blob("deconv1");
+    ASSERT_NE(output, nullptr);
+    EXPECT_EQ(output->shape(), std::vector<int>({1, 2, deconv_h, deconv_w}));
+    for (int i = 0; i < output->count(); ++i) {
+      EXPECT_NEAR(output->cpu_data()[i], expected[i], 1e-4);
+    }
+  }
+}
+
+TEST(CpuNetTest, bn_scale_pool_test) {
+  NetParameter net;
+  AddInputLayer({1, 2, 5, 6}, &net);
+  LayerParameter *bn = AddLayer("bn", "BatchNorm", "data", "bn", &net);
+  bn->add_blobs()->add_data(2.f);  // mean
+  bn->mutable_blobs(0)->add_data(4.f);
+  bn->add_blobs()->add_data(8.f);  // variance
+  bn->mutable_blobs(1)->add_data(2.f);
+  bn->add_blobs()->add_data(2.f);  // scale factor
+  bn->mutable_batch_norm_param()->set_eps(0.f);
+  LayerParameter *scale = AddLayer("scale", "Scale", "bn", "bn", &net);
+  scale->mutable_scale_param()->set_bias_term(true);
+  scale->add_blobs()->add_data(3.f);
+  scale->mutable_blobs(0)->add_data(1.f);
+  scale->add_blobs()->add_data(1.f);
+  scale->mutable_blobs(1)->add_data(-1.f);
+  LayerParameter *pool = AddLayer("pool", "Pooling", "bn", "pool", &net);
+  pool->mutable_pooling_param()->set_kernel_size(3);
+  pool->mutable_pooling_param()->set_stride(2);
+  LayerParameter *pool_floor =
+      AddLayer("pool_floor", "Pooling", "bn", "pool_floor", &net);
+  pool_floor->mutable_pooling_param()->set_kernel_size(3);
+  pool_floor->mutable_pooling_param()->set_stride(2);
+  pool_floor->mutable_pooling_param()->set_pool(PoolingParameter::AVE);
+  pool_floor->mutable_pooling_param()->set_cmp_out_shape_floor_as_conv(true);
+  WriteNet(net, "bn_scale_pool");
+
+  CpuNet cpu_net(TestFile("bn_scale_pool.prototxt"),
+                 TestFile("bn_scale_pool.caffemodel"),
+                 {"pool", "pool_floor", "missing"}, {"data"});
+  std::map<std::string, std::vector<int>> shapes;
+  EXPECT_TRUE(cpu_net.Init(shapes));
+  EXPECT_EQ(cpu_net.get_blob("missing"), nullptr);
+  auto data = cpu_net.get_blob("data");
+  ASSERT_NE(data, nullptr);
+  for (int i = 0; i < data->count(); ++i) {
+    data->mutable_cpu_data()[i] = 3.f;
+  }
+  cpu_net.Infer();
+  // channel 0: (3 - 1) / 2 * 3 + 1, channel 1: (3 - 2) / 1 * 1 - 1
+  auto pool_blob = cpu_net.get_blob("pool");
+  ASSERT_NE(pool_blob, nullptr);
+  EXPECT_EQ(pool_blob->shape(), std::vector<int>({1, 2, 2, 3}));
+  auto pool_floor_blob = cpu_net.get_blob("pool_floor");
+  ASSERT_NE(pool_floor_blob, nullptr);
+  EXPECT_EQ(pool_floor_blob->shape(), std::vector<int>({1, 2, 2, 2}));
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_FLOAT_EQ(pool_blob->cpu_data()[i], 4.f);
+    EXPECT_FLOAT_EQ(pool_blob->cpu_data()[6 + i], 0.f);
+  }
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_FLOAT_EQ(pool_floor_blob->cpu_data()[i], 4.f);
+    EXPECT_FLOAT_EQ(pool_floor_blob->cpu_data()[4 + i], 0.f);
+  }
+
+  // the net follows inputs reshaped outside like caffe
+  data->Reshape({1, 2, 9, 9});
+  cpu_net.Infer();
+  EXPECT_EQ(pool_blob->shape(), std::vector<int>({1, 2, 4, 4}));
+}
+
+TEST(CpuNetTest, unsupported_test) {
+  NetParameter net;
+  AddInputLayer({1, 1, 4, 4}, &net);
+  AddLayer("lrn", "LRN", "data", "lrn", &net);
+  WriteNet(net, "unsupported");
+  CpuNet cpu_net(TestFile("unsupported.prototxt"),
+                 TestFile("unsupported.caffemodel"), {"lrn"}, {"data"});
+  std::map<std::string, std::vector<int>> shapes;
+  EXPECT_FALSE(cpu_net.Init(shapes));
+
+  CpuNet missing_net(TestFile("missing.prototxt"),
+                     TestFile("missing.caffemodel"), {"lrn"}, {"data"});
+  EXPECT_FALSE(missing_net.Init(shapes));
+}
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
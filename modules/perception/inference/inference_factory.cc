@@ -17,6 +17,7 @@
 #include "modules/perception/inference/inference_factory.h"
 
 #include "modules/perception/inference/caffe/caffe_net.h"
+#include "modules/perception/inference/cpu/cpu_net.h"
 #include "modules/perception/inference/tensorrt/rt_net.h"
 
 namespace apollo {
@@ -35,6 +36,8 @@ Inference *CreateInferenceByName(const std::string &name,
     return new RTNet(proto_file, weight_file, outputs, inputs);
   } else if (name == "RTNetInt8") {
     return new RTNet(proto_file, weight_file, outputs, inputs, model_root);
+  } else if (name == "CpuNet") {
+    return new CpuNet(proto_file, weight_file, outputs, inputs);
   }
   return nullptr;
 }
@@ -16,9 +16,14 @@
 
 #include "modules/perception/inference/inference_factory.h"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "modules/perception/inference/caffe/caffe_net.h"
+#include "modules/perception/inference/cpu/cpu_net.h"
 #include "modules/perception/inference/tensorrt/rt_net.h"
 
 namespace apollo {
@@ -27,6 +32,17 @@ namespace inference {
 
 TEST(Inference_Factory, default) {}
 
+TEST(Inference_Factory, cpu_net) {
+  std::vector<std::string> outputs{"output"};
+  std::vector<std::string> inputs{"data"};
+  std::unique_ptr<Inference> inference(CreateInferenceByName(
+      "CpuNet", "deploy.prototxt", "deploy.caffemodel", outputs, inputs));
+  EXPECT_NE(dynamic_cast<CpuNet *>(inference.get()), nullptr);
+  std::unique_ptr<Inference> unknown(CreateInferenceByName(
+      "UnknownNet", "deploy.prototxt", "deploy.caffemodel", outputs, inputs));
+  EXPECT_EQ(unknown, nullptr);
+}
+
 }  // namespace inference
 }  // namespace perception
 }  // namespace apollo
@@ -19,16 +19,12 @@
 #include <google/protobuf/text_format.h>
 #include <string>
 
+#include "modules/perception/inference/utils/proto_util.h"
 #include "modules/perception/proto/rt.pb.h"
 
 namespace apollo {
 namespace perception {
 namespace inference {
-bool ReadProtoFromTextFile(const std::string &filename,
-                           google::protobuf::Message *proto);
-bool ReadProtoFromBinaryFile(const std::string &filename,
-                             google::protobuf::Message *proto);
-bool loadNetParams(const std::string &param_file, NetParameter *param);
 std::string locateFile(const std::string &path, const std::string &input);
 
 }  // namespace inference
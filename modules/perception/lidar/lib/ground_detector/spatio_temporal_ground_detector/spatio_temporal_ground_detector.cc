@@ -60,6 +60,9 @@ bool SpatioTemporalGroundDetector::Init(
   param_->roi_region_rad_z = config_params.roi_rad_z();
   param_->nr_grids_coarse = config_params.grid_size();
   param_->nr_smooth_iter = config_params.nr_smooth_iter();
+  param_->enable_parallel_fit = config_params.enable_parallel_fit();
+  param_->nr_fit_threads = config_params.nr_fit_threads();
+  param_->enable_warm_start = config_params.enable_warm_start();
 
   pfdetector_ = new common::PlaneFitGroundDetector(*param_);
   pfdetector_->Init();
@@ -104,6 +107,16 @@ bool SpatioTemporalGroundDetector::Detect(const GroundDetectorOptions& options,
   cloud_center_(1) = frame->lidar2world_pose(1, 3);
   cloud_center_(2) = frame->lidar2world_pose(2, 3);
 
+  // the grid is centered at the lidar, move last frame planes along with it
+  if (param_->enable_warm_start) {
+    float translation[3] = {
+        static_cast<float>(cloud_center_(0) - prev_cloud_center_(0)),
+        static_cast<float>(cloud_center_(1) - prev_cloud_center_(1)),
+        static_cast<float>(cloud_center_(2) - prev_cloud_center_(2))};
+    pfdetector_->TranslateWarmStartPlanes(translation);
+  }
+  prev_cloud_center_ = cloud_center_;
+
   // check output
   frame->non_ground_indices.indices.clear();
 
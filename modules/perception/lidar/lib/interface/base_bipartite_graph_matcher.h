@@ -29,7 +29,11 @@ namespace apollo {
 namespace perception {
 namespace lidar {
 
-struct BipartiteGraphMatcherInitOptions {};
+struct BipartiteGraphMatcherInitOptions {
+  // solve the assignment on the gated pairs only, bounds the latency of
+  // crowded scenes
+  bool use_sparse_solver = false;
+};
 
 struct BipartiteGraphMatcherOptions {
   float cost_thresh = 4.0f;
@@ -42,6 +46,11 @@ class BaseBipartiteGraphMatcher {
   BaseBipartiteGraphMatcher() = default;
   virtual ~BaseBipartiteGraphMatcher() = default;
 
+  bool Init() { return Init(BipartiteGraphMatcherInitOptions()); }
+  virtual bool Init(const BipartiteGraphMatcherInitOptions &options) {
+    return true;
+  }
+
   // @params[OUT] assignments: matched pair of objects & tracks
   // @params[OUT] unassigned_rows: unmatched rows
   // @params[OUT] unassigned_cols: unmatched cols
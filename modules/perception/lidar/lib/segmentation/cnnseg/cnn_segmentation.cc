@@ -149,6 +149,7 @@ bool CNNSegmentation::InitClusterAndBackgroundSegmentation() {
   // init spp engine
   SppParams params;
   params.height_gap = spp_engine_config_.height_gap();
+  params.cc_threads = spp_engine_config_.cc_threads();
   params.confidence_range = cnnseg_param_.confidence_range();
 
   // init spp data
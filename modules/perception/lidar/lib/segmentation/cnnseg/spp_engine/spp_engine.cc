@@ -26,7 +26,8 @@ namespace lidar {
 void SppEngine::Init(size_t width, size_t height, float range,
                      const SppParams& param, const std::string& sensor_name) {
   // initialize connect component detector
-  detector_2d_cc_.Init(static_cast<int>(height), static_cast<int>(width));
+  detector_2d_cc_.Init(static_cast<int>(height), static_cast<int>(width),
+                       param.cc_threads);
   detector_2d_cc_.SetData(data_.obs_prob_data_ref, data_.offset_data,
                           static_cast<float>(height) / (2.f * range),
                           data_.objectness_threshold);
@@ -88,6 +89,10 @@ size_t SppEngine::ProcessConnectedComponentCluster(
   // first sync between cluster list and label image,
   // and they shared the same cluster pointer
   clusters_ = labels_2d_;
+  // bucket the points by label: count first so that each cluster is
+  // reserved once, then fill them in point order
+  point_labels_.assign(point_cloud->size(), 0);
+  cluster_sizes_.assign(clusters_.size(), 0);
   for (size_t i = 0; i < point_cloud->size(); ++i) {
     if (mask.size() && mask[static_cast<int>(i)] == 0) {
       continue;
@@ -97,15 +102,26 @@ size_t SppEngine::ProcessConnectedComponentCluster(
     if (id < 0) {
       continue;
     }
-    const auto& point = point_cloud->at(i);
     const uint16_t& label = labels_2d_[0][id];
     if (!label) {
       continue;
     }
-    if (point.z <=
+    if (point_cloud->at(i).z <=
         labels_2d_.GetCluster(label - 1)->top_z + data_.top_z_threshold) {
-      clusters_.AddPointSample(label - 1, point, point_cloud->points_height(i),
-                               static_cast<uint32_t>(i));
+      point_labels_[i] = label;
+      ++cluster_sizes_[label - 1];
+    }
+  }
+  for (size_t i = 0; i < clusters_.size(); ++i) {
+    auto& cluster = clusters_[static_cast<int>(i)];
+    cluster->points.reserve(cluster->points.size() + cluster_sizes_[i]);
+    cluster->point_ids.reserve(cluster->point_ids.size() + cluster_sizes_[i]);
+  }
+  for (size_t i = 0; i < point_cloud->size(); ++i) {
+    if (point_labels_[i]) {
+      clusters_[point_labels_[i] - 1]->AddPointSample(
+          point_cloud->at(i), point_cloud->points_height(i),
+          static_cast<uint32_t>(i));
     }
   }
   double mapping_time = timer.toc(true);
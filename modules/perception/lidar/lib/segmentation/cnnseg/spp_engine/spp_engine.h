@@ -16,6 +16,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "Eigen/Dense"
 
@@ -93,6 +94,9 @@ class SppEngine {
   SppData data_;
   // thread worker for sync data
   lib::ThreadWorker worker_;
+  // label of each point and point number of each cluster for mapping
+  std::vector<uint16_t> point_labels_;
+  std::vector<uint32_t> cluster_sizes_;
 };
 
 }  // namespace lidar
@@ -54,6 +54,32 @@ bool SppCCDetector::BuildNodes(int start_row_index, int end_row_index) {
   return true;
 }
 
+void SppCCDetector::InitBands(int num_bands) {
+  band_workers_.clear();
+  num_bands = std::max(1, std::min(num_bands, rows_));
+  band_rows_.resize(num_bands + 1);
+  for (int i = 0; i <= num_bands; ++i) {
+    band_rows_[i] = rows_ * i / num_bands;
+  }
+  band_links_.assign(num_bands, {});
+  for (size_t i = 1; i < static_cast<size_t>(num_bands); ++i) {
+    band_workers_.emplace_back(new lib::ThreadWorker);
+    band_workers_.back()->Bind([this, i]() { return band_task_(i); });
+    band_workers_.back()->Start();
+  }
+}
+
+void SppCCDetector::RunBands(const std::function<bool(size_t)>& task) {
+  band_task_ = task;
+  for (auto& worker : band_workers_) {
+    worker->WakeUp();
+  }
+  task(0);
+  for (auto& worker : band_workers_) {
+    worker->Join();
+  }
+}
+
 bool SppCCDetector::CleanNodes() {
   memset(nodes_[0], 0, sizeof(Node) * rows_ * cols_);
   uint32_t node_idx = 0;
@@ -71,7 +97,13 @@ size_t SppCCDetector::Detect(SppLabelImage* labels) {
     worker_.Join();  // sync for cleaning nodes
   }
   first_process_ = false;
-  BuildNodes(0, rows_);
+  if (band_workers_.empty()) {
+    BuildNodes(0, rows_);
+  } else {
+    RunBands([this](size_t band) {
+      return BuildNodes(band_rows_[band], band_rows_[band + 1]);
+    });
+  }
   double init_time = timer.toc(true);
 
   double sync_time = timer.toc(true);
@@ -79,7 +111,12 @@ size_t SppCCDetector::Detect(SppLabelImage* labels) {
   TraverseNodes();
   double traverse_time = timer.toc(true);
 
-  UnionNodes();
+  if (band_workers_.empty()) {
+    UnionNodes();
+  } else {
+    RunBands([this](size_t band) { return UnionBandNodes(band); });
+    MergeBands();
+  }
   double union_time = timer.toc(true);
 
   size_t num = ToLabelMap(labels);
@@ -144,12 +181,80 @@ void SppCCDetector::UnionNodes() {
   }
 }
 
+bool SppCCDetector::UnionBandNodes(size_t band) {
+  const int start_row = band_rows_[band];
+  const int end_row = band_rows_[band + 1];
+  const uint32_t begin = static_cast<uint32_t>(start_row * cols_);
+  const uint32_t end = static_cast<uint32_t>(end_row * cols_);
+  // a center of a loop through several bands is linked to a parent outside
+  // of the band, cut the link so that the band stays a separate forest
+  auto& links = band_links_[band];
+  links.clear();
+  Node* node = nodes_[0] + begin;
+  for (uint32_t node_id = begin; node_id < end; ++node_id, ++node) {
+    if (node->is_center() && (node->parent < begin || node->parent >= end)) {
+      links.emplace_back(node_id, node->parent);
+      node->parent = node_id;
+    }
+  }
+  for (int row = start_row; row < end_row; ++row) {
+    const bool has_down = row < end_row - 1;
+    for (int col = 0; col < cols_; ++col) {
+      node = &nodes_[row][col];
+      if (!node->is_center()) {
+        continue;
+      }
+      // right
+      if (col < cols_ - 1) {
+        UnionCenters(node, &nodes_[row][col + 1]);
+      }
+      if (!has_down) {
+        continue;
+      }
+      // down, right down and left down
+      UnionCenters(node, &nodes_[row + 1][col]);
+      if (col < cols_ - 1) {
+        UnionCenters(node, &nodes_[row + 1][col + 1]);
+      }
+      if (col > 0) {
+        UnionCenters(node, &nodes_[row + 1][col - 1]);
+      }
+    }
+  }
+  return true;
+}
+
+void SppCCDetector::MergeBands() {
+  for (size_t band = 0; band < band_links_.size(); ++band) {
+    for (const auto& link : band_links_[band]) {
+      DisjointSetUnion(nodes_[0] + link.first, nodes_[0] + link.second);
+    }
+    if (band == 0) {
+      continue;
+    }
+    // the last row of the previous band with the first row of this band
+    const int row = band_rows_[band] - 1;
+    for (int col = 0; col < cols_; ++col) {
+      Node* node = &nodes_[row][col];
+      if (!node->is_center()) {
+        continue;
+      }
+      UnionCenters(node, &nodes_[row + 1][col]);
+      if (col < cols_ - 1) {
+        UnionCenters(node, &nodes_[row + 1][col + 1]);
+      }
+      if (col > 0) {
+        UnionCenters(node, &nodes_[row + 1][col - 1]);
+      }
+    }
+  }
+}
+
 size_t SppCCDetector::ToLabelMap(SppLabelImage* labels) {
   uint16_t id = 0;
-  uint32_t pixel_id = 0;
-  labels->ResetClusters(kDefaultReserveSize);
+  cluster_sizes_.clear();
   for (int row = 0; row < rows_; ++row) {
-    for (int col = 0; col < cols_; ++col, ++pixel_id) {
+    for (int col = 0; col < cols_; ++col) {
       Node* node = &nodes_[row][col];
       if (!node->is_object()) {
         (*labels)[row][col] = 0;
@@ -160,12 +265,26 @@ size_t SppCCDetector::ToLabelMap(SppLabelImage* labels) {
       // zero is reserved from non-object
       if (!root->id) {
         root->id = ++id;
+        cluster_sizes_.push_back(0);
       }
       (*labels)[row][col] = root->id;
-      labels->AddPixelSample(root->id - 1, pixel_id);
+      ++cluster_sizes_[root->id - 1];
+    }
+  }
+  // bucket the pixels by label, each cluster is reserved once and
+  // pixels keep the raster order
+  labels->ResetClusters(id);
+  auto& clusters = labels->GetClusters();
+  for (size_t i = 0; i < clusters.size(); ++i) {
+    clusters[i]->pixels.reserve(cluster_sizes_[i]);
+  }
+  const uint16_t* label_ptr = (*labels)[0];
+  const uint32_t size = static_cast<uint32_t>(rows_ * cols_);
+  for (uint32_t pixel_id = 0; pixel_id < size; ++pixel_id) {
+    if (label_ptr[pixel_id]) {
+      clusters[label_ptr[pixel_id] - 1]->pixels.push_back(pixel_id);
     }
   }
-  labels->ResizeClusters(id);
   return id;
 }
 
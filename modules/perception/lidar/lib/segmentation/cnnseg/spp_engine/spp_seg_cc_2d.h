@@ -15,6 +15,9 @@
  *****************************************************************************/
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "modules/perception/common/i_lib/core/i_alloc.h"
@@ -30,6 +33,10 @@ class SppCCDetector {
   SppCCDetector() = default;
 
   ~SppCCDetector() {
+    // the workers use the nodes, wait for the cleaning and stop them first
+    worker_.Join();
+    worker_.Release();
+    band_workers_.clear();
     if (nodes_ != nullptr) {
       common::IFree2(&nodes_);
     }
@@ -37,15 +44,17 @@ class SppCCDetector {
   // @brief: initialize detector
   // @param [in]: rows of feature map
   // @param [in]: cols of feature map
-  void Init(int rows, int cols) {
+  // @param [in]: number of row bands built and unioned in parallel
+  void Init(int rows, int cols, int num_bands = 1) {
     if (rows_ * cols_ != rows * cols) {
       if (nodes_ != nullptr) {
         common::IFree2(&nodes_);
       }
       nodes_ = common::IAlloc2<Node>(rows, cols);
-      rows_ = static_cast<int>(rows);
-      cols_ = static_cast<int>(cols);
     }
+    rows_ = static_cast<int>(rows);
+    cols_ = static_cast<int>(cols);
+    InitBands(num_bands);
     CleanNodes();
   }
   // @brief: set data for clusterin
@@ -70,6 +79,20 @@ class SppCCDetector {
   void TraverseNodes();
   // @brief: union adjacent nodes
   void UnionNodes();
+  // @brief: union adjacent nodes given start row index and end row index,
+  //         only nodes inside the band are touched, links leaving the band
+  //         are kept in the band links and merged by MergeBands
+  // @param [in]: band index
+  // @return: state of union nodes
+  bool UnionBandNodes(size_t band);
+  // @brief: merge the unions of the bands across their boundaries
+  void MergeBands();
+  // @brief: split rows into bands and start the band workers
+  // @param [in]: number of bands
+  void InitBands(int num_bands);
+  // @brief: run a band task on all bands and wait for them
+  // @param [in]: band task
+  void RunBands(const std::function<bool(size_t)>& task);
   // @brief: collect clusters to label map
   size_t ToLabelMap(SppLabelImage* labels);
   // @brief: clean node matrix
@@ -130,6 +153,13 @@ class SppCCDetector {
   // @brief: union of two sets
   // @param [in]: input two nodes
   void DisjointSetUnion(Node* x, Node* y);
+  // @brief: union the node and its neighbor if both are centers
+  // @param [in]: input node and neighbor node
+  inline void UnionCenters(Node* x, Node* y) {
+    if (y->is_center()) {
+      DisjointSetUnion(x, y);
+    }
+  }
 
  private:
   int rows_ = 0;
@@ -144,8 +174,15 @@ class SppCCDetector {
   lib::ThreadWorker worker_;
   bool first_process_ = true;
 
- private:
-  static const size_t kDefaultReserveSize = 500;
+  // first row of each band, the last one is rows_
+  std::vector<int> band_rows_;
+  // links from centers of a band to parents outside of it
+  std::vector<std::vector<std::pair<uint32_t, uint32_t>>> band_links_;
+  // workers of the bands except the first one, run on the caller
+  std::vector<std::unique_ptr<lib::ThreadWorker>> band_workers_;
+  std::function<bool(size_t)> band_task_;
+  // pixel number of each cluster, for a single reservation per cluster
+  std::vector<uint32_t> cluster_sizes_;
 };  // class SppCCDetector
 
 }  // namespace lidar
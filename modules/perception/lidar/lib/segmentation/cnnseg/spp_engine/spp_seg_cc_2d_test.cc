@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/lidar/lib/segmentation/cnnseg/spp_engine/spp_seg_cc_2d.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+// random objectness and center offsets, the offsets point a few cells away
+// so that center loops cross the band boundaries
+void RandomFeature(int rows, int cols, unsigned int seed,
+                   std::vector<float>* prob, std::vector<float>* offset) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> prob_dist(0.f, 1.f);
+  std::uniform_real_distribution<float> offset_dist(-3.f, 3.f);
+  prob->resize(rows * cols);
+  offset->resize(2 * rows * cols);
+  for (auto& value : *prob) {
+    value = prob_dist(rng);
+  }
+  for (auto& value : *offset) {
+    value = offset_dist(rng);
+  }
+}
+
+TEST(SppCCDetectorTest, spp_cc_detector_test) {
+  // 0 1 1 0
+  // 0 0 0 0
+  // 1 0 0 1
+  // the center of (0, 2) is (0, 1), the other cells are their own centers
+  const int rows = 3;
+  const int cols = 4;
+  std::vector<float> prob = {0, 1, 1, 0, 0, 0, 0, 0, 1, 0, 0, 1};
+  std::vector<float> offset(2 * rows * cols, 0.f);
+  offset[rows * cols + 2] = -1.f;
+  const float* prob_ptr = prob.data();
+  SppLabelImage labels;
+  labels.Init(cols, rows);
+  SppCCDetector detector;
+  detector.Init(rows, cols);
+  detector.SetData(&prob_ptr, offset.data(), 1.f, 0.5f);
+  EXPECT_EQ(detector.Detect(&labels), 3);
+  EXPECT_EQ(labels[0][1], 1);
+  EXPECT_EQ(labels[0][2], 1);
+  EXPECT_EQ(labels[2][0], 2);
+  EXPECT_EQ(labels[2][3], 3);
+  EXPECT_EQ(labels[1][1], 0);
+  ASSERT_EQ(labels.GetClusterNum(), 3);
+  EXPECT_EQ(labels.GetCluster(0)->pixels, std::vector<uint32_t>({1, 2}));
+  EXPECT_EQ(labels.GetCluster(1)->pixels, std::vector<uint32_t>({8}));
+  EXPECT_EQ(labels.GetCluster(2)->pixels, std::vector<uint32_t>({11}));
+}
+
+TEST(SppCCDetectorTest, spp_cc_detector_band_test) {
+  const int rows = 61;
+  const int cols = 47;
+  SppLabelImage expected_labels;
+  expected_labels.Init(cols, rows);
+  SppLabelImage labels;
+  labels.Init(cols, rows);
+  SppCCDetector serial_detector;
+  serial_detector.Init(rows, cols);
+  SppCCDetector band_detector;
+  band_detector.Init(rows, cols, 7);
+  std::vector<float> prob;
+  std::vector<float> offset;
+  RandomFeature(rows, cols, 0, &prob, &offset);
+  const float* prob_ptr = prob.data();
+  serial_detector.SetData(&prob_ptr, offset.data(), 1.f, 0.5f);
+  band_detector.SetData(&prob_ptr, offset.data(), 1.f, 0.5f);
+  // several frames to cover the node cleaning between frames
+  for (unsigned int seed = 0; seed < 4; ++seed) {
+    RandomFeature(rows, cols, seed, &prob, &offset);
+    size_t num = serial_detector.Detect(&expected_labels);
+    EXPECT_GT(num, 0);
+    EXPECT_EQ(band_detector.Detect(&labels), num);
+    for (int row = 0; row < rows; ++row) {
+      for (int col = 0; col < cols; ++col) {
+        EXPECT_EQ(labels[row][col], expected_labels[row][col]);
+      }
+    }
+    ASSERT_EQ(labels.GetClusterNum(), num);
+    for (size_t i = 0; i < num; ++i) {
+      EXPECT_EQ(labels.GetCluster(i)->pixels,
+                expected_labels.GetCluster(i)->pixels);
+    }
+  }
+}
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
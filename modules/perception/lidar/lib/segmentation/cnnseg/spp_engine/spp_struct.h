@@ -58,6 +58,8 @@ struct SppData {
 struct SppParams {
   float height_gap = 0.5f;
   float confidence_range = 58.f;
+  // row bands of the connected component detector
+  int cc_threads = 1;
 };
 
 }  // namespace lidar
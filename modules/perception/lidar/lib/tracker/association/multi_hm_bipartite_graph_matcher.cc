@@ -31,6 +31,15 @@ MultiHmBipartiteGraphMatcher::~MultiHmBipartiteGraphMatcher() {
   cost_matrix_ = nullptr;
 }
 
+bool MultiHmBipartiteGraphMatcher::Init(
+    const BipartiteGraphMatcherInitOptions &options) {
+  optimizer_.set_solver_type(
+      options.use_sparse_solver
+          ? common::GatedHungarianMatcher<float>::SolverType::SPARSE
+          : common::GatedHungarianMatcher<float>::SolverType::HUNGARIAN);
+  return true;
+}
+
 void MultiHmBipartiteGraphMatcher::Match(
     const BipartiteGraphMatcherOptions &options,
     std::vector<NodeNodePair> *assignments,
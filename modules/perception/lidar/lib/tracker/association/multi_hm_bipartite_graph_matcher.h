@@ -31,6 +31,9 @@ class MultiHmBipartiteGraphMatcher : public BaseBipartiteGraphMatcher {
   MultiHmBipartiteGraphMatcher();
   ~MultiHmBipartiteGraphMatcher();
 
+  using BaseBipartiteGraphMatcher::Init;
+  bool Init(const BipartiteGraphMatcherInitOptions &options) override;
+
   // @brief: match interface
   // @params [in]: match params
   // @params [out]: matched pair of objects & tracks
@@ -49,6 +49,10 @@ bool MlfTrackObjectMatcher::Init(
           config.background_matcher_method()));
   CHECK(background_matcher_ != nullptr);
   AINFO << "MlfTrackObjectMatcher, bg: " << background_matcher_->Name();
+  BipartiteGraphMatcherInitOptions matcher_init_options;
+  matcher_init_options.use_sparse_solver = config.use_sparse_solver();
+  CHECK(foreground_matcher_->Init(matcher_init_options));
+  CHECK(background_matcher_->Init(matcher_init_options));
   foreground_matcher_->cost_matrix()->Reserve(1000, 1000);
   background_matcher_->cost_matrix()->Reserve(1000, 1000);
 
@@ -17,6 +17,7 @@
 #include "modules/perception/map/hdmap/hdmap_input.h"
 
 #include <algorithm>
+#include <utility>
 
 #include "cyber/common/file.h"
 #include "cyber/common/log.h"
@@ -67,7 +68,7 @@ bool HDMapInput::Reset() {
 }
 
 bool HDMapInput::InitHDMap() {
-  hdmap_.reset(new apollo::hdmap::HDMap());
+  hdmap_.reset();
   const std::string model_name = "HDMapInput";
   const lib::ModelConfig* model_config = nullptr;
   if (!lib::ConfigManager::Instance()->GetModelConfig(model_name,
@@ -83,6 +84,11 @@ bool HDMapInput::InitHDMap() {
   // TO DO: Decide which map to use
   // Option 1: Use global hdmap_ = apollo::hdmap::HDMapUtil::BaseMapPtr();
   // hdmap_ = apollo::hdmap::HDMapUtil::BaseMapPtr();
+  if (FLAGS_use_tiled_map) {
+    // the tiles around the queried points are loaded with the queries
+    AINFO << "Use the tiled base map.";
+    return true;
+  }
 
   // Option2: Load own map with different hdmap_sample_step_
   // Load hdmap path from global_flagfile.txt
@@ -92,20 +98,35 @@ bool HDMapInput::InitHDMap() {
     AERROR << "Failed to find hadmap file: " << hdmap_file_;
     return false;
   }
-  if (hdmap_->LoadMapFromFile(hdmap_file_) != 0) {
+  auto hdmap = std::make_shared<apollo::hdmap::HDMap>();
+  if (hdmap->LoadMapFromFile(hdmap_file_) != 0) {
     AERROR << "Failed to load hadmap file: " << hdmap_file_;
     return false;
   }
+  hdmap_ = hdmap;
 
   AINFO << "Load hdmap file: " << hdmap_file_;
   return true;
 }
 
+bool HDMapInput::UpdateHDMap(const apollo::common::PointENU& point) {
+  if (!FLAGS_use_tiled_map) {
+    return true;
+  }
+  auto hdmap = apollo::hdmap::HDMapUtil::TiledBaseMap(point);
+  if (hdmap == nullptr) {
+    AERROR << "Failed to get the tiled base map, point: "
+           << point.ShortDebugString();
+    return false;
+  }
+  hdmap_ = std::move(hdmap);
+  return true;
+}
+
 bool HDMapInput::GetRoiHDMapStruct(
     const base::PointD& pointd, const double distance,
     std::shared_ptr<base::HdmapStruct> hdmap_struct_ptr) {
   lib::MutexLock lock(&mutex_);
-  CHECK_NOTNULL(hdmap_.get());
   // Get original road boundary and junction
   std::vector<RoadRoiPtr> road_boundary_vec;
   std::vector<JunctionInfoConstPtr> junctions_vec;
@@ -113,6 +134,10 @@ bool HDMapInput::GetRoiHDMapStruct(
   point.set_x(pointd.x);
   point.set_y(pointd.y);
   point.set_z(pointd.z);
+  if (!UpdateHDMap(point)) {
+    return false;
+  }
+  CHECK_NOTNULL(hdmap_.get());
   if (hdmap_->GetRoadBoundaries(point, distance, &road_boundary_vec,
                                 &junctions_vec) != 0) {
     AERROR << "Failed to get road boundary, point: " << point.DebugString();
@@ -384,6 +409,10 @@ bool HDMapInput::GetSignalsFromHDMap(
   point.set_x(pointd(0));
   point.set_y(pointd(1));
   point.set_z(pointd(2));
+  if (!UpdateHDMap(point)) {
+    return false;
+  }
+  CHECK_NOTNULL(hdmap_.get());
   std::vector<SignalInfoConstPtr> forward_signals;
   if (hdmap_->GetForwardNearestSignalsOnLane(point, forward_distance,
                                              &forward_signals) != 0) {
@@ -405,7 +434,6 @@ bool HDMapInput::GetSignals(const Eigen::Vector3d& pointd,
                             double forward_distance,
                             std::vector<apollo::hdmap::Signal>* signals) {
   lib::MutexLock lock(&mutex_);
-  CHECK_NOTNULL(hdmap_.get());
   return GetSignalsFromHDMap(pointd, forward_distance, signals);
 }
 
@@ -45,6 +45,8 @@ class HDMapInput {
  private:
   bool InitHDMap();
   bool InitInternal();
+  // With FLAGS_use_tiled_map, takes the base map of the tiles around point.
+  bool UpdateHDMap(const apollo::common::PointENU& point);
 
   void MergeBoundaryJunction(
       const std::vector<apollo::hdmap::RoadRoiPtr>& boundary,
@@ -73,7 +75,7 @@ class HDMapInput {
 
   bool inited_ = false;
   lib::Mutex mutex_;
-  std::unique_ptr<apollo::hdmap::HDMap> hdmap_;
+  std::shared_ptr<const apollo::hdmap::HDMap> hdmap_;
   int hdmap_sample_step_ = 5;
   std::string hdmap_file_;
 
@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <utility>
 
 #include "modules/routing/proto/routing.pb.h"
 
@@ -49,9 +50,18 @@ using apollo::common::math::Polygon2d;
 using apollo::common::time::Clock;
 using apollo::prediction::PredictionObstacles;
 
+thread_local IndexedObstacles *Frame::thread_virtual_obstacles_ = nullptr;
+
 FrameHistory::FrameHistory()
     : IndexedQueue<uint32_t, Frame>(FLAGS_max_history_frame_num) {}
 
+bool FrameHistory::Add(const uint32_t id, std::unique_ptr<Frame> frame) {
+  if (frame != nullptr) {
+    frame->ReleaseCycleData();
+  }
+  return IndexedQueue<uint32_t, Frame>::Add(id, std::move(frame));
+}
+
 Frame::Frame(uint32_t sequence_num)
     : sequence_num_(sequence_num),
       monitor_logger_buffer_(common::monitor::MonitorMessageItem::PLANNING) {}
@@ -313,15 +323,40 @@ const Obstacle *Frame::CreateStaticObstacle(
   return CreateStaticVirtualObstacle(obstacle_id, obstacle_box);
 }
 
+Frame::ScopedVirtualObstacles::ScopedVirtualObstacles(
+    IndexedObstacles *obstacles)
+    : previous_(thread_virtual_obstacles_) {
+  thread_virtual_obstacles_ = obstacles;
+}
+
+Frame::ScopedVirtualObstacles::~ScopedVirtualObstacles() {
+  thread_virtual_obstacles_ = previous_;
+}
+
+void Frame::AddVirtualObstacles(const IndexedObstacles &obstacles) {
+  std::lock_guard<std::mutex> lock(virtual_obstacle_mutex_);
+  for (const auto *obstacle : obstacles.Items()) {
+    if (!obstacles_.Find(obstacle->Id())) {
+      obstacles_.Add(obstacle->Id(), *obstacle);
+    }
+  }
+}
+
 const Obstacle *Frame::CreateStaticVirtualObstacle(const std::string &id,
                                                    const Box2d &box) {
-  const auto *object = obstacles_.Find(id);
+  std::lock_guard<std::mutex> lock(virtual_obstacle_mutex_);
+  const Obstacle *object = obstacles_.Find(id);
+  if (!object && thread_virtual_obstacles_) {
+    object = thread_virtual_obstacles_->Find(id);
+  }
   if (object) {
     AWARN << "obstacle " << id << " already exist.";
     return object;
   }
-  auto *ptr =
-      obstacles_.Add(id, *Obstacle::CreateStaticVirtualObstacles(id, box));
+  auto obstacle = Obstacle::CreateStaticVirtualObstacles(id, box);
+  auto *ptr = thread_virtual_obstacles_
+                  ? thread_virtual_obstacles_->Add(id, std::move(*obstacle))
+                  : obstacles_.Add(id, std::move(*obstacle));
   if (!ptr) {
     AERROR << "Failed to create virtual obstacle " << id;
   }
@@ -343,6 +378,12 @@ Status Frame::Init(
     AERROR << msg;
     return Status(ErrorCode::PLANNING_ERROR, msg);
   }
+  for (auto &reference_line_info : reference_line_info_) {
+    if (reference_line_info.IsChangeLanePath()) {
+      reference_line_info.SetClearToChangeLane(
+          ChangeLaneDecider::IsClearToChangeLane(&reference_line_info));
+    }
+  }
   future_route_waypoints_ = future_route_waypoints;
   return Status::OK();
 }
@@ -367,7 +408,7 @@ Status Frame::InitFrameData() {
   }
   for (auto &ptr :
        Obstacle::CreateObstacles(*local_view_.prediction_obstacles)) {
-    AddObstacle(*ptr);
+    obstacles_.Add(ptr->Id(), std::move(*ptr));
   }
   if (planning_start_point_.v() < 1e-3) {
     const auto *collision_obstacle = FindCollisionObstacle();
@@ -468,10 +509,6 @@ void Frame::AlignPredictionTime(const double planning_start_time,
 
 Obstacle *Frame::Find(const std::string &id) { return obstacles_.Find(id); }
 
-void Frame::AddObstacle(const Obstacle &obstacle) {
-  obstacles_.Add(obstacle.Id(), obstacle);
-}
-
 void Frame::ReadTrafficLights() {
   traffic_lights_.clear();
 
@@ -523,6 +560,20 @@ const ReferenceLineInfo *Frame::DriveReferenceLineInfo() const {
   return drive_reference_line_info_;
 }
 
+void Frame::ReleaseCycleData() {
+  obstacles_.Clear();
+  for (auto iter = reference_line_info_.begin();
+       iter != reference_line_info_.end();) {
+    if (&(*iter) != drive_reference_line_info_) {
+      iter = reference_line_info_.erase(iter);
+      continue;
+    }
+    iter->SetCandidatePathData({});
+    iter->SetCandidatePathBoundaries({});
+    ++iter;
+  }
+}
+
 const std::vector<const Obstacle *> Frame::obstacles() const {
   return obstacles_.Items();
 }
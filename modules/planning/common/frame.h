@@ -23,6 +23,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -37,6 +38,7 @@
 #include "modules/prediction/proto/prediction_obstacle.pb.h"
 #include "modules/routing/proto/routing.pb.h"
 
+#include "cyber/common/macros.h"
 #include "modules/common/math/vec2d.h"
 #include "modules/common/monitor_log/monitor_log_buffer.h"
 #include "modules/common/status/status.h"
@@ -97,6 +99,15 @@ class Frame {
 
   const ReferenceLineInfo *DriveReferenceLineInfo() const;
 
+  /**
+   * @brief Release the data only used within the planning cycle of the frame:
+   * the obstacles, the reference line infos other than the drive one and the
+   * candidate paths. The following cycles only read the planned trajectory,
+   * the planning start point, the open space info and the drive reference line
+   * info of a frame in FrameHistory.
+   */
+  void ReleaseCycleData();
+
   const std::vector<const Obstacle *> obstacles() const;
 
   const Obstacle *CreateStopObstacle(
@@ -112,6 +123,28 @@ class Frame {
       const std::string &obstacle_id, const double obstacle_start_s,
       const double obstacle_end_s);
 
+  /**
+   * @brief Makes the virtual obstacles created on the calling thread during
+   * the scope go to obstacles instead of the frame, so that a reference line
+   * planned concurrently only adds them to the frame once it is known that
+   * planning one reference line after the other would have planned it.
+   */
+  class ScopedVirtualObstacles {
+   public:
+    explicit ScopedVirtualObstacles(IndexedObstacles *obstacles);
+    ~ScopedVirtualObstacles();
+
+   private:
+    IndexedObstacles *previous_ = nullptr;
+    DISALLOW_COPY_AND_ASSIGN(ScopedVirtualObstacles)
+  };
+
+  /**
+   * @brief Adds the virtual obstacles of a ScopedVirtualObstacles which are
+   * not in the frame yet.
+   */
+  void AddVirtualObstacles(const IndexedObstacles &obstacles);
+
   bool Rerouting();
 
   const common::VehicleState &vehicle_state() const;
@@ -189,8 +222,6 @@ class Frame {
   const Obstacle *CreateStaticVirtualObstacle(const std::string &id,
                                               const common::math::Box2d &box);
 
-  void AddObstacle(const Obstacle &obstacle);
-
   void ReadTrafficLights();
 
  private:
@@ -209,6 +240,10 @@ class Frame {
   const ReferenceLineInfo *drive_reference_line_info_ = nullptr;
 
   ThreadSafeIndexedObstacles obstacles_;
+  // makes the find or create of virtual obstacles atomic, they are created by
+  // the tasks of concurrently planned reference lines
+  std::mutex virtual_obstacle_mutex_;
+  static thread_local IndexedObstacles *thread_virtual_obstacles_;
   std::unordered_map<std::string, const perception::TrafficLight *>
       traffic_lights_;
 
@@ -230,6 +265,13 @@ class Frame {
 };
 
 class FrameHistory : public IndexedQueue<uint32_t, Frame> {
+ public:
+  /**
+   * @brief Add a frame after releasing its cycle data, see
+   * Frame::ReleaseCycleData.
+   */
+  bool Add(const uint32_t id, std::unique_ptr<Frame> frame);
+
  private:
   DECLARE_SINGLETON(FrameHistory)
 };
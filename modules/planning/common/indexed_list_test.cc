@@ -18,6 +18,9 @@
  * @file
  **/
 
+#include <string>
+#include <utility>
+
 #include "gtest/gtest.h"
 
 #include "modules/common/util/util.h"
@@ -50,6 +53,31 @@ TEST(IndexedList, Add_ConstRef) {
   }
 }
 
+TEST(IndexedList, Add_Move) {
+  StringIndexedList object;
+  std::string one("one");
+  ASSERT_NE(nullptr, object.Add(1, std::move(one)));
+  std::string one_again("one_again");
+  ASSERT_NE(nullptr, object.Add(1, std::move(one_again)));
+  ASSERT_NE(nullptr, object.Add(2, std::string("two")));
+  const auto& items = object.Items();
+  ASSERT_EQ(2, items.size());
+  ASSERT_EQ("one_again", *items[0]);
+  ASSERT_EQ("two", *items[1]);
+  ASSERT_EQ("two", *object.Find(2));
+}
+
+TEST(IndexedList, Clear) {
+  ThreadSafeIndexedList<int, std::string> object;
+  object.Add(1, "one");
+  object.Add(2, "two");
+  object.Clear();
+  ASSERT_TRUE(object.Items().empty());
+  ASSERT_EQ(nullptr, object.Find(1));
+  ASSERT_NE(nullptr, object.Add(1, "one"));
+  ASSERT_EQ(1, object.Items().size());
+}
+
 TEST(IndexedList, Find) {
   StringIndexedList object;
   object.Add(1, "one");
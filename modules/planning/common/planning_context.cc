@@ -16,6 +16,7 @@
 
 #include "modules/planning/common/planning_context.h"
 
+#include "modules/common/util/util.h"
 #include "modules/planning/common/planning_gflags.h"
 
 namespace apollo {
@@ -26,8 +27,109 @@ namespace planning {
 // PlanningContext::FallBackInfo PlanningContext::fallback_info_;
 // PlanningContext::OpenSpaceInfo PlanningContext::open_space_info_;
 
+thread_local PlanningContext* PlanningContext::thread_instance_ = nullptr;
+
 PlanningContext::PlanningContext() {}
 
+PlanningContext* PlanningContext::Instance() {
+  if (thread_instance_ != nullptr) {
+    return thread_instance_;
+  }
+  static PlanningContext* instance = new PlanningContext();
+  return instance;
+}
+
+PlanningContext::ScopedThreadInstance::ScopedThreadInstance(
+    PlanningContext* context)
+    : previous_(thread_instance_) {
+  thread_instance_ = context;
+}
+
+PlanningContext::ScopedThreadInstance::~ScopedThreadInstance() {
+  thread_instance_ = previous_;
+}
+
+std::unique_ptr<PlanningContext> PlanningContext::Fork() {
+  std::unique_ptr<PlanningContext> context(new PlanningContext());
+  context->CopyFrom(*Instance());
+  return context;
+}
+
+void PlanningContext::CopyFrom(const PlanningContext& other) {
+  if (&other == this) {
+    return;
+  }
+  planning_status_.CopyFrom(other.planning_status_);
+  side_pass_info_ = other.side_pass_info_;
+  fallback_info_ = other.fallback_info_;
+  open_space_info_ = other.open_space_info_;
+  front_static_obstacle_cycle_counter_ =
+      other.front_static_obstacle_cycle_counter_;
+  front_static_obstacle_id_ = other.front_static_obstacle_id_;
+  able_to_use_self_lane_counter_ = other.able_to_use_self_lane_counter_;
+  is_in_path_lane_borrow_scenario_ = other.is_in_path_lane_borrow_scenario_;
+}
+
+void PlanningContext::MergeFrom(const PlanningContext& base,
+                                const PlanningContext& other) {
+  if (&other == this) {
+    return;
+  }
+  const auto* descriptor = planning_status_.GetDescriptor();
+  const auto* reflection = planning_status_.GetReflection();
+  for (int i = 0; i < descriptor->field_count(); ++i) {
+    const auto* field = descriptor->field(i);
+    const bool has_field = reflection->HasField(other.planning_status_, field);
+    if (has_field == reflection->HasField(base.planning_status_, field) &&
+        (!has_field ||
+         common::util::IsProtoEqual(
+             reflection->GetMessage(other.planning_status_, field),
+             reflection->GetMessage(base.planning_status_, field)))) {
+      continue;
+    }
+    if (has_field) {
+      reflection->MutableMessage(&planning_status_, field)
+          ->CopyFrom(reflection->GetMessage(other.planning_status_, field));
+    } else {
+      reflection->ClearField(&planning_status_, field);
+    }
+  }
+
+  if (other.side_pass_info_.change_lane_stop_flag !=
+          base.side_pass_info_.change_lane_stop_flag ||
+      !common::util::IsProtoEqual(
+          other.side_pass_info_.change_lane_stop_path_point,
+          base.side_pass_info_.change_lane_stop_path_point) ||
+      other.side_pass_info_.check_clear_flag !=
+          base.side_pass_info_.check_clear_flag) {
+    side_pass_info_ = other.side_pass_info_;
+  }
+  if (other.fallback_info_.last_successful_path_label !=
+      base.fallback_info_.last_successful_path_label) {
+    fallback_info_ = other.fallback_info_;
+  }
+  if (other.open_space_info_.partitioned_trajectories_index_history !=
+      base.open_space_info_.partitioned_trajectories_index_history) {
+    open_space_info_ = other.open_space_info_;
+  }
+  if (other.front_static_obstacle_cycle_counter_ !=
+      base.front_static_obstacle_cycle_counter_) {
+    front_static_obstacle_cycle_counter_ =
+        other.front_static_obstacle_cycle_counter_;
+  }
+  if (other.front_static_obstacle_id_ != base.front_static_obstacle_id_) {
+    front_static_obstacle_id_ = other.front_static_obstacle_id_;
+  }
+  if (other.able_to_use_self_lane_counter_ !=
+      base.able_to_use_self_lane_counter_) {
+    able_to_use_self_lane_counter_ = other.able_to_use_self_lane_counter_;
+  }
+  if (other.is_in_path_lane_borrow_scenario_ !=
+      base.is_in_path_lane_borrow_scenario_) {
+    is_in_path_lane_borrow_scenario_ = other.is_in_path_lane_borrow_scenario_;
+  }
+}
+
 void PlanningContext::Init() {}
 
 void PlanningContext::Clear() {
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -44,6 +45,43 @@ constexpr int kPathScenarioTransitionHysteresisFrame = 5;
 
 class PlanningContext {
  public:
+  /**
+   * @brief The context of the calling thread, which is the planning wide
+   * context unless a ScopedThreadInstance is alive on the thread.
+   */
+  static PlanningContext* Instance();
+
+  /**
+   * @brief Makes Instance() return context on the calling thread during the
+   * scope, so that work planned concurrently within a cycle can update its
+   * own copy of the context instead of sharing one.
+   */
+  class ScopedThreadInstance {
+   public:
+    explicit ScopedThreadInstance(PlanningContext* context);
+    ~ScopedThreadInstance();
+
+   private:
+    PlanningContext* previous_ = nullptr;
+    DISALLOW_COPY_AND_ASSIGN(ScopedThreadInstance)
+  };
+
+  /**
+   * @brief A copy of the context of the calling thread.
+   */
+  static std::unique_ptr<PlanningContext> Fork();
+
+  void CopyFrom(const PlanningContext& other);
+
+  /**
+   * @brief Applies the updates other made since it was forked from base.
+   * Each status of the planning status and each other member is updated as
+   * a whole, to its value in other if it differs from the one in base.
+   * Merging the forks of several concurrent plannings in order applies their
+   * updates in order, a later fork overwriting what an earlier one updated.
+   */
+  void MergeFrom(const PlanningContext& base, const PlanningContext& other);
+
   // TODO(jinyun): to be removed/cleaned up.
   //               put all of them inside Planningstatus
   // @brief a container logging the data required for non-scenario side pass
@@ -155,8 +193,11 @@ class PlanningContext {
 
   bool is_in_path_lane_borrow_scenario_ = false;
 
+  static thread_local PlanningContext* thread_instance_;
+
   // this is a singleton class
-  DECLARE_SINGLETON(PlanningContext)
+  PlanningContext();
+  DISALLOW_COPY_AND_ASSIGN(PlanningContext)
 };
 
 }  // namespace planning
@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/planning_context.h"
+
+#include <memory>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+TEST(PlanningContextTest, ScopedThreadInstance) {
+  PlanningContext* context = PlanningContext::Instance();
+  context->Clear();
+  context->set_front_static_obstacle_id("front");
+  context->MutablePlanningStatus()->mutable_change_lane()->set_path_id("a");
+
+  std::unique_ptr<PlanningContext> fork = PlanningContext::Fork();
+  EXPECT_EQ(fork->front_static_obstacle_id(), "front");
+  std::thread thread([&fork]() {
+    PlanningContext::ScopedThreadInstance scoped_context(fork.get());
+    EXPECT_EQ(PlanningContext::Instance(), fork.get());
+    PlanningContext::Instance()->set_front_static_obstacle_id("fork");
+    PlanningContext::Instance()
+        ->MutablePlanningStatus()
+        ->mutable_change_lane()
+        ->set_path_id("b");
+  });
+  thread.join();
+  EXPECT_EQ(PlanningContext::Instance(), context);
+  EXPECT_EQ(context->front_static_obstacle_id(), "front");
+  EXPECT_EQ(context->Planningstatus().change_lane().path_id(), "a");
+
+  {
+    PlanningContext::ScopedThreadInstance scoped_context(fork.get());
+    EXPECT_EQ(PlanningContext::Instance(), fork.get());
+  }
+  EXPECT_EQ(PlanningContext::Instance(), context);
+
+  context->CopyFrom(*fork);
+  EXPECT_EQ(context->front_static_obstacle_id(), "fork");
+  EXPECT_EQ(context->Planningstatus().change_lane().path_id(), "b");
+  context->Clear();
+}
+
+TEST(PlanningContextTest, MergeFrom) {
+  PlanningContext* context = PlanningContext::Instance();
+  context->Clear();
+  context->set_front_static_obstacle_id("front");
+  context->MutablePlanningStatus()->mutable_change_lane()->set_path_id("a");
+  context->MutablePlanningStatus()
+      ->mutable_destination()
+      ->set_has_passed_destination(true);
+  context->ResetAbleToUseSelfLaneCounter();
+  std::unique_ptr<PlanningContext> base = PlanningContext::Fork();
+
+  // the forks of two reference lines planned concurrently
+  std::unique_ptr<PlanningContext> first = PlanningContext::Fork();
+  first->set_front_static_obstacle_id("first");
+  first->MutablePlanningStatus()->mutable_change_lane()->set_path_id("b");
+  first->MutablePlanningStatus()->mutable_pull_over()->set_in_pull_over(true);
+  first->IncrementAbleToUseSelfLaneCounter();
+  std::unique_ptr<PlanningContext> second = PlanningContext::Fork();
+  second->MutablePlanningStatus()->mutable_change_lane()->set_path_id("c");
+  second->MutablePlanningStatus()->clear_destination();
+  second->mutable_fallback_info()->last_successful_path_label = "second";
+
+  context->MergeFrom(*base, *first);
+  context->MergeFrom(*base, *second);
+  // the updates of both forks are applied in order
+  EXPECT_EQ(context->front_static_obstacle_id(), "first");
+  EXPECT_EQ(context->Planningstatus().change_lane().path_id(), "c");
+  EXPECT_TRUE(context->Planningstatus().pull_over().in_pull_over());
+  EXPECT_FALSE(context->Planningstatus().has_destination());
+  EXPECT_EQ(context->able_to_use_self_lane_counter(), 1);
+  EXPECT_EQ(context->fallback_info().last_successful_path_label, "second");
+
+  // a fork without updates leaves the context as is
+  context->MergeFrom(*base, *base);
+  EXPECT_EQ(context->front_static_obstacle_id(), "first");
+  EXPECT_EQ(context->Planningstatus().change_lane().path_id(), "c");
+  context->Clear();
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -316,6 +316,10 @@ DEFINE_bool(
     "Enable multiple thread to calculation curve cost in dp_poly_path.");
 DEFINE_bool(enable_multi_thread_in_dp_st_graph, false,
             "Enable multiple thread to calculation curve cost in dp_st_graph.");
+DEFINE_bool(enable_multi_thread_in_reference_line_planning, false,
+            "Enable multiple thread to plan the candidate reference lines.");
+DEFINE_bool(enable_multi_thread_in_st_boundary_mapper, false,
+            "Enable multiple thread to map obstacles in st_boundary_mapper.");
 
 /// Lattice Planner
 DEFINE_double(lattice_epsilon, 1e-6, "Epsilon in lattice planner.");
@@ -156,6 +156,8 @@ DECLARE_uint32(max_planning_thread_pool_size);
 DECLARE_bool(use_multi_thread_to_add_obstacles);
 DECLARE_bool(enable_multi_thread_in_dp_poly_path);
 DECLARE_bool(enable_multi_thread_in_dp_st_graph);
+DECLARE_bool(enable_multi_thread_in_reference_line_planning);
+DECLARE_bool(enable_multi_thread_in_st_boundary_mapper);
 
 // lattice planner
 DECLARE_double(lattice_epsilon);
@@ -150,6 +150,16 @@ class ReferenceLineInfo {
 
   bool IsSafeToChangeLane() const { return is_safe_to_change_lane_; }
 
+  /**
+   * Whether the target lane of a change lane reference line is clear of
+   * moving obstacles, evaluated when the frame is created so that the tasks
+   * of other reference lines can read it while this one is planned.
+   */
+  bool IsClearToChangeLane() const { return is_clear_to_change_lane_; }
+  void SetClearToChangeLane(const bool is_clear_to_change_lane) {
+    is_clear_to_change_lane_ = is_clear_to_change_lane;
+  }
+
   const hdmap::RouteSegments& Lanes() const;
   const std::list<hdmap::Id> TargetLaneId() const;
 
@@ -304,6 +314,8 @@ class ReferenceLineInfo {
 
   bool is_safe_to_change_lane_ = false;
 
+  bool is_clear_to_change_lane_ = false;
+
   bool is_path_lane_borrow_ = false;
 
   ADCTrajectory::RightOfWayStatus status_ = ADCTrajectory::UNPROTECTED;
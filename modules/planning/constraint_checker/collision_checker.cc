@@ -85,7 +85,7 @@ bool CollisionChecker::InCollision(
 bool CollisionChecker::InCollision(
     const DiscretizedTrajectory& discretized_trajectory) {
   CHECK_LE(discretized_trajectory.NumOfPoints(),
-           predicted_bounding_rectangles_.size());
+           predicted_environment_.NumOfTimeSlots());
   const auto& vehicle_config =
       common::VehicleConfigHelper::Instance()->GetConfig();
   double ego_length = vehicle_config.vehicle_param().length();
@@ -104,10 +104,8 @@ bool CollisionChecker::InCollision(
                     shift_distance * std::sin(ego_theta)};
     ego_box.Shift(shift_vec);
 
-    for (const auto& obstacle_box : predicted_bounding_rectangles_[i]) {
-      if (ego_box.HasOverlap(obstacle_box)) {
-        return true;
-      }
+    if (predicted_environment_.HasOverlap(i, ego_box)) {
+      return true;
     }
   }
   return false;
@@ -117,7 +115,7 @@ void CollisionChecker::BuildPredictedEnvironment(
     const std::vector<const Obstacle*>& obstacles, const double ego_vehicle_s,
     const double ego_vehicle_d,
     const std::vector<PathPoint>& discretized_reference_line) {
-  CHECK(predicted_bounding_rectangles_.empty());
+  CHECK_EQ(predicted_environment_.NumOfTimeSlots(), 0);
 
   // If the ego vehicle is in lane,
   // then, ignore all obstacles from the same lane.
@@ -149,7 +147,7 @@ void CollisionChecker::BuildPredictedEnvironment(
       box.LateralExtend(2.0 * FLAGS_lat_collision_buffer);
       predicted_env.push_back(std::move(box));
     }
-    predicted_bounding_rectangles_.push_back(std::move(predicted_env));
+    predicted_environment_.AddTimeSlot(std::move(predicted_env));
     relative_time += FLAGS_trajectory_time_resolution;
   }
 }
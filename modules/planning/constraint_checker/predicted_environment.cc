@@ -0,0 +1,175 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/constraint_checker/predicted_environment.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Box2d;
+
+void PredictedEnvironment::AddTimeSlot(std::vector<Box2d> boxes) {
+  time_slots_.emplace_back();
+  TimeSlot& time_slot = time_slots_.back();
+  time_slot.boxes = std::move(boxes);
+  BuildGrid(&time_slot);
+}
+
+void PredictedEnvironment::Clear() { time_slots_.clear(); }
+
+bool PredictedEnvironment::HasOverlap(const size_t slot,
+                                      const Box2d& box) const {
+  CHECK_LT(slot, time_slots_.size());
+  const TimeSlot& time_slot = time_slots_[slot];
+  if (time_slot.boxes.empty()) {
+    return false;
+  }
+  const int query_min_x = CellX(time_slot, box.min_x());
+  const int query_max_x = CellX(time_slot, box.max_x());
+  const int query_min_y = CellY(time_slot, box.min_y());
+  const int query_max_y = CellY(time_slot, box.max_y());
+  for (int y = query_min_y; y <= query_max_y; ++y) {
+    for (int x = query_min_x; x <= query_max_x; ++x) {
+      const int cell = y * time_slot.num_cells_x + x;
+      for (int i = time_slot.cell_begin[cell];
+           i < time_slot.cell_begin[cell + 1]; ++i) {
+        const int index = time_slot.cell_boxes[i];
+        // same rejection as the one of Box2d::HasOverlap
+        if (time_slot.max_x[index] < box.min_x() ||
+            time_slot.min_x[index] > box.max_x() ||
+            time_slot.max_y[index] < box.min_y() ||
+            time_slot.min_y[index] > box.max_y()) {
+          continue;
+        }
+        // a box in several of the cells is only tested in the first one
+        if (std::max(CellX(time_slot, time_slot.min_x[index]), query_min_x) !=
+                x ||
+            std::max(CellY(time_slot, time_slot.min_y[index]), query_min_y) !=
+                y) {
+          continue;
+        }
+        if (box.HasOverlap(time_slot.boxes[index])) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+void PredictedEnvironment::BuildGrid(TimeSlot* time_slot) {
+  const auto& boxes = time_slot->boxes;
+  const size_t num_boxes = boxes.size();
+  time_slot->min_x.resize(num_boxes);
+  time_slot->max_x.resize(num_boxes);
+  time_slot->min_y.resize(num_boxes);
+  time_slot->max_y.resize(num_boxes);
+  if (num_boxes == 0) {
+    return;
+  }
+  double min_x = boxes.front().min_x();
+  double max_x = boxes.front().max_x();
+  double min_y = boxes.front().min_y();
+  double max_y = boxes.front().max_y();
+  double sum_box_size = 0.0;
+  for (size_t i = 0; i < num_boxes; ++i) {
+    time_slot->min_x[i] = boxes[i].min_x();
+    time_slot->max_x[i] = boxes[i].max_x();
+    time_slot->min_y[i] = boxes[i].min_y();
+    time_slot->max_y[i] = boxes[i].max_y();
+    min_x = std::min(min_x, time_slot->min_x[i]);
+    max_x = std::max(max_x, time_slot->max_x[i]);
+    min_y = std::min(min_y, time_slot->min_y[i]);
+    max_y = std::max(max_y, time_slot->max_y[i]);
+    sum_box_size += std::max(time_slot->max_x[i] - time_slot->min_x[i],
+                             time_slot->max_y[i] - time_slot->min_y[i]);
+  }
+
+  // about one box per cell, and cells not smaller than the boxes so that a
+  // box is in a few cells only
+  const double area = (max_x - min_x) * (max_y - min_y);
+  const double kMinCellSize = 0.1;
+  time_slot->cell_size =
+      std::max({std::sqrt(area / static_cast<double>(num_boxes)),
+                sum_box_size / static_cast<double>(num_boxes), kMinCellSize});
+  time_slot->origin_x = min_x;
+  time_slot->origin_y = min_y;
+  time_slot->num_cells_x =
+      static_cast<int>((max_x - min_x) / time_slot->cell_size) + 1;
+  time_slot->num_cells_y =
+      static_cast<int>((max_y - min_y) / time_slot->cell_size) + 1;
+
+  // counting sort of the boxes into the cells they cover
+  const int num_cells = time_slot->num_cells_x * time_slot->num_cells_y;
+  time_slot->cell_begin.assign(num_cells + 1, 0);
+  for (int pass = 0; pass < 2; ++pass) {
+    if (pass == 1) {
+      for (int cell = 0; cell < num_cells; ++cell) {
+        time_slot->cell_begin[cell + 1] += time_slot->cell_begin[cell];
+      }
+      time_slot->cell_boxes.resize(time_slot->cell_begin[num_cells]);
+    }
+    for (size_t i = 0; i < num_boxes; ++i) {
+      const int box_min_x = CellX(*time_slot, time_slot->min_x[i]);
+      const int box_max_x = CellX(*time_slot, time_slot->max_x[i]);
+      const int box_min_y = CellY(*time_slot, time_slot->min_y[i]);
+      const int box_max_y = CellY(*time_slot, time_slot->max_y[i]);
+      for (int y = box_min_y; y <= box_max_y; ++y) {
+        for (int x = box_min_x; x <= box_max_x; ++x) {
+          const int cell = y * time_slot->num_cells_x + x;
+          if (pass == 0) {
+            ++time_slot->cell_begin[cell + 1];
+          } else {
+            time_slot->cell_boxes[time_slot->cell_begin[cell]++] =
+                static_cast<int>(i);
+          }
+        }
+      }
+    }
+  }
+  // the second pass moved each begin to the begin of the next cell
+  for (int cell = num_cells; cell > 0; --cell) {
+    time_slot->cell_begin[cell] = time_slot->cell_begin[cell - 1];
+  }
+  time_slot->cell_begin[0] = 0;
+}
+
+int PredictedEnvironment::CellX(const TimeSlot& time_slot, const double x) {
+  const double cell =
+      std::floor((x - time_slot.origin_x) / time_slot.cell_size);
+  return static_cast<int>(std::max(
+      0.0, std::min(cell, static_cast<double>(time_slot.num_cells_x - 1))));
+}
+
+int PredictedEnvironment::CellY(const TimeSlot& time_slot, const double y) {
+  const double cell =
+      std::floor((y - time_slot.origin_y) / time_slot.cell_size);
+  return static_cast<int>(std::max(
+      0.0, std::min(cell, static_cast<double>(time_slot.num_cells_y - 1))));
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <vector>
+
+#include "modules/common/math/box2d.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class PredictedEnvironment
+ * @brief The predicted obstacle boxes of a planning cycle in time slots, with
+ * a uniform grid over the axis-aligned bounding boxes of each slot. Overlap
+ * queries only run the separating axis test on the boxes sharing a grid cell
+ * with the query box, so their cost follows the obstacles nearby rather than
+ * the number of obstacles in the scene.
+ */
+class PredictedEnvironment {
+ public:
+  PredictedEnvironment() = default;
+
+  /**
+   * @brief Append a time slot.
+   * @param boxes The obstacle boxes of the slot.
+   */
+  void AddTimeSlot(std::vector<common::math::Box2d> boxes);
+
+  void Clear();
+
+  size_t NumOfTimeSlots() const { return time_slots_.size(); }
+
+  const std::vector<common::math::Box2d>& Boxes(const size_t slot) const {
+    return time_slots_[slot].boxes;
+  }
+
+  /**
+   * @brief Check if a box overlaps any obstacle box of a time slot, the same
+   * as Box2d::HasOverlap over all the boxes of the slot.
+   */
+  bool HasOverlap(const size_t slot, const common::math::Box2d& box) const;
+
+ private:
+  struct TimeSlot {
+    std::vector<common::math::Box2d> boxes;
+    // axis-aligned bounding boxes, in the order of boxes
+    std::vector<double> min_x;
+    std::vector<double> max_x;
+    std::vector<double> min_y;
+    std::vector<double> max_y;
+    double origin_x = 0.0;
+    double origin_y = 0.0;
+    double cell_size = 1.0;
+    int num_cells_x = 0;
+    int num_cells_y = 0;
+    // boxes of cell i are cell_boxes[cell_begin[i], cell_begin[i + 1])
+    std::vector<int> cell_begin;
+    std::vector<int> cell_boxes;
+  };
+
+  static void BuildGrid(TimeSlot* time_slot);
+
+  static int CellX(const TimeSlot& time_slot, const double x);
+
+  static int CellY(const TimeSlot& time_slot, const double y);
+
+ private:
+  std::vector<TimeSlot> time_slots_;
+};
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/constraint_checker/predicted_environment.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Box2d;
+using apollo::common::math::Vec2d;
+
+TEST(PredictedEnvironmentTest, HasOverlap) {
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<double> position_dist(-60.0, 60.0);
+  std::uniform_real_distribution<double> heading_dist(-M_PI, M_PI);
+  std::uniform_real_distribution<double> length_dist(0.5, 8.0);
+  std::uniform_real_distribution<double> width_dist(0.5, 3.0);
+  auto random_box = [&]() {
+    return Box2d(Vec2d(position_dist(rng), position_dist(rng)),
+                 heading_dist(rng), length_dist(rng), width_dist(rng));
+  };
+
+  PredictedEnvironment environment;
+  for (const int num_boxes : {0, 1, 40, 300}) {
+    std::vector<Box2d> boxes;
+    for (int i = 0; i < num_boxes; ++i) {
+      boxes.push_back(random_box());
+    }
+    // a long box covering many cells
+    if (num_boxes > 1) {
+      boxes.emplace_back(Vec2d(0.0, 0.0), 0.3, 100.0, 1.0);
+    }
+    environment.AddTimeSlot(boxes);
+  }
+  ASSERT_EQ(environment.NumOfTimeSlots(), 4);
+
+  for (size_t slot = 0; slot < environment.NumOfTimeSlots(); ++slot) {
+    int num_overlaps = 0;
+    for (int i = 0; i < 2000; ++i) {
+      Box2d query = random_box();
+      bool expected = false;
+      for (const auto& box : environment.Boxes(slot)) {
+        expected = expected || query.HasOverlap(box);
+      }
+      EXPECT_EQ(environment.HasOverlap(slot, query), expected) << slot;
+      num_overlaps += expected ? 1 : 0;
+    }
+    if (slot > 1) {
+      EXPECT_GT(num_overlaps, 0);
+    }
+    // far from all the boxes
+    EXPECT_FALSE(environment.HasOverlap(
+        slot, Box2d(Vec2d(500.0, -500.0), 0.0, 4.0, 2.0)));
+  }
+
+  environment.Clear();
+  EXPECT_EQ(environment.NumOfTimeSlots(), 0);
+}
+
+}  // namespace planning
+}  // namespace apollo
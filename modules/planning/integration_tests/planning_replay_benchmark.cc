@@ -0,0 +1,272 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Replays recorded planning inputs through OnLanePlanning cycle by
+ * cycle, with the mock clock set to the localization time of each cycle, and
+ * reports the latency of the cycles, the tasks and the scenarios together
+ * with the heap allocations of the cycles.
+ *
+ * The cycles are read from --replay_data_dir as
+ *   <i>_chassis.pb.txt, <i>_localization.pb.txt, <i>_prediction.pb.txt
+ * and optionally <i>_traffic_light.pb.txt and <i>_routing.pb.txt, for i = 1,
+ * 2, ... until the chassis file of a cycle is missing. A cycle without a
+ * routing file keeps the routing of the previous cycle, the first one uses
+ * --replay_routing_file if it has none.
+ *
+ * Example:
+ *   planning_replay_benchmark --flagfile=modules/planning/conf/planning.conf
+ *     --replay_data_dir=/apollo/data/replay --replay_warmup_cycles=5
+ **/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "modules/common/time/time.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/on_lane_planning.h"
+
+DEFINE_string(replay_data_dir, "", "the folder of the recorded cycles");
+DEFINE_string(replay_routing_file, "",
+              "the routing response used until a cycle has its own");
+DEFINE_int32(replay_warmup_cycles, 0,
+             "the number of first cycles left out of the statistics");
+
+namespace {
+
+std::atomic<uint64_t> num_allocations(0);
+std::atomic<uint64_t> num_allocated_bytes(0);
+
+void* CountedAllocate(const size_t size) {
+  num_allocations.fetch_add(1, std::memory_order_relaxed);
+  num_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+}  // namespace
+
+// the allocations of the whole process, only this binary replaces them
+void* operator new(size_t size) { return CountedAllocate(size); }
+void* operator new[](size_t size) { return CountedAllocate(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+
+namespace apollo {
+namespace planning {
+namespace {
+
+using apollo::common::time::Clock;
+using apollo::cyber::common::GetProtoFromFile;
+using apollo::cyber::common::PathExists;
+using apollo::perception::TrafficLightDetection;
+using apollo::routing::RoutingResponse;
+
+class LatencyStatistics {
+ public:
+  void Add(const double time_ms) { samples_.push_back(time_ms); }
+
+  bool Empty() const { return samples_.empty(); }
+
+  void Print(const std::string& name) {
+    std::sort(samples_.begin(), samples_.end());
+    double sum = 0.0;
+    for (const double sample : samples_) {
+      sum += sample;
+    }
+    std::printf("%-40s %6zu %9.3f %9.3f %9.3f %9.3f %9.3f\n", name.c_str(),
+                samples_.size(), sum / static_cast<double>(samples_.size()),
+                Percentile(0.5), Percentile(0.9), Percentile(0.99),
+                samples_.back());
+  }
+
+ private:
+  // nearest rank on the sorted samples
+  double Percentile(const double p) const {
+    const size_t rank = static_cast<size_t>(
+        std::ceil(p * static_cast<double>(samples_.size())));
+    return samples_[std::max<size_t>(rank, 1) - 1];
+  }
+
+ private:
+  std::vector<double> samples_;
+};
+
+void PrintHeader(const std::string& title) {
+  std::printf("\n%-40s %6s %9s %9s %9s %9s %9s\n", title.c_str(), "count",
+              "mean", "p50", "p90", "p99", "max");
+}
+
+template <typename T>
+bool LoadCycleFile(const std::string& file, const bool optional,
+                   std::shared_ptr<T>* message) {
+  if (!PathExists(file)) {
+    if (!optional) {
+      AERROR << "missing file: " << file;
+    }
+    return optional;
+  }
+  message->reset(new T());
+  if (!GetProtoFromFile(file, message->get())) {
+    AERROR << "failed to load file: " << file;
+    return false;
+  }
+  return true;
+}
+
+int Run() {
+  if (FLAGS_replay_data_dir.empty()) {
+    AERROR << "Requires FLAGS_replay_data_dir to be set";
+    return -1;
+  }
+  // plan synchronously in the calling thread, and record the task latency
+  FLAGS_enable_reference_line_provider_thread = false;
+  FLAGS_enable_record_debug = true;
+  Clock::SetMode(Clock::MOCK);
+
+  PlanningConfig config;
+  CHECK(GetProtoFromFile(FLAGS_planning_config_file, &config))
+      << "failed to load planning config file " << FLAGS_planning_config_file;
+  OnLanePlanning planning;
+  CHECK(planning.Init(config).ok()) << "Failed to init planning module";
+
+  std::shared_ptr<RoutingResponse> routing;
+  if (!FLAGS_replay_routing_file.empty()) {
+    routing = std::make_shared<RoutingResponse>();
+    CHECK(GetProtoFromFile(FLAGS_replay_routing_file, routing.get()))
+        << "failed to load file: " << FLAGS_replay_routing_file;
+  }
+
+  LatencyStatistics cycle_latency;
+  LatencyStatistics cycle_allocations;
+  LatencyStatistics cycle_allocated_kb;
+  std::map<std::string, LatencyStatistics> task_latency;
+  std::map<std::string, LatencyStatistics> scenario_latency;
+  int num_cycles = 0;
+  for (int i = 1;; ++i) {
+    const std::string prefix =
+        FLAGS_replay_data_dir + "/" + std::to_string(i) + "_";
+    if (!PathExists(prefix + "chassis.pb.txt")) {
+      break;
+    }
+    LocalView local_view;
+    std::shared_ptr<RoutingResponse> cycle_routing;
+    if (!LoadCycleFile(prefix + "chassis.pb.txt", false,
+                       &local_view.chassis) ||
+        !LoadCycleFile(prefix + "localization.pb.txt", false,
+                       &local_view.localization_estimate) ||
+        !LoadCycleFile(prefix + "prediction.pb.txt", false,
+                       &local_view.prediction_obstacles) ||
+        !LoadCycleFile(prefix + "traffic_light.pb.txt", true,
+                       &local_view.traffic_light) ||
+        !LoadCycleFile(prefix + "routing.pb.txt", true, &cycle_routing)) {
+      return -1;
+    }
+    if (cycle_routing != nullptr) {
+      routing = cycle_routing;
+    }
+    if (routing == nullptr) {
+      AERROR << "No routing for cycle " << i;
+      return -1;
+    }
+    local_view.routing = routing;
+    if (local_view.traffic_light == nullptr) {
+      local_view.traffic_light = std::make_shared<TrafficLightDetection>();
+    }
+    Clock::SetNowInSeconds(
+        local_view.localization_estimate->header().timestamp_sec());
+
+    ADCTrajectory trajectory;
+    const uint64_t allocations_before = num_allocations.load();
+    const uint64_t allocated_bytes_before = num_allocated_bytes.load();
+    const auto start = std::chrono::steady_clock::now();
+    planning.RunOnce(local_view, &trajectory);
+    const auto end = std::chrono::steady_clock::now();
+    const uint64_t allocations = num_allocations.load() - allocations_before;
+    const uint64_t allocated_bytes =
+        num_allocated_bytes.load() - allocated_bytes_before;
+    ++num_cycles;
+    if (i <= FLAGS_replay_warmup_cycles) {
+      continue;
+    }
+
+    const double time_ms =
+        std::chrono::duration<double, std::milli>(end - start).count();
+    cycle_latency.Add(time_ms);
+    cycle_allocations.Add(static_cast<double>(allocations));
+    cycle_allocated_kb.Add(static_cast<double>(allocated_bytes) / 1024.0);
+    for (const auto& task : trajectory.latency_stats().task_stats()) {
+      task_latency[task.name()].Add(task.time_ms());
+    }
+    const auto& scenario = trajectory.debug().planning_data().scenario();
+    scenario_latency[ScenarioConfig::ScenarioType_Name(
+                         scenario.scenario_type()) +
+                     "/" +
+                     ScenarioConfig::StageType_Name(scenario.stage_type())]
+        .Add(time_ms);
+  }
+
+  AINFO << "Replayed " << num_cycles << " cycles from "
+        << FLAGS_replay_data_dir;
+  if (cycle_latency.Empty()) {
+    AERROR << "No cycle after the " << FLAGS_replay_warmup_cycles
+           << " warmup cycles";
+    return -1;
+  }
+  PrintHeader("cycle");
+  cycle_latency.Print("latency (ms)");
+  cycle_allocations.Print("allocations");
+  cycle_allocated_kb.Print("allocated (KB)");
+  PrintHeader("task latency (ms)");
+  for (auto& task : task_latency) {
+    task.second.Print(task.first);
+  }
+  PrintHeader("scenario/stage latency (ms)");
+  for (auto& scenario : scenario_latency) {
+    scenario.second.Print(scenario.first);
+  }
+  return 0;
+}
+
+}  // namespace
+}  // namespace planning
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::InitGoogleLogging(argv[0]);
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return apollo::planning::Run();
+}
@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <numeric>
 
 #include "cyber/common/log.h"
 #include "modules/common/math/path_matcher.h"
@@ -74,20 +75,45 @@ TrajectoryEvaluator::TrajectoryEvaluator(
     if (!ConstraintChecker1d::IsValidLongitudinalTrajectory(*lon_trajectory)) {
       continue;
     }
+    lon_trajectories_.push_back(lon_trajectory);
+    lon_costs_.push_back(
+        EvaluateLonTrajectory(planning_target, lon_trajectory));
+  }
+  /**
+   * The validity of the code needs to be verified.
+  if (!ConstraintChecker1d::IsValidLateralTrajectory(*lat_trajectory,
+                                                     *lon_trajectory)) {
+    continue;
+  }
+  */
+  if (!lon_trajectories_.empty()) {
     for (const auto& lat_trajectory : lat_trajectories) {
-      /**
-       * The validity of the code needs to be verified.
-      if (!ConstraintChecker1d::IsValidLateralTrajectory(*lat_trajectory,
-                                                         *lon_trajectory)) {
-        continue;
-      }
-      */
-      double cost = Evaluate(planning_target, lon_trajectory, lat_trajectory);
-      cost_queue_.emplace(Trajectory1dPair(lon_trajectory, lat_trajectory),
-                          cost);
+      lat_trajectories_.push_back(lat_trajectory);
+      lat_cost_lower_bounds_.push_back(LatCostLowerBound(lat_trajectory));
     }
   }
-  ADEBUG << "Number of valid 1d trajectory pairs: " << cost_queue_.size();
+
+  lon_order_.resize(lon_trajectories_.size());
+  std::iota(lon_order_.begin(), lon_order_.end(), 0);
+  std::stable_sort(lon_order_.begin(), lon_order_.end(),
+                   [this](const size_t left, const size_t right) {
+                     return lon_costs_[left].cost < lon_costs_[right].cost;
+                   });
+  lat_order_.resize(lat_trajectories_.size());
+  std::iota(lat_order_.begin(), lat_order_.end(), 0);
+  std::stable_sort(lat_order_.begin(), lat_order_.end(),
+                   [this](const size_t left, const size_t right) {
+                     return lat_cost_lower_bounds_[left] <
+                            lat_cost_lower_bounds_[right];
+                   });
+
+  num_of_trajectory_pairs_ =
+      lon_trajectories_.size() * lat_trajectories_.size();
+  if (num_of_trajectory_pairs_ > 0) {
+    PushLowerBound(0, 0);
+    EvaluateTopTrajectoryPair();
+  }
+  ADEBUG << "Number of valid 1d trajectory pairs: " << num_of_trajectory_pairs_;
 }
 
 bool TrajectoryEvaluator::has_more_trajectory_pairs() const {
@@ -95,34 +121,70 @@ bool TrajectoryEvaluator::has_more_trajectory_pairs() const {
 }
 
 size_t TrajectoryEvaluator::num_of_trajectory_pairs() const {
-  return cost_queue_.size();
+  return num_of_trajectory_pairs_;
 }
 
 std::pair<PtrTrajectory1d, PtrTrajectory1d>
 TrajectoryEvaluator::next_top_trajectory_pair() {
   CHECK(has_more_trajectory_pairs());
-  auto top = cost_queue_.top();
+  const PairCost top = cost_queue_.top();
   cost_queue_.pop();
-  return top.first;
+  --num_of_trajectory_pairs_;
+  EvaluateTopTrajectoryPair();
+  return Trajectory1dPair(lon_trajectories_[lon_order_[top.lon_rank]],
+                          lat_trajectories_[lat_order_[top.lat_rank]]);
 }
 
 double TrajectoryEvaluator::top_trajectory_pair_cost() const {
-  return cost_queue_.top().second;
+  return cost_queue_.top().cost;
 }
 
-double TrajectoryEvaluator::Evaluate(
+void TrajectoryEvaluator::PushLowerBound(const size_t lon_rank,
+                                         const size_t lat_rank) {
+  PairCost pair_cost;
+  pair_cost.lon_rank = lon_rank;
+  pair_cost.lat_rank = lat_rank;
+  pair_cost.cost = lon_costs_[lon_order_[lon_rank]].cost +
+                   lat_cost_lower_bounds_[lat_order_[lat_rank]];
+  pair_cost.is_exact = false;
+  cost_queue_.push(pair_cost);
+}
+
+void TrajectoryEvaluator::EvaluateTopTrajectoryPair() {
+  // The lower bounds are sums of a lon and a lat part, both sorted, so the
+  // successors of a pair are never below it. Every pair not generated yet is
+  // bounded by a queued lower bound, hence an exact cost on top is the lowest.
+  while (!cost_queue_.empty() && !cost_queue_.top().is_exact) {
+    PairCost pair_cost = cost_queue_.top();
+    cost_queue_.pop();
+    if (pair_cost.lat_rank + 1 < lat_order_.size()) {
+      PushLowerBound(pair_cost.lon_rank, pair_cost.lat_rank + 1);
+    }
+    if (pair_cost.lat_rank == 0 && pair_cost.lon_rank + 1 < lon_order_.size()) {
+      PushLowerBound(pair_cost.lon_rank + 1, 0);
+    }
+    const auto& lat_trajectory =
+        lat_trajectories_[lat_order_[pair_cost.lat_rank]];
+    pair_cost.cost =
+        Evaluate(lon_costs_[lon_order_[pair_cost.lon_rank]], lat_trajectory);
+    pair_cost.is_exact = true;
+    cost_queue_.push(pair_cost);
+  }
+}
+
+TrajectoryEvaluator::LonTrajectoryCost
+TrajectoryEvaluator::EvaluateLonTrajectory(
     const PlanningTarget& planning_target,
-    const PtrTrajectory1d& lon_trajectory,
-    const PtrTrajectory1d& lat_trajectory,
-    std::vector<double>* cost_components) const {
+    const PtrTrajectory1d& lon_trajectory) const {
   // Costs:
   // 1. Cost of missing the objective, e.g., cruise, stop, etc.
   // 2. Cost of logitudinal jerk
   // 3. Cost of logitudinal collision
   // 4. Cost of lateral offsets
   // 5. Cost of lateral comfort
+  // The longitudinal costs are shared by all the pairs of lon_trajectory.
+  LonTrajectoryCost lon_cost;
 
-  // Longitudinal costs
   double lon_objective_cost =
       LonObjectiveCost(lon_trajectory, planning_target, reference_s_dot_);
 
@@ -132,33 +194,49 @@ double TrajectoryEvaluator::Evaluate(
 
   double centripetal_acc_cost = CentripetalAccelerationCost(lon_trajectory);
 
+  lon_cost.cost = lon_objective_cost * FLAGS_weight_lon_objective +
+                  lon_jerk_cost * FLAGS_weight_lon_jerk +
+                  lon_collision_cost * FLAGS_weight_lon_collision +
+                  centripetal_acc_cost * FLAGS_weight_centripetal_acceleration;
+
   // decides the longitudinal evaluation horizon for lateral trajectories.
   double evaluation_horizon =
       std::min(FLAGS_decision_horizon,
                lon_trajectory->Evaluate(0, lon_trajectory->ParamLength()));
-  std::vector<double> s_values;
   for (double s = 0.0; s < evaluation_horizon;
        s += FLAGS_trajectory_space_resolution) {
-    s_values.emplace_back(s);
+    lon_cost.s_values.emplace_back(s);
   }
 
-  // Lateral costs
-  double lat_offset_cost = LatOffsetCost(lat_trajectory, s_values);
+  for (double t = 0.0; t < FLAGS_trajectory_time_length;
+       t += FLAGS_trajectory_time_resolution) {
+    lon_cost.relative_s.push_back(lon_trajectory->Evaluate(0, t) - init_s_[0]);
+    lon_cost.s_dot.push_back(lon_trajectory->Evaluate(1, t));
+    lon_cost.s_dotdot.push_back(lon_trajectory->Evaluate(2, t));
+  }
+  return lon_cost;
+}
 
-  double lat_comfort_cost = LatComfortCost(lon_trajectory, lat_trajectory);
+double TrajectoryEvaluator::LatCostLowerBound(
+    const PtrTrajectory1d& lat_trajectory) const {
+  // The lateral offset cost is not negative, and the lateral comfort cost is
+  // at least its value at t = 0, where every lon trajectory is at init_s.
+  double l_prime = lat_trajectory->Evaluate(1, 0.0);
+  double l_primeprime = lat_trajectory->Evaluate(2, 0.0);
+  double cost =
+      l_primeprime * init_s_[1] * init_s_[1] + l_prime * init_s_[2];
+  return std::fabs(cost) * FLAGS_weight_lat_comfort;
+}
 
-  if (cost_components != nullptr) {
-    cost_components->emplace_back(lon_objective_cost);
-    cost_components->emplace_back(lon_jerk_cost);
-    cost_components->emplace_back(lon_collision_cost);
-    cost_components->emplace_back(lat_offset_cost);
-  }
+double TrajectoryEvaluator::Evaluate(
+    const LonTrajectoryCost& lon_cost,
+    const PtrTrajectory1d& lat_trajectory) const {
+  // Lateral costs
+  double lat_offset_cost = LatOffsetCost(lat_trajectory, lon_cost.s_values);
+
+  double lat_comfort_cost = LatComfortCost(lon_cost, lat_trajectory);
 
-  return lon_objective_cost * FLAGS_weight_lon_objective +
-         lon_jerk_cost * FLAGS_weight_lon_jerk +
-         lon_collision_cost * FLAGS_weight_lon_collision +
-         centripetal_acc_cost * FLAGS_weight_centripetal_acceleration +
-         lat_offset_cost * FLAGS_weight_lat_offset +
+  return lon_cost.cost + lat_offset_cost * FLAGS_weight_lat_offset +
          lat_comfort_cost * FLAGS_weight_lat_comfort;
 }
 
@@ -183,16 +261,14 @@ double TrajectoryEvaluator::LatOffsetCost(
 }
 
 double TrajectoryEvaluator::LatComfortCost(
-    const PtrTrajectory1d& lon_trajectory,
+    const LonTrajectoryCost& lon_cost,
     const PtrTrajectory1d& lat_trajectory) const {
   double max_cost = 0.0;
-  for (double t = 0.0; t < FLAGS_trajectory_time_length;
-       t += FLAGS_trajectory_time_resolution) {
-    double s = lon_trajectory->Evaluate(0, t);
-    double s_dot = lon_trajectory->Evaluate(1, t);
-    double s_dotdot = lon_trajectory->Evaluate(2, t);
+  for (size_t i = 0; i < lon_cost.relative_s.size(); ++i) {
+    double s_dot = lon_cost.s_dot[i];
+    double s_dotdot = lon_cost.s_dotdot[i];
 
-    double relative_s = s - init_s_[0];
+    double relative_s = lon_cost.relative_s[i];
     double l_prime = lat_trajectory->Evaluate(1, relative_s);
     double l_primeprime = lat_trajectory->Evaluate(2, relative_s);
     double cost = l_primeprime * s_dot * s_dot + l_prime * s_dotdot;
@@ -34,18 +34,13 @@
 namespace apollo {
 namespace planning {
 
+/**
+ * @brief Enumerates the lon-lat trajectory pairs in increasing cost. The
+ * pairs are generated lazily in best-first order of a lower bound of their
+ * costs, so that only the pairs close to the ones actually taken are
+ * evaluated.
+ */
 class TrajectoryEvaluator {
-  // normal use
-  typedef std::pair<
-      std::pair<std::shared_ptr<Curve1d>, std::shared_ptr<Curve1d>>, double>
-      PairCost;
-
-  // auto tuning
-  typedef std::pair<
-      std::pair<std::shared_ptr<Curve1d>, std::shared_ptr<Curve1d>>,
-      std::pair<std::vector<double>, double>>
-      PairCostWithComponents;
-
  public:
   explicit TrajectoryEvaluator(
       const std::array<double, 3>& init_s,
@@ -69,15 +64,47 @@ class TrajectoryEvaluator {
   std::vector<double> top_trajectory_pair_component_cost() const;
 
  private:
-  double Evaluate(const PlanningTarget& planning_target,
-                  const std::shared_ptr<Curve1d>& lon_trajectory,
-                  const std::shared_ptr<Curve1d>& lat_trajectory,
-                  std::vector<double>* cost_components = nullptr) const;
+  // The costs of a longitudinal trajectory shared by all of its pairs, with
+  // the samples of the lateral costs.
+  struct LonTrajectoryCost {
+    double cost = 0.0;
+    // stations of the lateral offset cost
+    std::vector<double> s_values;
+    // s relative to init_s, s_dot and s_dotdot at the time resolution
+    std::vector<double> relative_s;
+    std::vector<double> s_dot;
+    std::vector<double> s_dotdot;
+  };
+
+  // a pair by the ranks of its lon and lat trajectories in increasing cost,
+  // with either its cost or a lower bound of its cost
+  struct PairCost {
+    size_t lon_rank = 0;
+    size_t lat_rank = 0;
+    double cost = 0.0;
+    bool is_exact = false;
+  };
+
+  LonTrajectoryCost EvaluateLonTrajectory(
+      const PlanningTarget& planning_target,
+      const std::shared_ptr<Curve1d>& lon_trajectory) const;
+
+  double LatCostLowerBound(
+      const std::shared_ptr<Curve1d>& lat_trajectory) const;
+
+  double Evaluate(const LonTrajectoryCost& lon_cost,
+                  const std::shared_ptr<Curve1d>& lat_trajectory) const;
+
+  void PushLowerBound(const size_t lon_rank, const size_t lat_rank);
+
+  // evaluate the pairs with a lower bound on top of cost_queue_ until the top
+  // pair has its exact cost
+  void EvaluateTopTrajectoryPair();
 
   double LatOffsetCost(const std::shared_ptr<Curve1d>& lat_trajectory,
                        const std::vector<double>& s_values) const;
 
-  double LatComfortCost(const std::shared_ptr<Curve1d>& lon_trajectory,
+  double LatComfortCost(const LonTrajectoryCost& lon_cost,
                         const std::shared_ptr<Curve1d>& lat_trajectory) const;
 
   double LonComfortCost(const std::shared_ptr<Curve1d>& lon_trajectory) const;
@@ -101,13 +128,27 @@ class TrajectoryEvaluator {
   struct CostComparator
       : public std::binary_function<const PairCost&, const PairCost&, bool> {
     bool operator()(const PairCost& left, const PairCost& right) const {
-      return left.second > right.second;
+      if (left.cost != right.cost) {
+        return left.cost > right.cost;
+      }
+      return !left.is_exact && right.is_exact;
     }
   };
 
   std::priority_queue<PairCost, std::vector<PairCost>, CostComparator>
       cost_queue_;
 
+  // the valid lon trajectories and the lat trajectories, with their costs in
+  // the same order, and their indices by increasing cost
+  std::vector<std::shared_ptr<Curve1d>> lon_trajectories_;
+  std::vector<LonTrajectoryCost> lon_costs_;
+  std::vector<size_t> lon_order_;
+  std::vector<std::shared_ptr<Curve1d>> lat_trajectories_;
+  std::vector<double> lat_cost_lower_bounds_;
+  std::vector<size_t> lat_order_;
+
+  size_t num_of_trajectory_pairs_ = 0;
+
   std::shared_ptr<PathTimeGraph> path_time_graph_;
 
   std::shared_ptr<std::vector<apollo::common::PathPoint>> reference_line_;
@@ -0,0 +1,224 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/lattice/trajectory_generation/trajectory_evaluator.h"
+
+#include <algorithm>
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/planning/lattice/trajectory_generation/lattice_trajectory1d.h"
+#include "modules/planning/math/curve1d/quartic_polynomial_curve1d.h"
+#include "modules/planning/math/curve1d/quintic_polynomial_curve1d.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::PathPoint;
+
+namespace {
+
+using TrajectoryPair = std::pair<const Curve1d*, const Curve1d*>;
+
+// the pairs popped with the same cost
+using PairsOfCost = std::pair<double, std::vector<TrajectoryPair>>;
+
+std::shared_ptr<Curve1d> LonTrajectory(const std::array<double, 3>& init_s,
+                                       const double end_v, const double t) {
+  return std::make_shared<LatticeTrajectory1d>(
+      std::make_shared<QuarticPolynomialCurve1d>(
+          init_s, std::array<double, 2>{end_v, 0.0}, t));
+}
+
+std::shared_ptr<Curve1d> LatTrajectory(const std::array<double, 3>& init_d,
+                                       const double end_d, const double s) {
+  return std::make_shared<LatticeTrajectory1d>(
+      std::make_shared<QuinticPolynomialCurve1d>(
+          init_d, std::array<double, 3>{end_d, 0.0, 0.0}, s));
+}
+
+std::vector<PairsOfCost> GroupByCost(
+    const std::vector<std::pair<TrajectoryPair, double>>& popped_pairs) {
+  std::vector<PairsOfCost> groups;
+  for (const auto& popped_pair : popped_pairs) {
+    if (groups.empty() || groups.back().first != popped_pair.second) {
+      groups.emplace_back(popped_pair.second, std::vector<TrajectoryPair>());
+    }
+    groups.back().second.push_back(popped_pair.first);
+  }
+  for (auto& group : groups) {
+    std::sort(group.second.begin(), group.second.end());
+  }
+  return groups;
+}
+
+}  // namespace
+
+class TrajectoryEvaluatorTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    // a reference line along x bending to the left
+    reference_line_ = std::make_shared<std::vector<PathPoint>>();
+    for (int i = 0; i <= 300; ++i) {
+      PathPoint point;
+      point.set_x(static_cast<double>(i));
+      point.set_s(static_cast<double>(i));
+      point.set_kappa(i < 100 ? 0.0 : 0.01);
+      reference_line_->push_back(point);
+    }
+    path_time_graph_ = std::make_shared<PathTimeGraph>(
+        std::vector<const Obstacle*>(), *reference_line_, nullptr, 0.0, 300.0,
+        0.0, FLAGS_trajectory_time_length, init_d_);
+    planning_target_.set_cruise_speed(10.0);
+
+    for (const double end_v : {4.0, 7.0, 10.0, 13.0}) {
+      for (const double t : {6.0, 8.0}) {
+        lon_trajectories_.push_back(LonTrajectory(init_s_, end_v, t));
+      }
+    }
+    // ties on the lon costs, hence on the pair costs
+    lon_trajectories_.push_back(lon_trajectories_[2]);
+    lon_trajectories_.push_back(LonTrajectory(init_s_, 7.0, 6.0));
+
+    // the lat trajectories from init_d share their lower bound
+    for (const double end_d : {-0.5, 0.0, 0.5}) {
+      for (const double s : {20.0, 40.0, 60.0}) {
+        lat_trajectories_.push_back(LatTrajectory(init_d_, end_d, s));
+      }
+    }
+    lat_trajectories_.push_back(lat_trajectories_[4]);
+    lat_trajectories_.push_back(LatTrajectory({0.2, 0.05, 0.01}, 0.0, 40.0));
+    lat_trajectories_.push_back(LatTrajectory({0.2, -0.02, 0.0}, 0.0, 30.0));
+  }
+
+  // pops all the pairs of the evaluator with their costs
+  std::vector<std::pair<TrajectoryPair, double>> PopAll(
+      TrajectoryEvaluator* evaluator) {
+    std::vector<std::pair<TrajectoryPair, double>> popped_pairs;
+    while (evaluator->has_more_trajectory_pairs()) {
+      const double cost = evaluator->top_trajectory_pair_cost();
+      const auto pair = evaluator->next_top_trajectory_pair();
+      popped_pairs.emplace_back(
+          TrajectoryPair(pair.first.get(), pair.second.get()), cost);
+    }
+    return popped_pairs;
+  }
+
+  // pops all the pairs of the lon and lat trajectories the way the evaluator
+  // did before the pairs were evaluated lazily: every pair is evaluated, then
+  // popped from a priority queue of the costs
+  std::vector<std::pair<TrajectoryPair, double>> PopAllEagerly() {
+    struct CostComparator {
+      bool operator()(const std::pair<TrajectoryPair, double>& left,
+                      const std::pair<TrajectoryPair, double>& right) const {
+        return left.second > right.second;
+      }
+    };
+    std::priority_queue<std::pair<TrajectoryPair, double>,
+                        std::vector<std::pair<TrajectoryPair, double>>,
+                        CostComparator>
+        cost_queue;
+    for (const auto& lon_trajectory : lon_trajectories_) {
+      for (const auto& lat_trajectory : lat_trajectories_) {
+        TrajectoryEvaluator evaluator(init_s_, planning_target_,
+                                      {lon_trajectory}, {lat_trajectory},
+                                      path_time_graph_, reference_line_);
+        if (!evaluator.has_more_trajectory_pairs()) {
+          continue;
+        }
+        cost_queue.emplace(
+            TrajectoryPair(lon_trajectory.get(), lat_trajectory.get()),
+            evaluator.top_trajectory_pair_cost());
+      }
+    }
+    std::vector<std::pair<TrajectoryPair, double>> popped_pairs;
+    while (!cost_queue.empty()) {
+      popped_pairs.push_back(cost_queue.top());
+      cost_queue.pop();
+    }
+    return popped_pairs;
+  }
+
+ protected:
+  const std::array<double, 3> init_s_{{0.0, 8.0, 0.5}};
+  const std::array<double, 3> init_d_{{0.2, 0.0, 0.0}};
+  std::shared_ptr<std::vector<PathPoint>> reference_line_;
+  std::shared_ptr<PathTimeGraph> path_time_graph_;
+  PlanningTarget planning_target_;
+  std::vector<std::shared_ptr<Curve1d>> lon_trajectories_;
+  std::vector<std::shared_ptr<Curve1d>> lat_trajectories_;
+};
+
+TEST_F(TrajectoryEvaluatorTest, PopsAsEagerEvaluation) {
+  TrajectoryEvaluator evaluator(init_s_, planning_target_, lon_trajectories_,
+                                lat_trajectories_, path_time_graph_,
+                                reference_line_);
+  const size_t num_of_trajectory_pairs = evaluator.num_of_trajectory_pairs();
+  const auto popped_pairs = PopAll(&evaluator);
+  const auto expected_popped_pairs = PopAllEagerly();
+  EXPECT_EQ(num_of_trajectory_pairs, expected_popped_pairs.size());
+  ASSERT_EQ(popped_pairs.size(), expected_popped_pairs.size());
+  EXPECT_EQ(evaluator.num_of_trajectory_pairs(), 0);
+
+  // the costs are popped in the same order, the pairs of equal costs in any
+  // order, as the heap of the priority queue orders them
+  for (size_t i = 0; i < popped_pairs.size(); ++i) {
+    EXPECT_EQ(popped_pairs[i].second, expected_popped_pairs[i].second);
+  }
+  const auto groups = GroupByCost(popped_pairs);
+  const auto expected_groups = GroupByCost(expected_popped_pairs);
+  ASSERT_EQ(groups.size(), expected_groups.size());
+  bool has_tie = false;
+  for (size_t i = 0; i < groups.size(); ++i) {
+    EXPECT_EQ(groups[i].first, expected_groups[i].first);
+    EXPECT_EQ(groups[i].second, expected_groups[i].second);
+    has_tie = has_tie || groups[i].second.size() > 1;
+  }
+  EXPECT_TRUE(has_tie);
+}
+
+TEST_F(TrajectoryEvaluatorTest, PopsTheFirstPairsAsEagerEvaluation) {
+  // the planner stops popping at the first pair that passes its checks
+  TrajectoryEvaluator evaluator(init_s_, planning_target_, lon_trajectories_,
+                                lat_trajectories_, path_time_graph_,
+                                reference_line_);
+  const auto expected_popped_pairs = PopAllEagerly();
+  ASSERT_GT(expected_popped_pairs.size(), 3);
+  for (size_t i = 0; i < 3; ++i) {
+    ASSERT_TRUE(evaluator.has_more_trajectory_pairs());
+    EXPECT_EQ(evaluator.top_trajectory_pair_cost(),
+              expected_popped_pairs[i].second);
+    evaluator.next_top_trajectory_pair();
+  }
+}
+
+TEST_F(TrajectoryEvaluatorTest, NoLatTrajectory) {
+  TrajectoryEvaluator evaluator(init_s_, planning_target_, lon_trajectories_,
+                                {}, path_time_graph_, reference_line_);
+  EXPECT_EQ(evaluator.num_of_trajectory_pairs(), 0);
+  EXPECT_FALSE(evaluator.has_more_trajectory_pairs());
+}
+
+}  // namespace planning
+}  // namespace apollo
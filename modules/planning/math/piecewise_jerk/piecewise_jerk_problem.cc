@@ -17,6 +17,7 @@
 #include "modules/planning/math/piecewise_jerk/piecewise_jerk_problem.h"
 
 #include <algorithm>
+#include <chrono>
 
 #include "cyber/common/log.h"
 
@@ -60,48 +61,115 @@ void PiecewiseJerkProblem::InitProblem(
                      std::make_pair(-kMaxVariableRange, kMaxVariableRange));
 }
 
-bool PiecewiseJerkProblem::OptimizeWithOsqp(
-    const size_t kernel_dim, const size_t num_affine_constraint,
-    std::vector<c_float>& P_data, std::vector<c_int>& P_indices,    // NOLINT
-    std::vector<c_int>& P_indptr, std::vector<c_float>& A_data,     // NOLINT
-    std::vector<c_int>& A_indices, std::vector<c_int>& A_indptr,    // NOLINT
-    std::vector<c_float>& lower_bounds,                             // NOLINT
-    std::vector<c_float>& upper_bounds,                             // NOLINT
-    std::vector<c_float>& q, OSQPData* data, OSQPWorkspace** work,  // NOLINT
-    OSQPSettings* settings) {
-  data->n = kernel_dim;
-  data->m = num_affine_constraint;
-  data->P = csc_matrix(data->n, data->n, P_data.size(), P_data.data(),
-                       P_indices.data(), P_indptr.data());
-  data->q = q.data();
-  data->A = csc_matrix(data->m, data->n, A_data.size(), A_data.data(),
-                       A_indices.data(), A_indptr.data());
-  data->l = lower_bounds.data();
-  data->u = upper_bounds.data();
-
-  CHECK_EQ(upper_bounds.size(), lower_bounds.size());
-
-  *work = osqp_setup(data, settings);
+PiecewiseJerkProblem::~PiecewiseJerkProblem() { CleanUpOsqp(); }
+
+bool PiecewiseJerkProblem::OptimizeWithOsqp(const int max_iter) {
+  CHECK_EQ(upper_bounds_.size(), lower_bounds_.size());
+  if (work_ == nullptr && !SetUpOsqp(max_iter)) {
+    return false;
+  }
 
   // Solve Problem
-  osqp_solve(*work);
+  osqp_solve(work_);
 
-  auto status = (*work)->info->status_val;
+  auto status = work_->info->status_val;
+  num_of_iterations_ = static_cast<int>(work_->info->iter);
 
   if (status < 0) {
-    AERROR << "failed optimization status:\t" << (*work)->info->status;
+    AERROR << "failed optimization status:\t" << work_->info->status;
     return false;
   }
 
   /**
   if (status != 1 && status != 2) {
-    AERROR << "failed optimization status:\t" << (*work)->info->status;
+    AERROR << "failed optimization status:\t" << work_->info->status;
     return false;
   }
   **/
   return true;
 }
 
+bool PiecewiseJerkProblem::SetUpOsqp(const int max_iter) {
+  CleanUpOsqp();
+  data_ = reinterpret_cast<OSQPData*>(c_malloc(sizeof(OSQPData)));
+  settings_ = reinterpret_cast<OSQPSettings*>(c_malloc(sizeof(OSQPSettings)));
+  // Define Solver settings
+  osqp_set_default_settings(settings_);
+  settings_->max_iter = max_iter;
+  settings_->polish = true;
+  settings_->verbose = FLAGS_enable_osqp_debug;
+  settings_->scaled_termination = true;
+  settings_->warm_start = true;
+
+  data_->n = q_.size();
+  data_->m = lower_bounds_.size();
+  data_->P = csc_matrix(data_->n, data_->n, P_data_.size(), P_data_.data(),
+                        P_indices_.data(), P_indptr_.data());
+  data_->q = q_.data();
+  data_->A = csc_matrix(data_->m, data_->n, A_data_.size(), A_data_.data(),
+                        A_indices_.data(), A_indptr_.data());
+  data_->l = lower_bounds_.data();
+  data_->u = upper_bounds_.data();
+
+  work_ = osqp_setup(data_, settings_);
+  if (work_ == nullptr) {
+    AERROR << "failed to set up osqp workspace";
+    CleanUpOsqp();
+    return false;
+  }
+  return true;
+}
+
+void PiecewiseJerkProblem::ShiftOsqpWarmStart() {
+  if (warm_start_shift_ == 0) {
+    return;
+  }
+  const size_t N = num_of_knots_;
+  const size_t shift = std::min(warm_start_shift_, N - 1);
+  const size_t n = static_cast<size_t>(work_->data->n);
+  const size_t m = static_cast<size_t>(work_->data->m);
+  const c_float* prev_x = work_->solution->x;
+  const c_float* prev_y = work_->solution->y;
+
+  // each of x, x', x'' is a block of N knots
+  std::vector<c_float> x(n);
+  for (size_t i = 0; i < n; ++i) {
+    const size_t block_start = i / N * N;
+    x[i] = prev_x[block_start + std::min(i - block_start + shift, N - 1)];
+  }
+  // the duals follow the constraints of CalculateAffineConstraint: a block
+  // of N for each variable, a block of N - 1 for each continuity, and the
+  // init conditions
+  if (n != 3 * N || m != 3 * N + 3 * (N - 1) + 3) {
+    osqp_warm_start_x(work_, x.data());
+    return;
+  }
+  std::vector<c_float> y(prev_y, prev_y + m);
+  for (size_t i = 0; i < 3 * N; ++i) {
+    y[i] = prev_y[i / N * N + std::min(i % N + shift, N - 1)];
+  }
+  for (size_t i = 0; i < 3 * (N - 1); ++i) {
+    const size_t block_start = 3 * N + i / (N - 1) * (N - 1);
+    y[3 * N + i] = prev_y[block_start + std::min(i % (N - 1) + shift, N - 2)];
+  }
+  osqp_warm_start(work_, x.data(), y.data());
+}
+
+void PiecewiseJerkProblem::CleanUpOsqp() {
+  osqp_cleanup(work_);
+  work_ = nullptr;
+  if (data_ != nullptr) {
+    c_free(data_->A);
+    c_free(data_->P);
+    c_free(data_);
+    data_ = nullptr;
+  }
+  if (settings_ != nullptr) {
+    c_free(settings_);
+    settings_ = nullptr;
+  }
+}
+
 void PiecewiseJerkProblem::SetZeroOrderBounds(
     std::vector<std::pair<double, double>> x_bounds) {
   CHECK_EQ(x_bounds.size(), num_of_knots_);
@@ -182,6 +250,8 @@ void PiecewiseJerkProblem::SetVariableSecondOrderDerivativeBounds(
 }
 
 bool PiecewiseJerkProblem::Optimize(const int max_iter) {
+  auto start_time = std::chrono::system_clock::now();
+
   // calculate kernel
   std::vector<c_float> P_data;
   std::vector<c_int> P_indices;
@@ -192,40 +262,52 @@ bool PiecewiseJerkProblem::Optimize(const int max_iter) {
   std::vector<c_float> A_data;
   std::vector<c_int> A_indices;
   std::vector<c_int> A_indptr;
-  std::vector<c_float> lower_bounds;
-  std::vector<c_float> upper_bounds;
-  CalculateAffineConstraint(&A_data, &A_indices, &A_indptr, &lower_bounds,
-                            &upper_bounds);
+  CalculateAffineConstraint(&A_data, &A_indices, &A_indptr, &lower_bounds_,
+                            &upper_bounds_);
 
   // calculate offset
-  std::vector<c_float> q;
-  CalculateOffset(&q);
+  CalculateOffset(&q_);
+
+  // keep the workspace if only the bounds and the offset have changed
+  is_warm_started_ = work_ != nullptr && P_data == P_data_ &&
+                     P_indices == P_indices_ && P_indptr == P_indptr_ &&
+                     A_data == A_data_ && A_indices == A_indices_ &&
+                     A_indptr == A_indptr_ &&
+                     lower_bounds_.size() == static_cast<size_t>(data_->m) &&
+                     q_.size() == static_cast<size_t>(data_->n);
+  if (is_warm_started_) {
+    is_warm_started_ =
+        osqp_update_lin_cost(work_, q_.data()) == 0 &&
+        osqp_update_bounds(work_, lower_bounds_.data(),
+                           upper_bounds_.data()) == 0 &&
+        osqp_update_max_iter(work_, max_iter) == 0;
+  }
+  if (is_warm_started_) {
+    ShiftOsqpWarmStart();
+  } else {
+    CleanUpOsqp();
+    P_data_ = std::move(P_data);
+    P_indices_ = std::move(P_indices);
+    P_indptr_ = std::move(P_indptr);
+    A_data_ = std::move(A_data);
+    A_indices_ = std::move(A_indices);
+    A_indptr_ = std::move(A_indptr);
+  }
+  warm_start_shift_ = 0;
 
-  OSQPData* data = reinterpret_cast<OSQPData*>(c_malloc(sizeof(OSQPData)));
-  OSQPSettings* settings =
-      reinterpret_cast<OSQPSettings*>(c_malloc(sizeof(OSQPSettings)));
-  // Define Solver settings
-  osqp_set_default_settings(settings);
-  settings->max_iter = max_iter;
-  settings->polish = true;
-  settings->verbose = FLAGS_enable_osqp_debug;
-  settings->scaled_termination = true;
-
-  OSQPWorkspace* work = nullptr;
-
-  bool res =
-      OptimizeWithOsqp(3 * num_of_knots_, lower_bounds.size(), P_data,
-                       P_indices, P_indptr, A_data, A_indices, A_indptr,
-                       lower_bounds, upper_bounds, q, data, &work, settings);
-  if (res == false || work == nullptr || work->solution == nullptr) {
-    AERROR << "Failed to find solution.";
-    // Cleanup
-    osqp_cleanup(work);
-    c_free(data->A);
-    c_free(data->P);
-    c_free(data);
-    c_free(settings);
+  bool res = OptimizeWithOsqp(max_iter);
+
+  auto end_time = std::chrono::system_clock::now();
+  std::chrono::duration<double> diff = end_time - start_time;
+  solve_time_ms_ = diff.count() * 1000.0;
+  ADEBUG << "piecewise jerk problem solved in " << solve_time_ms_ << " ms, "
+         << num_of_iterations_ << " iterations, "
+         << (is_warm_started_ ? "warm" : "cold") << " start.";
 
+  if (res == false || work_ == nullptr || work_->solution == nullptr) {
+    AERROR << "Failed to find solution.";
+    // the next solve starts from scratch
+    CleanUpOsqp();
     return false;
   }
 
@@ -234,19 +316,12 @@ bool PiecewiseJerkProblem::Optimize(const int max_iter) {
   dx_.resize(num_of_knots_);
   ddx_.resize(num_of_knots_);
   for (size_t i = 0; i < num_of_knots_; ++i) {
-    x_.at(i) = work->solution->x[i];
-    dx_.at(i) = work->solution->x[i + num_of_knots_];
-    ddx_.at(i) = work->solution->x[i + 2 * num_of_knots_];
+    x_.at(i) = work_->solution->x[i];
+    dx_.at(i) = work_->solution->x[i + num_of_knots_];
+    ddx_.at(i) = work_->solution->x[i + 2 * num_of_knots_];
   }
-  dx_.back() = work->solution->x[2 * num_of_knots_ - 1];
-  ddx_.back() = work->solution->x[3 * num_of_knots_ - 1];
-
-  // Cleanup
-  osqp_cleanup(work);
-  c_free(data->A);
-  c_free(data->P);
-  c_free(data);
-  c_free(settings);
+  dx_.back() = work_->solution->x[2 * num_of_knots_ - 1];
+  ddx_.back() = work_->solution->x[3 * num_of_knots_ - 1];
 
   return true;
 }
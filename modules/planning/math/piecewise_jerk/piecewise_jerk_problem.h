@@ -20,12 +20,15 @@
 
 #pragma once
 
+#include <array>
 #include <tuple>
 #include <utility>
 #include <vector>
 
 #include "osqp/include/osqp.h"
 
+#include "cyber/common/macros.h"
+
 namespace apollo {
 namespace planning {
 
@@ -44,13 +47,17 @@ namespace planning {
  *
  * Given the x, x', x'' at P(start),  The goal is to find x0, x1, ... x(k-1)
  * which makes the line P(start), P0, P(1) ... P(k-1) "smooth".
+ *
+ * The OSQP workspace is kept across Optimize calls. As long as the kernel and
+ * the constraint matrix are unchanged, the next solve only updates the
+ * bounds and the offset, and starts from the previous solution.
  */
 
 class PiecewiseJerkProblem {
  public:
   PiecewiseJerkProblem() = default;
 
-  virtual ~PiecewiseJerkProblem() = default;
+  virtual ~PiecewiseJerkProblem();
 
   /*
    * @param
@@ -111,12 +118,28 @@ class PiecewiseJerkProblem {
 
   virtual bool Optimize(const int max_iter = 4000);
 
+  /*
+   * @brief shift the warm start of the next Optimize by num_of_knots knots,
+   * for a problem starting num_of_knots * delta_s further than the last one.
+   * The solution is extended with its last knot.
+   */
+  void ShiftWarmStart(const size_t num_of_knots) {
+    warm_start_shift_ = num_of_knots;
+  }
+
   const std::vector<double>& x() const { return x_; }
 
   const std::vector<double>& x_derivative() const { return dx_; }
 
   const std::vector<double>& x_second_order_derivative() const { return ddx_; }
 
+  // statistics of the last Optimize
+  bool is_warm_started() const { return is_warm_started_; }
+
+  int num_of_iterations() const { return num_of_iterations_; }
+
+  double solve_time_ms() const { return solve_time_ms_; }
+
  protected:
   // naming convention follows osqp solver.
   virtual void CalculateKernel(std::vector<c_float>* P_data,
@@ -131,15 +154,15 @@ class PiecewiseJerkProblem {
                                          std::vector<c_float>* lower_bounds,
                                          std::vector<c_float>* upper_bounds);
 
-  bool OptimizeWithOsqp(
-      const size_t kernel_dim, const size_t num_affine_constraint,
-      std::vector<c_float>& P_data, std::vector<c_int>& P_indices,    // NOLINT
-      std::vector<c_int>& P_indptr, std::vector<c_float>& A_data,     // NOLINT
-      std::vector<c_int>& A_indices, std::vector<c_int>& A_indptr,    // NOLINT
-      std::vector<c_float>& lower_bounds,                             // NOLINT
-      std::vector<c_float>& upper_bounds,                             // NOLINT
-      std::vector<c_float>& q, OSQPData* data, OSQPWorkspace** work,  // NOLINT
-      OSQPSettings* settings);
+  bool OptimizeWithOsqp(const int max_iter);
+
+  // set up a new workspace with the current matrices
+  bool SetUpOsqp(const int max_iter);
+
+  // apply warm_start_shift_ to the solution kept in the workspace
+  void ShiftOsqpWarmStart();
+
+  void CleanUpOsqp();
 
   virtual void ProcessBound(
       const std::vector<std::tuple<double, double, double>>& src,
@@ -171,6 +194,28 @@ class PiecewiseJerkProblem {
 
   double delta_s_ = 1.0;
   double delta_s_sq_ = 1.0;
+
+  // osqp problem of the last Optimize, P and A are referred by data_
+  std::vector<c_float> P_data_;
+  std::vector<c_int> P_indices_;
+  std::vector<c_int> P_indptr_;
+  std::vector<c_float> A_data_;
+  std::vector<c_int> A_indices_;
+  std::vector<c_int> A_indptr_;
+  std::vector<c_float> lower_bounds_;
+  std::vector<c_float> upper_bounds_;
+  std::vector<c_float> q_;
+  OSQPData* data_ = nullptr;
+  OSQPSettings* settings_ = nullptr;
+  OSQPWorkspace* work_ = nullptr;
+
+  size_t warm_start_shift_ = 0;
+
+  bool is_warm_started_ = false;
+  int num_of_iterations_ = 0;
+  double solve_time_ms_ = 0.0;
+
+  DISALLOW_COPY_AND_ASSIGN(PiecewiseJerkProblem);
 };
 
 }  // namespace planning
@@ -22,6 +22,9 @@
 
 #include <chrono>
 #include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include "cyber/common/log.h"
 #include "gtest/gtest.h"
@@ -30,7 +33,7 @@
 
 #define private public
 #define protected public
-#include "modules/planning/math/piecewise_jerk/piesewise_jerk_problem.h"
+#include "modules/planning/math/piecewise_jerk/piecewise_jerk_problem.h"
 
 namespace apollo {
 namespace planning {
@@ -53,8 +56,8 @@ TEST(PiecewiseJerkProblemTest, basic_test) {
   std::array<double, 5> w = {1.0, 2.0, 3.0, 4.0, 1.45};
   double max_x_third_order_derivative = 1.25;
 
-  std::unique_ptr<PiecewiseJerkProblem> fem_qp(new PiecewiseJerkProblem(
-      n, x_init, delta_s, w, max_x_third_order_derivative));
+  std::unique_ptr<PiecewiseJerkProblem> fem_qp(new PiecewiseJerkProblem());
+  fem_qp->InitProblem(n, delta_s, w, max_x_third_order_derivative, x_init);
 
   fem_qp->SetVariableBounds(x_bounds);
   fem_qp->SetFirstOrderBounds(-FLAGS_lateral_derivative_bound_default,
@@ -84,8 +87,8 @@ TEST(PiecewiseJerkProblemTest, add_bounds_test) {
   std::array<double, 5> w = {1.0, 2.0, 3.0, 4.0, 1.45};
   double max_x_third_order_derivative = 0.25;
 
-  std::unique_ptr<PiecewiseJerkProblem> fem_qp(new PiecewiseJerkProblem(
-      n, delta_s, w, max_x_third_order_derivative, x_init));
+  std::unique_ptr<PiecewiseJerkProblem> fem_qp(new PiecewiseJerkProblem());
+  fem_qp->InitProblem(n, delta_s, w, max_x_third_order_derivative, x_init);
 
   std::vector<std::tuple<double, double, double>> x_bounds;
   for (size_t i = 10; i < 20; ++i) {
@@ -115,8 +118,8 @@ TEST(PiecewiseJerkProblemTest, derivative_constraint_test) {
   std::array<double, 5> w = {1.0, 100.0, 1000.0, 1000.0, 0.0};
   double max_x_third_order_derivative = 2.0;
 
-  std::unique_ptr<PiecewiseJerkProblem> fem_qp(new PiecewiseJerkProblem(
-      n, x_init, delta_s, w, max_x_third_order_derivative));
+  std::unique_ptr<PiecewiseJerkProblem> fem_qp(new PiecewiseJerkProblem());
+  fem_qp->InitProblem(n, delta_s, w, max_x_third_order_derivative, x_init);
 
   fem_qp->SetVariableBounds(x_bounds);
   fem_qp->SetFirstOrderBounds(-FLAGS_lateral_derivative_bound_default,
@@ -153,5 +156,152 @@ TEST(PiecewiseJerkProblemTest, derivative_constraint_test) {
   }
 }
 
+namespace {
+
+constexpr size_t kNumOfKnots = 100;
+constexpr double kDeltaS = 0.5;
+
+// the lateral bounds of a lane of half width 1.8 with an obstacle on its left
+// side from s_obstacle to s_obstacle + 5
+std::vector<std::pair<double, double>> LaneBounds(const double start_s,
+                                                  const double s_obstacle) {
+  std::vector<std::pair<double, double>> x_bounds;
+  for (size_t i = 0; i < kNumOfKnots; ++i) {
+    const double s = start_s + static_cast<double>(i) * kDeltaS;
+    if (s >= s_obstacle && s <= s_obstacle + 5.0) {
+      x_bounds.emplace_back(-1.8, 0.2);
+    } else {
+      x_bounds.emplace_back(-1.8, 1.8);
+    }
+  }
+  return x_bounds;
+}
+
+void SetUpProblem(const std::array<double, 3>& x_init,
+                  const std::vector<std::pair<double, double>>& x_bounds,
+                  PiecewiseJerkProblem* problem) {
+  std::array<double, 5> w = {1.0, 100.0, 1000.0, 1000.0, 0.0};
+  problem->InitProblem(kNumOfKnots, kDeltaS, w, 2.0, x_init);
+  problem->SetZeroOrderBounds(x_bounds);
+  problem->SetFirstOrderBounds(-FLAGS_lateral_derivative_bound_default,
+                               FLAGS_lateral_derivative_bound_default);
+  problem->SetSecondOrderBounds(-FLAGS_lateral_derivative_bound_default,
+                                FLAGS_lateral_derivative_bound_default);
+}
+
+void ExpectNear(const std::vector<double>& expected,
+                const std::vector<double>& actual, const double tolerance) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(expected[i], actual[i], tolerance) << "at knot " << i;
+  }
+}
+
+}  // namespace
+
+TEST(PiecewiseJerkProblemTest, reuse_workspace_test) {
+  FLAGS_enable_osqp_debug = false;
+  const std::array<double, 3> x_init = {0.5, 0.0, 0.0};
+  PiecewiseJerkProblem problem;
+  SetUpProblem(x_init, LaneBounds(0.0, 20.0), &problem);
+  EXPECT_TRUE(problem.Optimize());
+  EXPECT_FALSE(problem.is_warm_started());
+  const OSQPWorkspace* work = problem.work_;
+  ASSERT_NE(work, nullptr);
+
+  // the same dimensions and weights, only the bounds and the init state move
+  SetUpProblem({0.4, 0.01, 0.0}, LaneBounds(0.0, 19.0), &problem);
+  EXPECT_TRUE(problem.Optimize());
+  EXPECT_TRUE(problem.is_warm_started());
+  EXPECT_EQ(problem.work_, work);
+
+  // another number of knots needs a new workspace
+  std::array<double, 5> w = {1.0, 100.0, 1000.0, 1000.0, 0.0};
+  problem.InitProblem(kNumOfKnots / 2, kDeltaS, w, 2.0, x_init);
+  EXPECT_TRUE(problem.Optimize());
+  EXPECT_FALSE(problem.is_warm_started());
+  EXPECT_EQ(problem.x().size(), kNumOfKnots / 2);
+}
+
+TEST(PiecewiseJerkProblemTest, warm_start_test) {
+  FLAGS_enable_osqp_debug = false;
+  PiecewiseJerkProblem warm_problem;
+  SetUpProblem({0.5, 0.0, 0.0}, LaneBounds(0.0, 20.0), &warm_problem);
+  EXPECT_TRUE(warm_problem.Optimize());
+
+  const std::array<double, 3> x_init = {0.3, 0.02, -0.01};
+  const auto x_bounds = LaneBounds(0.0, 18.0);
+  SetUpProblem(x_init, x_bounds, &warm_problem);
+  EXPECT_TRUE(warm_problem.Optimize());
+  EXPECT_TRUE(warm_problem.is_warm_started());
+
+  PiecewiseJerkProblem cold_problem;
+  SetUpProblem(x_init, x_bounds, &cold_problem);
+  EXPECT_TRUE(cold_problem.Optimize());
+  EXPECT_FALSE(cold_problem.is_warm_started());
+
+  ExpectNear(cold_problem.x(), warm_problem.x(), 1e-2);
+  ExpectNear(cold_problem.x_derivative(), warm_problem.x_derivative(), 1e-2);
+  for (size_t i = 0; i < x_bounds.size(); ++i) {
+    EXPECT_LE(warm_problem.x()[i], x_bounds[i].second + 1e-3);
+    EXPECT_GE(warm_problem.x()[i], x_bounds[i].first - 1e-3);
+  }
+}
+
+TEST(PiecewiseJerkProblemTest, shift_warm_start_test) {
+  FLAGS_enable_osqp_debug = false;
+  PiecewiseJerkProblem warm_problem;
+  SetUpProblem({0.5, 0.0, 0.0}, LaneBounds(0.0, 20.0), &warm_problem);
+  EXPECT_TRUE(warm_problem.Optimize());
+  const std::vector<double> last_x = warm_problem.x();
+
+  // the next problem starts k knots further, on the last solution
+  const size_t k = 6;
+  const double start_s = static_cast<double>(k) * kDeltaS;
+  const std::array<double, 3> x_init = {
+      last_x[k], warm_problem.x_derivative()[k],
+      warm_problem.x_second_order_derivative()[k]};
+  const auto x_bounds = LaneBounds(start_s, 20.0);
+  SetUpProblem(x_init, x_bounds, &warm_problem);
+  warm_problem.ShiftWarmStart(k);
+  EXPECT_TRUE(warm_problem.Optimize());
+  EXPECT_TRUE(warm_problem.is_warm_started());
+  // the shift only applies to one solve
+  EXPECT_EQ(warm_problem.warm_start_shift_, 0);
+
+  PiecewiseJerkProblem cold_problem;
+  SetUpProblem(x_init, x_bounds, &cold_problem);
+  EXPECT_TRUE(cold_problem.Optimize());
+  ExpectNear(cold_problem.x(), warm_problem.x(), 1e-2);
+
+  // a shift beyond the last knot starts from the last knot of the solution
+  SetUpProblem(x_init, x_bounds, &warm_problem);
+  warm_problem.ShiftWarmStart(2 * kNumOfKnots);
+  EXPECT_TRUE(warm_problem.Optimize());
+  EXPECT_TRUE(warm_problem.is_warm_started());
+  ExpectNear(cold_problem.x(), warm_problem.x(), 1e-2);
+}
+
+TEST(PiecewiseJerkProblemTest, failed_solve_test) {
+  FLAGS_enable_osqp_debug = false;
+  PiecewiseJerkProblem problem;
+  SetUpProblem({0.5, 0.0, 0.0}, LaneBounds(0.0, 20.0), &problem);
+  EXPECT_TRUE(problem.Optimize());
+  ASSERT_NE(problem.work_, nullptr);
+
+  // the init state is outside of the bounds of the first knot
+  SetUpProblem({2.5, 0.0, 0.0}, LaneBounds(0.0, 20.0), &problem);
+  EXPECT_FALSE(problem.Optimize());
+  EXPECT_TRUE(problem.is_warm_started());
+  EXPECT_EQ(problem.work_, nullptr);
+  EXPECT_EQ(problem.data_, nullptr);
+
+  // the next solve starts cold
+  SetUpProblem({0.5, 0.0, 0.0}, LaneBounds(0.0, 20.0), &problem);
+  EXPECT_TRUE(problem.Optimize());
+  EXPECT_FALSE(problem.is_warm_started());
+  EXPECT_NE(problem.work_, nullptr);
+}
+
 }  // namespace planning
 }  // namespace apollo
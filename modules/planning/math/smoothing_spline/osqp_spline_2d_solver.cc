@@ -149,6 +149,15 @@ bool OsqpSpline2dSolver::Solve() {
   // Setup workspace
   OSQPWorkspace* work = osqp_setup(data, settings);
 
+  // warm start from the last solution when the problem has the same size,
+  // as the active set solver hot starts
+  const int num_param = static_cast<int>(P.rows());
+  if (last_problem_success_ && num_param == last_num_param_ &&
+      constraint_num == last_num_constraint_) {
+    ADEBUG << "OsqpSpline2dSolver is using warm start.";
+    osqp_warm_start(work, last_primal_.data(), last_dual_.data());
+  }
+
   // Solve Problem
   osqp_solve(work);
 
@@ -157,8 +166,14 @@ bool OsqpSpline2dSolver::Solve() {
     solved_params(i, 0) = work->solution->x[i];
   }
 
-  last_num_param_ = static_cast<int>(P.rows());
+  last_num_param_ = num_param;
   last_num_constraint_ = static_cast<int>(constraint_num);
+  last_problem_success_ = work->info->status_val == OSQP_SOLVED ||
+                          work->info->status_val == OSQP_SOLVED_INACCURATE;
+  if (last_problem_success_) {
+    last_primal_.assign(work->solution->x, work->solution->x + num_param);
+    last_dual_.assign(work->solution->y, work->solution->y + constraint_num);
+  }
 
   // Cleanup
   osqp_cleanup(work);
@@ -59,6 +59,9 @@ class OsqpSpline2dSolver final : public Spline2dSolver {
   int last_num_constraint_ = 0;
   int last_num_param_ = 0;
   bool last_problem_success_ = false;
+  // solution of the last problem, to warm start the next one
+  std::vector<c_float> last_primal_;
+  std::vector<c_float> last_dual_;
 };
 
 }  // namespace planning
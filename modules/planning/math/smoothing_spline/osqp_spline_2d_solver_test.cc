@@ -20,6 +20,8 @@
 #include "modules/planning/math/smoothing_spline/osqp_spline_2d_solver.h"
 
 #include <chrono>
+#include <cmath>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -146,5 +148,46 @@ TEST(OSQPSolverTest, solver_test_01) {
   }
 }
 
+TEST(OSQPSolverTest, warm_start) {
+  std::vector<double> t_knots{0, 1, 2, 3};
+  uint32_t order = 5;
+  std::vector<double> et{0, 0.5, 1, 1.5, 2, 2.5, 3};
+  std::vector<double> bound(et.size(), 0.2);
+  std::vector<double> angle(et.size(), 0.3);
+  auto set_up = [&](const double offset, OsqpSpline2dSolver* spline_solver) {
+    spline_solver->Reset(t_knots, order);
+    std::vector<Vec2d> ref_point;
+    for (const double t : et) {
+      ref_point.emplace_back(t * std::cos(0.3),
+                             t * std::sin(0.3) + offset * t * t);
+    }
+    Spline2dConstraint* constraint = spline_solver->mutable_constraint();
+    Spline2dKernel* kernel = spline_solver->mutable_kernel();
+    EXPECT_TRUE(constraint->Add2dBoundary(et, angle, ref_point, bound, bound));
+    EXPECT_TRUE(constraint->AddSecondDerivativeSmoothConstraint());
+    kernel->AddThirdOrderDerivativeMatrix(100);
+    kernel->AddRegularization(0.1);
+  };
+
+  // the second problem has the size of the first one and is warm started
+  // from its solution, which should not change the solution
+  OsqpSpline2dSolver warm_solver(t_knots, order);
+  set_up(0.0, &warm_solver);
+  EXPECT_TRUE(warm_solver.Solve());
+  set_up(0.05, &warm_solver);
+  EXPECT_TRUE(warm_solver.Solve());
+
+  OsqpSpline2dSolver cold_solver(t_knots, order);
+  set_up(0.05, &cold_solver);
+  EXPECT_TRUE(cold_solver.Solve());
+
+  for (double t = 0.0; t <= 3.0; t += 0.1) {
+    auto warm_xy = warm_solver.spline()(t);
+    auto cold_xy = cold_solver.spline()(t);
+    EXPECT_NEAR(warm_xy.first, cold_xy.first, 1e-3);
+    EXPECT_NEAR(warm_xy.second, cold_xy.second, 1e-3);
+  }
+}
+
 }  // namespace planning
 }  // namespace apollo
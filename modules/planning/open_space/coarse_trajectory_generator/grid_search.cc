@@ -20,8 +20,40 @@
 
 #include "modules/planning/open_space/coarse_trajectory_generator/grid_search.h"
 
+#include <cmath>
+#include <utility>
+
 namespace apollo {
 namespace planning {
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+// the eight neighbors of a cell and their grid distances
+constexpr int kNeighborNum = 8;
+constexpr int kNeighborDx[kNeighborNum] = {0, 1, 1, 1, 0, -1, -1, -1};
+constexpr int kNeighborDy[kNeighborNum] = {1, 1, 0, -1, -1, -1, 0, 1};
+const double kNeighborCost[kNeighborNum] = {
+    1.0, std::sqrt(2.0), 1.0, std::sqrt(2.0),
+    1.0, std::sqrt(2.0), 1.0, std::sqrt(2.0)};
+
+// XYbounds with xmin, xmax, ymin, ymax
+int CalcCell(const double x, const double y, const double xy_resolution,
+             const std::vector<double>& XYbounds, const int grid_num_x,
+             const int grid_num_y) {
+  if (XYbounds.size() != 4) {
+    return -1;
+  }
+  int grid_x = static_cast<int>((x - XYbounds[0]) / xy_resolution);
+  int grid_y = static_cast<int>((y - XYbounds[2]) / xy_resolution);
+  if (grid_x < 0 || grid_x >= grid_num_x || grid_y < 0 ||
+      grid_y >= grid_num_y) {
+    return -1;
+  }
+  return grid_x * grid_num_y + grid_y;
+}
+
+}  // namespace
 
 GridSearch::GridSearch(const PlannerOpenSpaceConfig& open_space_conf) {
   xy_grid_resolution_ =
@@ -34,69 +66,106 @@ double GridSearch::EuclidDistance(const double x1, const double y1,
   return std::sqrt((x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2));
 }
 
-bool GridSearch::CheckConstraints(std::shared_ptr<Node2d> node) {
-  if (obstacles_linesegments_vec_.empty()) {
-    return true;
-  }
-  double node_grid_x = node->GetGridX();
-  double node_grid_y = node->GetGridY();
-  if (node_grid_x > max_grid_x_ || node_grid_x < 0 ||
-      node_grid_y > max_grid_y_ || node_grid_y < 0) {
-    return false;
+int GridSearch::CalcCellIndex(const double x, const double y) const {
+  return CalcCell(x, y, xy_grid_resolution_, XYbounds_, grid_num_x_,
+                  grid_num_y_);
+}
+
+void GridSearch::SetGrid(
+    const std::vector<double>& XYbounds,
+    const std::vector<std::vector<common::math::LineSegment2d>>&
+        obstacles_linesegments_vec) {
+  XYbounds_ = XYbounds;
+  obstacles_linesegments_vec_ = obstacles_linesegments_vec;
+  // XYbounds with xmin, xmax, ymin, ymax
+  max_grid_y_ = std::round((XYbounds_[3] - XYbounds_[2]) / xy_grid_resolution_);
+  max_grid_x_ = std::round((XYbounds_[1] - XYbounds_[0]) / xy_grid_resolution_);
+  grid_num_x_ = std::max(static_cast<int>(max_grid_x_) + 1, 0);
+  grid_num_y_ = std::max(static_cast<int>(max_grid_y_) + 1, 0);
+  open_pq_.Clear();
+  final_cell_ = -1;
+  RasterizeObstacles();
+}
+
+void GridSearch::RasterizeObstacles() {
+  // assign keeps the capacity of the buffer
+  blocked_.assign(static_cast<size_t>(grid_num_x_) * grid_num_y_, 0);
+  if (grid_num_x_ == 0 || grid_num_y_ == 0) {
+    return;
   }
+  // a cell is blocked if a line segment is closer than node_radius_ to its
+  // grid coordinates, only the cells around the segment box can be
+  const auto clamp_grid = [](const double grid, const int grid_num) {
+    return static_cast<int>(
+        std::max(0.0, std::min(grid, static_cast<double>(grid_num - 1))));
+  };
   for (const auto& obstacle_linesegments : obstacles_linesegments_vec_) {
     for (const common::math::LineSegment2d& linesegment :
          obstacle_linesegments) {
-      if (linesegment.DistanceTo({node->GetGridX(), node->GetGridY()}) <
-          node_radius_) {
-        return false;
+      const common::math::Vec2d& start = linesegment.start();
+      const common::math::Vec2d& end = linesegment.end();
+      const int min_x = clamp_grid(
+          std::floor(std::min(start.x(), end.x()) - node_radius_), grid_num_x_);
+      const int max_x = clamp_grid(
+          std::ceil(std::max(start.x(), end.x()) + node_radius_), grid_num_x_);
+      const int min_y = clamp_grid(
+          std::floor(std::min(start.y(), end.y()) - node_radius_), grid_num_y_);
+      const int max_y = clamp_grid(
+          std::ceil(std::max(start.y(), end.y()) + node_radius_), grid_num_y_);
+      for (int grid_x = min_x; grid_x <= max_x; ++grid_x) {
+        for (int grid_y = min_y; grid_y <= max_y; ++grid_y) {
+          uint8_t& blocked = blocked_[CellIndex(grid_x, grid_y)];
+          if (!blocked &&
+              linesegment.DistanceTo({static_cast<double>(grid_x),
+                                      static_cast<double>(grid_y)}) <
+                  node_radius_) {
+            blocked = 1;
+          }
+        }
       }
     }
   }
-  return true;
 }
 
-std::vector<std::shared_ptr<Node2d>> GridSearch::GenerateNextNodes(
-    std::shared_ptr<Node2d> current_node) {
-  double current_node_x = current_node->GetGridX();
-  double current_node_y = current_node->GetGridY();
-  double current_node_path_cost = current_node->GetPathCost();
-  double diagonal_distance = std::sqrt(2.0);
-  std::vector<std::shared_ptr<Node2d>> next_nodes;
-  std::shared_ptr<Node2d> up =
-      std::make_shared<Node2d>(current_node_x, current_node_y + 1.0, XYbounds_);
-  up->SetPathCost(current_node_path_cost + 1.0);
-  std::shared_ptr<Node2d> up_right = std::make_shared<Node2d>(
-      current_node_x + 1.0, current_node_y + 1.0, XYbounds_);
-  up_right->SetPathCost(current_node_path_cost + diagonal_distance);
-  std::shared_ptr<Node2d> right =
-      std::make_shared<Node2d>(current_node_x + 1.0, current_node_y, XYbounds_);
-  right->SetPathCost(current_node_path_cost + 1.0);
-  std::shared_ptr<Node2d> down_right = std::make_shared<Node2d>(
-      current_node_x + 1.0, current_node_y - 1.0, XYbounds_);
-  down_right->SetPathCost(current_node_path_cost + diagonal_distance);
-  std::shared_ptr<Node2d> down =
-      std::make_shared<Node2d>(current_node_x, current_node_y - 1.0, XYbounds_);
-  down->SetPathCost(current_node_path_cost + 1.0);
-  std::shared_ptr<Node2d> down_left = std::make_shared<Node2d>(
-      current_node_x - 1.0, current_node_y - 1.0, XYbounds_);
-  down_left->SetPathCost(current_node_path_cost + diagonal_distance);
-  std::shared_ptr<Node2d> left =
-      std::make_shared<Node2d>(current_node_x - 1.0, current_node_y, XYbounds_);
-  left->SetPathCost(current_node_path_cost + 1.0);
-  std::shared_ptr<Node2d> up_left = std::make_shared<Node2d>(
-      current_node_x - 1.0, current_node_y + 1.0, XYbounds_);
-  up_left->SetPathCost(current_node_path_cost + diagonal_distance);
-
-  next_nodes.emplace_back(up);
-  next_nodes.emplace_back(up_right);
-  next_nodes.emplace_back(right);
-  next_nodes.emplace_back(down_right);
-  next_nodes.emplace_back(down);
-  next_nodes.emplace_back(down_left);
-  next_nodes.emplace_back(left);
-  next_nodes.emplace_back(up_left);
-  return next_nodes;
+bool GridSearch::CheckConstraints(const int grid_x, const int grid_y) const {
+  if (grid_x >= grid_num_x_ || grid_x < 0 || grid_y >= grid_num_y_ ||
+      grid_y < 0) {
+    return false;
+  }
+  return !blocked_[CellIndex(grid_x, grid_y)];
+}
+
+void GridSearch::ExpandCell(const int cell, const int end_cell) {
+  const int grid_x = cell / grid_num_y_;
+  const int grid_y = cell % grid_num_y_;
+  const double path_cost = path_costs_[cell];
+  for (int i = 0; i < kNeighborNum; ++i) {
+    const int next_x = grid_x + kNeighborDx[i];
+    const int next_y = grid_y + kNeighborDy[i];
+    if (!CheckConstraints(next_x, next_y)) {
+      continue;
+    }
+    const int next_cell = CellIndex(next_x, next_y);
+    if (closed_[next_cell]) {
+      continue;
+    }
+    const double next_path_cost = path_cost + kNeighborCost[i];
+    if (next_path_cost >= path_costs_[next_cell]) {
+      continue;
+    }
+    path_costs_[next_cell] = next_path_cost;
+    pre_cells_[next_cell] = cell;
+    double heuristic = 0.0;
+    if (end_cell >= 0) {
+      heuristic = EuclidDistance(next_x, next_y, end_cell / grid_num_y_,
+                                 end_cell % grid_num_y_);
+    }
+    if (open_pq_.Contains(next_cell)) {
+      open_pq_.DecreaseKey(next_cell, next_path_cost + heuristic);
+    } else {
+      open_pq_.Push(next_cell, next_path_cost + heuristic);
+    }
+  }
 }
 
 bool GridSearch::GenerateAStarPath(
@@ -105,56 +174,39 @@ bool GridSearch::GenerateAStarPath(
     const std::vector<std::vector<common::math::LineSegment2d>>&
         obstacles_linesegments_vec,
     GridAStartResult* result) {
-  std::priority_queue<std::pair<std::string, double>,
-                      std::vector<std::pair<std::string, double>>, cmp>
-      open_pq;
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> open_set;
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> close_set;
-  XYbounds_ = XYbounds;
-  std::shared_ptr<Node2d> start_node =
-      std::make_shared<Node2d>(sx, sy, xy_grid_resolution_, XYbounds_);
-  std::shared_ptr<Node2d> end_node =
-      std::make_shared<Node2d>(ex, ey, xy_grid_resolution_, XYbounds_);
-  std::shared_ptr<Node2d> final_node_ = nullptr;
-  obstacles_linesegments_vec_ = obstacles_linesegments_vec;
-  open_set.insert(std::make_pair(start_node->GetIndex(), start_node));
-  open_pq.push(std::make_pair(start_node->GetIndex(), start_node->GetCost()));
+  SetGrid(XYbounds, obstacles_linesegments_vec);
+  const int start_cell = CalcCellIndex(sx, sy);
+  if (start_cell < 0) {
+    AERROR << "Grid A start point is out of XYbounds";
+    return false;
+  }
+  const int end_cell = CalcCellIndex(ex, ey);
+  if (end_cell < 0) {
+    AERROR << "Grid A end point is out of XYbounds";
+    return false;
+  }
+  const size_t cell_num = blocked_.size();
+  path_costs_.assign(cell_num, kInfinity);
+  pre_cells_.assign(cell_num, -1);
+  closed_.assign(cell_num, 0);
+  path_costs_[start_cell] = 0.0;
+  open_pq_.Push(start_cell, 0.0);
 
   // Grid a star begins
   size_t explored_node_num = 0;
-  while (!open_pq.empty()) {
-    std::string current_id = open_pq.top().first;
-    open_pq.pop();
-    std::shared_ptr<Node2d> current_node = open_set[current_id];
+  while (!open_pq_.Empty()) {
+    const int current_cell = open_pq_.Pop();
     // Check destination
-    if (*(current_node) == *(end_node)) {
-      final_node_ = current_node;
+    if (current_cell == end_cell) {
+      final_cell_ = current_cell;
       break;
     }
-    close_set.emplace(current_node->GetIndex(), current_node);
-    std::vector<std::shared_ptr<Node2d>> next_nodes =
-        std::move(GenerateNextNodes(current_node));
-    for (auto& next_node : next_nodes) {
-      if (!CheckConstraints(next_node)) {
-        continue;
-      }
-      if (close_set.find(next_node->GetIndex()) != close_set.end()) {
-        continue;
-      }
-      if (open_set.find(next_node->GetIndex()) == open_set.end()) {
-        ++explored_node_num;
-        next_node->SetHeuristic(
-            EuclidDistance(next_node->GetGridX(), next_node->GetGridY(),
-                           end_node->GetGridX(), end_node->GetGridY()));
-        next_node->SetPreNode(current_node);
-        open_set.insert(std::make_pair(next_node->GetIndex(), next_node));
-        open_pq.push(
-            std::make_pair(next_node->GetIndex(), next_node->GetCost()));
-      }
-    }
+    closed_[current_cell] = 1;
+    ++explored_node_num;
+    ExpandCell(current_cell, end_cell);
   }
 
-  if (final_node_ == nullptr) {
+  if (final_cell_ < 0) {
     AERROR << "Grid A searching return null ptr(open_set ran out)";
     return false;
   }
@@ -167,80 +219,178 @@ bool GridSearch::GenerateDpMap(
     const double ex, const double ey, const std::vector<double>& XYbounds,
     const std::vector<std::vector<common::math::LineSegment2d>>&
         obstacles_linesegments_vec) {
-  std::priority_queue<std::pair<std::string, double>,
-                      std::vector<std::pair<std::string, double>>, cmp>
-      open_pq;
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> open_set;
-  dp_map_ = decltype(dp_map_)();
-  XYbounds_ = XYbounds;
-  // XYbounds with xmin, xmax, ymin, ymax
-  max_grid_y_ = std::round((XYbounds_[3] - XYbounds_[2]) / xy_grid_resolution_);
-  max_grid_x_ = std::round((XYbounds_[1] - XYbounds_[0]) / xy_grid_resolution_);
-  std::shared_ptr<Node2d> end_node =
-      std::make_shared<Node2d>(ex, ey, xy_grid_resolution_, XYbounds_);
-  obstacles_linesegments_vec_ = obstacles_linesegments_vec;
-  open_set.insert(std::make_pair(end_node->GetIndex(), end_node));
-  open_pq.push(std::make_pair(end_node->GetIndex(), end_node->GetCost()));
+  SetGrid(XYbounds, obstacles_linesegments_vec);
+  const int end_cell = CalcCellIndex(ex, ey);
+  const size_t cell_num = blocked_.size();
+  if (end_cell >= 0 && end_cell == dp_map_end_cell_ &&
+      XYbounds_ == dp_map_XYbounds_) {
+    // same end and grid as the cached map, only the obstacles may differ
+    if (RepairDpMap()) {
+      PropagateDpMap();
+    } else {
+      ADEBUG << "DP map reused";
+    }
+  } else {
+    dp_map_.assign(cell_num, std::numeric_limits<float>::infinity());
+    dp_pre_cells_.assign(cell_num, -1);
+    if (end_cell >= 0) {
+      dp_map_[end_cell] = 0.0f;
+      open_pq_.Push(end_cell, 0.0);
+    } else {
+      AERROR << "DP map end point is out of XYbounds";
+    }
+    PropagateDpMap();
+  }
+  dp_blocked_.swap(blocked_);
+  dp_map_XYbounds_ = XYbounds_;
+  dp_map_grid_num_x_ = grid_num_x_;
+  dp_map_grid_num_y_ = grid_num_y_;
+  dp_map_end_cell_ = end_cell;
+  return end_cell >= 0;
+}
 
-  // Grid a star begins
+void GridSearch::PropagateDpMap() {
   size_t explored_node_num = 0;
-  while (!open_pq.empty()) {
-    const std::string current_id = open_pq.top().first;
-    open_pq.pop();
-    std::shared_ptr<Node2d> current_node = open_set[current_id];
-    dp_map_.insert(std::make_pair(current_node->GetIndex(), current_node));
-    std::vector<std::shared_ptr<Node2d>> next_nodes =
-        std::move(GenerateNextNodes(current_node));
-    for (auto& next_node : next_nodes) {
-      if (!CheckConstraints(next_node)) {
+  while (!open_pq_.Empty()) {
+    const int cell = open_pq_.Pop();
+    ++explored_node_num;
+    const int grid_x = cell / grid_num_y_;
+    const int grid_y = cell % grid_num_y_;
+    const float path_cost = dp_map_[cell];
+    for (int i = 0; i < kNeighborNum; ++i) {
+      const int next_x = grid_x + kNeighborDx[i];
+      const int next_y = grid_y + kNeighborDy[i];
+      if (!CheckConstraints(next_x, next_y)) {
         continue;
       }
-      if (dp_map_.find(next_node->GetIndex()) != dp_map_.end()) {
+      const int next_cell = CellIndex(next_x, next_y);
+      const float next_path_cost =
+          path_cost + static_cast<float>(kNeighborCost[i]);
+      if (next_path_cost >= dp_map_[next_cell]) {
         continue;
       }
-      if (open_set.find(next_node->GetIndex()) == open_set.end()) {
-        ++explored_node_num;
-        next_node->SetPreNode(current_node);
-        open_set.insert(std::make_pair(next_node->GetIndex(), next_node));
-        open_pq.push(
-            std::make_pair(next_node->GetIndex(), next_node->GetCost()));
+      dp_map_[next_cell] = next_path_cost;
+      dp_pre_cells_[next_cell] = cell;
+      if (open_pq_.Contains(next_cell)) {
+        open_pq_.DecreaseKey(next_cell, next_path_cost);
       } else {
-        if (open_set[next_node->GetIndex()]->GetCost() > next_node->GetCost()) {
-          open_set[next_node->GetIndex()]->SetCost(next_node->GetCost());
-          open_set[next_node->GetIndex()]->SetPreNode(current_node);
-        }
+        open_pq_.Push(next_cell, next_path_cost);
       }
     }
   }
   ADEBUG << "explored node num is " << explored_node_num;
+}
+
+bool GridSearch::RepairDpMap() {
+  dp_changed_cells_.clear();
+  for (size_t cell = 0; cell < blocked_.size(); ++cell) {
+    if (blocked_[cell] != dp_blocked_[cell] &&
+        static_cast<int>(cell) != dp_map_end_cell_) {
+      dp_changed_cells_.push_back(static_cast<int>(cell));
+    }
+  }
+  if (dp_changed_cells_.empty()) {
+    return false;
+  }
+  // The labels of the newly blocked cells and of their subtrees in the
+  // shortest path tree are no longer supported, reset them to infinity.
+  dp_invalid_cells_.clear();
+  for (const int cell : dp_changed_cells_) {
+    if (blocked_[cell] && std::isfinite(dp_map_[cell])) {
+      dp_map_[cell] = std::numeric_limits<float>::infinity();
+      dp_pre_cells_[cell] = -1;
+      dp_invalid_cells_.push_back(cell);
+    }
+  }
+  for (size_t i = 0; i < dp_invalid_cells_.size(); ++i) {
+    const int cell = dp_invalid_cells_[i];
+    const int grid_x = cell / grid_num_y_;
+    const int grid_y = cell % grid_num_y_;
+    for (int j = 0; j < kNeighborNum; ++j) {
+      const int next_x = grid_x + kNeighborDx[j];
+      const int next_y = grid_y + kNeighborDy[j];
+      if (next_x < 0 || next_x >= grid_num_x_ || next_y < 0 ||
+          next_y >= grid_num_y_) {
+        continue;
+      }
+      const int next_cell = CellIndex(next_x, next_y);
+      if (dp_pre_cells_[next_cell] == cell) {
+        dp_map_[next_cell] = std::numeric_limits<float>::infinity();
+        dp_pre_cells_[next_cell] = -1;
+        dp_invalid_cells_.push_back(next_cell);
+      }
+    }
+  }
+  // The invalidated free cells and the newly freed cells are reached again
+  // from their neighbors whose labels still hold, the propagation lowers the
+  // rest. Every other label is an upper bound of the new distance already.
+  for (const int cell : dp_invalid_cells_) {
+    SeedDpCell(cell);
+  }
+  for (const int cell : dp_changed_cells_) {
+    SeedDpCell(cell);
+  }
+  ADEBUG << "DP map repaired for " << dp_changed_cells_.size()
+         << " changed cells, " << dp_invalid_cells_.size() << " invalidated";
   return true;
 }
 
-double GridSearch::CheckDpMap(const double sx, const double sy) {
-  std::string index = Node2d::CalcIndex(sx, sy, xy_grid_resolution_, XYbounds_);
-  if (dp_map_.find(index) != dp_map_.end()) {
-    return dp_map_[index]->GetCost() * xy_grid_resolution_;
+void GridSearch::SeedDpCell(const int cell) {
+  if (blocked_[cell]) {
+    return;
+  }
+  const int grid_x = cell / grid_num_y_;
+  const int grid_y = cell % grid_num_y_;
+  for (int i = 0; i < kNeighborNum; ++i) {
+    const int pre_x = grid_x + kNeighborDx[i];
+    const int pre_y = grid_y + kNeighborDy[i];
+    if (pre_x < 0 || pre_x >= grid_num_x_ || pre_y < 0 ||
+        pre_y >= grid_num_y_) {
+      continue;
+    }
+    const int pre_cell = CellIndex(pre_x, pre_y);
+    const float path_cost =
+        dp_map_[pre_cell] + static_cast<float>(kNeighborCost[i]);
+    if (path_cost < dp_map_[cell]) {
+      dp_map_[cell] = path_cost;
+      dp_pre_cells_[cell] = pre_cell;
+    }
+  }
+  if (!std::isfinite(dp_map_[cell])) {
+    return;
+  }
+  if (open_pq_.Contains(cell)) {
+    open_pq_.DecreaseKey(cell, dp_map_[cell]);
   } else {
-    return std::numeric_limits<double>::infinity();
+    open_pq_.Push(cell, dp_map_[cell]);
   }
 }
 
+double GridSearch::CheckDpMap(const double sx, const double sy) {
+  const int cell = CalcCell(sx, sy, xy_grid_resolution_, dp_map_XYbounds_,
+                            dp_map_grid_num_x_, dp_map_grid_num_y_);
+  if (cell < 0) {
+    return kInfinity;
+  }
+  return dp_map_[cell] * xy_grid_resolution_;
+}
+
 void GridSearch::LoadGridAStarResult(GridAStartResult* result) {
-  (*result).path_cost = final_node_->GetPathCost() * xy_grid_resolution_;
-  std::shared_ptr<Node2d> current_node = final_node_;
+  (*result).path_cost = path_costs_[final_cell_] * xy_grid_resolution_;
   std::vector<double> grid_a_x;
   std::vector<double> grid_a_y;
-  while (current_node->GetPreNode() != nullptr) {
-    grid_a_x.push_back(current_node->GetGridX() * xy_grid_resolution_ +
+  for (int cell = final_cell_; pre_cells_[cell] >= 0;
+       cell = pre_cells_[cell]) {
+    grid_a_x.push_back((cell / grid_num_y_) * xy_grid_resolution_ +
                        XYbounds_[0]);
-    grid_a_y.push_back(current_node->GetGridY() * xy_grid_resolution_ +
+    grid_a_y.push_back((cell % grid_num_y_) * xy_grid_resolution_ +
                        XYbounds_[2]);
-    current_node = current_node->GetPreNode();
   }
   std::reverse(grid_a_x.begin(), grid_a_x.end());
   std::reverse(grid_a_y.begin(), grid_a_y.end());
   (*result).x = std::move(grid_a_x);
   (*result).y = std::move(grid_a_y);
 }
+
 }  // namespace planning
 }  // namespace apollo
@@ -21,80 +21,18 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 #include <limits>
-#include <memory>
-#include <queue>
-#include <string>
-#include <unordered_map>
-#include <utility>
 #include <vector>
 
 #include "cyber/common/log.h"
 #include "modules/common/math/line_segment2d.h"
+#include "modules/planning/open_space/coarse_trajectory_generator/indexed_priority_queue.h"
 #include "modules/planning/proto/planner_open_space_config.pb.h"
 
 namespace apollo {
 namespace planning {
 
-class Node2d {
- public:
-  Node2d(const double x, const double y, const double xy_resolution,
-         const std::vector<double>& XYbounds) {
-    // XYbounds with xmin, xmax, ymin, ymax
-    grid_x_ = static_cast<int>((x - XYbounds[0]) / xy_resolution);
-    grid_y_ = static_cast<int>((y - XYbounds[2]) / xy_resolution);
-    index_ = ComputeStringIndex(grid_x_, grid_y_);
-  }
-  Node2d(const int grid_x, const int grid_y,
-         const std::vector<double>& XYbounds) {
-    grid_x_ = grid_x;
-    grid_y_ = grid_y;
-    index_ = ComputeStringIndex(grid_x_, grid_y_);
-  }
-  void SetPathCost(const double path_cost) {
-    path_cost_ = path_cost;
-    cost_ = path_cost_ + heuristic_;
-  }
-  void SetHeuristic(const double heuristic) {
-    heuristic_ = heuristic;
-    cost_ = path_cost_ + heuristic_;
-  }
-  void SetCost(const double cost) { cost_ = cost; }
-  void SetPreNode(std::shared_ptr<Node2d> pre_node) { pre_node_ = pre_node; }
-  double GetGridX() const { return grid_x_; }
-  double GetGridY() const { return grid_y_; }
-  double GetPathCost() const { return path_cost_; }
-  double GetHeuCost() const { return heuristic_; }
-  double GetCost() const { return cost_; }
-  const std::string& GetIndex() const { return index_; }
-  std::shared_ptr<Node2d> GetPreNode() const { return pre_node_; }
-  static std::string CalcIndex(const double x, const double y,
-                               const double xy_resolution,
-                               const std::vector<double>& XYbounds) {
-    // XYbounds with xmin, xmax, ymin, ymax
-    int grid_x = static_cast<int>((x - XYbounds[0]) / xy_resolution);
-    int grid_y = static_cast<int>((y - XYbounds[2]) / xy_resolution);
-    return ComputeStringIndex(grid_x, grid_y);
-  }
-  bool operator==(const Node2d& right) const {
-    return right.GetIndex() == index_;
-  }
-
- private:
-  static std::string ComputeStringIndex(int x_grid, int y_grid) {
-    return std::to_string(x_grid) + "_" + std::to_string(y_grid);
-  }
-
- private:
-  int grid_x_ = 0;
-  int grid_y_ = 0;
-  double path_cost_ = 0.0;
-  double heuristic_ = 0.0;
-  double cost_ = 0.0;
-  std::string index_;
-  std::shared_ptr<Node2d> pre_node_ = nullptr;
-};
-
 struct GridAStartResult {
   std::vector<double> x;
   std::vector<double> y;
@@ -120,30 +58,63 @@ class GridSearch {
  private:
   double EuclidDistance(const double x1, const double y1, const double x2,
                         const double y2);
-  std::vector<std::shared_ptr<Node2d>> GenerateNextNodes(
-      std::shared_ptr<Node2d> node);
-  bool CheckConstraints(std::shared_ptr<Node2d> node);
+  // set the grid of XYbounds and the blocked cells of the obstacles
+  void SetGrid(const std::vector<double>& XYbounds,
+               const std::vector<std::vector<common::math::LineSegment2d>>&
+                   obstacles_linesegments_vec);
+  void RasterizeObstacles();
+  // cell of the position, -1 if outside of the grid
+  int CalcCellIndex(const double x, const double y) const;
+  int CellIndex(const int grid_x, const int grid_y) const {
+    return grid_x * grid_num_y_ + grid_y;
+  }
+  bool CheckConstraints(const int grid_x, const int grid_y) const;
+  // relax the 8 neighbors of the popped cell for the a star path
+  void ExpandCell(const int cell, const int end_cell);
   void LoadGridAStarResult(GridAStartResult* result);
 
+  // dijkstra over dp_map_ from the queued cells, the labels only decrease
+  void PropagateDpMap();
+  // repair dp_map_ for the cells whose blocked state changed since the map
+  // was built, return false if nothing changed
+  bool RepairDpMap();
+  // lower the label of a free cell from its reached neighbors
+  void SeedDpCell(const int cell);
+
  private:
   double xy_grid_resolution_ = 0.0;
   double node_radius_ = 0.0;
   std::vector<double> XYbounds_;
   double max_grid_x_ = 0.0;
   double max_grid_y_ = 0.0;
-  std::shared_ptr<Node2d> start_node_;
-  std::shared_ptr<Node2d> end_node_;
-  std::shared_ptr<Node2d> final_node_;
+  int grid_num_x_ = 0;
+  int grid_num_y_ = 0;
+  int final_cell_ = -1;
   std::vector<std::vector<common::math::LineSegment2d>>
       obstacles_linesegments_vec_;
 
-  struct cmp {
-    bool operator()(const std::pair<std::string, double>& left,
-                    const std::pair<std::string, double>& right) const {
-      return left.second >= right.second;
-    }
-  };
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> dp_map_;
+  // dense per cell states indexed by CellIndex, the buffers are kept across
+  // searches
+  std::vector<uint8_t> blocked_;
+  std::vector<double> path_costs_;
+  std::vector<int> pre_cells_;
+  std::vector<uint8_t> closed_;
+  IndexedPriorityQueue open_pq_;
+
+  // The holonomic heuristic of the last GenerateDpMap: grid distances to the
+  // end cell, infinity if not reachable, with the shortest path tree and the
+  // blocked cells it was built on. It is repaired instead of rebuilt when
+  // only the obstacles change.
+  std::vector<float> dp_map_;
+  std::vector<int> dp_pre_cells_;
+  std::vector<uint8_t> dp_blocked_;
+  std::vector<double> dp_map_XYbounds_;
+  int dp_map_grid_num_x_ = 0;
+  int dp_map_grid_num_y_ = 0;
+  int dp_map_end_cell_ = -1;
+  // scratch of RepairDpMap
+  std::vector<int> dp_changed_cells_;
+  std::vector<int> dp_invalid_cells_;
 };
 }  // namespace planning
 }  // namespace apollo
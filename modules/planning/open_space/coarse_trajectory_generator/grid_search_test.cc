@@ -0,0 +1,213 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#include "modules/planning/open_space/coarse_trajectory_generator/grid_search.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+using common::math::LineSegment2d;
+using common::math::Vec2d;
+
+class GridSearchTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    // a unit grid at the origin so that grid and world coordinates agree
+    planner_open_space_config_.mutable_warm_start_config()
+        ->set_grid_a_star_xy_resolution(1.0);
+    planner_open_space_config_.mutable_warm_start_config()->set_node_radius(
+        0.5);
+    grid_search_.reset(new GridSearch(planner_open_space_config_));
+    XYbounds_ = {0.0, 20.0, 0.0, 15.0};
+    // a wall with a gap at the top and an obstacle on its right
+    obstacles_.push_back(
+        {LineSegment2d(Vec2d(10.0, -1.0), Vec2d(10.0, 12.0))});
+    obstacles_.push_back({LineSegment2d(Vec2d(14.0, 4.0), Vec2d(17.0, 4.0)),
+                          LineSegment2d(Vec2d(17.0, 4.0), Vec2d(17.0, 9.0))});
+  }
+
+  // bellman ford over the free cells of the grid
+  std::vector<std::vector<double>> ReferenceDpMap(int end_x, int end_y) {
+    const int num_x = 21;
+    const int num_y = 16;
+    const double kInf = std::numeric_limits<double>::infinity();
+    std::vector<std::vector<bool>> free(num_x, std::vector<bool>(num_y, true));
+    for (int x = 0; x < num_x; ++x) {
+      for (int y = 0; y < num_y; ++y) {
+        for (const auto& obstacle : obstacles_) {
+          for (const auto& segment : obstacle) {
+            if (segment.DistanceTo(Vec2d(x, y)) < 0.5) {
+              free[x][y] = false;
+            }
+          }
+        }
+      }
+    }
+    std::vector<std::vector<double>> costs(num_x,
+                                           std::vector<double>(num_y, kInf));
+    costs[end_x][end_y] = 0.0;
+    bool updated = true;
+    while (updated) {
+      updated = false;
+      for (int x = 0; x < num_x; ++x) {
+        for (int y = 0; y < num_y; ++y) {
+          if (std::isinf(costs[x][y])) {
+            continue;
+          }
+          for (int dx = -1; dx <= 1; ++dx) {
+            for (int dy = -1; dy <= 1; ++dy) {
+              int nx = x + dx;
+              int ny = y + dy;
+              if ((dx == 0 && dy == 0) || nx < 0 || nx >= num_x || ny < 0 ||
+                  ny >= num_y || !free[nx][ny]) {
+                continue;
+              }
+              double cost =
+                  costs[x][y] + ((dx != 0 && dy != 0) ? std::sqrt(2.0) : 1.0);
+              if (cost < costs[nx][ny] - 1e-9) {
+                costs[nx][ny] = cost;
+                updated = true;
+              }
+            }
+          }
+        }
+      }
+    }
+    return costs;
+  }
+
+ protected:
+  PlannerOpenSpaceConfig planner_open_space_config_;
+  std::unique_ptr<GridSearch> grid_search_;
+  std::vector<double> XYbounds_;
+  std::vector<std::vector<LineSegment2d>> obstacles_;
+};
+
+TEST_F(GridSearchTest, GenerateDpMap) {
+  ASSERT_TRUE(grid_search_->GenerateDpMap(18.2, 6.3, XYbounds_, obstacles_));
+  auto reference = ReferenceDpMap(18, 6);
+  for (int x = 0; x <= 20; ++x) {
+    for (int y = 0; y <= 15; ++y) {
+      double cost = grid_search_->CheckDpMap(x + 0.5, y + 0.5);
+      if (std::isinf(reference[x][y])) {
+        EXPECT_TRUE(std::isinf(cost)) << x << " " << y;
+      } else {
+        EXPECT_NEAR(cost, reference[x][y], 1e-4) << x << " " << y;
+      }
+    }
+  }
+  EXPECT_TRUE(std::isinf(grid_search_->CheckDpMap(-5.0, 3.0)));
+  EXPECT_TRUE(std::isinf(grid_search_->CheckDpMap(3.0, 30.0)));
+
+  // a second map reuses the buffers
+  ASSERT_TRUE(grid_search_->GenerateDpMap(2.0, 2.0, XYbounds_, obstacles_));
+  reference = ReferenceDpMap(2, 2);
+  EXPECT_NEAR(grid_search_->CheckDpMap(18.0, 6.0), reference[18][6], 1e-4);
+  EXPECT_FALSE(grid_search_->GenerateDpMap(25.0, 2.0, XYbounds_, obstacles_));
+}
+
+TEST_F(GridSearchTest, RepairDpMap) {
+  // moving boxes around the fixed obstacles, the cached map is repaired
+  // while a new grid search builds the map from scratch
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<double> x_dist(0.0, 20.0);
+  std::uniform_real_distribution<double> y_dist(0.0, 15.0);
+  std::uniform_real_distribution<double> size_dist(0.5, 4.0);
+  std::vector<Vec2d> centers(4);
+  std::vector<double> half_sizes(4);
+  for (size_t i = 0; i < centers.size(); ++i) {
+    centers[i] = Vec2d(x_dist(rng), y_dist(rng));
+    half_sizes[i] = size_dist(rng) / 2.0;
+  }
+  for (int cycle = 0; cycle < 30; ++cycle) {
+    std::vector<std::vector<LineSegment2d>> obstacles = obstacles_;
+    for (size_t i = 0; i < centers.size(); ++i) {
+      // one box moves per cycle, and none in every fifth cycle
+      if (cycle % 5 != 0 && static_cast<int>(i) == cycle % 4) {
+        centers[i] = Vec2d(x_dist(rng), y_dist(rng));
+        half_sizes[i] = size_dist(rng) / 2.0;
+      }
+      const double half_size = half_sizes[i];
+      Vec2d corners[4] = {centers[i] + Vec2d(-half_size, -half_size),
+                          centers[i] + Vec2d(half_size, -half_size),
+                          centers[i] + Vec2d(half_size, half_size),
+                          centers[i] + Vec2d(-half_size, half_size)};
+      std::vector<LineSegment2d> box;
+      for (int j = 0; j < 4; ++j) {
+        box.emplace_back(corners[j], corners[(j + 1) % 4]);
+      }
+      obstacles.push_back(box);
+    }
+    ASSERT_TRUE(grid_search_->GenerateDpMap(18.2, 6.3, XYbounds_, obstacles));
+    GridSearch full_search(planner_open_space_config_);
+    ASSERT_TRUE(full_search.GenerateDpMap(18.2, 6.3, XYbounds_, obstacles));
+    for (int x = 0; x <= 20; ++x) {
+      for (int y = 0; y <= 15; ++y) {
+        double cost = grid_search_->CheckDpMap(x + 0.5, y + 0.5);
+        double expected_cost = full_search.CheckDpMap(x + 0.5, y + 0.5);
+        if (std::isinf(expected_cost)) {
+          EXPECT_TRUE(std::isinf(cost)) << cycle << " " << x << " " << y;
+        } else {
+          EXPECT_NEAR(cost, expected_cost, 1e-4)
+              << cycle << " " << x << " " << y;
+        }
+      }
+    }
+  }
+}
+
+TEST_F(GridSearchTest, GenerateAStarPath) {
+  GridAStartResult result;
+  ASSERT_TRUE(grid_search_->GenerateAStarPath(2.0, 3.0, 18.0, 6.0, XYbounds_,
+                                              obstacles_, &result));
+  auto reference = ReferenceDpMap(18, 6);
+  EXPECT_NEAR(result.path_cost, reference[2][3], 1e-9);
+  ASSERT_FALSE(result.x.empty());
+  ASSERT_EQ(result.x.size(), result.y.size());
+  EXPECT_DOUBLE_EQ(result.x.back(), 18.0);
+  EXPECT_DOUBLE_EQ(result.y.back(), 6.0);
+  double length = 0.0;
+  double last_x = 2.0;
+  double last_y = 3.0;
+  for (size_t i = 0; i < result.x.size(); ++i) {
+    double step = std::hypot(result.x[i] - last_x, result.y[i] - last_y);
+    EXPECT_LT(step, 1.5);
+    length += step;
+    last_x = result.x[i];
+    last_y = result.y[i];
+  }
+  EXPECT_NEAR(length, result.path_cost, 1e-9);
+
+  // the end is walled in
+  std::vector<std::vector<LineSegment2d>> obstacles = obstacles_;
+  obstacles.push_back({LineSegment2d(Vec2d(0.0, 12.0), Vec2d(20.0, 12.0))});
+  EXPECT_FALSE(grid_search_->GenerateAStarPath(2.0, 3.0, 15.0, 14.0, XYbounds_,
+                                               obstacles, &result));
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -49,50 +49,59 @@ HybridAStar::HybridAStar(const PlannerOpenSpaceConfig& open_space_conf) {
       planner_open_space_config_.warm_start_config().traj_steer_penalty();
   traj_steer_change_penalty_ = planner_open_space_config_.warm_start_config()
                                    .traj_steer_change_penalty();
+  end_node_ = std::make_shared<Node3d>(0.0, 0.0, 0.0);
+  reeds_shepp_to_check_ = std::make_shared<ReedSheppPath>();
+  reeds_shepp_node_ = std::make_unique<Node3d>(0.0, 0.0, 0.0);
 }
 
-bool HybridAStar::AnalyticExpansion(std::shared_ptr<Node3d> current_node) {
-  std::shared_ptr<ReedSheppPath> reeds_shepp_to_check =
-      std::make_shared<ReedSheppPath>();
-  if (!reed_shepp_generator_->ShortestRSP(current_node, end_node_,
-                                          reeds_shepp_to_check)) {
+int HybridAStar::NewNode() {
+  if (static_cast<size_t>(node_num_) == node_pool_.size()) {
+    node_pool_.push_back(std::make_shared<Node3d>(0.0, 0.0, 0.0));
+  } else {
+    node_pool_[node_num_]->Reset();
+  }
+  return node_num_++;
+}
+
+bool HybridAStar::AnalyticExpansion(const int current_slot) {
+  if (!reed_shepp_generator_->ShortestRSP(node_pool_[current_slot], end_node_,
+                                          reeds_shepp_to_check_)) {
     ADEBUG << "ShortestRSP failed";
     return false;
   }
 
-  if (!RSPCheck(reeds_shepp_to_check)) {
+  if (!RSPCheck(reeds_shepp_to_check_)) {
     return false;
   }
 
   ADEBUG << "Reach the end configuration with Reed Sharp";
   // load the whole RSP as nodes and add to the close set
-  final_node_ = LoadRSPinCS(reeds_shepp_to_check, current_node);
+  final_node_ =
+      LoadRSPinCS(reeds_shepp_to_check_, node_pool_[current_slot].get());
   return true;
 }
 
 bool HybridAStar::RSPCheck(
     const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end) {
-  std::shared_ptr<Node3d> node = std::shared_ptr<Node3d>(new Node3d(
-      reeds_shepp_to_end->x, reeds_shepp_to_end->y, reeds_shepp_to_end->phi,
-      XYbounds_, planner_open_space_config_));
-  return ValidityCheck(node);
+  reeds_shepp_node_->Reset();
+  for (size_t i = 0; i < reeds_shepp_to_end->x.size(); ++i) {
+    reeds_shepp_node_->AddTraversedPoint(reeds_shepp_to_end->x[i],
+                                         reeds_shepp_to_end->y[i],
+                                         reeds_shepp_to_end->phi[i]);
+  }
+  reeds_shepp_node_->UpdateGrid(XYbounds_, planner_open_space_config_);
+  return ValidityCheck(*reeds_shepp_node_);
 }
 
-bool HybridAStar::ValidityCheck(std::shared_ptr<Node3d> node) {
+bool HybridAStar::ValidityCheck(const Node3d& node) {
   if (obstacles_linesegments_vec_.empty()) {
     return true;
   }
-  size_t node_step_size = node->GetStepSize();
+  const std::vector<double>& traversed_x = node.GetXs();
+  const std::vector<double>& traversed_y = node.GetYs();
+  const std::vector<double>& traversed_phi = node.GetPhis();
+  size_t node_step_size = traversed_x.size();
   size_t last_check_index = 0;
-  std::vector<double> traversed_x;
-  std::vector<double> traversed_y;
-  std::vector<double> traversed_phi;
-  traversed_x = node->GetXs();
-  traversed_y = node->GetYs();
-  traversed_phi = node->GetPhis();
-  std::reverse(traversed_x.begin(), traversed_x.end());
-  std::reverse(traversed_y.begin(), traversed_y.end());
-  std::reverse(traversed_phi.begin(), traversed_phi.end());
   // The first {x, y, phi} is collision free unless they are start and end
   // configuration of search problem
   if (node_step_size == 1) {
@@ -100,13 +109,15 @@ bool HybridAStar::ValidityCheck(std::shared_ptr<Node3d> node) {
   } else {
     last_check_index = node_step_size - 1;
   }
+  // check from the last configuration backward
   for (size_t i = 0; i < last_check_index; ++i) {
-    if (traversed_x[i] > XYbounds_[1] || traversed_x[i] < XYbounds_[0] ||
-        traversed_y[i] > XYbounds_[3] || traversed_y[i] < XYbounds_[2]) {
+    const size_t j = node_step_size - 1 - i;
+    if (traversed_x[j] > XYbounds_[1] || traversed_x[j] < XYbounds_[0] ||
+        traversed_y[j] > XYbounds_[3] || traversed_y[j] < XYbounds_[2]) {
       return false;
     }
     Box2d bounding_box = Node3d::GetBoundingBox(
-        vehicle_param_, traversed_x[i], traversed_y[i], traversed_phi[i]);
+        vehicle_param_, traversed_x[j], traversed_y[j], traversed_phi[j]);
     for (const auto& obstacle_linesegments : obstacles_linesegments_vec_) {
       for (const common::math::LineSegment2d& linesegment :
            obstacle_linesegments) {
@@ -119,19 +130,23 @@ bool HybridAStar::ValidityCheck(std::shared_ptr<Node3d> node) {
   return true;
 }
 
-std::shared_ptr<Node3d> HybridAStar::LoadRSPinCS(
+const Node3d* HybridAStar::LoadRSPinCS(
     const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end,
-    std::shared_ptr<Node3d> current_node) {
-  std::shared_ptr<Node3d> end_node = std::shared_ptr<Node3d>(new Node3d(
-      reeds_shepp_to_end->x, reeds_shepp_to_end->y, reeds_shepp_to_end->phi,
-      XYbounds_, planner_open_space_config_));
+    const Node3d* current_node) {
+  Node3d* end_node = node_pool_[NewNode()].get();
+  for (size_t i = 0; i < reeds_shepp_to_end->x.size(); ++i) {
+    end_node->AddTraversedPoint(reeds_shepp_to_end->x[i],
+                                reeds_shepp_to_end->y[i],
+                                reeds_shepp_to_end->phi[i]);
+  }
+  end_node->UpdateGrid(XYbounds_, planner_open_space_config_);
   end_node->SetPre(current_node);
-  close_set_.insert(std::make_pair(end_node->GetIndex(), end_node));
   return end_node;
 }
 
-std::shared_ptr<Node3d> HybridAStar::Next_node_generator(
-    std::shared_ptr<Node3d> current_node, size_t next_node_index) {
+bool HybridAStar::Next_node_generator(const Node3d& current_node,
+                                      size_t next_node_index,
+                                      Node3d* next_node) {
   double steering = 0.0;
   size_t index = 0;
   double traveled_distance = 0.0;
@@ -152,101 +167,87 @@ std::shared_ptr<Node3d> HybridAStar::Next_node_generator(
   // take above motion primitive to generate a curve driving the car to a
   // different grid
   double arc = std::sqrt(2) * xy_grid_resolution_;
-  std::vector<double> intermediate_x;
-  std::vector<double> intermediate_y;
-  std::vector<double> intermediate_phi;
-  double last_x = current_node->GetX();
-  double last_y = current_node->GetY();
-  double last_phi = current_node->GetPhi();
-  intermediate_x.emplace_back(last_x);
-  intermediate_y.emplace_back(last_y);
-  intermediate_phi.emplace_back(last_phi);
+  double last_x = current_node.GetX();
+  double last_y = current_node.GetY();
+  double last_phi = current_node.GetPhi();
+  next_node->AddTraversedPoint(last_x, last_y, last_phi);
   for (size_t i = 0; i < arc / step_size_; ++i) {
     double next_x = last_x + traveled_distance * std::cos(last_phi);
     double next_y = last_y + traveled_distance * std::sin(last_phi);
     double next_phi = common::math::NormalizeAngle(
         last_phi +
         traveled_distance / vehicle_param_.wheel_base() * std::tan(steering));
-    intermediate_x.emplace_back(next_x);
-    intermediate_y.emplace_back(next_y);
-    intermediate_phi.emplace_back(next_phi);
+    next_node->AddTraversedPoint(next_x, next_y, next_phi);
     last_x = next_x;
     last_y = next_y;
     last_phi = next_phi;
   }
   // check if the vehicle runs outside of XY boundary
-  if (intermediate_x.back() > XYbounds_[1] ||
-      intermediate_x.back() < XYbounds_[0] ||
-      intermediate_y.back() > XYbounds_[3] ||
-      intermediate_y.back() < XYbounds_[2]) {
-    return nullptr;
+  if (last_x > XYbounds_[1] || last_x < XYbounds_[0] ||
+      last_y > XYbounds_[3] || last_y < XYbounds_[2]) {
+    return false;
   }
-  std::shared_ptr<Node3d> next_node = std::shared_ptr<Node3d>(
-      new Node3d(intermediate_x, intermediate_y, intermediate_phi, XYbounds_,
-                 planner_open_space_config_));
-  next_node->SetPre(current_node);
+  next_node->UpdateGrid(XYbounds_, planner_open_space_config_);
+  next_node->SetPre(&current_node);
   next_node->SetDirec(traveled_distance > 0);
   next_node->SetSteer(steering);
-  return next_node;
+  return true;
 }
 
-void HybridAStar::CalculateNodeCost(std::shared_ptr<Node3d> current_node,
-                                    std::shared_ptr<Node3d> next_node) {
-  next_node->SetTrajCost(current_node->GetTrajCost() +
-                         TrajCost(current_node, next_node));
+void HybridAStar::CalculateNodeCost(const Node3d& current_node,
+                                    Node3d* next_node) {
+  next_node->SetTrajCost(current_node.GetTrajCost() +
+                         TrajCost(current_node, *next_node));
   // evaluate heuristic cost
   double optimal_path_cost = 0.0;
-  optimal_path_cost += HoloObstacleHeuristic(next_node);
+  optimal_path_cost += HoloObstacleHeuristic(*next_node);
   next_node->SetHeuCost(optimal_path_cost);
 }
 
-double HybridAStar::TrajCost(std::shared_ptr<Node3d> current_node,
-                             std::shared_ptr<Node3d> next_node) {
+double HybridAStar::TrajCost(const Node3d& current_node,
+                             const Node3d& next_node) {
   // evaluate cost on the trajectory and add current cost
   double piecewise_cost = 0.0;
-  if (next_node->GetDirec()) {
-    piecewise_cost += static_cast<double>(next_node->GetStepSize() - 1) *
+  if (next_node.GetDirec()) {
+    piecewise_cost += static_cast<double>(next_node.GetStepSize() - 1) *
                       step_size_ * traj_forward_penalty_;
   } else {
-    piecewise_cost += static_cast<double>(next_node->GetStepSize() - 1) *
+    piecewise_cost += static_cast<double>(next_node.GetStepSize() - 1) *
                       step_size_ * traj_back_penalty_;
   }
-  if (current_node->GetDirec() != next_node->GetDirec()) {
+  if (current_node.GetDirec() != next_node.GetDirec()) {
     piecewise_cost += traj_gear_switch_penalty_;
   }
-  piecewise_cost += traj_steer_penalty_ * std::abs(next_node->GetSteer());
+  piecewise_cost += traj_steer_penalty_ * std::abs(next_node.GetSteer());
   piecewise_cost += traj_steer_change_penalty_ *
-                    std::abs(next_node->GetSteer() - current_node->GetSteer());
+                    std::abs(next_node.GetSteer() - current_node.GetSteer());
   return piecewise_cost;
 }
 
-double HybridAStar::HoloObstacleHeuristic(std::shared_ptr<Node3d> next_node) {
-  return grid_a_star_heuristic_generator_->CheckDpMap(next_node->GetX(),
-                                                      next_node->GetY());
+double HybridAStar::HoloObstacleHeuristic(const Node3d& next_node) {
+  return grid_a_star_heuristic_generator_->CheckDpMap(next_node.GetX(),
+                                                      next_node.GetY());
 }
 
 bool HybridAStar::GetResult(HybridAStartResult* result) {
-  std::shared_ptr<Node3d> current_node = final_node_;
+  const Node3d* current_node = final_node_;
   std::vector<double> hybrid_a_x;
   std::vector<double> hybrid_a_y;
   std::vector<double> hybrid_a_phi;
   while (current_node->GetPreNode() != nullptr) {
-    std::vector<double> x = current_node->GetXs();
-    std::vector<double> y = current_node->GetYs();
-    std::vector<double> phi = current_node->GetPhis();
+    const std::vector<double>& x = current_node->GetXs();
+    const std::vector<double>& y = current_node->GetYs();
+    const std::vector<double>& phi = current_node->GetPhis();
     if (x.empty() || y.empty() || phi.empty()) {
       AERROR << "result size check failed";
       return false;
     }
-    std::reverse(x.begin(), x.end());
-    std::reverse(y.begin(), y.end());
-    std::reverse(phi.begin(), phi.end());
-    x.pop_back();
-    y.pop_back();
-    phi.pop_back();
-    hybrid_a_x.insert(hybrid_a_x.end(), x.begin(), x.end());
-    hybrid_a_y.insert(hybrid_a_y.end(), y.begin(), y.end());
-    hybrid_a_phi.insert(hybrid_a_phi.end(), phi.begin(), phi.end());
+    // the first configuration is the last one of the previous node
+    for (size_t i = x.size() - 1; i > 0; --i) {
+      hybrid_a_x.push_back(x[i]);
+      hybrid_a_y.push_back(y[i]);
+      hybrid_a_phi.push_back(phi[i]);
+    }
     current_node = current_node->GetPreNode();
   }
   hybrid_a_x.push_back(current_node->GetX());
@@ -318,10 +319,10 @@ bool HybridAStar::Plan(
     const std::vector<double>& XYbounds,
     const std::vector<std::vector<common::math::Vec2d>>& obstacles_vertices_vec,
     HybridAStartResult* result) {
-  // clear containers
-  open_set_.clear();
-  close_set_.clear();
-  open_pq_ = decltype(open_pq_)();
+  // clear containers, the node arena keeps its nodes
+  node_num_ = 0;
+  node_slots_.Clear();
+  open_pq_.Clear();
   final_node_ = nullptr;
 
   std::vector<std::vector<common::math::LineSegment2d>>
@@ -341,15 +342,18 @@ bool HybridAStar::Plan(
   // load XYbounds
   XYbounds_ = XYbounds;
   // load nodes and obstacles
-  start_node_.reset(
-      new Node3d({sx}, {sy}, {sphi}, XYbounds_, planner_open_space_config_));
-  end_node_.reset(
-      new Node3d({ex}, {ey}, {ephi}, XYbounds_, planner_open_space_config_));
-  if (!ValidityCheck(start_node_)) {
+  const int start_slot = NewNode();
+  Node3d* start_node = node_pool_[start_slot].get();
+  start_node->AddTraversedPoint(sx, sy, sphi);
+  start_node->UpdateGrid(XYbounds_, planner_open_space_config_);
+  end_node_->Reset();
+  end_node_->AddTraversedPoint(ex, ey, ephi);
+  end_node_->UpdateGrid(XYbounds_, planner_open_space_config_);
+  if (!ValidityCheck(*start_node)) {
     ADEBUG << "start_node in collision with obstacles";
     return false;
   }
-  if (!ValidityCheck(end_node_)) {
+  if (!ValidityCheck(*end_node_)) {
     ADEBUG << "end_node in collision with obstacles";
     return false;
   }
@@ -358,9 +362,8 @@ bool HybridAStar::Plan(
                                                   obstacles_linesegments_vec_);
   ADEBUG << "map time " << Clock::NowInSeconds() - map_time;
   // load open set, pq
-  open_set_.insert(std::make_pair(start_node_->GetIndex(), start_node_));
-  open_pq_.push(
-      std::make_pair(start_node_->GetIndex(), start_node_->GetCost()));
+  node_slots_.Insert(start_node->GetIndex(), start_slot);
+  open_pq_.Push(start_slot, start_node->GetCost());
 
   // Hybrid A* begins
   size_t explored_node_num = 0;
@@ -369,44 +372,45 @@ bool HybridAStar::Plan(
   double rs_time = 0.0;
   double start_time = 0.0;
   double end_time = 0.0;
-  while (!open_pq_.empty()) {
+  while (!open_pq_.Empty()) {
     // take out the lowest cost neighboring node
-    const std::string current_id = open_pq_.top().first;
-    open_pq_.pop();
-    std::shared_ptr<Node3d> current_node = open_set_[current_id];
+    const int current_slot = open_pq_.Pop();
+    // the nodes are not moved when the arena grows
+    const Node3d* current_node = node_pool_[current_slot].get();
     // check if a analystic curve could be connected from current
     // configuration to the end configuration without collision. if so, search
     // ends.
     start_time = Clock::NowInSeconds();
-    if (AnalyticExpansion(current_node)) {
+    if (AnalyticExpansion(current_slot)) {
       break;
     }
     end_time = Clock::NowInSeconds();
     rs_time += end_time - start_time;
-    close_set_.insert(std::make_pair(current_node->GetIndex(), current_node));
     for (size_t i = 0; i < next_node_num_; ++i) {
-      std::shared_ptr<Node3d> next_node = Next_node_generator(current_node, i);
+      const int next_slot = NewNode();
+      Node3d* next_node = node_pool_[next_slot].get();
       // boundary check failure handle
-      if (next_node == nullptr) {
+      if (!Next_node_generator(*current_node, i, next_node)) {
+        ReleaseLastNode();
         continue;
       }
-      // check if the node is already in the close set
-      if (close_set_.find(next_node->GetIndex()) != close_set_.end()) {
+      // check if the node is already in the open or close set
+      if (node_slots_.Find(next_node->GetIndex()) >= 0) {
+        ReleaseLastNode();
         continue;
       }
       // collision check
-      if (!ValidityCheck(next_node)) {
+      if (!ValidityCheck(*next_node)) {
+        ReleaseLastNode();
         continue;
       }
-      if (open_set_.find(next_node->GetIndex()) == open_set_.end()) {
-        explored_node_num++;
-        start_time = Clock::NowInSeconds();
-        CalculateNodeCost(current_node, next_node);
-        end_time = Clock::NowInSeconds();
-        heuristic_time += end_time - start_time;
-        open_set_.emplace(next_node->GetIndex(), next_node);
-        open_pq_.emplace(next_node->GetIndex(), next_node->GetCost());
-      }
+      explored_node_num++;
+      start_time = Clock::NowInSeconds();
+      CalculateNodeCost(*current_node, next_node);
+      end_time = Clock::NowInSeconds();
+      heuristic_time += end_time - start_time;
+      node_slots_.Insert(next_node->GetIndex(), next_slot);
+      open_pq_.Push(next_slot, next_node->GetCost());
     }
   }
   if (final_node_ == nullptr) {
@@ -21,14 +21,13 @@
 #pragma once
 
 #include <memory>
-#include <queue>
-#include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "modules/planning/open_space/coarse_trajectory_generator/grid_search.h"
+#include "modules/planning/open_space/coarse_trajectory_generator/indexed_priority_queue.h"
 #include "modules/planning/open_space/coarse_trajectory_generator/node3d.h"
+#include "modules/planning/open_space/coarse_trajectory_generator/node_index_map.h"
 #include "modules/planning/open_space/coarse_trajectory_generator/reeds_shepp_path.h"
 
 #include "cyber/common/log.h"
@@ -67,22 +66,26 @@ class HybridAStar {
             HybridAStartResult* result);
 
  private:
-  bool AnalyticExpansion(std::shared_ptr<Node3d> current_node);
+  bool AnalyticExpansion(const int current_slot);
   // check collision and validity
-  bool ValidityCheck(std::shared_ptr<Node3d> node);
+  bool ValidityCheck(const Node3d& node);
   // check Reeds Shepp path collision and validity
   bool RSPCheck(const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end);
-  // load the whole RSP as nodes and add to the close set
-  std::shared_ptr<Node3d> LoadRSPinCS(
+  // load the whole RSP as a node after current_node
+  const Node3d* LoadRSPinCS(
       const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end,
-      std::shared_ptr<Node3d> current_node);
-  std::shared_ptr<Node3d> Next_node_generator(
-      std::shared_ptr<Node3d> current_node, size_t next_node_index);
-  void CalculateNodeCost(std::shared_ptr<Node3d> current_node,
-                         std::shared_ptr<Node3d> next_node);
-  double TrajCost(std::shared_ptr<Node3d> current_node,
-                  std::shared_ptr<Node3d> next_node);
-  double HoloObstacleHeuristic(std::shared_ptr<Node3d> next_node);
+      const Node3d* current_node);
+  // generate the next_node_index-th motion primitive from current_node into
+  // next_node, return false if it runs out of XYbounds
+  bool Next_node_generator(const Node3d& current_node,
+                           size_t next_node_index, Node3d* next_node);
+  void CalculateNodeCost(const Node3d& current_node, Node3d* next_node);
+  double TrajCost(const Node3d& current_node, const Node3d& next_node);
+  double HoloObstacleHeuristic(const Node3d& next_node);
+  // take a cleared node from the arena and return its slot
+  int NewNode();
+  // give back the node taken by the last NewNode()
+  void ReleaseLastNode() { --node_num_; }
   bool GetResult(HybridAStartResult* result);
   bool GenerateSpeedAcceleration(HybridAStartResult* result);
 
@@ -106,23 +109,21 @@ class HybridAStar {
   double heu_rs_steer_penalty_ = 0.0;
   double heu_rs_steer_change_penalty_ = 0.0;
   std::vector<double> XYbounds_;
-  std::shared_ptr<Node3d> start_node_;
   std::shared_ptr<Node3d> end_node_;
-  std::shared_ptr<Node3d> final_node_;
+  const Node3d* final_node_ = nullptr;
   std::vector<std::vector<common::math::LineSegment2d>>
       obstacles_linesegments_vec_;
 
-  struct cmp {
-    bool operator()(const std::pair<std::string, double>& left,
-                    const std::pair<std::string, double>& right) const {
-      return left.second >= right.second;
-    }
-  };
-  std::priority_queue<std::pair<std::string, double>,
-                      std::vector<std::pair<std::string, double>>, cmp>
-      open_pq_;
-  std::unordered_map<std::string, std::shared_ptr<Node3d>> open_set_;
-  std::unordered_map<std::string, std::shared_ptr<Node3d>> close_set_;
+  // node arena of the search, the first node_num_ nodes are in use and the
+  // rest are kept with their buffers for the next searches
+  std::vector<std::shared_ptr<Node3d>> node_pool_;
+  int node_num_ = 0;
+  // slots of the nodes in the open or close set by packed grid index
+  NodeIndexMap node_slots_;
+  // slots of the nodes in the open set
+  IndexedPriorityQueue open_pq_;
+  std::shared_ptr<ReedSheppPath> reeds_shepp_to_check_;
+  std::unique_ptr<Node3d> reeds_shepp_node_;
   std::unique_ptr<ReedShepp> reed_shepp_generator_;
   std::unique_ptr<GridSearch> grid_a_star_heuristic_generator_;
 };
@@ -0,0 +1,150 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace planning {
+
+/*
+ * @brief Binary min heap of dense integer ids keyed by cost, supporting
+ * decrease-key. Equal costs pop the smaller id first, so that the search
+ * order is deterministic. The buffers only grow, so a queue reused across
+ * searches does not allocate once it has seen the largest id.
+ */
+class IndexedPriorityQueue {
+ public:
+  IndexedPriorityQueue() = default;
+
+  bool Empty() const { return heap_.empty(); }
+  size_t Size() const { return heap_.size(); }
+
+  bool Contains(const int id) const {
+    return id >= 0 && static_cast<size_t>(id) < positions_.size() &&
+           positions_[id] >= 0;
+  }
+
+  double Cost(const int id) const { return costs_[id]; }
+
+  int Top() const { return heap_.front(); }
+
+  void Clear() {
+    for (const int id : heap_) {
+      positions_[id] = -1;
+    }
+    heap_.clear();
+  }
+
+  // id should not be in the queue
+  void Push(const int id, const double cost) {
+    CHECK_GE(id, 0);
+    if (static_cast<size_t>(id) >= positions_.size()) {
+      positions_.resize(id + 1, -1);
+      costs_.resize(id + 1, 0.0);
+    }
+    CHECK_LT(positions_[id], 0) << "id " << id << " is already queued";
+    costs_[id] = cost;
+    positions_[id] = static_cast<int>(heap_.size());
+    heap_.push_back(id);
+    SiftUp(positions_[id]);
+  }
+
+  // lower the cost of a queued id, return false if cost is not lower
+  bool DecreaseKey(const int id, const double cost) {
+    if (!Contains(id) || cost >= costs_[id]) {
+      return false;
+    }
+    costs_[id] = cost;
+    SiftUp(positions_[id]);
+    return true;
+  }
+
+  // pop and return the id with the lowest cost
+  int Pop() {
+    const int top = heap_.front();
+    positions_[top] = -1;
+    const int last = heap_.back();
+    heap_.pop_back();
+    if (!heap_.empty()) {
+      heap_.front() = last;
+      positions_[last] = 0;
+      SiftDown(0);
+    }
+    return top;
+  }
+
+ private:
+  bool Less(const int left, const int right) const {
+    return costs_[left] < costs_[right] ||
+           (costs_[left] == costs_[right] && left < right);
+  }
+
+  void SiftUp(int pos) {
+    const int id = heap_[pos];
+    while (pos > 0) {
+      const int parent = (pos - 1) / 2;
+      if (!Less(id, heap_[parent])) {
+        break;
+      }
+      Place(heap_[parent], pos);
+      pos = parent;
+    }
+    Place(id, pos);
+  }
+
+  void SiftDown(int pos) {
+    const int size = static_cast<int>(heap_.size());
+    const int id = heap_[pos];
+    while (true) {
+      int child = 2 * pos + 1;
+      if (child >= size) {
+        break;
+      }
+      if (child + 1 < size && Less(heap_[child + 1], heap_[child])) {
+        ++child;
+      }
+      if (!Less(heap_[child], id)) {
+        break;
+      }
+      Place(heap_[child], pos);
+      pos = child;
+    }
+    Place(id, pos);
+  }
+
+  void Place(const int id, const int pos) {
+    heap_[pos] = id;
+    positions_[id] = pos;
+  }
+
+ private:
+  std::vector<int> heap_;
+  // position of each id in heap_, -1 if not queued
+  std::vector<int> positions_;
+  std::vector<double> costs_;
+};
+
+}  // namespace planning
+}  // namespace apollo
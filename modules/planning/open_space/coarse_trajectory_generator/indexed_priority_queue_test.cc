@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#include "modules/planning/open_space/coarse_trajectory_generator/indexed_priority_queue.h"
+
+#include <map>
+#include <random>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "modules/planning/open_space/coarse_trajectory_generator/node_index_map.h"
+
+namespace apollo {
+namespace planning {
+
+TEST(IndexedPriorityQueueTest, PushPopDecreaseKey) {
+  IndexedPriorityQueue queue;
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> cost_dist(0.0, 100.0);
+  for (int round = 0; round < 3; ++round) {
+    // reference of the queued ids by cost
+    std::map<int, double> queued;
+    for (int id = 0; id < 500; id += 1 + round) {
+      double cost = cost_dist(rng);
+      queue.Push(id, cost);
+      queued[id] = cost;
+    }
+    for (auto& entry : queued) {
+      if (entry.first % 3 == 0) {
+        double cost = entry.second / 2.0;
+        EXPECT_TRUE(queue.DecreaseKey(entry.first, cost));
+        entry.second = cost;
+      }
+      EXPECT_FALSE(queue.DecreaseKey(entry.first, entry.second + 1.0));
+    }
+    EXPECT_FALSE(queue.DecreaseKey(1000, 0.0));
+    EXPECT_EQ(queue.Size(), queued.size());
+    double last_cost = -1.0;
+    while (queue.Size() > queued.size() / 2) {
+      int id = queue.Pop();
+      ASSERT_EQ(queued.count(id), 1);
+      EXPECT_DOUBLE_EQ(queue.Cost(id), queued[id]);
+      EXPECT_GE(queued[id], last_cost);
+      EXPECT_FALSE(queue.Contains(id));
+      last_cost = queued[id];
+      queued.erase(id);
+    }
+    for (const auto& entry : queued) {
+      EXPECT_TRUE(queue.Contains(entry.first));
+      EXPECT_GE(entry.second, last_cost);
+    }
+    queue.Clear();
+    EXPECT_TRUE(queue.Empty());
+    for (const auto& entry : queued) {
+      EXPECT_FALSE(queue.Contains(entry.first));
+    }
+  }
+}
+
+TEST(NodeIndexMapTest, InsertFind) {
+  NodeIndexMap map;
+  for (int round = 0; round < 2; ++round) {
+    for (int i = 0; i < 5000; ++i) {
+      uint64_t key = static_cast<uint64_t>(i) << (i % 3 == 0 ? 40 : 16);
+      EXPECT_TRUE(map.Insert(key, i));
+      EXPECT_FALSE(map.Insert(key, i + 1));
+    }
+    EXPECT_EQ(map.Size(), 5000);
+    for (int i = 0; i < 5000; ++i) {
+      uint64_t key = static_cast<uint64_t>(i) << (i % 3 == 0 ? 40 : 16);
+      EXPECT_EQ(map.Find(key), i);
+      EXPECT_EQ(map.Find(key + 1), -1);
+    }
+    map.Clear();
+    EXPECT_EQ(map.Size(), 0);
+    EXPECT_EQ(map.Find(0), -1);
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -32,28 +32,8 @@ Node3d::Node3d(double x, double y, double phi) {
 Node3d::Node3d(double x, double y, double phi,
                const std::vector<double>& XYbounds,
                const PlannerOpenSpaceConfig& open_space_conf) {
-  CHECK_EQ(XYbounds.size(), 4)
-      << "XYbounds size is not 4, but" << XYbounds.size();
-
-  x_ = x;
-  y_ = y;
-  phi_ = phi;
-
-  x_grid_ = static_cast<int>(
-      (x_ - XYbounds[0]) /
-      open_space_conf.warm_start_config().xy_grid_resolution());
-  y_grid_ = static_cast<int>(
-      (y_ - XYbounds[2]) /
-      open_space_conf.warm_start_config().xy_grid_resolution());
-  phi_grid_ = static_cast<int>(
-      (phi_ - (-M_PI)) /
-      open_space_conf.warm_start_config().phi_grid_resolution());
-
-  traversed_x_.push_back(x);
-  traversed_y_.push_back(y);
-  traversed_phi_.push_back(phi);
-
-  index_ = ComputeStringIndex(x_grid_, y_grid_, phi_grid_);
+  AddTraversedPoint(x, y, phi);
+  UpdateGrid(XYbounds, open_space_conf);
 }
 
 Node3d::Node3d(const std::vector<double>& traversed_x,
@@ -61,14 +41,37 @@ Node3d::Node3d(const std::vector<double>& traversed_x,
                const std::vector<double>& traversed_phi,
                const std::vector<double>& XYbounds,
                const PlannerOpenSpaceConfig& open_space_conf) {
-  CHECK_EQ(XYbounds.size(), 4)
-      << "XYbounds size is not 4, but" << XYbounds.size();
   CHECK_EQ(traversed_x.size(), traversed_y.size());
   CHECK_EQ(traversed_x.size(), traversed_phi.size());
 
-  x_ = traversed_x.back();
-  y_ = traversed_y.back();
-  phi_ = traversed_phi.back();
+  traversed_x_ = traversed_x;
+  traversed_y_ = traversed_y;
+  traversed_phi_ = traversed_phi;
+  UpdateGrid(XYbounds, open_space_conf);
+}
+
+void Node3d::Reset() {
+  traversed_x_.clear();
+  traversed_y_.clear();
+  traversed_phi_.clear();
+  step_size_ = 1;
+  traj_cost_ = 0.0;
+  heuristic_cost_ = 0.0;
+  cost_ = 0.0;
+  pre_node_ = nullptr;
+  steering_ = 0.0;
+  direction_ = true;
+}
+
+void Node3d::UpdateGrid(const std::vector<double>& XYbounds,
+                        const PlannerOpenSpaceConfig& open_space_conf) {
+  CHECK_EQ(XYbounds.size(), 4)
+      << "XYbounds size is not 4, but" << XYbounds.size();
+  CHECK(!traversed_x_.empty());
+
+  x_ = traversed_x_.back();
+  y_ = traversed_y_.back();
+  phi_ = traversed_phi_.back();
 
   // XYbounds in xmin, xmax, ymin, ymax
   x_grid_ = static_cast<int>(
@@ -81,12 +84,8 @@ Node3d::Node3d(const std::vector<double>& traversed_x,
       (phi_ - (-M_PI)) /
       open_space_conf.warm_start_config().phi_grid_resolution());
 
-  traversed_x_ = traversed_x;
-  traversed_y_ = traversed_y;
-  traversed_phi_ = traversed_phi;
-
-  index_ = ComputeStringIndex(x_grid_, y_grid_, phi_grid_);
-  step_size_ = traversed_x.size();
+  index_ = ComputeIndex(x_grid_, y_grid_, phi_grid_);
+  step_size_ = traversed_x_.size();
 }
 
 Box2d Node3d::GetBoundingBox(const common::VehicleParam& vehicle_param_,
@@ -105,9 +104,12 @@ bool Node3d::operator==(const Node3d& right) const {
   return right.GetIndex() == index_;
 }
 
-std::string Node3d::ComputeStringIndex(int x_grid, int y_grid, int phi_grid) {
-  return std::to_string(x_grid) + "_" + std::to_string(y_grid) + "_" +
-         std::to_string(phi_grid);
+uint64_t Node3d::ComputeIndex(int x_grid, int y_grid, int phi_grid) {
+  return (static_cast<uint64_t>(static_cast<uint32_t>(x_grid) & 0xFFFFFF)
+          << 40) |
+         (static_cast<uint64_t>(static_cast<uint32_t>(y_grid) & 0xFFFFFF)
+          << 16) |
+         static_cast<uint64_t>(static_cast<uint32_t>(phi_grid) & 0xFFFF);
 }
 
 }  // namespace planning
@@ -20,8 +20,8 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
-#include <string>
 #include <vector>
 
 #include "modules/planning/proto/planner_open_space_config.pb.h"
@@ -59,22 +59,34 @@ class Node3d {
   double GetY() const { return y_; }
   double GetPhi() const { return phi_; }
   bool operator==(const Node3d& right) const;
-  const std::string& GetIndex() const { return index_; }
+  uint64_t GetIndex() const { return index_; }
   size_t GetStepSize() const { return step_size_; }
   bool GetDirec() const { return direction_; }
   double GetSteer() const { return steering_; }
-  std::shared_ptr<Node3d> GetPreNode() const { return pre_node_; }
+  const Node3d* GetPreNode() const { return pre_node_; }
   const std::vector<double>& GetXs() const { return traversed_x_; }
   const std::vector<double>& GetYs() const { return traversed_y_; }
   const std::vector<double>& GetPhis() const { return traversed_phi_; }
-  void SetPre(std::shared_ptr<Node3d> pre_node) { pre_node_ = pre_node; }
+  void SetPre(const Node3d* pre_node) { pre_node_ = pre_node; }
   void SetDirec(bool direction) { direction_ = direction; }
   void SetTrajCost(double cost) { traj_cost_ = cost; }
   void SetHeuCost(double cost) { heuristic_cost_ = cost; }
   void SetSteer(double steering) { steering_ = steering; }
 
- private:
-  static std::string ComputeStringIndex(int x_grid, int y_grid, int phi_grid);
+  // Reuse the node in a search arena: clear the traversed configurations,
+  // costs and parent but keep the capacity of the traversal buffers.
+  void Reset();
+  void AddTraversedPoint(const double x, const double y, const double phi) {
+    traversed_x_.push_back(x);
+    traversed_y_.push_back(y);
+    traversed_phi_.push_back(phi);
+  }
+  // set the pose, grid and index from the last traversed configuration
+  void UpdateGrid(const std::vector<double>& XYbounds,
+                  const PlannerOpenSpaceConfig& open_space_conf);
+
+  // pack the grid indices, each of x and y takes 24 bits and phi 16 bits
+  static uint64_t ComputeIndex(int x_grid, int y_grid, int phi_grid);
 
  private:
   double x_ = 0.0;
@@ -87,11 +99,11 @@ class Node3d {
   int x_grid_ = 0;
   int y_grid_ = 0;
   int phi_grid_ = 0;
-  std::string index_;
+  uint64_t index_ = 0;
   double traj_cost_ = 0.0;
   double heuristic_cost_ = 0.0;
   double cost_ = 0.0;
-  std::shared_ptr<Node3d> pre_node_ = nullptr;
+  const Node3d* pre_node_ = nullptr;
   double steering_ = 0.0;
   // true for moving forward and false for moving backward
   bool direction_ = true;
@@ -57,5 +57,34 @@ TEST_F(Node3dTest, GetBoundingBox) {
   ASSERT_EQ(test_box.width(), gold_box.width());
 }
 
+TEST_F(Node3dTest, ReuseInArena) {
+  PlannerOpenSpaceConfig open_space_conf;
+  open_space_conf.mutable_warm_start_config()->set_xy_grid_resolution(0.5);
+  open_space_conf.mutable_warm_start_config()->set_phi_grid_resolution(0.1);
+  std::vector<double> XYbounds = {-10.0, 10.0, -5.0, 5.0};
+  Node3d node({0.0, 1.2}, {0.0, 2.3}, {0.0, 0.05}, XYbounds, open_space_conf);
+  EXPECT_EQ(node.GetStepSize(), 2);
+  EXPECT_EQ(node.GetGridX(), 22);
+  EXPECT_EQ(node.GetGridY(), 14);
+  EXPECT_EQ(node.GetIndex(), Node3d::ComputeIndex(22, 14, 31));
+
+  Node3d pre_node(1.0, 1.0, 0.0, XYbounds, open_space_conf);
+  node.SetPre(&pre_node);
+  node.SetTrajCost(3.0);
+  node.Reset();
+  EXPECT_EQ(node.GetPreNode(), nullptr);
+  EXPECT_EQ(node.GetTrajCost(), 0.0);
+  EXPECT_TRUE(node.GetXs().empty());
+  node.AddTraversedPoint(1.0, 1.0, 0.0);
+  node.UpdateGrid(XYbounds, open_space_conf);
+  EXPECT_EQ(node.GetStepSize(), 1);
+  EXPECT_TRUE(node == pre_node);
+
+  // the packed indices of neighboring grids differ
+  EXPECT_NE(Node3d::ComputeIndex(1, 0, 0), Node3d::ComputeIndex(0, 1, 0));
+  EXPECT_NE(Node3d::ComputeIndex(0, 1, 0), Node3d::ComputeIndex(0, 0, 1));
+  EXPECT_NE(Node3d::ComputeIndex(0, 0, 0), Node3d::ComputeIndex(-1, 0, 0));
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace apollo {
+namespace planning {
+
+/*
+ * @brief Open addressing hash map from packed node keys to non negative
+ * node slots, with linear probing. Clear keeps the table, so a map reused
+ * across searches does not allocate once it is large enough.
+ */
+class NodeIndexMap {
+ public:
+  NodeIndexMap() { Rehash(kMinCapacity); }
+
+  size_t Size() const { return size_; }
+
+  void Clear() {
+    if (size_ == 0) {
+      return;
+    }
+    for (auto& entry : entries_) {
+      entry.value = -1;
+    }
+    size_ = 0;
+  }
+
+  // the slot of key, -1 if not found
+  int Find(const uint64_t key) const {
+    for (size_t i = Hash(key) & mask_;; i = (i + 1) & mask_) {
+      const Entry& entry = entries_[i];
+      if (entry.value < 0) {
+        return -1;
+      }
+      if (entry.key == key) {
+        return entry.value;
+      }
+    }
+  }
+
+  // insert key with value >= 0, return false and keep the current value if
+  // key already exists
+  bool Insert(const uint64_t key, const int value) {
+    if (2 * (size_ + 1) > entries_.size()) {
+      Rehash(2 * entries_.size());
+    }
+    for (size_t i = Hash(key) & mask_;; i = (i + 1) & mask_) {
+      Entry& entry = entries_[i];
+      if (entry.value < 0) {
+        entry.key = key;
+        entry.value = value;
+        ++size_;
+        return true;
+      }
+      if (entry.key == key) {
+        return false;
+      }
+    }
+  }
+
+ private:
+  struct Entry {
+    uint64_t key = 0;
+    int value = -1;
+  };
+
+  static constexpr size_t kMinCapacity = 1024;
+
+  static size_t Hash(uint64_t key) {
+    // finalizer of splitmix64, the grid fields of the keys are poorly mixed
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return static_cast<size_t>(key);
+  }
+
+  void Rehash(const size_t capacity) {
+    std::vector<Entry> entries(capacity);
+    entries.swap(entries_);
+    mask_ = capacity - 1;
+    size_ = 0;
+    for (const Entry& entry : entries) {
+      if (entry.value >= 0) {
+        Insert(entry.key, entry.value);
+      }
+    }
+  }
+
+ private:
+  std::vector<Entry> entries_;
+  size_t mask_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace planning
+}  // namespace apollo
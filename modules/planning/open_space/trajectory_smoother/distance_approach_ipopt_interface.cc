@@ -563,7 +563,11 @@ bool DistanceApproachIPOPTInterface::eval_grad_f_hand(int n, const double* x,
 
 bool DistanceApproachIPOPTInterface::eval_g(int n, const double* x, bool new_x,
                                             int m, double* g) {
-  eval_constraints(n, x, m, g);
+  if (!FLAGS_enable_parallel_open_space_smoother) {
+    eval_constraints(n, x, m, g);
+  } else {
+    eval_constraints_par(n, x, m, g);
+  }
   if (enable_constraint_check_) check_g(n, x, m, g);
   return true;
 }
@@ -2732,6 +2736,161 @@ bool DistanceApproachIPOPTInterface::eval_constraints(int n, const T* x, int m,
   return true;
 }
 
+bool DistanceApproachIPOPTInterface::eval_constraints_par(int n,
+                                                          const double* x,
+                                                          int m, double* g) {
+  ADEBUG << "eval_constraints_par";
+  CHECK_EQ(n, num_of_variables_)
+      << "No. of variables wrong in eval_constraints_par. n : " << n;
+  CHECK_EQ(m, num_of_constraints_)
+      << "No. of constraints wrong in eval_constraints_par. m : " << m;
+
+  // 1. state constraints 4 * [0, horizons-1]
+#pragma omp parallel for schedule(static) num_threads(4)
+  for (int i = 0; i < horizon_; ++i) {
+    const int state_index = state_start_index_ + 4 * i;
+    const int control_index = control_start_index_ + 2 * i;
+    const int time_index = time_start_index_ + i;
+    const int constraint_index = 4 * i;
+    const double ds = ts_ * x[time_index] *
+                      (x[state_index + 3] +
+                       ts_ * x[time_index] * 0.5 * x[control_index + 1]);
+    const double heading =
+        x[state_index + 2] + ts_ * x[time_index] * 0.5 * x[state_index + 3] *
+                                 tan(x[control_index]) / wheelbase_;
+    // x1
+    g[constraint_index] = x[state_index + 4] -
+                          (x[state_index] + ds * std::cos(heading));
+    // x2
+    g[constraint_index + 1] =
+        x[state_index + 5] - (x[state_index + 1] + ds * std::sin(heading));
+    // x3
+    g[constraint_index + 2] =
+        x[state_index + 6] -
+        (x[state_index + 2] + ds * tan(x[control_index]) / wheelbase_);
+    // x4
+    g[constraint_index + 3] =
+        x[state_index + 7] -
+        (x[state_index + 3] + ts_ * x[time_index] * x[control_index + 1]);
+  }
+  int constraint_index = 4 * horizon_;
+
+  // 2. Control rate limit constraints, 1 * [0, horizons-1], only apply
+  // steering rate as of now
+  int control_index = control_start_index_;
+  int time_index = time_start_index_;
+
+  // First rate is compare first with stitch point
+  g[constraint_index] =
+      (x[control_index] - last_time_u_(0, 0)) / x[time_index] / ts_;
+  control_index += 2;
+  constraint_index++;
+  time_index++;
+
+  for (int i = 1; i < horizon_; ++i) {
+    g[constraint_index] =
+        (x[control_index] - x[control_index - 2]) / x[time_index] / ts_;
+    constraint_index++;
+    control_index += 2;
+    time_index++;
+  }
+
+  // 3. Time constraints 1 * [0, horizons-1]
+  time_index = time_start_index_;
+  for (int i = 0; i < horizon_; ++i) {
+    g[constraint_index] = x[time_index + 1] - x[time_index];
+    constraint_index++;
+    time_index++;
+  }
+
+  // 4. Three obstacles related equal constraints, one equality constraints,
+  // [0, horizon_] * [0, obstacles_num_-1] * 4
+  const int obstacle_constraint_start = constraint_index;
+#pragma omp parallel for schedule(static) num_threads(4)
+  for (int i = 0; i < horizon_ + 1; ++i) {
+    const int state_index = state_start_index_ + 4 * i;
+    const double cos_heading = std::cos(x[state_index + 2]);
+    const double sin_heading = std::sin(x[state_index + 2]);
+    int l_index = l_start_index_ + i * obstacles_edges_sum_;
+    int n_index = n_start_index_ + 4 * obstacles_num_ * i;
+    int obstacle_constraint_index =
+        obstacle_constraint_start + 4 * obstacles_num_ * i;
+    int edges_counter = 0;
+    for (int j = 0; j < obstacles_num_; ++j) {
+      const int current_edges_num = obstacles_edges_num_(j, 0);
+
+      // norm(A* lambda) <= 1
+      double tmp1 = 0.0;
+      double tmp2 = 0.0;
+      double tmp4 = 0.0;
+      for (int k = 0; k < current_edges_num; ++k) {
+        tmp1 += obstacles_A_(edges_counter + k, 0) * x[l_index + k];
+        tmp2 += obstacles_A_(edges_counter + k, 1) * x[l_index + k];
+        tmp4 += obstacles_b_(edges_counter + k, 0) * x[l_index + k];
+      }
+      g[obstacle_constraint_index] = tmp1 * tmp1 + tmp2 * tmp2;
+
+      // G' * mu + R' * lambda == 0
+      g[obstacle_constraint_index + 1] = x[n_index] - x[n_index + 2] +
+                                         cos_heading * tmp1 +
+                                         sin_heading * tmp2;
+
+      g[obstacle_constraint_index + 2] = x[n_index + 1] - x[n_index + 3] -
+                                         sin_heading * tmp1 +
+                                         cos_heading * tmp2;
+
+      //  -g'*mu + (A*t - b)*lambda > 0
+      double tmp3 = 0.0;
+      for (int k = 0; k < 4; ++k) {
+        tmp3 += -g_[k] * x[n_index + k];
+      }
+
+      g[obstacle_constraint_index + 3] =
+          tmp3 + (x[state_index] + cos_heading * offset_) * tmp1 +
+          (x[state_index + 1] + sin_heading * offset_) * tmp2 - tmp4;
+
+      // Update index
+      edges_counter += current_edges_num;
+      l_index += current_edges_num;
+      n_index += 4;
+      obstacle_constraint_index += 4;
+    }
+  }
+  constraint_index += 4 * obstacles_num_ * (horizon_ + 1);
+
+  // 5. load variable bounds as constraints
+  int state_index = state_start_index_;
+  control_index = control_start_index_;
+  time_index = time_start_index_;
+
+  // start configuration
+  std::copy(x + state_index, x + state_index + 4, g + constraint_index);
+  constraint_index += 4;
+  state_index += 4;
+
+  // constraints on x,y,v
+  for (int i = 1; i < horizon_; ++i) {
+    g[constraint_index] = x[state_index];
+    g[constraint_index + 1] = x[state_index + 1];
+    g[constraint_index + 2] = x[state_index + 3];
+    constraint_index += 3;
+    state_index += 4;
+  }
+
+  // end configuration
+  std::copy(x + state_index, x + state_index + 4, g + constraint_index);
+  constraint_index += 4;
+
+  // control, time, lambda and miu are contiguous variables
+  const int num_of_bounded_variables =
+      2 * horizon_ + (horizon_ + 1) + lambda_horizon_ + miu_horizon_;
+  std::copy(x + control_index, x + control_index + num_of_bounded_variables,
+            g + constraint_index);
+  constraint_index += num_of_bounded_variables;
+  CHECK_EQ(constraint_index, m);
+  return true;
+}
+
 bool DistanceApproachIPOPTInterface::check_g(int n, const double* x, int m,
                                              double* g) {
   int kN = n;
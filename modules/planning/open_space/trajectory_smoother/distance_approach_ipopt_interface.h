@@ -88,6 +88,10 @@ class DistanceApproachIPOPTInterface : public DistanceApproachInterface {
   /** Method to return the constraint residuals */
   bool eval_g(int n, const double* x, bool new_x, int m, double* g) override;
 
+  // parallel implementation to eval_constraints, the dynamics and obstacle
+  // constraints of the time steps are evaluated concurrently
+  bool eval_constraints_par(int n, const double* x, int m, double* g);
+
   /** Check unfeasible constraints for futher study**/
   bool check_g(int n, const double* x, int m, double* g) override;
 
@@ -19,6 +19,7 @@
  **/
 #include "modules/planning/open_space/trajectory_smoother/distance_approach_ipopt_interface.h"
 
+#include <chrono>
 #include <fstream>
 #include <iostream>
 
@@ -169,6 +170,43 @@ TEST_F(DistanceApproachIPOPTInterfaceTest, eval_jac_g_par) {
   }
 }
 
+TEST_F(DistanceApproachIPOPTInterfaceTest, eval_constraints_par) {
+  int n = 1274;
+  int m = 2194;
+  double x[1274];
+  for (int i = 0; i < n; ++i) {
+    x[i] = 1.2 + 0.01 * (i % 7);
+  }
+  double g_ser[2194];
+  double g_par[2194];
+  std::fill_n(g_ser, m, 0.0);
+  std::fill_n(g_par, m, 0.0);
+
+  // compare the serial and the parallel evaluations, and their time
+  const int kNumRuns = 100;
+  auto start_time = std::chrono::system_clock::now();
+  for (int i = 0; i < kNumRuns; ++i) {
+    EXPECT_TRUE(ptop_->eval_constraints(n, x, m, g_ser));
+  }
+  auto end_time = std::chrono::system_clock::now();
+  std::chrono::duration<double> diff = end_time - start_time;
+  AINFO << "eval_constraints used time: " << diff.count() * 1000 / kNumRuns
+        << " ms.";
+
+  start_time = std::chrono::system_clock::now();
+  for (int i = 0; i < kNumRuns; ++i) {
+    EXPECT_TRUE(ptop_->eval_constraints_par(n, x, m, g_par));
+  }
+  end_time = std::chrono::system_clock::now();
+  diff = end_time - start_time;
+  AINFO << "eval_constraints_par used time: "
+        << diff.count() * 1000 / kNumRuns << " ms.";
+
+  for (int i = 0; i < m; ++i) {
+    EXPECT_DOUBLE_EQ(g_ser[i], g_par[i]) << "g differ at index " << i;
+  }
+}
+
 TEST_F(DistanceApproachIPOPTInterfaceTest, eval_grad_f_hand) {
   int n = 1274;
   double x[1274];
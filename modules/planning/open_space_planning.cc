@@ -607,12 +607,10 @@ bool OpenSpacePlanning::IsCollisionFreeTrajectory(
     Vec2d shift_vec{shift_distance * std::cos(ego_theta),
                     shift_distance * std::sin(ego_theta)};
     ego_box.Shift(shift_vec);
-    size_t predicted_time_horizon = predicted_bounding_rectangles_.size();
+    size_t predicted_time_horizon = predicted_environment_.NumOfTimeSlots();
     for (size_t j = 0; j < predicted_time_horizon; j++) {
-      for (const auto& obstacle_box : predicted_bounding_rectangles_[j]) {
-        if (ego_box.HasOverlap(obstacle_box)) {
-          return false;
-        }
+      if (predicted_environment_.HasOverlap(j, ego_box)) {
+        return false;
       }
     }
   }
@@ -621,7 +619,7 @@ bool OpenSpacePlanning::IsCollisionFreeTrajectory(
 
 void OpenSpacePlanning::BuildPredictedEnvironment(
     const std::vector<const Obstacle*>& obstacles) {
-  predicted_bounding_rectangles_.clear();
+  predicted_environment_.Clear();
   double relative_time = 0.0;
   while (relative_time < FLAGS_open_space_prediction_time_horizon) {
     std::vector<Box2d> predicted_env;
@@ -630,7 +628,7 @@ void OpenSpacePlanning::BuildPredictedEnvironment(
       Box2d box = obstacle->GetBoundingBox(point);
       predicted_env.push_back(std::move(box));
     }
-    predicted_bounding_rectangles_.push_back(std::move(predicted_env));
+    predicted_environment_.AddTimeSlot(std::move(predicted_env));
     relative_time += FLAGS_trajectory_time_resolution;
   }
 }
@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 
+#include "modules/planning/constraint_checker/predicted_environment.h"
 #include "modules/planning/open_space/trajectory_partition/trajectory_partitioner.h"
 #include "modules/planning/planner/on_lane_planner_dispatcher.h"
 #include "modules/planning/planning_base.h"
@@ -99,7 +100,7 @@ class OpenSpacePlanning : public PlanningBase {
 
  private:
   routing::RoutingResponse last_routing_;
-  std::vector<std::vector<common::math::Box2d>> predicted_bounding_rectangles_;
+  PredictedEnvironment predicted_environment_;
   std::unique_ptr<PublishableTrajectory> last_trajectory_;
   std::vector<common::TrajectoryPoint> last_stitching_trajectory_;
   planning_internal::OpenSpaceDebug last_open_space_debug_;
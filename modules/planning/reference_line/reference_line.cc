@@ -401,6 +401,21 @@ bool ReferenceLine::XYToSL(const common::math::Vec2d& xy_point,
   return true;
 }
 
+bool ReferenceLine::XYToSL(const common::math::Vec2d& xy_point,
+                           const double warm_start_s,
+                           SLPoint* const sl_point) const {
+  DCHECK_NOTNULL(sl_point);
+  double s = 0.0;
+  double l = 0.0;
+  if (!map_path_.GetProjectionWithWarmStartS(xy_point, warm_start_s, &s, &l)) {
+    AERROR << "Cannot get nearest point from path.";
+    return false;
+  }
+  sl_point->set_s(s);
+  sl_point->set_l(l);
+  return true;
+}
+
 ReferencePoint ReferenceLine::InterpolateWithMatchedIndex(
     const ReferencePoint& p0, const double s0, const ReferencePoint& p1,
     const double s1, const InterpolatedIndex& index) const {
@@ -655,7 +670,11 @@ bool ReferenceLine::GetSLBoundary(const common::math::Box2d& box,
   std::vector<SLPoint> sl_corners;
   for (const auto& point : corners) {
     SLPoint sl_point;
-    if (!XYToSL(point, &sl_point)) {
+    // each corner is searched from the previous one
+    const bool found = sl_corners.empty()
+                           ? XYToSL(point, &sl_point)
+                           : XYToSL(point, sl_corners.back().s(), &sl_point);
+    if (!found) {
       AERROR << "Failed to get projection for point: " << point.DebugString()
              << " on reference line.";
       return false;
@@ -671,7 +690,7 @@ bool ReferenceLine::GetSLBoundary(const common::math::Box2d& box,
 
     const auto p_mid = (p0 + p1) * 0.5;
     SLPoint sl_point_mid;
-    if (!XYToSL(p_mid, &sl_point_mid)) {
+    if (!XYToSL(p_mid, sl_corners[index0].s(), &sl_point_mid)) {
       AERROR << "Failed to get projection for point: " << p_mid.DebugString()
              << " on reference line.";
       return false;
@@ -716,9 +735,16 @@ bool ReferenceLine::GetSLBoundary(const hdmap::Polygon& polygon,
   double end_s(std::numeric_limits<double>::lowest());
   double start_l(std::numeric_limits<double>::max());
   double end_l(std::numeric_limits<double>::lowest());
+  SLPoint sl_point;
+  bool is_first_point = true;
   for (const auto& point : polygon.point()) {
-    SLPoint sl_point;
-    if (!XYToSL(point, &sl_point)) {
+    // each point is searched from the previous one along the polygon
+    const Vec2d xy_point(point.x(), point.y());
+    const bool found = is_first_point
+                           ? XYToSL(xy_point, &sl_point)
+                           : XYToSL(xy_point, sl_point.s(), &sl_point);
+    is_first_point = false;
+    if (!found) {
       AERROR << "Failed to get projection for point: " << point.DebugString()
              << " on reference line.";
       return false;
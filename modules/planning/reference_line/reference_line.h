@@ -112,6 +112,10 @@ class ReferenceLine {
               common::math::Vec2d* const xy_point) const;
   bool XYToSL(const common::math::Vec2d& xy_point,
               common::SLPoint* const sl_point) const;
+  // Same as XYToSL, but the projection is searched from warm_start_s first,
+  // e.g. the s of a neighbouring point.
+  bool XYToSL(const common::math::Vec2d& xy_point, const double warm_start_s,
+              common::SLPoint* const sl_point) const;
   template <class XYPoint>
   bool XYToSL(const XYPoint& xy, common::SLPoint* const sl_point) const {
     return XYToSL(common::math::Vec2d(xy.x(), xy.y()), sl_point);
@@ -22,6 +22,7 @@
 #include "modules/planning/reference_line/reference_line_provider.h"
 
 #include <algorithm>
+#include <chrono>
 #include <limits>
 #include <utility>
 
@@ -241,11 +242,14 @@ bool ReferenceLineProvider::GetReferenceLines(
       return true;
     }
   } else {
-    double start_time = Clock::NowInSeconds();
+    // wall time, so that the delay is also measured under a mock clock
+    const auto start_time = std::chrono::steady_clock::now();
     if (CreateReferenceLine(reference_lines, segments)) {
       UpdateReferenceLine(*reference_lines, *segments);
-      double end_time = Clock::NowInSeconds();
-      last_calculation_time_ = end_time - start_time;
+      last_calculation_time_ = std::chrono::duration<double>(
+                                   std::chrono::steady_clock::now() -
+                                   start_time)
+                                   .count();
       return true;
     }
   }
@@ -859,7 +863,11 @@ bool ReferenceLineProvider::SmoothPrefixedReferenceLine(
   // generate anchor points:
   std::vector<AnchorPoint> anchor_points;
   GetAnchorPoints(raw_ref, &anchor_points);
-  // modify anchor points based on prefix_ref
+  // modify anchor points based on prefix_ref: the first anchor on the prefix
+  // is fixed to it, and the following anchors on the prefix are held on it
+  // laterally, so that only the extended tail is smoothed and it continues
+  // the prefix over the whole overlap rather than at a single point
+  bool is_first_on_prefix = true;
   for (auto &point : anchor_points) {
     common::SLPoint sl_point;
     Vec2d xy{point.path_point.x(), point.path_point.y()};
@@ -867,17 +875,22 @@ bool ReferenceLineProvider::SmoothPrefixedReferenceLine(
       continue;
     }
     if (sl_point.s() < 0 || sl_point.s() > prefix_ref.Length()) {
-      continue;
+      if (is_first_on_prefix) {
+        continue;
+      }
+      break;
     }
     auto prefix_ref_point = prefix_ref.GetNearestReferencePoint(sl_point.s());
     point.path_point.set_x(prefix_ref_point.x());
     point.path_point.set_y(prefix_ref_point.y());
     point.path_point.set_z(0.0);
     point.path_point.set_theta(prefix_ref_point.heading());
-    point.longitudinal_bound = 1e-6;
     point.lateral_bound = 1e-6;
-    point.enforced = true;
-    break;
+    if (is_first_on_prefix) {
+      point.longitudinal_bound = 1e-6;
+      point.enforced = true;
+      is_first_on_prefix = false;
+    }
   }
 
   smoother_->SetAnchorPoints(anchor_points);
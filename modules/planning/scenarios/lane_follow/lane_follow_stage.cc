@@ -20,7 +20,12 @@
 
 #include "modules/planning/scenarios/lane_follow/lane_follow_stage.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <limits>
+#include <memory>
 #include <utility>
 
 #include "cyber/common/log.h"
@@ -31,9 +36,9 @@
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 #include "modules/map/hdmap/hdmap.h"
 #include "modules/map/hdmap/hdmap_common.h"
-#include "modules/planning/common/change_lane_decider.h"
 #include "modules/planning/common/ego_info.h"
 #include "modules/planning/common/frame.h"
+#include "modules/planning/common/planning_context.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/constraint_checker/constraint_checker.h"
 #include "modules/planning/tasks/optimizers/dp_poly_path/dp_poly_path_optimizer.h"
@@ -53,7 +58,6 @@ using common::ErrorCode;
 using common::SLPoint;
 using common::Status;
 using common::TrajectoryPoint;
-using common::time::Clock;
 
 namespace {
 constexpr double kPathOptimizationFallbackCost = 2e4;
@@ -118,6 +122,11 @@ Stage::StageStatus LaneFollowStage::Process(
   ADEBUG << "Number of reference lines:\t"
          << frame->mutable_reference_line_info()->size();
 
+  if (FLAGS_enable_multi_thread_in_reference_line_planning &&
+      frame->reference_line_info().size() > 1) {
+    return ProcessConcurrently(planning_start_point, frame);
+  }
+
   for (auto& reference_line_info : *frame->mutable_reference_line_info()) {
     if (has_drivable_reference_line) {
       reference_line_info.SetDrivable(false);
@@ -126,35 +135,118 @@ Stage::StageStatus LaneFollowStage::Process(
 
     auto cur_status =
         PlanOnReferenceLine(planning_start_point, frame, &reference_line_info);
-
-    if (cur_status.ok()) {
-      if (reference_line_info.IsChangeLanePath()) {
-        ADEBUG << "reference line is lane change ref.";
-        if (reference_line_info.Cost() < kStraightForwardLineCost &&
-            ChangeLaneDecider::IsClearToChangeLane(&reference_line_info)) {
-          has_drivable_reference_line = true;
-          reference_line_info.SetDrivable(true);
-          AERROR << "\tclear for lane change";
-        } else {
-          reference_line_info.SetDrivable(false);
-          AERROR << "\tlane change failed";
-        }
-      } else {
-        ADEBUG << "reference line is NOT lane change ref.";
-        has_drivable_reference_line = true;
-      }
-    } else {
-      reference_line_info.SetDrivable(false);
-    }
+    has_drivable_reference_line =
+        SetReferenceLineDrivable(cur_status, &reference_line_info);
   }
 
   return has_drivable_reference_line ? StageStatus::RUNNING
                                      : StageStatus::ERROR;
 }
 
+Stage::StageStatus LaneFollowStage::ProcessConcurrently(
+    const TrajectoryPoint& planning_start_point, Frame* frame) {
+  // Every reference line is planned with its own tasks, its own fork of the
+  // planning context and its own virtual obstacles, so that the reference
+  // lines only share the frame. They are planned on threads of their own
+  // rather than on the cyber task pool, since their tasks may wait for the
+  // work they submit to the pool.
+  std::vector<ReferenceLineInfo*> reference_line_infos;
+  std::vector<std::vector<Task*>> task_lists;
+  std::vector<std::unique_ptr<PlanningContext>> planning_contexts;
+  const auto base_planning_context = PlanningContext::Fork();
+  for (auto& reference_line_info : *frame->mutable_reference_line_info()) {
+    task_lists.push_back(ReferenceLineTaskList(reference_line_infos.size()));
+    planning_contexts.push_back(PlanningContext::Fork());
+    reference_line_infos.push_back(&reference_line_info);
+  }
+
+  const size_t num_reference_lines = reference_line_infos.size();
+  std::vector<IndexedObstacles> virtual_obstacles(num_reference_lines);
+  std::atomic<size_t> selected_index(num_reference_lines);
+  auto plan = [&](const size_t index) {
+    PlanningContext::ScopedThreadInstance scoped_planning_context(
+        planning_contexts[index].get());
+    Frame::ScopedVirtualObstacles scoped_virtual_obstacles(
+        &virtual_obstacles[index]);
+    // planning one reference line after the other stops at the first
+    // drivable one, so the reference lines after it stop at their next task
+    auto is_cancelled = [&selected_index, index]() {
+      return selected_index.load() < index;
+    };
+    const Status status =
+        PlanOnReferenceLine(planning_start_point, frame,
+                            reference_line_infos[index], task_lists[index],
+                            is_cancelled);
+    if (is_cancelled() ||
+        !SetReferenceLineDrivable(status, reference_line_infos[index])) {
+      return;
+    }
+    size_t current_index = selected_index.load();
+    while (index < current_index &&
+           !selected_index.compare_exchange_weak(current_index, index)) {
+    }
+  };
+  std::vector<std::future<void>> results;
+  for (size_t i = 1; i < num_reference_lines; ++i) {
+    results.push_back(std::async(std::launch::async, plan, i));
+  }
+  plan(0);
+  for (auto& result : results) {
+    result.get();
+  }
+
+  // The updates of the reference lines up to the selected one are kept in
+  // order, the ones planning one reference line after the other would have
+  // made, except that each reference line was planned from the context of
+  // the start of the stage rather than the one left by the previous lines.
+  const size_t num_planned_lines =
+      std::min(selected_index.load() + 1, num_reference_lines);
+  for (size_t i = 0; i < num_planned_lines; ++i) {
+    PlanningContext::Instance()->MergeFrom(*base_planning_context,
+                                           *planning_contexts[i]);
+    frame->AddVirtualObstacles(virtual_obstacles[i]);
+  }
+  for (size_t i = num_planned_lines; i < num_reference_lines; ++i) {
+    reference_line_infos[i]->SetDrivable(false);
+  }
+
+  return selected_index.load() < num_reference_lines ? StageStatus::RUNNING
+                                                     : StageStatus::ERROR;
+}
+
+bool LaneFollowStage::SetReferenceLineDrivable(
+    const Status& status, ReferenceLineInfo* reference_line_info) {
+  if (!status.ok()) {
+    reference_line_info->SetDrivable(false);
+    return false;
+  }
+  if (reference_line_info->IsChangeLanePath()) {
+    ADEBUG << "reference line is lane change ref.";
+    if (reference_line_info->Cost() < kStraightForwardLineCost &&
+        reference_line_info->IsClearToChangeLane()) {
+      reference_line_info->SetDrivable(true);
+      AERROR << "\tclear for lane change";
+      return true;
+    }
+    reference_line_info->SetDrivable(false);
+    AERROR << "\tlane change failed";
+    return false;
+  }
+  ADEBUG << "reference line is NOT lane change ref.";
+  return true;
+}
+
 Status LaneFollowStage::PlanOnReferenceLine(
     const TrajectoryPoint& planning_start_point, Frame* frame,
     ReferenceLineInfo* reference_line_info) {
+  return PlanOnReferenceLine(planning_start_point, frame, reference_line_info,
+                             task_list_, nullptr);
+}
+
+Status LaneFollowStage::PlanOnReferenceLine(
+    const TrajectoryPoint& planning_start_point, Frame* frame,
+    ReferenceLineInfo* reference_line_info, const std::vector<Task*>& task_list,
+    const std::function<bool()>& is_cancelled) {
   if (!reference_line_info->IsChangeLanePath()) {
     reference_line_info->AddCost(kStraightForwardLineCost);
   }
@@ -171,16 +263,23 @@ Status LaneFollowStage::PlanOnReferenceLine(
 
   auto ret = Status::OK();
 
-  for (auto* optimizer : task_list_) {
-    const double start_timestamp = Clock::NowInSeconds();
+  for (auto* optimizer : task_list) {
+    if (is_cancelled && is_cancelled()) {
+      return Status(ErrorCode::PLANNING_ERROR,
+                    "Planning on the reference line is cancelled.");
+    }
+    // wall time, so that the task latency is also measured under a mock clock
+    const auto start_time = std::chrono::steady_clock::now();
     ret = optimizer->Execute(frame, reference_line_info);
     if (!ret.ok()) {
       AERROR << "Failed to run tasks[" << optimizer->Name()
              << "], Error message: " << ret.error_message();
       break;
     }
-    const double end_timestamp = Clock::NowInSeconds();
-    const double time_diff_ms = (end_timestamp - start_timestamp) * 1000;
+    const double time_diff_ms = std::chrono::duration<double, std::milli>(
+                                    std::chrono::steady_clock::now() -
+                                    start_time)
+                                    .count();
 
     ADEBUG << "after optimizer " << optimizer->Name() << ":"
            << reference_line_info->PathSpeedDebugString();
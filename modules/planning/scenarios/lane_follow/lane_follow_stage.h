@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -64,6 +65,28 @@ class LaneFollowStage : public Stage {
   void RecordDebugInfo(ReferenceLineInfo* reference_line_info,
                        const std::string& name, const double time_diff_ms);
 
+ private:
+  /**
+   * @brief Plans all the reference lines concurrently, then marks them
+   * drivable in the order Process does when planning them one by one. The
+   * reference lines after a drivable one stop planning.
+   */
+  StageStatus ProcessConcurrently(
+      const common::TrajectoryPoint& planning_start_point, Frame* frame);
+
+  // @brief plans with the tasks of task_list, stops before the next task
+  // once is_cancelled, if not empty, returns true
+  common::Status PlanOnReferenceLine(
+      const common::TrajectoryPoint& planning_start_point, Frame* frame,
+      ReferenceLineInfo* reference_line_info,
+      const std::vector<Task*>& task_list,
+      const std::function<bool()>& is_cancelled);
+
+  // set the drivable flag of a planned reference line, return true if the
+  // reference line is selected to drive on
+  bool SetReferenceLineDrivable(const common::Status& status,
+                                ReferenceLineInfo* reference_line_info);
+
  private:
   ScenarioConfig config_;
   std::unique_ptr<Stage> stage_;
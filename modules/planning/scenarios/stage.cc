@@ -49,6 +49,12 @@ Stage::Stage(const ScenarioConfig::StageConfig& config) : config_(config) {
 
   name_ = ScenarioConfig::StageType_Name(config_.stage_type());
   next_stage_ = config_.stage_type();
+  CreateTasks(&tasks_, &task_list_);
+}
+
+void Stage::CreateTasks(
+    std::map<TaskConfig::TaskType, std::unique_ptr<Task>>* tasks,
+    std::vector<Task*>* task_list) const {
   std::unordered_map<TaskConfig::TaskType, const TaskConfig*, std::hash<int>>
       config_map;
   for (const auto& task_config : config_.task_config()) {
@@ -59,17 +65,31 @@ Stage::Stage(const ScenarioConfig::StageConfig& config) : config_(config) {
     CHECK(config_map.find(task_type) != config_map.end())
         << "Task: " << TaskConfig::TaskType_Name(task_type)
         << " used but not configured";
-    auto iter = tasks_.find(task_type);
-    if (iter == tasks_.end()) {
+    auto iter = tasks->find(task_type);
+    if (iter == tasks->end()) {
       auto ptr = TaskFactory::CreateTask(*config_map[task_type]);
-      task_list_.push_back(ptr.get());
-      tasks_[task_type] = std::move(ptr);
+      task_list->push_back(ptr.get());
+      (*tasks)[task_type] = std::move(ptr);
     } else {
-      task_list_.push_back(iter->second.get());
+      task_list->push_back(iter->second.get());
     }
   }
 }
 
+std::vector<Task*> Stage::ReferenceLineTaskList(const size_t index) {
+  if (index == 0) {
+    return task_list_;
+  }
+  while (reference_line_task_lists_.size() < index) {
+    std::map<TaskConfig::TaskType, std::unique_ptr<Task>> tasks;
+    std::vector<Task*> task_list;
+    CreateTasks(&tasks, &task_list);
+    reference_line_tasks_.push_back(std::move(tasks));
+    reference_line_task_lists_.push_back(std::move(task_list));
+  }
+  return reference_line_task_lists_[index - 1];
+}
+
 const std::string& Stage::Name() const { return name_; }
 
 Task* Stage::FindTask(TaskConfig::TaskType task_type) const {
@@ -86,11 +86,28 @@ class Stage {
 
   bool ExecuteTaskOnOpenSpace(Frame* frame);
 
+  /**
+   * @brief The tasks to plan the reference line at index with. The first
+   * reference line uses task_list_, the others get their own task instances
+   * so that the reference lines can be planned concurrently. The instances
+   * are created on demand, so it should not be called concurrently.
+   */
+  std::vector<Task*> ReferenceLineTaskList(const size_t index);
+
   virtual Stage::StageStatus FinishScenario();
 
+ private:
+  void CreateTasks(
+      std::map<TaskConfig::TaskType, std::unique_ptr<Task>>* tasks,
+      std::vector<Task*>* task_list) const;
+
  protected:
   std::map<TaskConfig::TaskType, std::unique_ptr<Task>> tasks_;
   std::vector<Task*> task_list_;
+  // the tasks of the reference lines after the first one
+  std::vector<std::map<TaskConfig::TaskType, std::unique_ptr<Task>>>
+      reference_line_tasks_;
+  std::vector<std::vector<Task*>> reference_line_task_lists_;
   ScenarioConfig::StageConfig config_;
   ScenarioConfig::StageType next_stage_;
   void* context_ = nullptr;
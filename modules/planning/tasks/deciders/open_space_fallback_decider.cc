@@ -31,19 +31,19 @@ OpenSpaceFallbackDecider::OpenSpaceFallbackDecider(const TaskConfig& config)
     : Decider(config) {}
 
 Status OpenSpaceFallbackDecider::Process(Frame* frame) {
-  std::vector<std::vector<common::math::Box2d>> predicted_bounding_rectangles;
+  PredictedEnvironment predicted_environment;
   // double obstacle_to_vehicle_distance = 0.0;
   size_t first_collision_idx = 0;
   size_t current_idx = 0;
 
-  BuildPredictedEnvironment(frame->obstacles(), predicted_bounding_rectangles);
+  BuildPredictedEnvironment(frame->obstacles(), &predicted_environment);
   ADEBUG << "Numbers of obstsacles are: " << frame->obstacles().size();
   ADEBUG << "Numbers of predicted bounding rectangles are: "
-         << predicted_bounding_rectangles[0].size()
-         << " and : " << predicted_bounding_rectangles.size();
+         << predicted_environment.Boxes(0).size()
+         << " and : " << predicted_environment.NumOfTimeSlots();
   if (!IsCollisionFreeTrajectory(
           frame->open_space_info().chosen_paritioned_trajectory(),
-          predicted_bounding_rectangles, &current_idx, &first_collision_idx)) {
+          predicted_environment, &current_idx, &first_collision_idx)) {
     // change gflag
     frame_->mutable_open_space_info()->set_fallback_flag(true);
 
@@ -96,9 +96,8 @@ Status OpenSpaceFallbackDecider::Process(Frame* frame) {
 
 void OpenSpaceFallbackDecider::BuildPredictedEnvironment(
     const std::vector<const Obstacle*>& obstacles,
-    std::vector<std::vector<common::math::Box2d>>&
-        predicted_bounding_rectangles) {
-  predicted_bounding_rectangles.clear();
+    PredictedEnvironment* predicted_environment) {
+  predicted_environment->Clear();
   double relative_time = 0.0;
   while (relative_time < config_.open_space_fallback_decider_config()
                              .open_space_prediction_time_period()) {
@@ -110,16 +109,15 @@ void OpenSpaceFallbackDecider::BuildPredictedEnvironment(
         predicted_env.push_back(std::move(box));
       }
     }
-    predicted_bounding_rectangles.emplace_back(std::move(predicted_env));
+    predicted_environment->AddTimeSlot(std::move(predicted_env));
     relative_time += FLAGS_trajectory_time_resolution;
   }
 }
 
 bool OpenSpaceFallbackDecider::IsCollisionFreeTrajectory(
     const TrajGearPair& trajectory_gear_pair,
-    const std::vector<std::vector<common::math::Box2d>>&
-        predicted_bounding_rectangles,
-    size_t* current_idx, size_t* first_collision_idx) {
+    const PredictedEnvironment& predicted_environment, size_t* current_idx,
+    size_t* first_collision_idx) {
   // prediction time resolution: FLAGS_trajectory_time_resolution
   const auto& vehicle_config =
       common::VehicleConfigHelper::Instance()->GetConfig();
@@ -140,20 +138,15 @@ bool OpenSpaceFallbackDecider::IsCollisionFreeTrajectory(
     Vec2d shift_vec{shift_distance * std::cos(ego_theta),
                     shift_distance * std::sin(ego_theta)};
     ego_box.Shift(shift_vec);
-    size_t predicted_time_horizon = predicted_bounding_rectangles.size();
+    size_t predicted_time_horizon = predicted_environment.NumOfTimeSlots();
     for (size_t j = 0; j < predicted_time_horizon; j++) {
-      for (const auto& obstacle_box : predicted_bounding_rectangles[j]) {
-        if (ego_box.HasOverlap(obstacle_box)) {
-          const auto& vehicle_state = frame_->vehicle_state();
-          Vec2d vehicle_vec({vehicle_state.x(), vehicle_state.y()});
-          if (std::abs(trajectory_point.relative_time() -
-                       static_cast<double>(j) *
-                           FLAGS_trajectory_time_resolution) <
-              FLAGS_trajectory_time_resolution) {
-            *first_collision_idx = i;
-            return false;
-          }
-        }
+      // only the time slots next to the point count as a collision
+      if (std::abs(trajectory_point.relative_time() -
+                   static_cast<double>(j) * FLAGS_trajectory_time_resolution) <
+              FLAGS_trajectory_time_resolution &&
+          predicted_environment.HasOverlap(j, ego_box)) {
+        *first_collision_idx = i;
+        return false;
       }
     }
   }
@@ -35,6 +35,7 @@
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/common/trajectory/discretized_trajectory.h"
 #include "modules/planning/common/trajectory/publishable_trajectory.h"
+#include "modules/planning/constraint_checker/predicted_environment.h"
 #include "modules/planning/tasks/deciders/decider.h"
 
 namespace apollo {
@@ -49,14 +50,12 @@ class OpenSpaceFallbackDecider : public Decider {
   // bool IsCollisionFreeTrajectory(const ADCTrajectory& trajectory_pb);
 
   void BuildPredictedEnvironment(const std::vector<const Obstacle*>& obstacles,
-                                 std::vector<std::vector<common::math::Box2d>>&
-                                     predicted_bounding_rectangles);
+                                 PredictedEnvironment* predicted_environment);
 
   bool IsCollisionFreeTrajectory(
       const TrajGearPair& trajectory_pb,
-      const std::vector<std::vector<common::math::Box2d>>&
-          predicted_bounding_rectangles,
-      size_t* current_idx, size_t* first_collision_idx);
+      const PredictedEnvironment& predicted_environment, size_t* current_idx,
+      size_t* first_collision_idx);
 };
 
 }  // namespace planning
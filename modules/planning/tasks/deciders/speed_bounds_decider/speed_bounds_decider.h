@@ -38,7 +38,8 @@ class SpeedBoundsDecider : public Decider {
       Frame* const frame,
       ReferenceLineInfo* const reference_line_info) override;
 
-  void CheckLaneChangeUrgency(Frame* const frame);
+  void CheckLaneChangeUrgency(Frame* const frame,
+                              ReferenceLineInfo* const reference_line_info);
 
   // @brief Rule-based stop for side pass on reverse lane
   void StopOnSidePass(Frame* const frame,
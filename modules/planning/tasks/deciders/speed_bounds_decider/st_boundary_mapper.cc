@@ -21,6 +21,7 @@
 #include "modules/planning/tasks/deciders/speed_bounds_decider/st_boundary_mapper.h"
 
 #include <algorithm>
+#include <future>
 #include <limits>
 #include <unordered_map>
 #include <utility>
@@ -29,6 +30,7 @@
 #include "modules/planning/proto/decision.pb.h"
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 #include "modules/common/configs/vehicle_config_helper.h"
 #include "modules/common/math/line_segment2d.h"
 #include "modules/common/math/vec2d.h"
@@ -67,7 +69,92 @@ StBoundaryMapper::StBoundaryMapper(const SLBoundary& adc_sl_boundary,
       vehicle_param_(common::VehicleConfigHelper::GetConfig().vehicle_param()),
       planning_distance_(planning_distance),
       planning_time_(planning_time),
-      is_change_lane_(is_change_lane) {}
+      is_change_lane_(is_change_lane) {
+  BuildFootprintIndex();
+}
+
+void StBoundaryMapper::BuildFootprintIndex() {
+  const auto& path_points = path_data_.discretized_path();
+  if (path_points.size() < 2) {
+    return;
+  }
+  const size_t default_num_point = 50;
+  if (path_points.size() > 2 * default_num_point) {
+    const auto ratio = path_points.size() / default_num_point;
+    std::vector<PathPoint> sampled_path_points;
+    for (size_t i = 0; i < path_points.size(); ++i) {
+      if (i % ratio == 0) {
+        sampled_path_points.push_back(path_points[i]);
+      }
+    }
+    sampled_path_ = DiscretizedPath(sampled_path_points);
+  } else {
+    sampled_path_ = DiscretizedPath(path_points);
+  }
+
+  const double step_length = vehicle_param_.front_edge_to_center();
+  const double path_len =
+      std::min(FLAGS_max_trajectory_len, sampled_path_.Length());
+  for (double path_s = 0.0; path_s < path_len; path_s += step_length) {
+    sample_path_s_.push_back(path_s);
+    sample_boxes_.push_back(
+        GetAdcBox(sampled_path_.Evaluate(path_s + sampled_path_.front().s()),
+                  speed_bounds_config_.boundary_buffer()));
+  }
+
+  num_leaves_ = 1;
+  while (num_leaves_ < sample_boxes_.size()) {
+    num_leaves_ *= 2;
+  }
+  sample_tree_.assign(2 * num_leaves_, Bounds());
+  for (size_t i = 0; i < sample_boxes_.size(); ++i) {
+    Bounds& leaf = sample_tree_[num_leaves_ + i];
+    leaf.min_x = sample_boxes_[i].min_x();
+    leaf.min_y = sample_boxes_[i].min_y();
+    leaf.max_x = sample_boxes_[i].max_x();
+    leaf.max_y = sample_boxes_[i].max_y();
+  }
+  for (size_t k = num_leaves_ - 1; k > 0; --k) {
+    const Bounds& left = sample_tree_[2 * k];
+    const Bounds& right = sample_tree_[2 * k + 1];
+    Bounds& node = sample_tree_[k];
+    node.min_x = std::min(left.min_x, right.min_x);
+    node.min_y = std::min(left.min_y, right.min_y);
+    node.max_x = std::max(left.max_x, right.max_x);
+    node.max_y = std::max(left.max_y, right.max_y);
+  }
+}
+
+int StBoundaryMapper::FindFirstOverlapSample(const Box2d& obs_box) const {
+  if (sample_boxes_.empty()) {
+    return -1;
+  }
+  // depth first with the lower s first, so that the first leaf found is the
+  // first sample the linear walk along the path would find
+  std::vector<size_t> stack;
+  stack.reserve(64);
+  stack.push_back(1);
+  while (!stack.empty()) {
+    const size_t k = stack.back();
+    stack.pop_back();
+    const Bounds& node = sample_tree_[k];
+    // same rejection as the one of Box2d::HasOverlap
+    if (node.max_x < obs_box.min_x() || node.min_x > obs_box.max_x() ||
+        node.max_y < obs_box.min_y() || node.min_y > obs_box.max_y()) {
+      continue;
+    }
+    if (k >= num_leaves_) {
+      const size_t index = k - num_leaves_;
+      if (obs_box.HasOverlap(sample_boxes_[index])) {
+        return static_cast<int>(index);
+      }
+      continue;
+    }
+    stack.push_back(2 * k + 1);
+    stack.push_back(2 * k);
+  }
+  return -1;
+}
 
 Status StBoundaryMapper::CreateStBoundary(PathDecision* path_decision) const {
   const auto& obstacles = path_decision->obstacles();
@@ -89,6 +176,8 @@ Status StBoundaryMapper::CreateStBoundary(PathDecision* path_decision) const {
   Obstacle* stop_obstacle = nullptr;
   ObjectDecisionType stop_decision;
   double min_stop_s = std::numeric_limits<double>::max();
+  // the obstacles mapped on the path, all the other decisions are made first
+  std::vector<Obstacle*> mapped_obstacles;
 
   for (const auto* const_obstacle : obstacles.Items()) {
     auto* obstacle = path_decision->Find(const_obstacle->Id());
@@ -108,12 +197,7 @@ Status StBoundaryMapper::CreateStBoundary(PathDecision* path_decision) const {
     }
 
     if (!obstacle->HasLongitudinalDecision()) {
-      if (!MapWithoutDecision(obstacle).ok()) {
-        std::string msg = StrCat("Fail to map obstacle ", obstacle->Id(),
-                                 " without decision.");
-        AERROR << msg;
-        return Status(ErrorCode::PLANNING_ERROR, msg);
-      }
+      mapped_obstacles.push_back(obstacle);
       continue;
     }
 
@@ -138,17 +222,40 @@ Status StBoundaryMapper::CreateStBoundary(PathDecision* path_decision) const {
       }
     } else if (decision.has_follow() || decision.has_overtake() ||
                decision.has_yield()) {
-      if (!MapWithDecision(obstacle, decision).ok()) {
-        AERROR << "Fail to map obstacle " << obstacle->Id()
-               << " with decision: " << decision.DebugString();
-        return Status(ErrorCode::PLANNING_ERROR,
-                      "Fail to map overtake/yield decision");
-      }
+      mapped_obstacles.push_back(obstacle);
     } else if (!decision.has_ignore()) {
       AWARN << "No mapping for decision: " << decision.DebugString();
     }
   }
 
+  // each obstacle only sets its own st boundary
+  std::vector<Status> statuses(mapped_obstacles.size());
+  if (FLAGS_enable_multi_thread_in_st_boundary_mapper &&
+      mapped_obstacles.size() > 1) {
+    std::vector<std::future<Status>> futures;
+    for (size_t i = 1; i < mapped_obstacles.size(); ++i) {
+      Obstacle* obstacle = mapped_obstacles[i];
+      futures.push_back(
+          cyber::Async(&StBoundaryMapper::MapObstacle, this, obstacle));
+    }
+    statuses.front() = MapObstacle(mapped_obstacles.front());
+    for (size_t i = 0; i < futures.size(); ++i) {
+      statuses[i + 1] = futures[i].get();
+    }
+  } else {
+    for (size_t i = 0; i < mapped_obstacles.size(); ++i) {
+      statuses[i] = MapObstacle(mapped_obstacles[i]);
+      if (!statuses[i].ok()) {
+        break;
+      }
+    }
+  }
+  for (const auto& status : statuses) {
+    if (!status.ok()) {
+      return status;
+    }
+  }
+
   if (stop_obstacle) {
     bool success = MapStopDecision(stop_obstacle, stop_decision);
     if (!success) {
@@ -161,6 +268,26 @@ Status StBoundaryMapper::CreateStBoundary(PathDecision* path_decision) const {
   return Status::OK();
 }
 
+Status StBoundaryMapper::MapObstacle(Obstacle* obstacle) const {
+  if (!obstacle->HasLongitudinalDecision()) {
+    if (!MapWithoutDecision(obstacle).ok()) {
+      std::string msg = StrCat("Fail to map obstacle ", obstacle->Id(),
+                               " without decision.");
+      AERROR << msg;
+      return Status(ErrorCode::PLANNING_ERROR, msg);
+    }
+    return Status::OK();
+  }
+  const auto& decision = obstacle->LongitudinalDecision();
+  if (!MapWithDecision(obstacle, decision).ok()) {
+    AERROR << "Fail to map obstacle " << obstacle->Id()
+           << " with decision: " << decision.DebugString();
+    return Status(ErrorCode::PLANNING_ERROR,
+                  "Fail to map overtake/yield decision");
+  }
+  return Status::OK();
+}
+
 bool StBoundaryMapper::MapStopDecision(
     Obstacle* stop_obstacle, const ObjectDecisionType& stop_decision) const {
   DCHECK(stop_decision.has_stop()) << "Must have stop decision";
@@ -213,8 +340,7 @@ Status StBoundaryMapper::MapWithoutDecision(Obstacle* obstacle) const {
   std::vector<STPoint> lower_points;
   std::vector<STPoint> upper_points;
 
-  if (!GetOverlapBoundaryPoints(path_data_.discretized_path(), *obstacle,
-                                &upper_points, &lower_points)) {
+  if (!GetOverlapBoundaryPoints(*obstacle, &upper_points, &lower_points)) {
     return Status::OK();
   }
 
@@ -235,9 +361,9 @@ Status StBoundaryMapper::MapWithoutDecision(Obstacle* obstacle) const {
 }
 
 bool StBoundaryMapper::GetOverlapBoundaryPoints(
-    const std::vector<PathPoint>& path_points, const Obstacle& obstacle,
-    std::vector<STPoint>* upper_points,
+    const Obstacle& obstacle, std::vector<STPoint>* upper_points,
     std::vector<STPoint>* lower_points) const {
+  const auto& path_points = path_data_.discretized_path();
   DCHECK_NOTNULL(upper_points);
   DCHECK_NOTNULL(lower_points);
   DCHECK(upper_points->empty());
@@ -281,19 +407,7 @@ bool StBoundaryMapper::GetOverlapBoundaryPoints(
     }
   } else {
     const int default_num_point = 50;
-    DiscretizedPath discretized_path;
-    if (path_points.size() > 2 * default_num_point) {
-      const auto ratio = path_points.size() / default_num_point;
-      std::vector<PathPoint> sampled_path_points;
-      for (size_t i = 0; i < path_points.size(); ++i) {
-        if (i % ratio == 0) {
-          sampled_path_points.push_back(path_points[i]);
-        }
-      }
-      discretized_path = DiscretizedPath(sampled_path_points);
-    } else {
-      discretized_path = DiscretizedPath(path_points);
-    }
+    const DiscretizedPath& discretized_path = sampled_path_;
     for (int i = 0; i < trajectory.trajectory_point_size(); ++i) {
       const auto& trajectory_point = trajectory.trajectory_point(i);
       const Box2d obs_box = obstacle.GetBoundingBox(trajectory_point);
@@ -305,62 +419,56 @@ bool StBoundaryMapper::GetOverlapBoundaryPoints(
       }
 
       const double step_length = vehicle_param_.front_edge_to_center();
-      auto path_len =
-          std::min(FLAGS_max_trajectory_len, discretized_path.Length());
-      for (double path_s = 0.0; path_s < path_len; path_s += step_length) {
-        const auto curr_adc_path_point =
-            discretized_path.Evaluate(path_s + discretized_path.front().s());
-        if (CheckOverlap(curr_adc_path_point, obs_box,
-                         speed_bounds_config_.boundary_buffer())) {
-          // found overlap, start searching with higher resolution
-          const double backward_distance = -step_length;
-          const double forward_distance = vehicle_param_.length() +
-                                          vehicle_param_.width() +
-                                          obs_box.length() + obs_box.width();
-          const double default_min_step = 0.1;  // in meters
-          const double fine_tuning_step_length = std::fmin(
-              default_min_step, discretized_path.Length() / default_num_point);
-
-          bool find_low = false;
-          bool find_high = false;
-          double low_s = std::fmax(0.0, path_s + backward_distance);
-          double high_s =
-              std::fmin(discretized_path.Length(), path_s + forward_distance);
-
-          while (low_s < high_s) {
-            if (find_low && find_high) {
-              break;
-            }
-            if (!find_low) {
-              const auto& point_low = discretized_path.Evaluate(
-                  low_s + discretized_path.front().s());
-              if (!CheckOverlap(point_low, obs_box,
-                                speed_bounds_config_.boundary_buffer())) {
-                low_s += fine_tuning_step_length;
-              } else {
-                find_low = true;
-              }
-            }
-            if (!find_high) {
-              const auto& point_high = discretized_path.Evaluate(
-                  high_s + discretized_path.front().s());
-              if (!CheckOverlap(point_high, obs_box,
-                                speed_bounds_config_.boundary_buffer())) {
-                high_s -= fine_tuning_step_length;
-              } else {
-                find_high = true;
-              }
+      const int sample = FindFirstOverlapSample(obs_box);
+      if (sample >= 0) {
+        const double path_s = sample_path_s_[sample];
+        // found overlap, start searching with higher resolution
+        const double backward_distance = -step_length;
+        const double forward_distance = vehicle_param_.length() +
+                                        vehicle_param_.width() +
+                                        obs_box.length() + obs_box.width();
+        const double default_min_step = 0.1;  // in meters
+        const double fine_tuning_step_length = std::fmin(
+            default_min_step, discretized_path.Length() / default_num_point);
+
+        bool find_low = false;
+        bool find_high = false;
+        double low_s = std::fmax(0.0, path_s + backward_distance);
+        double high_s =
+            std::fmin(discretized_path.Length(), path_s + forward_distance);
+
+        while (low_s < high_s) {
+          if (find_low && find_high) {
+            break;
+          }
+          if (!find_low) {
+            const auto& point_low = discretized_path.Evaluate(
+                low_s + discretized_path.front().s());
+            if (!CheckOverlap(point_low, obs_box,
+                              speed_bounds_config_.boundary_buffer())) {
+              low_s += fine_tuning_step_length;
+            } else {
+              find_low = true;
             }
           }
-          if (find_high && find_low) {
-            lower_points->emplace_back(
-                low_s - speed_bounds_config_.point_extension(),
-                trajectory_point_time);
-            upper_points->emplace_back(
-                high_s + speed_bounds_config_.point_extension(),
-                trajectory_point_time);
+          if (!find_high) {
+            const auto& point_high = discretized_path.Evaluate(
+                high_s + discretized_path.front().s());
+            if (!CheckOverlap(point_high, obs_box,
+                              speed_bounds_config_.boundary_buffer())) {
+              high_s -= fine_tuning_step_length;
+            } else {
+              find_high = true;
+            }
           }
-          break;
+        }
+        if (find_high && find_low) {
+          lower_points->emplace_back(
+              low_s - speed_bounds_config_.point_extension(),
+              trajectory_point_time);
+          upper_points->emplace_back(
+              high_s + speed_bounds_config_.point_extension(),
+              trajectory_point_time);
         }
       }
     }
@@ -379,8 +487,7 @@ Status StBoundaryMapper::MapWithDecision(
   std::vector<STPoint> lower_points;
   std::vector<STPoint> upper_points;
 
-  if (!GetOverlapBoundaryPoints(path_data_.discretized_path(), *obstacle,
-                                &upper_points, &lower_points)) {
+  if (!GetOverlapBoundaryPoints(*obstacle, &upper_points, &lower_points)) {
     return Status::OK();
   }
 
@@ -430,6 +537,11 @@ Status StBoundaryMapper::MapWithDecision(
 bool StBoundaryMapper::CheckOverlap(const PathPoint& path_point,
                                     const Box2d& obs_box,
                                     const double buffer) const {
+  return obs_box.HasOverlap(GetAdcBox(path_point, buffer));
+}
+
+Box2d StBoundaryMapper::GetAdcBox(const PathPoint& path_point,
+                                  const double buffer) const {
   double left_delta_l = 0.0;
   double right_delta_l = 0.0;
   if (is_change_lane_) {
@@ -451,10 +563,8 @@ bool StBoundaryMapper::CheckOverlap(const PathPoint& path_point,
           .rotate(path_point.theta());
   Vec2d center = Vec2d(path_point.x(), path_point.y()) + vec_to_center;
 
-  const Box2d adc_box =
-      Box2d(center, path_point.theta(), vehicle_param_.length() + 2 * buffer,
-            vehicle_param_.width() + 2 * buffer);
-  return obs_box.HasOverlap(adc_box);
+  return Box2d(center, path_point.theta(), vehicle_param_.length() + 2 * buffer,
+               vehicle_param_.width() + 2 * buffer);
 }
 
 }  // namespace planning
@@ -20,13 +20,16 @@
 
 #pragma once
 
+#include <limits>
 #include <string>
 #include <vector>
 
 #include "modules/common/configs/proto/vehicle_config.pb.h"
 #include "modules/planning/proto/speed_bounds_decider_config.pb.h"
 
+#include "modules/common/math/box2d.h"
 #include "modules/common/status/status.h"
+#include "modules/planning/common/path/discretized_path.h"
 #include "modules/planning/common/path/path_data.h"
 #include "modules/planning/common/path_decision.h"
 #include "modules/planning/common/speed/st_boundary.h"
@@ -49,20 +52,46 @@ class StBoundaryMapper {
   apollo::common::Status CreateStBoundary(PathDecision* path_decision) const;
 
  private:
+  friend class StBoundaryMapperTest;
   FRIEND_TEST(StBoundaryMapperTest, check_overlap_test);
+  FRIEND_TEST(StBoundaryMapperTest, footprint_index_test);
+  FRIEND_TEST(StBoundaryMapperTest, footprint_index_buffer_test);
+  FRIEND_TEST(StBoundaryMapperTest, footprint_index_short_path_test);
   bool CheckOverlap(const apollo::common::PathPoint& path_point,
                     const apollo::common::math::Box2d& obs_box,
                     const double buffer) const;
 
+  apollo::common::math::Box2d GetAdcBox(
+      const apollo::common::PathPoint& path_point, const double buffer) const;
+
+  /**
+   * Samples the ADC footprint along the path every front_edge_to_center, and
+   * builds a tree of axis-aligned bounding boxes over ranges of consecutive
+   * samples, so that the first sample overlapping an obstacle box is found
+   * without testing the samples far from it.
+   */
+  void BuildFootprintIndex();
+
+  /**
+   * Finds the first footprint sample, in the order of s, overlapping obs_box.
+   * @return the index of the sample, or -1 if there is none.
+   */
+  int FindFirstOverlapSample(const apollo::common::math::Box2d& obs_box) const;
+
   /**
    * Creates valid st boundary upper_points and lower_points
    * If return true, upper_points.size() > 1 and
    * upper_points.size() = lower_points.size()
    */
-  bool GetOverlapBoundaryPoints(
-      const std::vector<apollo::common::PathPoint>& path_points,
-      const Obstacle& obstacle, std::vector<STPoint>* upper_points,
-      std::vector<STPoint>* lower_points) const;
+  bool GetOverlapBoundaryPoints(const Obstacle& obstacle,
+                                std::vector<STPoint>* upper_points,
+                                std::vector<STPoint>* lower_points) const;
+
+  /**
+   * Maps an obstacle without longitudinal decision, or with a follow, yield
+   * or overtake decision.
+   */
+  apollo::common::Status MapObstacle(Obstacle* obstacle) const;
 
   apollo::common::Status MapWithoutDecision(Obstacle* obstacle) const;
 
@@ -81,6 +110,23 @@ class StBoundaryMapper {
   const double planning_distance_;
   const double planning_time_;
   bool is_change_lane_ = false;
+
+  struct Bounds {
+    double min_x = std::numeric_limits<double>::infinity();
+    double min_y = std::numeric_limits<double>::infinity();
+    double max_x = -std::numeric_limits<double>::infinity();
+    double max_y = -std::numeric_limits<double>::infinity();
+  };
+
+  // the path the moving obstacles are mapped on, downsampled from the
+  // discretized path of path_data_
+  DiscretizedPath sampled_path_;
+  std::vector<double> sample_path_s_;
+  std::vector<apollo::common::math::Box2d> sample_boxes_;
+  // complete binary tree in an array, node k has the children 2k and 2k + 1
+  // and leaf num_leaves_ + i holds the bounds of sample i
+  std::vector<Bounds> sample_tree_;
+  size_t num_leaves_ = 0;
 };
 
 }  // namespace planning
@@ -16,9 +16,12 @@
 
 #include "modules/planning/tasks/deciders/speed_bounds_decider/st_boundary_mapper.h"
 
+#include <vector>
+
 #include "gmock/gmock.h"
 
 #include "cyber/common/log.h"
+#include "modules/common/configs/vehicle_config_helper.h"
 #include "modules/map/hdmap/hdmap_util.h"
 #include "modules/planning/common/obstacle.h"
 #include "modules/planning/reference_line/qp_spline_reference_line_smoother.h"
@@ -74,6 +77,22 @@ class StBoundaryMapperTest : public ::testing::Test {
   hdmap::LaneInfoConstPtr lane_info_ptr = nullptr;
   PathData path_data_;
   FrenetFramePath frenet_frame_path_;
+
+  // the first sample a walk along the path finds overlapping the box, what
+  // FindFirstOverlapSample must find
+  int FindFirstOverlapSampleByWalk(const StBoundaryMapper& mapper,
+                                   const common::math::Box2d& box) const {
+    const auto& sampled_path = mapper.sampled_path_;
+    for (size_t i = 0; i < mapper.sample_path_s_.size(); ++i) {
+      const auto point = sampled_path.Evaluate(mapper.sample_path_s_[i] +
+                                               sampled_path.front().s());
+      if (mapper.CheckOverlap(
+              point, box, mapper.speed_bounds_config_.boundary_buffer())) {
+        return static_cast<int>(i);
+      }
+    }
+    return -1;
+  }
 };
 
 TEST_F(StBoundaryMapperTest, check_overlap_test) {
@@ -90,5 +109,151 @@ TEST_F(StBoundaryMapperTest, check_overlap_test) {
   EXPECT_TRUE(mapper.CheckOverlap(path_point, box, 0.0));
 }
 
+namespace {
+
+// a box of 0.4 x 0.4 at the longitudinal and lateral offsets from the path
+// point
+common::math::Box2d BoxAt(const common::PathPoint& point,
+                          const double forward, const double left) {
+  const common::math::Vec2d heading =
+      common::math::Vec2d::CreateUnitVec2d(point.theta());
+  const common::math::Vec2d center =
+      common::math::Vec2d(point.x(), point.y()) + heading * forward +
+      common::math::Vec2d(-heading.y(), heading.x()) * left;
+  return common::math::Box2d(center, point.theta(), 0.4, 0.4);
+}
+
+}  // namespace
+
+TEST_F(StBoundaryMapperTest, footprint_index_test) {
+  SpeedBoundsDeciderConfig config;
+  SLBoundary adc_sl_boundary;
+  StBoundaryMapper mapper(adc_sl_boundary, config, *reference_line_, path_data_,
+                          70.0, 10.0, false);
+  ASSERT_GT(mapper.sample_boxes_.size(), 2);
+  ASSERT_EQ(mapper.sample_boxes_.size(), mapper.sample_path_s_.size());
+  const auto& vehicle_param = mapper.vehicle_param_;
+  const double buffer = config.boundary_buffer();
+  const auto& sampled_path = mapper.sampled_path_;
+  const auto sample_point = [&](const size_t i) {
+    return sampled_path.Evaluate(mapper.sample_path_s_[i] +
+                                 sampled_path.front().s());
+  };
+  const auto expect_as_walk = [&](const common::math::Box2d& box) {
+    const int expected = FindFirstOverlapSampleByWalk(mapper, box);
+    EXPECT_EQ(mapper.FindFirstOverlapSample(box), expected);
+    return expected;
+  };
+
+  // behind the first sample, only the first one reaches it
+  const auto first_box =
+      BoxAt(sample_point(0), -vehicle_param.back_edge_to_center() + 0.1, 0.0);
+  EXPECT_EQ(expect_as_walk(first_box), 0);
+  EXPECT_FALSE(mapper.CheckOverlap(sample_point(1), first_box, buffer));
+
+  // ahead of the last sample, only the last one reaches it
+  const size_t last = mapper.sample_boxes_.size() - 1;
+  const auto last_box =
+      BoxAt(sample_point(last), vehicle_param.front_edge_to_center() - 0.1,
+            0.0);
+  EXPECT_EQ(expect_as_walk(last_box), static_cast<int>(last));
+  EXPECT_FALSE(mapper.CheckOverlap(sample_point(last - 1), last_box, buffer));
+
+  // just beyond the footprints at both ends
+  expect_as_walk(
+      BoxAt(sample_point(0), -vehicle_param.back_edge_to_center() - 1.0, 0.0));
+  EXPECT_EQ(expect_as_walk(BoxAt(sample_point(last),
+                                 vehicle_param.front_edge_to_center() + 1.0,
+                                 0.0)),
+            -1);
+
+  // boxes along and across the path, on and off the footprints
+  for (size_t i = 0; i < mapper.sample_boxes_.size(); ++i) {
+    for (const double forward : {0.0, 1.0, 2.5}) {
+      for (const double left : {-2.0, -1.3, 0.0, 1.3, 2.0}) {
+        expect_as_walk(BoxAt(sample_point(i), forward, left));
+      }
+    }
+  }
+}
+
+TEST_F(StBoundaryMapperTest, footprint_index_buffer_test) {
+  SpeedBoundsDeciderConfig config;
+  config.set_boundary_buffer(0.5);
+  SpeedBoundsDeciderConfig no_buffer_config;
+  no_buffer_config.set_boundary_buffer(0.0);
+  SLBoundary adc_sl_boundary;
+  StBoundaryMapper mapper(adc_sl_boundary, config, *reference_line_, path_data_,
+                          70.0, 10.0, false);
+  StBoundaryMapper no_buffer_mapper(adc_sl_boundary, no_buffer_config,
+                                    *reference_line_, path_data_, 70.0, 10.0,
+                                    false);
+  ASSERT_GT(mapper.sample_boxes_.size(), 4);
+  ASSERT_EQ(mapper.sample_path_s_, no_buffer_mapper.sample_path_s_);
+
+  // a box 0.3 left of the footprints is only in the buffered ones
+  const auto& sampled_path = mapper.sampled_path_;
+  const auto point = sampled_path.Evaluate(mapper.sample_path_s_[2] +
+                                           sampled_path.front().s());
+  const double left =
+      mapper.vehicle_param_.left_edge_to_center() + 0.3 + 0.2;
+  const auto box = BoxAt(point, 1.0, left);
+  const int expected = FindFirstOverlapSampleByWalk(mapper, box);
+  EXPECT_GE(expected, 0);
+  EXPECT_EQ(mapper.FindFirstOverlapSample(box), expected);
+  EXPECT_EQ(FindFirstOverlapSampleByWalk(no_buffer_mapper, box), -1);
+  EXPECT_EQ(no_buffer_mapper.FindFirstOverlapSample(box), -1);
+}
+
+TEST_F(StBoundaryMapperTest, footprint_index_short_path_test) {
+  SpeedBoundsDeciderConfig config;
+  SLBoundary adc_sl_boundary;
+  const double step_length = common::VehicleConfigHelper::GetConfig()
+                                 .vehicle_param()
+                                 .front_edge_to_center();
+
+  // a path shorter than one sample step has a single sample, at its start
+  std::vector<common::FrenetFramePoint> ff_points;
+  for (int i = 0; i < 3; ++i) {
+    common::FrenetFramePoint ff_point;
+    ff_point.set_s(i * step_length / 4.0);
+    ff_point.set_l(0.1);
+    ff_points.push_back(std::move(ff_point));
+  }
+  PathData path_data;
+  path_data.SetReferenceLine(reference_line_.get());
+  ASSERT_TRUE(path_data.SetFrenetPath(FrenetFramePath(ff_points)));
+  StBoundaryMapper mapper(adc_sl_boundary, config, *reference_line_, path_data,
+                          70.0, 10.0, false);
+  ASSERT_EQ(mapper.sample_boxes_.size(), 1);
+  EXPECT_EQ(mapper.sample_path_s_.front(), 0.0);
+
+  const auto& sampled_path = mapper.sampled_path_;
+  const auto start_point = sampled_path.Evaluate(sampled_path.front().s());
+  const auto end_point = sampled_path.Evaluate(sampled_path.back().s());
+  for (const auto& box :
+       {BoxAt(start_point, 0.0, 0.0), BoxAt(end_point, 0.0, 0.0),
+        BoxAt(end_point, step_length, 0.0),
+        BoxAt(end_point, step_length + 1.0, 0.0)}) {
+    EXPECT_EQ(mapper.FindFirstOverlapSample(box),
+              FindFirstOverlapSampleByWalk(mapper, box));
+  }
+  EXPECT_EQ(mapper.FindFirstOverlapSample(BoxAt(end_point, 0.0, 0.0)), 0);
+  EXPECT_EQ(
+      mapper.FindFirstOverlapSample(BoxAt(end_point, step_length + 1.0, 0.0)),
+      -1);
+
+  // a path of a single point has no sample
+  PathData point_path_data;
+  point_path_data.SetReferenceLine(reference_line_.get());
+  ASSERT_TRUE(point_path_data.SetFrenetPath(
+      FrenetFramePath(std::vector<common::FrenetFramePoint>(1, ff_points[0]))));
+  StBoundaryMapper point_mapper(adc_sl_boundary, config, *reference_line_,
+                                point_path_data, 70.0, 10.0, false);
+  EXPECT_TRUE(point_mapper.sample_boxes_.empty());
+  EXPECT_EQ(point_mapper.FindFirstOverlapSample(BoxAt(start_point, 0.0, 0.0)),
+            -1);
+}
+
 }  // namespace planning
 }  // namespace apollo
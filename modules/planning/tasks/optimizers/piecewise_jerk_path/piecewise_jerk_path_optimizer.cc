@@ -22,6 +22,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -57,6 +58,24 @@ common::Status PiecewiseJerkPathOptimizer::Process(
       reference_line_info_->GetCandidatePathBoundaries();
   ADEBUG << "There are " << path_boundaries.size() << " path boundaries.";
 
+  // drop the problems of this reference line without a path boundary in this
+  // cycle, and those of the reference lines not planned in the last cycle
+  const std::string& line_id = reference_line_info_->Lanes().Id();
+  const uint32_t sequence_num = frame_->SequenceNum();
+  std::unordered_set<std::string> labels;
+  for (const auto& path_boundary : path_boundaries) {
+    labels.insert(path_boundary.label());
+  }
+  for (auto iter = path_problems_.begin(); iter != path_problems_.end();) {
+    if ((iter->first.first == line_id &&
+         labels.count(iter->first.second) == 0) ||
+        iter->second.sequence_num + 1 < sequence_num) {
+      iter = path_problems_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+
   std::vector<PathData> candidate_path_data;
   for (const auto& path_boundary : path_boundaries) {
     // if the path_boundary is normal, it is possible to have less than 2 points
@@ -74,12 +93,43 @@ common::Status PiecewiseJerkPathOptimizer::Process(
 
     CHECK_GT(path_boundary.boundary().size(), 1);
 
+    auto& path_problem =
+        path_problems_[std::make_pair(line_id, path_boundary.label())];
+    if (path_problem.fem_1d_qp == nullptr) {
+      path_problem.fem_1d_qp.reset(new Fem1dQpProblem());
+    } else if (path_problem.delta_s == path_boundary.delta_s()) {
+      // the reference line is rebuilt every cycle, so the last start is
+      // projected onto it to move the last solution to the current start
+      common::SLPoint last_start;
+      if (reference_line.XYToSL(path_problem.start_point, &last_start) &&
+          path_boundary.start_s() > last_start.s()) {
+        path_problem.fem_1d_qp->ShiftWarmStart(static_cast<size_t>(
+            (path_boundary.start_s() - last_start.s()) /
+                path_boundary.delta_s() +
+            0.5));
+      }
+    }
+    const auto start_point =
+        reference_line.GetReferencePoint(path_boundary.start_s());
+    path_problem.start_point.set_x(start_point.x());
+    path_problem.start_point.set_y(start_point.y());
+    path_problem.delta_s = path_boundary.delta_s();
+    path_problem.sequence_num = sequence_num;
+
     std::vector<double> opt_l;
     std::vector<double> opt_dl;
     std::vector<double> opt_ddl;
-    bool res_opt = OptimizePath(init_frenet_state, path_boundary.delta_s(),
-                                path_boundary.boundary(), w, &opt_l, &opt_dl,
-                                &opt_ddl, max_iter);
+    bool res_opt = OptimizePath(
+        init_frenet_state, path_boundary.delta_s(),
+        path_problem.fem_1d_qp.get(), path_boundary.boundary(), w, &opt_l,
+        &opt_dl, &opt_ddl, max_iter);
+    if (!res_opt && path_problem.fem_1d_qp->is_warm_started()) {
+      // the failed solve dropped the workspace, so this one starts cold
+      res_opt = OptimizePath(init_frenet_state, path_boundary.delta_s(),
+                             path_problem.fem_1d_qp.get(),
+                             path_boundary.boundary(), w, &opt_l, &opt_dl,
+                             &opt_ddl, max_iter);
+    }
 
     if (res_opt) {
       auto frenet_frame_path =
@@ -107,11 +157,10 @@ common::Status PiecewiseJerkPathOptimizer::Process(
 bool PiecewiseJerkPathOptimizer::OptimizePath(
     const std::pair<const std::array<double, 3>, const std::array<double, 3>>&
         init_state,
-    const double delta_s,
+    const double delta_s, Fem1dQpProblem* fem_1d_qp,
     const std::vector<std::pair<double, double>>& lat_boundaries,
     const std::array<double, 5>& w, std::vector<double>* x,
     std::vector<double>* dx, std::vector<double>* ddx, const int max_iter) {
-  std::unique_ptr<Fem1dQpProblem> fem_1d_qp(new Fem1dQpProblem());
   fem_1d_qp->InitProblem(lat_boundaries.size(), delta_s, w,
                          FLAGS_lateral_jerk_bound, init_state.second);
 
@@ -136,7 +185,10 @@ bool PiecewiseJerkPathOptimizer::OptimizePath(
 
   auto end_time = std::chrono::system_clock::now();
   std::chrono::duration<double> diff = end_time - start_time;
-  ADEBUG << "Path Optimizer used time: " << diff.count() * 1000 << " ms.";
+  ADEBUG << "Path Optimizer used time: " << diff.count() * 1000 << " ms, "
+         << "qp solved in " << fem_1d_qp->solve_time_ms() << " ms with "
+         << fem_1d_qp->num_of_iterations() << " iterations, "
+         << (fem_1d_qp->is_warm_started() ? "warm" : "cold") << " start.";
 
   if (!success) {
     AERROR << "piecewise jerk path optimizer failed";
@@ -20,9 +20,14 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "modules/common/math/vec2d.h"
+#include "modules/planning/math/piecewise_jerk/fem_1d_qp_problem.h"
 #include "modules/planning/tasks/optimizers/path_optimizer.h"
 
 namespace apollo {
@@ -43,7 +48,7 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
   bool OptimizePath(
       const std::pair<const std::array<double, 3>, const std::array<double, 3>>&
           init_state,
-      const double delta_s,
+      const double delta_s, Fem1dQpProblem* fem_1d_qp,
       const std::vector<std::pair<double, double>>& lat_boundaries,
       const std::array<double, 5>& w, std::vector<double>* ptr_x,
       std::vector<double>* ptr_dx, std::vector<double>* ptr_ddx,
@@ -58,6 +63,20 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
   double AdjustLateralDerivativeBounds(const double s_dot, const double dl,
                                        const double ddl,
                                        const double l_dot_bounds) const;
+
+ private:
+  // the problem of a path boundary is kept across cycles, so that its solver
+  // starts from the solution of the last cycle. One optimizer serves all the
+  // reference lines, so the problems are keyed by the id of the route
+  // segments of the reference line and the path boundary label.
+  struct PathProblem {
+    std::unique_ptr<Fem1dQpProblem> fem_1d_qp;
+    // the point of the reference line at the first knot of the last solution
+    common::math::Vec2d start_point;
+    double delta_s = 0.0;
+    uint32_t sequence_num = 0;
+  };
+  std::map<std::pair<std::string, std::string>, PathProblem> path_problems_;
 };
 
 }  // namespace planning
@@ -35,6 +35,8 @@ using apollo::hdmap::MapPathPoint;
 using apollo::hdmap::OverlapInfo;
 using apollo::hdmap::PNCJunctionInfo;
 
+thread_local PredictionMap::PrefetchedLanes PredictionMap::prefetched_lanes_;
+
 bool PredictionMap::Ready() { return HDMapUtil::BaseMapPtr() != nullptr; }
 
 Eigen::Vector2d PredictionMap::PositionOnLane(
@@ -156,7 +158,9 @@ void PredictionMap::OnLane(
   common::PointENU hdmap_point;
   hdmap_point.set_x(point.x());
   hdmap_point.set_y(point.y());
-  if (HDMapUtil::BaseMap().GetLanesWithHeading(hdmap_point, radius, heading,
+  if (!GetPrefetchedLanesWithHeading(point, radius, heading,
+                                     max_lane_angle_diff, &candidate_lanes) &&
+      HDMapUtil::BaseMap().GetLanesWithHeading(hdmap_point, radius, heading,
                                                max_lane_angle_diff,
                                                &candidate_lanes) != 0) {
     return;
@@ -663,5 +667,49 @@ std::vector<std::shared_ptr<const LaneInfo>> PredictionMap::GetNearbyLanes(
   return nearby_lanes;
 }
 
+void PredictionMap::PrefetchLanes(const std::vector<Eigen::Vector2d>& points,
+                                  const double radius) {
+  ClearPrefetchedLanes();
+  std::vector<common::PointENU> hdmap_points(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    hdmap_points[i].set_x(points[i].x());
+    hdmap_points[i].set_y(points[i].y());
+  }
+  std::vector<std::vector<std::shared_ptr<const LaneInfo>>> lanes;
+  if (HDMapUtil::BaseMap().GetLanes(hdmap_points, radius, &lanes) != 0) {
+    return;
+  }
+  prefetched_lanes_.radius = radius;
+  for (size_t i = 0; i < points.size(); ++i) {
+    prefetched_lanes_.lanes[{points[i].x(), points[i].y()}] =
+        std::move(lanes[i]);
+  }
+}
+
+void PredictionMap::ClearPrefetchedLanes() {
+  prefetched_lanes_.radius = 0.0;
+  prefetched_lanes_.lanes.clear();
+}
+
+bool PredictionMap::GetPrefetchedLanesWithHeading(
+    const Eigen::Vector2d& point, const double radius, const double heading,
+    const double max_lane_angle_diff,
+    std::vector<std::shared_ptr<const LaneInfo>>* lanes) {
+  if (radius > prefetched_lanes_.radius) {
+    return false;
+  }
+  const auto iter = prefetched_lanes_.lanes.find({point.x(), point.y()});
+  if (iter == prefetched_lanes_.lanes.end()) {
+    return false;
+  }
+  common::PointENU hdmap_point;
+  hdmap_point.set_x(point.x());
+  hdmap_point.set_y(point.y());
+  hdmap::HDMap::SelectLanesWithHeading(hdmap_point, radius, heading,
+                                       max_lane_angle_diff, iter->second,
+                                       lanes);
+  return true;
+}
+
 }  // namespace prediction
 }  // namespace apollo
@@ -16,8 +16,10 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "modules/map/pnc_map/path.h"
@@ -403,7 +405,30 @@ class PredictionMap {
   static std::vector<std::shared_ptr<const hdmap::LaneInfo>> GetNearbyLanes(
       const common::PointENU& position, const double nearby_radius);
 
+  /**
+   * @brief Search the lanes around many points in one batch, the following
+   *        searches of OnLane on the same thread at exactly one of the points
+   *        within the radius reuse the result until ClearPrefetchedLanes.
+   *        Each thread has its own prefetched lanes.
+   * @param points The points to search around
+   * @param radius The searching radius
+   */
+  static void PrefetchLanes(const std::vector<Eigen::Vector2d>& points,
+                            const double radius);
+
+  /**
+   * @brief Drop the lanes searched by PrefetchLanes on the thread
+   */
+  static void ClearPrefetchedLanes();
+
  private:
+  // the same lanes as HDMap::GetLanesWithHeading, false if not prefetched on
+  // the thread
+  static bool GetPrefetchedLanesWithHeading(
+      const Eigen::Vector2d& point, const double radius, const double heading,
+      const double max_lane_angle_diff,
+      std::vector<std::shared_ptr<const hdmap::LaneInfo>>* lanes);
+
   static std::shared_ptr<const hdmap::LaneInfo> GetNeighborLane(
       const std::shared_ptr<const hdmap::LaneInfo>& ptr_ego_lane,
       const Eigen::Vector2d& ego_position,
@@ -411,6 +436,17 @@ class PredictionMap {
       const double threshold);
 
   PredictionMap() = delete;
+
+ private:
+  struct PrefetchedLanes {
+    double radius = 0.0;
+    std::map<std::pair<double, double>,
+             std::vector<std::shared_ptr<const hdmap::LaneInfo>>>
+        lanes;
+  };
+  // the lanes are prefetched and queried by the thread inserting the
+  // obstacles, while the other threads query the map directly
+  static thread_local PrefetchedLanes prefetched_lanes_;
 };
 
 }  // namespace prediction
@@ -16,11 +16,13 @@
 
 #include "modules/prediction/container/obstacles/obstacles_container.h"
 
+#include <algorithm>
 #include <unordered_set>
 #include <utility>
 
 #include "modules/prediction/common/feature_output.h"
 #include "modules/prediction/common/junction_analyzer.h"
+#include "modules/prediction/common/prediction_map.h"
 #include "modules/prediction/common/prediction_gflags.h"
 #include "modules/prediction/common/prediction_system_gflags.h"
 #include "modules/prediction/container/obstacles/obstacle_clusters.h"
@@ -117,7 +119,10 @@ void ObstaclesContainer::Insert(const ::google::protobuf::Message& message) {
   // 1. Initialize ObstacleClusters
   ObstacleClusters::Init();
 
-  // 2. Insert the Obstacles one by one
+  // 2. Search the lanes of the Obstacles in one batch
+  PrefetchLanes(perception_obstacles);
+
+  // 3. Insert the Obstacles one by one
   for (const PerceptionObstacle& perception_obstacle :
        perception_obstacles.perception_obstacle()) {
     ADEBUG << "Perception obstacle [" << perception_obstacle.id() << "] "
@@ -126,10 +131,29 @@ void ObstaclesContainer::Insert(const ::google::protobuf::Message& message) {
     ADEBUG << "Perception obstacle [" << perception_obstacle.id() << "] "
            << "was inserted";
   }
-  // 3. Sort the Obstacles
+  PredictionMap::ClearPrefetchedLanes();
+
+  // 4. Sort the Obstacles
   ObstacleClusters::SortObstacles();
 }
 
+void ObstaclesContainer::PrefetchLanes(
+    const PerceptionObstacles& perception_obstacles) {
+  std::vector<Eigen::Vector2d> points;
+  for (const PerceptionObstacle& perception_obstacle :
+       perception_obstacles.perception_obstacle()) {
+    if (perception_obstacle.type() == PerceptionObstacle::PEDESTRIAN ||
+        !IsMovable(perception_obstacle)) {
+      continue;
+    }
+    points.emplace_back(perception_obstacle.position().x(),
+                        perception_obstacle.position().y());
+  }
+  PredictionMap::PrefetchLanes(
+      points,
+      std::max(FLAGS_lane_search_radius, FLAGS_lane_search_radius_in_junction));
+}
+
 Obstacle* ObstaclesContainer::GetObstacle(const int id) {
   auto ptr_obstacle = ptr_obstacles_.GetSilently(id);
   if (ptr_obstacle != nullptr) {
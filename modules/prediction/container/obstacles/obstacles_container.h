@@ -150,6 +150,14 @@ class ObstaclesContainer : public Container {
 
   int PerceptionIdToPredictionId(const int perception_id);
 
+  /**
+   * @brief Search the lanes of the movable non-pedestrian obstacles in one
+   *        batch for their insertion
+   * @param The PerceptionObstacles of the frame
+   */
+  void PrefetchLanes(
+      const perception::PerceptionObstacles& perception_obstacles);
+
  private:
   double timestamp_ = -1.0;
   common::util::LRUCache<int, std::unique_ptr<Obstacle>> ptr_obstacles_;
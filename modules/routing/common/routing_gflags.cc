@@ -30,5 +30,16 @@ DEFINE_double(min_length_for_lane_change, 1.0,
 DEFINE_bool(enable_change_lane_in_result, true,
             "contain change lane operator in result");
 
+DEFINE_bool(enable_landmarks_in_routing, true,
+            "search the shortest route with the landmarks of the topo graph "
+            "as the A* heuristic, if the graph has landmarks");
+
+DEFINE_bool(enable_multi_thread_in_topo_creation, true,
+            "create the nodes and edges of the topo graph in parallel");
+
+DEFINE_bool(enable_incremental_topo_creation, false,
+            "reuse the nodes and edges of the unchanged lanes from the topo "
+            "graph created before, if it exists");
+
 DEFINE_uint32(routing_response_history_interval_ms, 1000,
               "ms, emit routing resposne for this time interval");
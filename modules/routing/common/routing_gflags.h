@@ -23,4 +23,7 @@ DECLARE_string(routing_node_name);
 
 DECLARE_double(min_length_for_lane_change);
 DECLARE_bool(enable_change_lane_in_result);
+DECLARE_bool(enable_landmarks_in_routing);
+DECLARE_bool(enable_multi_thread_in_topo_creation);
+DECLARE_bool(enable_incremental_topo_creation);
 DECLARE_uint32(routing_response_history_interval_ms);
@@ -16,6 +16,8 @@
 
 #include "modules/routing/graph/topo_graph.h"
 
+#include <algorithm>
+#include <limits>
 #include <utility>
 
 namespace apollo {
@@ -25,6 +27,9 @@ void TopoGraph::Clear() {
   topo_nodes_.clear();
   topo_edges_.clear();
   node_index_map_.clear();
+  num_landmarks_ = 0;
+  costs_from_landmarks_.clear();
+  costs_to_landmarks_.clear();
 }
 
 bool TopoGraph::LoadNodes(const Graph& graph) {
@@ -36,6 +41,7 @@ bool TopoGraph::LoadNodes(const Graph& graph) {
     node_index_map_[node.lane_id()] = static_cast<int>(topo_nodes_.size());
     std::shared_ptr<TopoNode> topo_node;
     topo_node.reset(new TopoNode(node));
+    topo_node->SetIndex(static_cast<int>(topo_nodes_.size()));
     road_node_map_[node.road_id()].insert(topo_node.get());
     topo_nodes_.push_back(std::move(topo_node));
   }
@@ -66,6 +72,31 @@ bool TopoGraph::LoadEdges(const Graph& graph) {
   return true;
 }
 
+bool TopoGraph::LoadLandmarks(const Graph& graph) {
+  const int num_nodes = graph.node_size();
+  for (const auto& landmark : graph.landmark()) {
+    if (landmark.cost_from_landmark_size() != num_nodes ||
+        landmark.cost_to_landmark_size() != num_nodes) {
+      AERROR << "The costs of landmark " << landmark.lane_id()
+             << " do not match the nodes of the graph.";
+      return false;
+    }
+  }
+  num_landmarks_ = graph.landmark_size();
+  costs_from_landmarks_.resize(num_nodes * num_landmarks_);
+  costs_to_landmarks_.resize(num_nodes * num_landmarks_);
+  for (int k = 0; k < num_landmarks_; ++k) {
+    const auto& landmark = graph.landmark(k);
+    for (int i = 0; i < num_nodes; ++i) {
+      costs_from_landmarks_[i * num_landmarks_ + k] =
+          landmark.cost_from_landmark(i);
+      costs_to_landmarks_[i * num_landmarks_ + k] =
+          landmark.cost_to_landmark(i);
+    }
+  }
+  return true;
+}
+
 bool TopoGraph::LoadGraph(const Graph& graph) {
   Clear();
 
@@ -80,6 +111,11 @@ bool TopoGraph::LoadGraph(const Graph& graph) {
     AERROR << "Failed to load edges from topology graph.";
     return false;
   }
+  if (!LoadLandmarks(graph)) {
+    AWARN << "Failed to load landmarks from topology graph, search without "
+             "them.";
+    num_landmarks_ = 0;
+  }
   AINFO << "Load Topo data succesful.";
   return true;
 }
@@ -105,5 +141,44 @@ void TopoGraph::GetNodesByRoadId(
   }
 }
 
+int TopoGraph::NumNodes() const { return static_cast<int>(topo_nodes_.size()); }
+
+bool TopoGraph::HasLandmarks() const { return num_landmarks_ > 0; }
+
+double TopoGraph::GetLandmarkCostLowerBound(const TopoNode* from_node,
+                                            const TopoNode* to_node) const {
+  const int from_index = from_node->OriginNode()->Index();
+  const int to_index = to_node->OriginNode()->Index();
+  if (num_landmarks_ == 0 || from_index < 0 || to_index < 0) {
+    return 0.0;
+  }
+  const double* from_costs_from =
+      &costs_from_landmarks_[from_index * num_landmarks_];
+  const double* from_costs_to =
+      &costs_to_landmarks_[from_index * num_landmarks_];
+  const double* to_costs_from =
+      &costs_from_landmarks_[to_index * num_landmarks_];
+  const double* to_costs_to = &costs_to_landmarks_[to_index * num_landmarks_];
+  double lower_bound = 0.0;
+  for (int k = 0; k < num_landmarks_; ++k) {
+    // cost(from, to) >= cost(from, landmark) - cost(to, landmark)
+    if (to_costs_to[k] >= 0.0) {
+      if (from_costs_to[k] < 0.0) {
+        return std::numeric_limits<double>::infinity();
+      }
+      lower_bound = std::max(lower_bound, from_costs_to[k] - to_costs_to[k]);
+    }
+    // cost(from, to) >= cost(landmark, to) - cost(landmark, from)
+    if (from_costs_from[k] >= 0.0) {
+      if (to_costs_from[k] < 0.0) {
+        return std::numeric_limits<double>::infinity();
+      }
+      lower_bound =
+          std::max(lower_bound, to_costs_from[k] - from_costs_from[k]);
+    }
+  }
+  return lower_bound;
+}
+
 }  // namespace routing
 }  // namespace apollo
@@ -41,11 +41,21 @@ class TopoGraph {
   void GetNodesByRoadId(
       const std::string& road_id,
       std::unordered_set<const TopoNode*>* const node_in_road) const;
+  int NumNodes() const;
+
+  bool HasLandmarks() const;
+  // A lower bound of the search cost from from_node to to_node, of their
+  // origin nodes, by the triangle inequality with the costs from and to the
+  // landmarks. It is infinity if to_node is not reachable from from_node, and
+  // 0 without landmarks.
+  double GetLandmarkCostLowerBound(const TopoNode* from_node,
+                                   const TopoNode* to_node) const;
 
  private:
   void Clear();
   bool LoadNodes(const Graph& graph);
   bool LoadEdges(const Graph& graph);
+  bool LoadLandmarks(const Graph& graph);
 
  private:
   std::string map_version_;
@@ -55,6 +65,12 @@ class TopoGraph {
   std::unordered_map<std::string, int> node_index_map_;
   std::unordered_map<std::string, std::unordered_set<const TopoNode*> >
       road_node_map_;
+
+  // the costs of the landmarks in the order of [node][landmark], negative if
+  // unreachable
+  int num_landmarks_ = 0;
+  std::vector<double> costs_from_landmarks_;
+  std::vector<double> costs_to_landmarks_;
 };
 
 }  // namespace routing
@@ -234,6 +234,10 @@ double TopoNode::EndS() const { return end_s_; }
 
 bool TopoNode::IsSubNode() const { return OriginNode() != this; }
 
+int TopoNode::Index() const { return index_; }
+
+void TopoNode::SetIndex(const int index) { index_ = index; }
+
 bool TopoNode::IsOverlapEnough(const TopoNode* sub_node,
                                const TopoEdge* edge_for_type) const {
   if (edge_for_type->Type() == TET_LEFT) {
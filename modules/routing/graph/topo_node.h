@@ -70,6 +70,9 @@ class TopoNode {
   double StartS() const;
   double EndS() const;
   bool IsSubNode() const;
+  // the index of the node in the topo graph, -1 for a sub node
+  int Index() const;
+  void SetIndex(const int index);
   bool IsInFromPreEdgeValid() const;
   bool IsOutToSucEdgeValid() const;
   bool IsOverlapEnough(const TopoNode* sub_node,
@@ -110,6 +113,7 @@ class TopoNode {
   std::unordered_map<const TopoNode*, const TopoEdge*> in_edge_map_;
 
   const TopoNode* origin_node_;
+  int index_ = -1;
 };
 
 enum TopoEdgeType {
@@ -15,8 +15,10 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <queue>
+#include <utility>
 
 #include "modules/routing/common/routing_gflags.h"
 #include "modules/routing/graph/sub_topo_graph.h"
@@ -174,18 +176,8 @@ bool AdjustLaneChange(std::vector<const TopoNode*>* const result_node_vec) {
   return true;
 }
 
-bool Reconstruct(
-    const std::unordered_map<const TopoNode*, const TopoNode*>& came_from,
-    const TopoNode* dest_node, std::vector<NodeWithRange>* result_nodes) {
-  std::vector<const TopoNode*> result_node_vec;
-  result_node_vec.push_back(dest_node);
-
-  auto iter = came_from.find(dest_node);
-  while (iter != came_from.end()) {
-    result_node_vec.push_back(iter->second);
-    iter = came_from.find(iter->second);
-  }
-  std::reverse(result_node_vec.begin(), result_node_vec.end());
+bool Reconstruct(std::vector<const TopoNode*> result_node_vec,
+                 std::vector<NodeWithRange>* result_nodes) {
   if (!AdjustLaneChange(&result_node_vec)) {
     AERROR << "Failed to adjust lane change";
     return false;
@@ -203,16 +195,43 @@ bool Reconstruct(
 AStarStrategy::AStarStrategy(bool enable_change)
     : change_lane_enabled_(enable_change) {}
 
-void AStarStrategy::Clear() {
-  closed_set_.clear();
-  open_set_.clear();
-  came_from_.clear();
-  enter_s_.clear();
-  g_score_.clear();
+void AStarStrategy::Clear(const TopoGraph* graph) {
+  graph_ = graph;
+  use_landmarks_ = FLAGS_enable_landmarks_in_routing && graph->HasLandmarks();
+  sub_node_indices_.clear();
+  const size_t num_nodes = graph->NumNodes();
+  open_set_.assign(num_nodes, false);
+  closed_set_.assign(num_nodes, false);
+  came_from_.assign(num_nodes, nullptr);
+  g_score_.assign(num_nodes, 0.0);
+  enter_s_.assign(num_nodes, 0.0);
+  has_enter_s_.assign(num_nodes, false);
+}
+
+int AStarStrategy::GetIndex(const TopoNode* node) {
+  if (!node->IsSubNode()) {
+    return node->Index();
+  }
+  const auto iter = sub_node_indices_.find(node);
+  if (iter != sub_node_indices_.end()) {
+    return iter->second;
+  }
+  const int index = static_cast<int>(g_score_.size());
+  sub_node_indices_.emplace(node, index);
+  open_set_.push_back(false);
+  closed_set_.push_back(false);
+  came_from_.push_back(nullptr);
+  g_score_.push_back(0.0);
+  enter_s_.push_back(0.0);
+  has_enter_s_.push_back(false);
+  return index;
 }
 
 double AStarStrategy::HeuristicCost(const TopoNode* src_node,
                                     const TopoNode* dest_node) {
+  if (use_landmarks_) {
+    return graph_->GetLandmarkCostLowerBound(src_node, dest_node);
+  }
   const auto& src_point = src_node->AnchorPoint();
   const auto& dest_point = dest_node->AnchorPoint();
   double distance = fabs(src_point.x() - dest_point.x()) +
@@ -224,8 +243,9 @@ bool AStarStrategy::Search(const TopoGraph* graph,
                            const SubTopoGraph* sub_graph,
                            const TopoNode* src_node, const TopoNode* dest_node,
                            std::vector<NodeWithRange>* const result_nodes) {
-  Clear();
-  AINFO << "Start A* search algorithm.";
+  Clear(graph);
+  AINFO << "Start A* search algorithm"
+        << (use_landmarks_ ? " with landmarks." : ".");
 
   std::priority_queue<SearchNode> open_set_detail;
 
@@ -233,9 +253,11 @@ bool AStarStrategy::Search(const TopoGraph* graph,
   src_search_node.f = HeuristicCost(src_node, dest_node);
   open_set_detail.push(src_search_node);
 
-  open_set_.insert(src_node);
-  g_score_[src_node] = 0.0;
-  enter_s_[src_node] = src_node->StartS();
+  const int src_index = GetIndex(src_node);
+  open_set_[src_index] = true;
+  g_score_[src_index] = 0.0;
+  enter_s_[src_index] = src_node->StartS();
+  has_enter_s_[src_index] = true;
 
   SearchNode current_node;
   std::unordered_set<const TopoEdge*> next_edge_set;
@@ -243,21 +265,28 @@ bool AStarStrategy::Search(const TopoGraph* graph,
   while (!open_set_detail.empty()) {
     current_node = open_set_detail.top();
     const auto* from_node = current_node.topo_node;
+    const int from_index = GetIndex(from_node);
     if (current_node.topo_node == dest_node) {
-      if (!Reconstruct(came_from_, from_node, result_nodes)) {
+      std::vector<const TopoNode*> result_node_vec;
+      for (const auto* node = from_node; node != nullptr;
+           node = came_from_[GetIndex(node)]) {
+        result_node_vec.push_back(node);
+      }
+      std::reverse(result_node_vec.begin(), result_node_vec.end());
+      if (!Reconstruct(std::move(result_node_vec), result_nodes)) {
         AERROR << "Failed to reconstruct route.";
         return false;
       }
       return true;
     }
-    open_set_.erase(from_node);
+    open_set_[from_index] = false;
     open_set_detail.pop();
 
-    if (closed_set_.count(from_node) != 0) {
+    if (closed_set_[from_index]) {
       // if showed before, just skip...
       continue;
     }
-    closed_set_.emplace(from_node);
+    closed_set_[from_index] = true;
 
     // if residual_s is less than FLAGS_min_length_for_lane_change, only move
     // forward
@@ -276,29 +305,37 @@ bool AStarStrategy::Search(const TopoGraph* graph,
 
     for (const auto* edge : next_edge_set) {
       const auto* to_node = edge->ToNode();
-      if (closed_set_.count(to_node) == 1) {
+      const int to_index = GetIndex(to_node);
+      if (closed_set_[to_index]) {
         continue;
       }
       if (GetResidualS(edge, to_node) < FLAGS_min_length_for_lane_change) {
         continue;
       }
-      tentative_g_score =
-          g_score_[current_node.topo_node] + GetCostToNeighbor(edge);
+      tentative_g_score = g_score_[from_index] + GetCostToNeighbor(edge);
       if (edge->Type() != TopoEdgeType::TET_FORWARD) {
         tentative_g_score -=
             (edge->FromNode()->Cost() + edge->ToNode()->Cost()) / 2;
       }
-      double f = tentative_g_score + HeuristicCost(to_node, dest_node);
-      if (open_set_.count(to_node) != 0 && f >= g_score_[to_node]) {
+      const double h = HeuristicCost(to_node, dest_node);
+      if (std::isinf(h)) {
+        // the destination is not reachable from to_node
+        continue;
+      }
+      double f = tentative_g_score + h;
+      // the g score is the cost from the source with landmarks, which are a
+      // lower bound of the cost to the destination, and is f otherwise
+      const double g = use_landmarks_ ? tentative_g_score : f;
+      if (open_set_[to_index] && g >= g_score_[to_index]) {
         continue;
       }
       // if to_node is reached by forward, reset enter_s to start_s
       if (edge->Type() == TopoEdgeType::TET_FORWARD) {
-        enter_s_[to_node] = to_node->StartS();
+        enter_s_[to_index] = to_node->StartS();
       } else {
         // else, add enter_s with FLAGS_min_length_for_lane_change
         double to_node_enter_s =
-            (enter_s_[from_node] + FLAGS_min_length_for_lane_change) /
+            (enter_s_[from_index] + FLAGS_min_length_for_lane_change) /
             from_node->Length() * to_node->Length();
         // enter s could be larger than end_s but should be less than length
         to_node_enter_s = std::min(to_node_enter_s, to_node->Length());
@@ -306,17 +343,16 @@ bool AStarStrategy::Search(const TopoGraph* graph,
         if (to_node_enter_s > to_node->EndS() && to_node == dest_node) {
           continue;
         }
-        enter_s_[to_node] = to_node_enter_s;
+        enter_s_[to_index] = to_node_enter_s;
       }
+      has_enter_s_[to_index] = true;
 
-      g_score_[to_node] = f;
+      g_score_[to_index] = g;
       SearchNode next_node(to_node);
       next_node.f = f;
       open_set_detail.push(next_node);
-      came_from_[to_node] = from_node;
-      if (open_set_.count(to_node) == 0) {
-        open_set_.insert(to_node);
-      }
+      came_from_[to_index] = from_node;
+      open_set_[to_index] = true;
     }
   }
   AERROR << "Failed to find goal lane with id: " << dest_node->LaneId();
@@ -325,12 +361,12 @@ bool AStarStrategy::Search(const TopoGraph* graph,
 
 double AStarStrategy::GetResidualS(const TopoNode* node) {
   double start_s = node->StartS();
-  const auto iter = enter_s_.find(node);
-  if (iter != enter_s_.end()) {
-    if (iter->second > node->EndS()) {
+  const int index = GetIndex(node);
+  if (has_enter_s_[index]) {
+    if (enter_s_[index] > node->EndS()) {
       return 0.0;
     }
-    start_s = iter->second;
+    start_s = enter_s_[index];
   } else {
     AWARN << "lane " << node->LaneId() << "(" << node->StartS() << ", "
           << node->EndS() << "not found in enter_s map";
@@ -356,9 +392,10 @@ double AStarStrategy::GetResidualS(const TopoEdge* edge,
   }
   double start_s = to_node->StartS();
   const auto* from_node = edge->FromNode();
-  const auto iter = enter_s_.find(from_node);
-  if (iter != enter_s_.end()) {
-    double temp_s = iter->second / from_node->Length() * to_node->Length();
+  const int from_index = GetIndex(from_node);
+  if (has_enter_s_[from_index]) {
+    double temp_s =
+        enter_s_[from_index] / from_node->Length() * to_node->Length();
     start_s = std::max(start_s, temp_s);
   } else {
     AWARN << "lane " << from_node->LaneId() << "(" << from_node->StartS()
@@ -17,7 +17,6 @@
 #pragma once
 
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 #include "modules/routing/strategy/strategy.h"
@@ -35,18 +34,26 @@ class AStarStrategy : public Strategy {
                       std::vector<NodeWithRange>* const result_nodes);
 
  private:
-  void Clear();
+  void Clear(const TopoGraph* graph);
+  // the index of the node in the search states, the index in the graph for a
+  // node of the graph, and after the nodes of the graph for a sub node
+  int GetIndex(const TopoNode* node);
   double HeuristicCost(const TopoNode* src_node, const TopoNode* dest_node);
   double GetResidualS(const TopoNode* node);
   double GetResidualS(const TopoEdge* edge, const TopoNode* to_node);
 
  private:
   bool change_lane_enabled_;
-  std::unordered_set<const TopoNode*> open_set_;
-  std::unordered_set<const TopoNode*> closed_set_;
-  std::unordered_map<const TopoNode*, const TopoNode*> came_from_;
-  std::unordered_map<const TopoNode*, double> g_score_;
-  std::unordered_map<const TopoNode*, double> enter_s_;
+  const TopoGraph* graph_ = nullptr;
+  bool use_landmarks_ = false;
+  std::unordered_map<const TopoNode*, int> sub_node_indices_;
+  // the search states indexed by GetIndex
+  std::vector<bool> open_set_;
+  std::vector<bool> closed_set_;
+  std::vector<const TopoNode*> came_from_;
+  std::vector<double> g_score_;
+  std::vector<double> enter_s_;
+  std::vector<bool> has_enter_s_;
 };
 
 }  // namespace routing
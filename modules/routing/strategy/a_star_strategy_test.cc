@@ -0,0 +1,308 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/strategy/a_star_strategy.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "modules/routing/common/routing_gflags.h"
+#include "modules/routing/graph/sub_topo_graph.h"
+#include "modules/routing/graph/topo_graph.h"
+#include "modules/routing/graph/topo_test_utils.h"
+#include "modules/routing/topo_creator/landmark_creator.h"
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+using BlackMap = std::unordered_map<const TopoNode*, std::vector<NodeSRange>>;
+
+// Distinct lane costs, so that no two routes tie. The costs differ by less
+// than twice the edge cost, so that every lane change costs more than zero.
+void SetLaneCosts(Graph* graph) {
+  const std::unordered_map<std::string, double> lane_costs = {
+      {TEST_L1, 1.1}, {TEST_L2, 1.3}, {TEST_L3, 3.0},
+      {TEST_L4, 0.9}, {TEST_L5, 1.6}, {TEST_L6, 0.7}};
+  for (auto& node : *graph->mutable_node()) {
+    node.set_cost(lane_costs.at(node.lane_id()));
+  }
+}
+
+int GetNodeIndex(const Graph& graph, const std::string& lane_id) {
+  for (int i = 0; i < graph.node_size(); ++i) {
+    if (graph.node(i).lane_id() == lane_id) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// The optimal search costs between all the nodes by Floyd-Warshall, without
+// the edges from and to the blocked lane.
+std::vector<std::vector<double>> GetAllCosts(
+    const Graph& graph, const std::string& blocked_lane_id) {
+  const int num_nodes = graph.node_size();
+  std::vector<std::vector<double>> costs(
+      num_nodes, std::vector<double>(num_nodes, kInfinity));
+  for (int i = 0; i < num_nodes; ++i) {
+    costs[i][i] = 0.0;
+  }
+  for (const auto& edge : graph.edge()) {
+    if (edge.from_lane_id() == blocked_lane_id ||
+        edge.to_lane_id() == blocked_lane_id) {
+      continue;
+    }
+    const int from = GetNodeIndex(graph, edge.from_lane_id());
+    const int to = GetNodeIndex(graph, edge.to_lane_id());
+    costs[from][to] = std::min(
+        costs[from][to], landmark_creator::GetSearchCost(
+                             graph.node(from), graph.node(to), edge));
+  }
+  for (int k = 0; k < num_nodes; ++k) {
+    for (int i = 0; i < num_nodes; ++i) {
+      for (int j = 0; j < num_nodes; ++j) {
+        costs[i][j] = std::min(costs[i][j], costs[i][k] + costs[k][j]);
+      }
+    }
+  }
+  return costs;
+}
+
+// The search cost along the lanes of the route.
+double GetRouteCost(const Graph& graph,
+                    const std::vector<NodeWithRange>& route) {
+  double cost = 0.0;
+  for (size_t i = 1; i < route.size(); ++i) {
+    const std::string& from_lane_id = route[i - 1].LaneId();
+    const std::string& to_lane_id = route[i].LaneId();
+    if (from_lane_id == to_lane_id) {
+      continue;
+    }
+    double edge_cost = kInfinity;
+    for (const auto& edge : graph.edge()) {
+      if (edge.from_lane_id() == from_lane_id &&
+          edge.to_lane_id() == to_lane_id) {
+        edge_cost = landmark_creator::GetSearchCost(
+            graph.node(GetNodeIndex(graph, from_lane_id)),
+            graph.node(GetNodeIndex(graph, to_lane_id)), edge);
+      }
+    }
+    cost += edge_cost;
+  }
+  return cost;
+}
+
+std::string RouteToString(const std::vector<NodeWithRange>& route) {
+  std::ostringstream route_string;
+  for (size_t i = 0; i < route.size(); ++i) {
+    if (i > 0) {
+      route_string << " ";
+    }
+    route_string << route[i].LaneId() << "[" << route[i].StartS() << ", "
+                 << route[i].EndS() << "]";
+  }
+  return route_string.str();
+}
+
+}  // namespace
+
+class AStarStrategyTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    enable_landmarks_in_routing_ = FLAGS_enable_landmarks_in_routing;
+  }
+
+  virtual void TearDown() {
+    FLAGS_enable_landmarks_in_routing = enable_landmarks_in_routing_;
+  }
+
+  // loads the graph with the distinct lane costs, and with landmarks if
+  // num_landmarks is positive
+  void LoadGraph(void (*get_graph_for_test)(Graph*), const int num_landmarks) {
+    graph_.Clear();
+    get_graph_for_test(&graph_);
+    SetLaneCosts(&graph_);
+    landmark_creator::GetPbLandmarks(num_landmarks, &graph_);
+    topo_graph_.reset(new TopoGraph());
+    ASSERT_TRUE(topo_graph_->LoadGraph(graph_));
+    ASSERT_EQ(num_landmarks > 0, topo_graph_->HasLandmarks());
+  }
+
+  const TopoNode* GetNode(const std::string& lane_id) const {
+    return topo_graph_->GetNode(lane_id);
+  }
+
+  // the route as a string, empty if the search fails
+  std::string Search(const BlackMap& black_map, const std::string& src_lane_id,
+                     const std::string& dest_lane_id) {
+    std::vector<NodeWithRange> route;
+    if (!SearchRoute(black_map, src_lane_id, dest_lane_id, &route)) {
+      return "";
+    }
+    return RouteToString(route);
+  }
+
+  // searches from the start of the source lane to the end of the destination
+  // lane, which are sub nodes if the lanes are black listed in part
+  bool SearchRoute(const BlackMap& black_map, const std::string& src_lane_id,
+                   const std::string& dest_lane_id,
+                   std::vector<NodeWithRange>* const route) {
+    SubTopoGraph sub_graph(black_map);
+    const TopoNode* src_node =
+        sub_graph.GetSubNodeWithS(GetNode(src_lane_id), TEST_START_S);
+    const TopoNode* dest_node =
+        sub_graph.GetSubNodeWithS(GetNode(dest_lane_id), TEST_END_S);
+    if (src_node == nullptr || dest_node == nullptr) {
+      return false;
+    }
+    AStarStrategy strategy(true);
+    return strategy.Search(topo_graph_.get(), &sub_graph, src_node, dest_node,
+                           route);
+  }
+
+  // the black map of the lane from start_s to end_s
+  BlackMap BlackMapOf(const std::string& lane_id, const double start_s,
+                      const double end_s) const {
+    BlackMap black_map;
+    black_map[GetNode(lane_id)].emplace_back(start_s, end_s);
+    return black_map;
+  }
+
+  // The routes of the searches without the landmark heuristic, the same as
+  // before the search state moved to arrays.
+  void ExpectLegacyRoutes(const int num_landmarks) {
+    LoadGraph(GetGraph2ForTest, num_landmarks);
+    EXPECT_EQ("L1[0, 100] L3[0, 100] L4[0, 100] L5[0, 100] L6[0, 100]",
+              Search({}, TEST_L1, TEST_L6));
+    EXPECT_EQ("L3[0, 100] L4[0, 100] L5[0, 100] L6[0, 100]",
+              Search({}, TEST_L3, TEST_L6));
+    EXPECT_EQ("L2[0, 100] L4[0, 100] L5[0, 100]",
+              Search({}, TEST_L2, TEST_L5));
+    EXPECT_EQ("", Search({}, TEST_L6, TEST_L1));
+    EXPECT_EQ("L1[0, 100] L3[0, 100] L4[0, 100] L5[0, 100] L6[0, 100]",
+              Search(BlackMapOf(TEST_L4, 20.0, 50.0), TEST_L1, TEST_L6));
+    EXPECT_EQ("L1[0, 100] L3[0, 100] L4[0, 100] L5[0, 100] L6[0, 100]",
+              Search(BlackMapOf(TEST_L2, TEST_START_S, TEST_END_S), TEST_L1,
+                     TEST_L6));
+
+    LoadGraph(GetGraph3ForTest, num_landmarks);
+    EXPECT_EQ("L1[0, 100] L3[0, 100] L5[0, 100] L6[0, 100]",
+              Search({}, TEST_L1, TEST_L6));
+    EXPECT_EQ("L1[0, 100] L3[0, 100] L5[0, 100]",
+              Search({}, TEST_L1, TEST_L5));
+    EXPECT_EQ("L2[0, 100] L4[0, 100] L6[0, 100] L5[0, 100]",
+              Search({}, TEST_L2, TEST_L5));
+    EXPECT_EQ("L1[0, 100] L2[0, 100]", Search({}, TEST_L1, TEST_L2));
+    EXPECT_EQ("", Search({}, TEST_L5, TEST_L1));
+    EXPECT_EQ("L1[0, 100] L2[0, 100] L4[0, 100] L6[0, 100] L5[0, 100]",
+              Search(BlackMapOf(TEST_L3, TEST_START_S, TEST_END_S), TEST_L1,
+                     TEST_L5));
+    EXPECT_EQ("L2[0, 100] L1[0, 100] L3[0, 100] L5[0, 100] L6[0, 100]",
+              Search(BlackMapOf(TEST_L4, 20.0, 50.0), TEST_L2, TEST_L6));
+    EXPECT_EQ("L1[0, 100] L2[0, 100] L4[0, 100] L6[0, 100] L5[0, 100]",
+              Search(BlackMapOf(TEST_L3, 40.0, 60.0), TEST_L1, TEST_L5));
+    // the terminals are the sub nodes out of their black listed ranges
+    EXPECT_EQ("L1[0, 60] L2[0, 100] L4[0, 100] L6[0, 100] L5[0, 100]",
+              Search(BlackMapOf(TEST_L1, 60.0, TEST_END_S), TEST_L1, TEST_L5));
+    EXPECT_EQ("L1[0, 100] L3[0, 100] L4[0, 100] L6[0, 100] L5[30, 100]",
+              Search(BlackMapOf(TEST_L5, TEST_START_S, 30.0), TEST_L1,
+                     TEST_L5));
+    EXPECT_EQ("L2[0, 100] L4[0, 100] L3[0, 100] L5[0, 100] L6[30, 100]",
+              Search(BlackMapOf(TEST_L6, TEST_START_S, 30.0), TEST_L2,
+                     TEST_L6));
+  }
+
+  // Every route of the searches with landmarks has the optimal cost, without
+  // a black list and with each lane black listed in full.
+  void ExpectOptimalRoutes(void (*get_graph_for_test)(Graph*)) {
+    LoadGraph(get_graph_for_test, 16);
+    std::vector<std::string> blocked_lane_ids = {""};
+    for (const auto& node : graph_.node()) {
+      blocked_lane_ids.push_back(node.lane_id());
+    }
+    for (const auto& blocked_lane_id : blocked_lane_ids) {
+      const auto costs = GetAllCosts(graph_, blocked_lane_id);
+      BlackMap black_map;
+      if (!blocked_lane_id.empty()) {
+        black_map = BlackMapOf(blocked_lane_id, TEST_START_S, TEST_END_S);
+      }
+      for (int i = 0; i < graph_.node_size(); ++i) {
+        for (int j = 0; j < graph_.node_size(); ++j) {
+          const std::string& src_lane_id = graph_.node(i).lane_id();
+          const std::string& dest_lane_id = graph_.node(j).lane_id();
+          if (i == j || src_lane_id == blocked_lane_id ||
+              dest_lane_id == blocked_lane_id) {
+            continue;
+          }
+          SCOPED_TRACE(src_lane_id + " to " + dest_lane_id +
+                       ", black listed: " + blocked_lane_id);
+          std::vector<NodeWithRange> route;
+          const bool found =
+              SearchRoute(black_map, src_lane_id, dest_lane_id, &route);
+          EXPECT_EQ(costs[i][j] < kInfinity, found);
+          if (found) {
+            EXPECT_NEAR(costs[i][j], GetRouteCost(graph_, route), 1e-9);
+          }
+        }
+      }
+    }
+  }
+
+ protected:
+  Graph graph_;
+  std::unique_ptr<TopoGraph> topo_graph_;
+  bool enable_landmarks_in_routing_ = false;
+};
+
+TEST_F(AStarStrategyTest, LegacyRoutesWithoutLandmarks) {
+  FLAGS_enable_landmarks_in_routing = true;
+  ExpectLegacyRoutes(0);
+}
+
+TEST_F(AStarStrategyTest, LegacyRoutesWithLandmarksDisabled) {
+  FLAGS_enable_landmarks_in_routing = false;
+  ExpectLegacyRoutes(16);
+}
+
+TEST_F(AStarStrategyTest, OptimalRoutesWithLandmarks) {
+  FLAGS_enable_landmarks_in_routing = true;
+  ExpectOptimalRoutes(GetGraph2ForTest);
+  ExpectOptimalRoutes(GetGraph3ForTest);
+}
+
+TEST_F(AStarStrategyTest, UnreachableWithLandmarks) {
+  FLAGS_enable_landmarks_in_routing = true;
+  LoadGraph(GetGraph3ForTest, 16);
+  EXPECT_EQ("", Search({}, TEST_L5, TEST_L1));
+  EXPECT_EQ("", Search({}, TEST_L6, TEST_L2));
+  // the lanes of R2 are all black listed
+  auto black_map = BlackMapOf(TEST_L3, TEST_START_S, TEST_END_S);
+  black_map[GetNode(TEST_L4)].emplace_back(TEST_START_S, TEST_END_S);
+  EXPECT_EQ("", Search(black_map, TEST_L1, TEST_L5));
+}
+
+}  // namespace routing
+}  // namespace apollo
@@ -18,6 +18,9 @@
 
 #include <vector>
 
+#include "modules/routing/graph/sub_topo_graph.h"
+#include "modules/routing/graph/topo_graph.h"
+
 namespace apollo {
 namespace routing {
 
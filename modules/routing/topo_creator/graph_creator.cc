@@ -16,15 +16,20 @@
 
 #include "modules/routing/topo_creator/graph_creator.h"
 
+#include <algorithm>
+#include <functional>
+#include <future>
 #include <vector>
 
 #include "cyber/common/file.h"
+#include "cyber/task/task.h"
 #include "modules/common/configs/vehicle_config_helper.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/common/util/string_util.h"
 #include "modules/map/hdmap/adapter/opendrive_adapter.h"
 #include "modules/routing/common/routing_gflags.h"
 #include "modules/routing/topo_creator/edge_creator.h"
+#include "modules/routing/topo_creator/landmark_creator.h"
 #include "modules/routing/topo_creator/node_creator.h"
 
 namespace apollo {
@@ -42,6 +47,41 @@ using ::google::protobuf::RepeatedPtrField;
 
 namespace {
 
+constexpr int kNumLanesPerTask = 256;
+
+uint64_t Fnv1aHash(const std::string& data,
+                   uint64_t hash = 14695981039346656037ULL) {
+  for (const char c : data) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+// Run func on the lanes [0, num_lanes), in parallel tasks of
+// kNumLanesPerTask lanes if enabled.
+void ForEachLane(const int num_lanes, const std::function<void(int)>& func) {
+  if (!FLAGS_enable_multi_thread_in_topo_creation ||
+      num_lanes <= kNumLanesPerTask) {
+    for (int i = 0; i < num_lanes; ++i) {
+      func(i);
+    }
+    return;
+  }
+  std::vector<std::future<void>> futures;
+  for (int begin = 0; begin < num_lanes; begin += kNumLanesPerTask) {
+    const int end = std::min(begin + kNumLanesPerTask, num_lanes);
+    futures.push_back(cyber::Async([&func, begin, end] {
+      for (int i = begin; i < end; ++i) {
+        func(i);
+      }
+    }));
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+}
+
 bool IsAllowedToCross(const LaneBoundary& boundary) {
   for (const auto& boundary_type : boundary.boundary_type()) {
     if (boundary_type.types(0) != LaneBoundaryType::DOTTED_YELLOW &&
@@ -62,6 +102,16 @@ GraphCreator::GraphCreator(const std::string& base_map_file_path,
       routing_conf_(routing_conf) {}
 
 bool GraphCreator::Create() {
+  if (!EndWith(dump_topo_file_path_, ".bin") &&
+      !EndWith(dump_topo_file_path_, ".txt")) {
+    AERROR << "Failed to dump topo data into file, incorrect file type "
+           << dump_topo_file_path_;
+    return false;
+  }
+  auto type_pos = dump_topo_file_path_.find_last_of(".") + 1;
+  std::string bin_file = dump_topo_file_path_.replace(type_pos, 3, "bin");
+  std::string txt_file = dump_topo_file_path_.replace(type_pos, 3, "txt");
+
   if (EndWith(base_map_file_path_, ".xml")) {
     if (!hdmap::adapter::OpendriveAdapter::LoadData(base_map_file_path_,
                                                     &pbmap_)) {
@@ -77,12 +127,12 @@ bool GraphCreator::Create() {
 
   AINFO << "Number of lanes: " << pbmap_.lane_size();
 
+  graph_.Clear();
   graph_.set_hdmap_version(pbmap_.header().version());
   graph_.set_hdmap_district(pbmap_.header().district());
 
   node_index_map_.clear();
   road_id_map_.clear();
-  showed_edge_id_set_.clear();
 
   for (const auto& road : pbmap_.road()) {
     for (const auto& section : road.section()) {
@@ -95,7 +145,16 @@ bool GraphCreator::Create() {
   InitForbiddenLanes();
   const double min_turn_radius =
       VehicleConfigHelper::GetConfig().vehicle_param().min_turn_radius();
+  graph_.set_creation_fingerprint(GetCreationFingerprint(min_turn_radius));
 
+  previous_graph_.Clear();
+  previous_node_index_map_.clear();
+  previous_edge_indices_.clear();
+  const bool is_incremental =
+      FLAGS_enable_incremental_topo_creation && LoadPreviousGraph(bin_file);
+
+  // the lanes of the nodes, in the order of the nodes
+  std::vector<const hdmap::Lane*> node_lanes;
   for (const auto& lane : pbmap_.lane()) {
     const auto& lane_id = lane.id().id();
     if (forbidden_lane_id_set_.find(lane_id) != forbidden_lane_id_set_.end()) {
@@ -108,49 +167,52 @@ bool GraphCreator::Create() {
       ADEBUG << "The u-turn lane radius is too small for the vehicle to turn";
       continue;
     }
-    AINFO << "Current lane id: " << lane_id;
     node_index_map_[lane_id] = graph_.node_size();
-    const auto iter = road_id_map_.find(lane_id);
-    if (iter != road_id_map_.end()) {
-      node_creator::GetPbNode(lane, iter->second, routing_conf_,
-                              graph_.add_node());
-    } else {
-      AWARN << "Failed to find road id of lane " << lane_id;
-      node_creator::GetPbNode(lane, "", routing_conf_, graph_.add_node());
-    }
+    graph_.add_node();
+    node_lanes.push_back(&lane);
   }
+  const int num_nodes = static_cast<int>(node_lanes.size());
 
-  for (const auto& lane : pbmap_.lane()) {
-    const auto& lane_id = lane.id().id();
-    if (forbidden_lane_id_set_.find(lane_id) != forbidden_lane_id_set_.end()) {
-      ADEBUG << "Ignored lane id: " << lane_id
-             << " because its type is NOT CITY_DRIVING.";
-      continue;
-    }
-    const auto& from_node = graph_.node(node_index_map_[lane_id]);
+  // the nodes, and then the edges of every lane, are created independently
+  std::vector<char> is_node_reused(num_nodes, 0);
+  ForEachLane(num_nodes, [&](const int i) {
+    bool is_reused = false;
+    CreateNode(*node_lanes[i], graph_.mutable_node(i), &is_reused);
+    is_node_reused[i] = is_reused;
+  });
 
-    AddEdge(from_node, lane.successor_id(), Edge::FORWARD);
-    if (lane.length() < FLAGS_min_length_for_lane_change) {
-      continue;
-    }
-    if (lane.has_left_boundary() && IsAllowedToCross(lane.left_boundary())) {
-      AddEdge(from_node, lane.left_neighbor_forward_lane_id(), Edge::LEFT);
+  std::vector<std::vector<Edge>> lane_edges(num_nodes);
+  std::vector<char> is_edges_reused(num_nodes, 0);
+  ForEachLane(num_nodes, [&](const int i) {
+    const auto& lane = *node_lanes[i];
+    if (is_incremental && IsEdgesUnchanged(lane)) {
+      const auto iter = previous_edge_indices_.find(lane.id().id());
+      if (iter != previous_edge_indices_.end()) {
+        for (const int edge_index : iter->second) {
+          lane_edges[i].push_back(previous_graph_.edge(edge_index));
+        }
+      }
+      is_edges_reused[i] = 1;
+      return;
     }
-
-    if (lane.has_right_boundary() && IsAllowedToCross(lane.right_boundary())) {
-      AddEdge(from_node, lane.right_neighbor_forward_lane_id(), Edge::RIGHT);
+    CreateEdges(lane, graph_.node(i), &lane_edges[i]);
+  });
+  for (auto& edges : lane_edges) {
+    for (auto& edge : edges) {
+      graph_.add_edge()->Swap(&edge);
     }
   }
-
-  if (!EndWith(dump_topo_file_path_, ".bin") &&
-      !EndWith(dump_topo_file_path_, ".txt")) {
-    AERROR << "Failed to dump topo data into file, incorrect file type "
-           << dump_topo_file_path_;
-    return false;
+  if (is_incremental) {
+    AINFO << "Reused "
+          << std::count(is_node_reused.begin(), is_node_reused.end(), 1)
+          << " nodes and the edges of "
+          << std::count(is_edges_reused.begin(), is_edges_reused.end(), 1)
+          << " nodes of " << num_nodes << " nodes from " << bin_file;
   }
-  auto type_pos = dump_topo_file_path_.find_last_of(".") + 1;
-  std::string bin_file = dump_topo_file_path_.replace(type_pos, 3, "bin");
-  std::string txt_file = dump_topo_file_path_.replace(type_pos, 3, "txt");
+
+  landmark_creator::GetPbLandmarks(
+      static_cast<int>(routing_conf_.num_landmarks()), &graph_);
+
   if (!cyber::common::SetProtoToASCIIFile(graph_, txt_file)) {
     AERROR << "Failed to dump topo data into file " << txt_file;
     return false;
@@ -164,14 +226,128 @@ bool GraphCreator::Create() {
   return true;
 }
 
+uint64_t GraphCreator::GetCreationFingerprint(
+    const double min_turn_radius) const {
+  const double params[] = {min_turn_radius, FLAGS_min_length_for_lane_change};
+  return Fnv1aHash(
+      std::string(reinterpret_cast<const char*>(params), sizeof(params)),
+      Fnv1aHash(routing_conf_.SerializeAsString()));
+}
+
+bool GraphCreator::LoadPreviousGraph(const std::string& bin_file) {
+  if (!cyber::common::PathExists(bin_file)) {
+    AINFO << "No topo graph created before in " << bin_file
+          << ", create all the nodes and edges.";
+    return false;
+  }
+  if (!cyber::common::GetProtoFromBinaryFile(bin_file, &previous_graph_)) {
+    AWARN << "Failed to load the topo graph created before from " << bin_file
+          << ", create all the nodes and edges.";
+    previous_graph_.Clear();
+    return false;
+  }
+  if (!previous_graph_.has_creation_fingerprint() ||
+      previous_graph_.creation_fingerprint() !=
+          graph_.creation_fingerprint()) {
+    AINFO << "The topo graph in " << bin_file
+          << " is created with other configs, create all the nodes and edges.";
+    previous_graph_.Clear();
+    return false;
+  }
+  for (int i = 0; i < previous_graph_.node_size(); ++i) {
+    previous_node_index_map_[previous_graph_.node(i).lane_id()] = i;
+  }
+  for (int i = 0; i < previous_graph_.edge_size(); ++i) {
+    previous_edge_indices_[previous_graph_.edge(i).from_lane_id()].push_back(
+        i);
+  }
+  return true;
+}
+
+void GraphCreator::CreateNode(const hdmap::Lane& lane, Node* const node,
+                              bool* const is_reused) const {
+  const auto& lane_id = lane.id().id();
+  std::string road_id;
+  const auto iter = road_id_map_.find(lane_id);
+  if (iter != road_id_map_.end()) {
+    road_id = iter->second;
+  } else {
+    AWARN << "Failed to find road id of lane " << lane_id;
+  }
+  const uint64_t lane_fingerprint =
+      Fnv1aHash(road_id, Fnv1aHash(lane.SerializeAsString()));
+
+  const auto previous_iter = previous_node_index_map_.find(lane_id);
+  if (previous_iter != previous_node_index_map_.end() &&
+      previous_graph_.node(previous_iter->second).lane_fingerprint() ==
+          lane_fingerprint) {
+    *node = previous_graph_.node(previous_iter->second);
+    *is_reused = true;
+    return;
+  }
+  AINFO << "Current lane id: " << lane_id;
+  node_creator::GetPbNode(lane, road_id, routing_conf_, node);
+  node->set_lane_fingerprint(lane_fingerprint);
+  *is_reused = false;
+}
+
+void GraphCreator::CreateEdges(const hdmap::Lane& lane, const Node& from_node,
+                               std::vector<Edge>* const edges) const {
+  std::unordered_set<std::string> showed_edge_id_set;
+  AddEdge(from_node, lane.successor_id(), Edge::FORWARD, &showed_edge_id_set,
+          edges);
+  if (lane.length() < FLAGS_min_length_for_lane_change) {
+    return;
+  }
+  if (lane.has_left_boundary() && IsAllowedToCross(lane.left_boundary())) {
+    AddEdge(from_node, lane.left_neighbor_forward_lane_id(), Edge::LEFT,
+            &showed_edge_id_set, edges);
+  }
+
+  if (lane.has_right_boundary() && IsAllowedToCross(lane.right_boundary())) {
+    AddEdge(from_node, lane.right_neighbor_forward_lane_id(), Edge::RIGHT,
+            &showed_edge_id_set, edges);
+  }
+}
+
+bool GraphCreator::IsLaneUnchanged(const std::string& lane_id) const {
+  const auto iter = node_index_map_.find(lane_id);
+  const auto previous_iter = previous_node_index_map_.find(lane_id);
+  if (iter == node_index_map_.end() ||
+      previous_iter == previous_node_index_map_.end()) {
+    return iter == node_index_map_.end() &&
+           previous_iter == previous_node_index_map_.end();
+  }
+  return graph_.node(iter->second).lane_fingerprint() ==
+         previous_graph_.node(previous_iter->second).lane_fingerprint();
+}
+
+bool GraphCreator::IsEdgesUnchanged(const hdmap::Lane& lane) const {
+  if (!IsLaneUnchanged(lane.id().id())) {
+    return false;
+  }
+  for (const auto* to_ids :
+       {&lane.successor_id(), &lane.left_neighbor_forward_lane_id(),
+        &lane.right_neighbor_forward_lane_id()}) {
+    for (const auto& to_id : *to_ids) {
+      if (!IsLaneUnchanged(to_id.id())) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 std::string GraphCreator::GetEdgeID(const std::string& from_id,
-                                    const std::string& to_id) {
+                                    const std::string& to_id) const {
   return from_id + "->" + to_id;
 }
 
-void GraphCreator::AddEdge(const Node& from_node,
-                           const RepeatedPtrField<Id>& to_node_vec,
-                           const Edge::DirectionType& type) {
+void GraphCreator::AddEdge(
+    const Node& from_node, const RepeatedPtrField<Id>& to_node_vec,
+    const Edge::DirectionType& type,
+    std::unordered_set<std::string>* const showed_edge_id_set,
+    std::vector<Edge>* const edges) const {
   for (const auto& to_id : to_node_vec) {
     if (forbidden_lane_id_set_.find(to_id.id()) !=
         forbidden_lane_id_set_.end()) {
@@ -179,17 +355,18 @@ void GraphCreator::AddEdge(const Node& from_node,
       continue;
     }
     const std::string edge_id = GetEdgeID(from_node.lane_id(), to_id.id());
-    if (showed_edge_id_set_.count(edge_id) != 0) {
+    if (showed_edge_id_set->count(edge_id) != 0) {
       continue;
     }
-    showed_edge_id_set_.insert(edge_id);
+    showed_edge_id_set->insert(edge_id);
     const auto& iter = node_index_map_.find(to_id.id());
     if (iter == node_index_map_.end()) {
       continue;
     }
     const auto& to_node = graph_.node(iter->second);
+    edges->emplace_back();
     edge_creator::GetPbEdge(from_node, to_node, type, routing_conf_,
-                            graph_.add_edge());
+                            &edges->back());
   }
 }
 
@@ -234,6 +411,7 @@ bool GraphCreator::IsValidUTurn(const hdmap::Lane& lane, const double radius) {
 }
 
 void GraphCreator::InitForbiddenLanes() {
+  forbidden_lane_id_set_.clear();
   for (const auto& lane : pbmap_.lane()) {
     if (lane.type() != hdmap::Lane::CITY_DRIVING) {
       forbidden_lane_id_set_.insert(lane.id().id());
@@ -16,9 +16,11 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "modules/map/proto/map.pb.h"
 #include "modules/routing/proto/routing_config.pb.h"
@@ -39,12 +41,34 @@ class GraphCreator {
 
  private:
   void InitForbiddenLanes();
-  std::string GetEdgeID(const std::string& from_id, const std::string& to_id);
+  std::string GetEdgeID(const std::string& from_id,
+                        const std::string& to_id) const;
+
+  uint64_t GetCreationFingerprint(const double min_turn_radius) const;
+
+  // Load the graph created before from bin_file for the incremental creation.
+  bool LoadPreviousGraph(const std::string& bin_file);
+
+  void CreateNode(const hdmap::Lane& lane, Node* const node,
+                  bool* const is_reused) const;
+
+  void CreateEdges(const hdmap::Lane& lane, const Node& from_node,
+                   std::vector<Edge>* const edges) const;
 
   void AddEdge(
       const Node& from_node,
       const ::google::protobuf::RepeatedPtrField<hdmap::Id>& to_node_vec,
-      const Edge::DirectionType& type);
+      const Edge::DirectionType& type,
+      std::unordered_set<std::string>* const showed_edge_id_set,
+      std::vector<Edge>* const edges) const;
+
+  // Whether the node of the lane is the same as in the previous graph, or
+  // the lane has a node in neither of the graphs.
+  bool IsLaneUnchanged(const std::string& lane_id) const;
+
+  // Whether the edges from the lane are the same as in the previous graph,
+  // i.e. the lane and all the lanes it connects to are unchanged.
+  bool IsEdgesUnchanged(const hdmap::Lane& lane) const;
 
   static bool IsValidUTurn(const hdmap::Lane& lane, const double radius);
 
@@ -55,9 +79,13 @@ class GraphCreator {
   Graph graph_;
   std::unordered_map<std::string, int> node_index_map_;
   std::unordered_map<std::string, std::string> road_id_map_;
-  std::unordered_set<std::string> showed_edge_id_set_;
   std::unordered_set<std::string> forbidden_lane_id_set_;
 
+  // the graph created before, empty unless the creation is incremental
+  Graph previous_graph_;
+  std::unordered_map<std::string, int> previous_node_index_map_;
+  std::unordered_map<std::string, std::vector<int>> previous_edge_indices_;
+
   const RoutingConfig& routing_conf_;
 };
 
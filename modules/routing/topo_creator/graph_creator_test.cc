@@ -14,13 +14,23 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <string>
+
+#include "cyber/common/file.h"
 #include "gtest/gtest.h"
+#include "modules/common/configs/vehicle_config_helper.h"
+#include "modules/routing/common/routing_gflags.h"
 
 #define private public
 #include "modules/routing/topo_creator/graph_creator.h"
 
+using apollo::common::VehicleConfig;
+using apollo::common::VehicleConfigHelper;
 using apollo::hdmap::Lane;
+using apollo::hdmap::Map;
+using apollo::routing::Graph;
 using apollo::routing::GraphCreator;
+using apollo::routing::RoutingConfig;
 
 TEST(GraphCreatorTest, IsValidUTurn) {
   const double min_turn_radius = 6.0;
@@ -77,3 +87,90 @@ TEST(GraphCreatorTest, IsValidUTurn) {
     EXPECT_TRUE(GraphCreator::IsValidUTurn(lane, min_turn_radius));
   }
 }
+
+// A map of num_roads roads in a row, each of two lanes with dotted boundaries
+// between them.
+Map GetMapForTest(const int num_roads) {
+  Map map;
+  for (int i = 0; i < num_roads; ++i) {
+    auto* road = map.add_road();
+    road->mutable_id()->set_id("road_" + std::to_string(i));
+    auto* section = road->add_section();
+    for (int j = 0; j < 2; ++j) {
+      const std::string lane_id =
+          "lane_" + std::to_string(i) + "_" + std::to_string(j);
+      section->add_lane_id()->set_id(lane_id);
+      auto* lane = map.add_lane();
+      lane->mutable_id()->set_id(lane_id);
+      lane->set_type(Lane::CITY_DRIVING);
+      lane->set_turn(Lane::NO_TURN);
+      lane->set_length(100.0);
+      lane->set_speed_limit(10.0);
+      lane->mutable_central_curve()->add_segment()->set_length(100.0);
+      auto* boundary = j == 0 ? lane->mutable_right_boundary()
+                              : lane->mutable_left_boundary();
+      boundary->set_length(100.0);
+      boundary->add_boundary_type()->add_types(
+          apollo::hdmap::LaneBoundaryType::DOTTED_WHITE);
+      (j == 0 ? lane->add_right_neighbor_forward_lane_id()
+              : lane->add_left_neighbor_forward_lane_id())
+          ->set_id("lane_" + std::to_string(i) + "_" + std::to_string(1 - j));
+      if (i + 1 < num_roads) {
+        lane->add_successor_id()->set_id("lane_" + std::to_string(i + 1) +
+                                         "_" + std::to_string(j));
+      }
+    }
+  }
+  return map;
+}
+
+TEST(GraphCreatorTest, IncrementalCreation) {
+  const std::string base_map_file = "/tmp/graph_creator_test_base_map.bin";
+  const std::string edited_map_file = "/tmp/graph_creator_test_edited_map.bin";
+  const std::string full_topo_file = "/tmp/graph_creator_test_full.bin";
+  const std::string incremental_topo_file =
+      "/tmp/graph_creator_test_incremental.bin";
+
+  VehicleConfigHelper::Init(VehicleConfig());
+  RoutingConfig routing_conf;
+  routing_conf.set_base_speed(4.167);
+  routing_conf.set_left_turn_penalty(50.0);
+  routing_conf.set_right_turn_penalty(20.0);
+  routing_conf.set_uturn_penalty(100.0);
+  routing_conf.set_change_penalty(500.0);
+  routing_conf.set_base_changing_length(50.0);
+  routing_conf.set_num_landmarks(4);
+
+  // more lanes than a task of the parallel creation
+  Map map = GetMapForTest(300);
+  ASSERT_TRUE(apollo::cyber::common::SetProtoToBinaryFile(map, base_map_file));
+  map.mutable_lane(10)->set_speed_limit(20.0);
+  map.mutable_lane(20)->clear_successor_id();
+  map.mutable_lane(30)->set_type(Lane::BIKING);
+  ASSERT_TRUE(
+      apollo::cyber::common::SetProtoToBinaryFile(map, edited_map_file));
+
+  FLAGS_enable_multi_thread_in_topo_creation = false;
+  FLAGS_enable_incremental_topo_creation = false;
+  ASSERT_TRUE(
+      GraphCreator(edited_map_file, full_topo_file, routing_conf).Create());
+  FLAGS_enable_multi_thread_in_topo_creation = true;
+  ASSERT_TRUE(
+      GraphCreator(base_map_file, incremental_topo_file, routing_conf)
+          .Create());
+  FLAGS_enable_incremental_topo_creation = true;
+  ASSERT_TRUE(
+      GraphCreator(edited_map_file, incremental_topo_file, routing_conf)
+          .Create());
+  FLAGS_enable_incremental_topo_creation = false;
+
+  Graph full_graph;
+  Graph incremental_graph;
+  ASSERT_TRUE(
+      apollo::cyber::common::GetProtoFromFile(full_topo_file, &full_graph));
+  ASSERT_TRUE(apollo::cyber::common::GetProtoFromFile(incremental_topo_file,
+                                                      &incremental_graph));
+  EXPECT_EQ(599, full_graph.node_size());
+  EXPECT_EQ(full_graph.SerializeAsString(),
+            incremental_graph.SerializeAsString());
+}
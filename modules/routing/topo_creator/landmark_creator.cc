@@ -0,0 +1,160 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/topo_creator/landmark_creator.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace routing {
+namespace landmark_creator {
+
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+constexpr double kUnreachableCost = -1.0;
+
+struct Arc {
+  int node_index = 0;
+  double cost = 0.0;
+};
+
+// The search costs from the source to all the nodes along the arcs. A lane
+// change may have a negative cost, so a node is expanded again whenever its
+// cost decreases.
+std::vector<double> GetCosts(const std::vector<std::vector<Arc>>& arcs,
+                             const int source) {
+  using CostNode = std::pair<double, int>;
+  std::vector<double> costs(arcs.size(), kInfinity);
+  std::priority_queue<CostNode, std::vector<CostNode>, std::greater<CostNode>>
+      open_nodes;
+  costs[source] = 0.0;
+  open_nodes.emplace(0.0, source);
+  while (!open_nodes.empty()) {
+    const auto top = open_nodes.top();
+    open_nodes.pop();
+    if (top.first > costs[top.second]) {
+      continue;
+    }
+    for (const auto& arc : arcs[top.second]) {
+      const double cost = top.first + arc.cost;
+      if (cost < costs[arc.node_index]) {
+        costs[arc.node_index] = cost;
+        open_nodes.emplace(cost, arc.node_index);
+      }
+    }
+  }
+  return costs;
+}
+
+void AddCosts(const std::vector<double>& costs,
+              ::google::protobuf::RepeatedField<double>* const pb_costs) {
+  pb_costs->Reserve(static_cast<int>(costs.size()));
+  for (const double cost : costs) {
+    pb_costs->Add(cost < kInfinity ? cost : kUnreachableCost);
+  }
+}
+
+}  // namespace
+
+double GetSearchCost(const Node& from_node, const Node& to_node,
+                     const Edge& edge) {
+  double cost = edge.cost() + to_node.cost();
+  if (edge.direction_type() != Edge::FORWARD) {
+    cost -= (from_node.cost() + to_node.cost()) / 2;
+  }
+  return cost;
+}
+
+void GetPbLandmarks(const int num_landmarks, Graph* const graph) {
+  graph->clear_landmark();
+  const int num_nodes = graph->node_size();
+  if (num_landmarks <= 0 || num_nodes == 0) {
+    return;
+  }
+  std::unordered_map<std::string, int> node_index_map;
+  for (int i = 0; i < num_nodes; ++i) {
+    node_index_map[graph->node(i).lane_id()] = i;
+  }
+  std::vector<std::vector<Arc>> out_arcs(num_nodes);
+  std::vector<std::vector<Arc>> in_arcs(num_nodes);
+  for (const auto& edge : graph->edge()) {
+    const auto from_iter = node_index_map.find(edge.from_lane_id());
+    const auto to_iter = node_index_map.find(edge.to_lane_id());
+    if (from_iter == node_index_map.end() || to_iter == node_index_map.end()) {
+      continue;
+    }
+    const double cost = GetSearchCost(graph->node(from_iter->second),
+                                      graph->node(to_iter->second), edge);
+    out_arcs[from_iter->second].push_back({to_iter->second, cost});
+    in_arcs[to_iter->second].push_back({from_iter->second, cost});
+  }
+
+  // Every landmark is the node farthest from the landmarks before, in the sum
+  // of the costs in both directions, which starts from the farthest node
+  // from the first node.
+  std::vector<double> min_round_trip_costs(num_nodes, kInfinity);
+  int landmark_index = 0;
+  {
+    const auto costs = GetCosts(out_arcs, 0);
+    for (int i = 0; i < num_nodes; ++i) {
+      if (costs[i] < kInfinity && costs[i] > costs[landmark_index]) {
+        landmark_index = i;
+      }
+    }
+  }
+  for (int k = 0; k < std::min(num_landmarks, num_nodes); ++k) {
+    const auto costs_from_landmark = GetCosts(out_arcs, landmark_index);
+    const auto costs_to_landmark = GetCosts(in_arcs, landmark_index);
+    auto* landmark = graph->add_landmark();
+    landmark->set_lane_id(graph->node(landmark_index).lane_id());
+    AddCosts(costs_from_landmark, landmark->mutable_cost_from_landmark());
+    AddCosts(costs_to_landmark, landmark->mutable_cost_to_landmark());
+    AINFO << "Landmark " << k << ": " << landmark->lane_id();
+
+    int next_landmark_index = -1;
+    for (int i = 0; i < num_nodes; ++i) {
+      min_round_trip_costs[i] =
+          std::min(min_round_trip_costs[i],
+                   costs_from_landmark[i] + costs_to_landmark[i]);
+      // the nodes not connected with the landmarks are left out
+      if (min_round_trip_costs[i] < kInfinity &&
+          (next_landmark_index < 0 ||
+           min_round_trip_costs[i] >
+               min_round_trip_costs[next_landmark_index])) {
+        next_landmark_index = i;
+      }
+    }
+    if (next_landmark_index < 0 ||
+        min_round_trip_costs[next_landmark_index] <= 0.0) {
+      break;
+    }
+    landmark_index = next_landmark_index;
+  }
+}
+
+}  // namespace landmark_creator
+}  // namespace routing
+}  // namespace apollo
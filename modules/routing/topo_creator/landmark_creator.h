@@ -0,0 +1,37 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include "modules/routing/proto/topo_graph.pb.h"
+
+namespace apollo {
+namespace routing {
+namespace landmark_creator {
+
+// The cost of the routing search to move along the edge, which is the cost of
+// the edge and the node it enters, and half of the difference of the node
+// costs for a lane change. Same as the cost in AStarStrategy.
+double GetSearchCost(const Node& from_node, const Node& to_node,
+                     const Edge& edge);
+
+// Select num_landmarks nodes far from each other, and add them to the graph
+// with the search costs from and to all the nodes.
+void GetPbLandmarks(const int num_landmarks, Graph* const graph);
+
+}  // namespace landmark_creator
+}  // namespace routing
+}  // namespace apollo
@@ -0,0 +1,156 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/topo_creator/landmark_creator.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "modules/routing/graph/topo_graph.h"
+#include "modules/routing/graph/topo_test_utils.h"
+
+namespace apollo {
+namespace routing {
+namespace landmark_creator {
+
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+// The search costs between all the nodes by Floyd-Warshall.
+std::vector<std::vector<double>> GetAllCosts(const Graph& graph) {
+  const int num_nodes = graph.node_size();
+  std::unordered_map<std::string, int> node_index_map;
+  for (int i = 0; i < num_nodes; ++i) {
+    node_index_map[graph.node(i).lane_id()] = i;
+  }
+  std::vector<std::vector<double>> costs(
+      num_nodes, std::vector<double>(num_nodes, kInfinity));
+  for (int i = 0; i < num_nodes; ++i) {
+    costs[i][i] = 0.0;
+  }
+  for (const auto& edge : graph.edge()) {
+    const int from = node_index_map[edge.from_lane_id()];
+    const int to = node_index_map[edge.to_lane_id()];
+    costs[from][to] = std::min(
+        costs[from][to],
+        GetSearchCost(graph.node(from), graph.node(to), edge));
+  }
+  for (int k = 0; k < num_nodes; ++k) {
+    for (int i = 0; i < num_nodes; ++i) {
+      for (int j = 0; j < num_nodes; ++j) {
+        costs[i][j] = std::min(costs[i][j], costs[i][k] + costs[k][j]);
+      }
+    }
+  }
+  return costs;
+}
+
+}  // namespace
+
+TEST(LandmarkCreatorTest, GetSearchCost) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  Node from_node = graph.node(0);
+  Node to_node = graph.node(1);
+  from_node.set_cost(3.0);
+  to_node.set_cost(1.0);
+  Edge edge;
+  GetEdgeForTest(&edge, TEST_L1, TEST_L2, Edge::FORWARD);
+  EXPECT_DOUBLE_EQ(TEST_EDGE_COST + 1.0,
+                   GetSearchCost(from_node, to_node, edge));
+  edge.set_direction_type(Edge::RIGHT);
+  EXPECT_DOUBLE_EQ(TEST_EDGE_COST + 1.0 - 2.0,
+                   GetSearchCost(from_node, to_node, edge));
+}
+
+TEST(LandmarkCreatorTest, LandmarkCosts) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  GetPbLandmarks(16, &graph);
+  ASSERT_GT(graph.landmark_size(), 0);
+  ASSERT_LE(graph.landmark_size(), graph.node_size());
+
+  const auto costs = GetAllCosts(graph);
+  for (const auto& landmark : graph.landmark()) {
+    int landmark_index = -1;
+    for (int i = 0; i < graph.node_size(); ++i) {
+      if (graph.node(i).lane_id() == landmark.lane_id()) {
+        landmark_index = i;
+      }
+    }
+    ASSERT_GE(landmark_index, 0);
+    ASSERT_EQ(graph.node_size(), landmark.cost_from_landmark_size());
+    ASSERT_EQ(graph.node_size(), landmark.cost_to_landmark_size());
+    for (int i = 0; i < graph.node_size(); ++i) {
+      const double cost_from = costs[landmark_index][i];
+      const double cost_to = costs[i][landmark_index];
+      EXPECT_DOUBLE_EQ(cost_from < kInfinity ? cost_from : -1.0,
+                       landmark.cost_from_landmark(i));
+      EXPECT_DOUBLE_EQ(cost_to < kInfinity ? cost_to : -1.0,
+                       landmark.cost_to_landmark(i));
+    }
+  }
+
+  GetPbLandmarks(0, &graph);
+  EXPECT_EQ(0, graph.landmark_size());
+}
+
+TEST(LandmarkCreatorTest, CostLowerBound) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  TopoGraph graph_without_landmarks;
+  ASSERT_TRUE(graph_without_landmarks.LoadGraph(graph));
+  EXPECT_FALSE(graph_without_landmarks.HasLandmarks());
+
+  GetPbLandmarks(2, &graph);
+  EXPECT_EQ(2, graph.landmark_size());
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+  ASSERT_TRUE(topo_graph.HasLandmarks());
+  ASSERT_EQ(graph.node_size(), topo_graph.NumNodes());
+
+  const auto costs = GetAllCosts(graph);
+  for (int i = 0; i < graph.node_size(); ++i) {
+    const auto* from_node = topo_graph.GetNode(graph.node(i).lane_id());
+    ASSERT_NE(nullptr, from_node);
+    for (int j = 0; j < graph.node_size(); ++j) {
+      const auto* to_node = topo_graph.GetNode(graph.node(j).lane_id());
+      const double lower_bound =
+          topo_graph.GetLandmarkCostLowerBound(from_node, to_node);
+      EXPECT_GE(lower_bound, 0.0);
+      if (costs[i][j] < kInfinity) {
+        EXPECT_LE(lower_bound, costs[i][j] + 1e-9);
+      }
+      EXPECT_DOUBLE_EQ(
+          0.0, graph_without_landmarks.GetLandmarkCostLowerBound(
+                   graph_without_landmarks.GetNode(graph.node(i).lane_id()),
+                   graph_without_landmarks.GetNode(graph.node(j).lane_id())));
+    }
+  }
+  // the lanes of R1 are not reachable from the lanes of R3
+  EXPECT_EQ(kInfinity, topo_graph.GetLandmarkCostLowerBound(
+                           topo_graph.GetNode(TEST_L5),
+                           topo_graph.GetNode(TEST_L1)));
+}
+
+}  // namespace landmark_creator
+}  // namespace routing
+}  // namespace apollo